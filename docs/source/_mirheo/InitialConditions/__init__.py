@@ -32,7 +32,10 @@ class Membrane(InitialConditions):
     
     """
     def __init__():
-        r"""__init__(com_q: List[ComQ], global_scale: float = 1.0) -> None
+        r"""__init__(*args, **kwargs)
+Overloaded function.
+
+1. __init__(com_q: List[ComQ], global_scale: float = 1.0, mesh_types: List[int] = []) -> None
 
 
             Args:
@@ -45,6 +48,60 @@ class Membrane(InitialConditions):
                 global_scale:
                     All the membranes will be scaled by that value. Useful to implement membranes growth so that they
                     can fill the space with high volume fraction                                        
+                mesh_types:
+                    Index of the mesh of each object, for a :any:`MembraneMesh` made of several meshes.
+                    One entry per entry of **com_q**; all the objects use the first mesh if empty.
+        
+
+2. __init__(packing: Packing, global_scale: float = 1.0, save_to: str = '') -> None
+
+
+            Args:
+                packing:
+                    :any:`Packing` that generates the objects in parallel. If the packing could not reach
+                    the full size of the objects, they are created at the reached scale.
+                global_scale:
+                    All the membranes will be scaled by that value, on top of the packing scale
+                save_to:
+                    If not empty, the generated objects are written to that file, which can be given as **com_q_filename**
+        
+
+3. __init__(com_q_filename: str, global_scale: float = 1.0) -> None
+
+
+            Args:
+                com_q_filename:
+                    File written by a :any:`Packing`; each rank only reads its part of the file.
+                    The membranes are created at the scale reached by the packing.
+                global_scale:
+                    All the membranes will be scaled by that value, on top of the packing scale
+        
+
+        """
+        pass
+
+class Packing:
+    r"""
+        Generates the centers of mass and orientations of non-overlapping objects in parallel, see :ref:`user-ic`.
+        Can be given to :any:`Membrane` and :any:`Rigid` instead of a list of objects.
+
+        The objects are approximated by ellipsoids. Each rank generates the objects of its subdomain only,
+        placing them at random in cells processed in 8 colors, such that neighbouring cells are never filled at the same time.
+        The objects are first placed at **initial_scale** of their size, and then grown in **growth_steps** steps,
+        moving and rotating the overlapping ones. The growth stops at the last scale without overlaps.
+    
+    """
+    def __init__():
+        r"""__init__(axes: float3, number_density: float, initial_scale: float = 1.0, growth_steps: int = 0, max_attempts: int = 100, seed: int = 42) -> None
+
+
+            Args:
+                axes: semi-axes of the ellipsoid that encloses one object
+                number_density: number of objects per unit volume
+                initial_scale: size of the objects when they are placed, relative to their full size
+                growth_steps: number of steps to grow the objects from **initial_scale** to their full size
+                max_attempts: number of random trials to place one object or to remove one overlap
+                seed: seed of the random numbers
         
 
         """
@@ -133,6 +190,34 @@ Overloaded function.
                     One entry (list of 3 floats) in the list corresponds to one object 
         
 
+4. __init__(packing: Packing, coords: List[float3], save_to: str = '') -> None
+
+
+            Args:
+                packing:
+                    :any:`Packing` that generates the objects in parallel; it must reach the full size of the objects
+                coords:
+                    Template that describes the positions of the body particles before translation or        
+                    rotation is applied.       
+                    The number of coordinates must be the same as in number of particles per object
+                    in the corresponding PV
+                save_to:
+                    If not empty, the generated objects are written to that file, which can be given as **com_q_filename**
+        
+
+5. __init__(com_q_filename: str, coords: List[float3]) -> None
+
+
+            Args:
+                com_q_filename:
+                    File written by a :any:`Packing` that reached the full size of the objects; each rank only reads its part of the file.
+                coords:
+                    Template that describes the positions of the body particles before translation or        
+                    rotation is applied.       
+                    The number of coordinates must be the same as in number of particles per object
+                    in the corresponding PV
+        
+
         """
         pass
 
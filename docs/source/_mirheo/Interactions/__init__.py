@@ -79,7 +79,7 @@ class MembraneForces(Interaction):
     
     """
     def __init__():
-        r"""__init__(name: str, shear_desc: str, bending_desc: str, stress_free: bool = False, grow_until: float = 0.0, **kwargs) -> None
+        r"""__init__(name: str, shear_desc: str, bending_desc: str, stress_free: bool = False, grow_until: float = 0.0, deterministic: bool = False, per_object: bool = False, **kwargs) -> None
 
  
              Args:
@@ -89,6 +89,10 @@ class MembraneForces(Interaction):
                  stress_free: if True, stress Free shape is used for the shear parameters
                  grow_until: the size increases linearly in time from half of the provided mesh 
                              to its full size after that time; the parameters are scaled accordingly with time
+                 deterministic: if True, the bending forces on the neighbours are stored per vertex and gathered
+                                in a second pass instead of being added with atomics; the membrane forces are then bit-reproducible
+                 per_object: if True, each membrane is handled by one thread block which caches its vertices in shared memory
+                             and computes its area and volume in the same kernel; limited to about 4000 vertices per membrane
 
              kwargs:
 
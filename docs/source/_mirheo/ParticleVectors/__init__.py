@@ -149,23 +149,33 @@ class MembraneMesh(Mesh):
         Internally used class for desctibing a triangular mesh that can be used with the Membrane Interactions.
         In contrast with the simple :any:`Mesh`, this class precomputes some required quantities on the mesh, 
         including connectivity structures and stress-free quantities.        
+
+        The mesh files are read by one rank per node and broadcast to the other ranks.
+        Meshes created with identical data and reordering are the same object.
     
     """
     def __init__():
         r"""__init__(*args, **kwargs)
 Overloaded function.
 
-1. __init__(off_filename: str) -> None
+1. __init__(off_filename: str, reorder: str = 'none') -> None
 
 
             Create a mesh by reading the OFF file.
             The stress free shape is the input initial mesh
             
             Args:
-                off_filename: path of the OFF file
+                off_filename: path of the OFF file, or of a binary mesh written by :any:`writeBinary` (which can not be reordered)
+                reorder: renumbering of the vertices for memory locality, one of:
+
+                    * **none**: keep the order of the input
+                    * **rcm**: reverse Cuthill-McKee, minimizes the index distance between neighbouring vertices
+                    * **hilbert**: order along a Hilbert curve covering the mesh
+
+                    The dumps of :any:`createDumpMesh` are written in the input order, :any:`createDumpParticlesWithMesh` keeps the new order.
         
 
-2. __init__(off_initial_mesh: str, off_stress_free_mesh: str) -> None
+2. __init__(off_initial_mesh: str, off_stress_free_mesh: str, reorder: str = 'none') -> None
 
 
             Create a mesh by reading the OFF file, with a different stress free shape.
@@ -173,9 +183,10 @@ Overloaded function.
             Args:
                 off_initial_mesh: path of the OFF file : initial mesh
                 off_stress_free_mesh: path of the OFF file : stress-free mesh)
+                reorder: renumbering of the vertices, see above
         
 
-3. __init__(vertices: List[float3], faces: List[int3]) -> None
+3. __init__(vertices: List[float3], faces: List[int3], reorder: str = 'none') -> None
 
 
             Create a mesh by giving coordinates and connectivity
@@ -183,9 +194,10 @@ Overloaded function.
             Args:
                 vertices: vertex coordinates
                 faces:    connectivity: one triangle per entry, each integer corresponding to the vertex indices
+                reorder: renumbering of the vertices, see above
         
 
-4. __init__(vertices: List[float3], stress_free_vertices: List[float3], faces: List[int3]) -> None
+4. __init__(vertices: List[float3], stress_free_vertices: List[float3], faces: List[int3], reorder: str = 'none') -> None
 
 
             Create a mesh by giving coordinates and connectivity, with a different stress-free shape.
@@ -194,6 +206,39 @@ Overloaded function.
                 vertices: vertex coordinates
                 stress_free_vertices: vertex coordinates of the stress-free shape
                 faces:    connectivity: one triangle per entry, each integer corresponding to the vertex indices
+                reorder: renumbering of the vertices, see above
+    
+
+5. __init__(meshes: List[ParticleVectors.MembraneMesh]) -> None
+
+
+            Combine several meshes into one, e.g. to simulate different cell types with the same :any:`MembraneVector`.
+            The type of each membrane is then given to the initial conditions (see :any:`InitialConditions.Membrane`).
+            All the membranes have as many particles as the largest mesh, the extra particles of the smaller ones are placeholders.
+
+            Args:
+                meshes: list of :any:`MembraneMesh`; the constraints on the area and volume of the membrane forces
+                    are relative to the stress-free shape of each mesh, the given totals correspond to the first one
+    
+
+        """
+        pass
+
+    def getNtypes():
+        r"""getNtypes(self: ParticleVectors.MembraneMesh) -> int
+
+
+            returns the number of meshes combined in this mesh.
+    
+
+        """
+        pass
+
+    def getOriginalIds():
+        r"""getOriginalIds(self: ParticleVectors.MembraneMesh) -> List[int]
+
+
+            returns the index in the input of each vertex, empty if the vertices were not reordered.
     
 
         """
@@ -216,6 +261,21 @@ Overloaded function.
         returns the vertex coordinates of the mesh.
     
 
+        """
+        pass
+
+    def writeBinary():
+        r"""writeBinary(self: ParticleVectors.MembraneMesh, filename: str) -> None
+
+
+            Write the mesh in a binary format, together with its connectivity structures and stress-free quantities.
+            Creating a mesh from this file is faster than from an OFF file, as nothing needs to be recomputed.
+            The vertices keep their current order; the file is written by one rank only.
+
+            Args:
+                filename: path of the binary file
+    
+
         """
         pass
 
@@ -131,6 +131,30 @@ class MeshPlugin(SimulationPlugin):
         .. note::
             This plugin is inactive if postprocess is disabled
     
+    """
+class MeshTrajectoryDumper(PostprocessPlugin):
+    r"""
+        Postprocess side plugin of :any:`MeshTrajectoryPlugin`.
+        Responsible for performing the I/O.
+    
+    """
+class MeshTrajectoryPlugin(SimulationPlugin):
+    r"""
+        This plugin will write the meshes of all the objects of the specified Object Vector into a single trajectory file.
+        The connectivity is written only once, then every frame contains the object ids, their centers of mass and the vertex positions.
+        The vertices can be stored as 16 bits integers relative to the center of mass of their object, which divides the file size by two.
+        Use the ``mir.mesh_traj`` tool to convert the trajectory into PLY or XDMF files.
+
+        .. note::
+            This plugin is inactive if postprocess is disabled
+    
+    """
+class MultiTauCorrelatorDumper(PostprocessPlugin):
+    r"""
+        Postprocess side plugin of :any:`ParticleCorrelator` and :any:`StressCorrelator`.
+        Merges the correlators of all the ranks and writes the lag, the correlation and the number of samples per lag.
+        The file is overwritten at every dump with the current estimate.
+    
     """
 class ObjStats(SimulationPlugin):
     r"""
@@ -140,7 +164,18 @@ class ObjStats(SimulationPlugin):
         
         The file format is the following:
         
-        <object id> <simulation time> <COM>x3 [<quaternion>x4] <velocity>x3 <angular velocity>x3 <force>x3 <torque>x3
+        <object id> <simulation time> <COM>x3 [<quaternion>x4] <velocity>x3 <angular velocity>x3 <force>x3 <torque>x3 [<shape>x8]
+        
+        The binary variant stores the same fields as fixed-size records after a self-describing header.
+
+        For membranes, the shape descriptors can be computed on the device and appended to each line,
+        which is much more compact than dumping the meshes:
+
+        * area and volume
+        * eigenvalues :math:`\lambda_1 \geq \lambda_2 \geq \lambda_3` of the gyration tensor of the vertices
+        * asphericity :math:`\left[(\lambda_1-\lambda_2)^2 + (\lambda_2-\lambda_3)^2 + (\lambda_3-\lambda_1)^2\right] / \left[2 (\lambda_1+\lambda_2+\lambda_3)^2\right]`
+        * Taylor deformation index :math:`(a-c)/(a+c)`, with :math:`a = \sqrt{\lambda_1}` and :math:`c = \sqrt{\lambda_3}`
+        * angle between the x axis and the major axis projected on the x-y plane, in :math:`(-\pi/2, \pi/2]`
         
         .. note::
             Note that all the written values are *instantaneous*
@@ -190,6 +225,19 @@ class ParticleChecker(SimulationPlugin):
         This plugin will check the positions and velocities of all particles in the simulation every given time steps.
         To be used for debugging purpose.
     
+    """
+class ParticleCorrelator(SimulationPlugin):
+    r"""
+        This plugin computes in situ a time correlation of a per-particle quantity, averaged over all the particles of a :any:`ParticleVector`:
+
+        * 'msd': mean square displacement :math:`\left\langle |\mathbf{r}(t+\tau) - \mathbf{r}(t)|^2 \right\rangle`
+        * 'vacf': velocity autocorrelation :math:`\left\langle \mathbf{v}(t) \cdot \mathbf{v}(t+\tau) \right\rangle`
+
+        The correlation is computed with the multi-tau algorithm: the samples are stored in levels of `points` registers,
+        each level averaging `averaging` samples of the previous one, so that the lags span :math:`points \times averaging^{levels-1}` samples.
+        Each particle keeps its registers in extra channels that follow it across the ranks, that is :math:`levels \times (points + 1)` vectors per particle.
+        The particle vector is expected to keep the same particles, e.g. no inlet nor outlet.
+    
     """
 class ParticleDisplacementPlugin(SimulationPlugin):
     r"""
@@ -305,6 +353,22 @@ class RateOutletPlugin(SimulationPlugin):
     r"""
         This plugin removes particles from a set of :any:`ParticleVector` in a given region at a given mass rate.
     
+    """
+class Rdf(SimulationPlugin):
+    r"""
+        This plugin computes in situ the radial distribution function :math:`g(r)` of a :any:`ParticleVector`
+        and, optionally, its static structure factor :math:`S(\mathbf{k}) = \left\langle |\sum_j e^{i \mathbf{k} \cdot \mathbf{r}_j}|^2 \right\rangle / N`.
+        The pair distances are binned on the device in one pass over the cell list and the halo of the particle vector,
+        hence the particle vector must interact with a cut-off at least as large as the largest distance.
+        The histograms are accumulated between two dumps.
+    
+    """
+class RdfDumper(PostprocessPlugin):
+    r"""
+        Postprocess side plugin of :any:`Rdf`.
+        Merges the histograms of all the ranks and writes one file per dump with :math:`g(r)` and :math:`S(\mathbf{k})`,
+        averaged over the samples since the previous dump.
+    
     """
 class ReportPinObject(PostprocessPlugin):
     r"""
@@ -321,6 +385,20 @@ class SimulationStats(SimulationPlugin):
         .. note::
             This plugin is inactive if postprocess is disabled
     
+    """
+class StressCorrelator(SimulationPlugin):
+    r"""
+        This plugin computes in situ the autocorrelation of the off-diagonal components of the volume averaged stress,
+        :math:`C(\tau) = \sum_{\alpha < \beta} \left\langle P_{\alpha\beta}(t) P_{\alpha\beta}(t+\tau) \right\rangle`,
+        with :math:`P_{\alpha\beta} = \frac{1}{V} \sum_i \left( m_i v_{i\alpha} v_{i\beta} + \frac{1}{2} \sum_j r_{ij\alpha} f_{ij\beta} \right)`
+        (kinetic and virial parts),
+        from which the viscosity follows with the Green-Kubo relation :math:`\eta = \frac{V}{3 k_BT} \int_0^\infty C(\tau) d\tau`.
+        The correlation is computed with the multi-tau algorithm on the first simulation rank.
+
+        .. note::
+            The stresses must be computed by the interactions at every sample, see the `stress` and `stress_period` arguments of the interactions.
+            The velocities are used as they are: the particle vectors must have no mean flow.
+    
     """
 class Temperaturize(SimulationPlugin):
     r"""
@@ -579,8 +657,27 @@ def createDumpMesh():
     """
     pass
 
+def createDumpMeshTrajectory():
+    r"""createDumpMeshTrajectory(state: MirState, name: str, ov: ParticleVectors.ObjectVector, dump_every: int, path: str, quantization_step: float = 0.0) -> Tuple[Plugins.MeshTrajectoryPlugin, Plugins.MeshTrajectoryDumper]
+
+
+        Create :any:`MeshTrajectoryPlugin` plugin
+        
+        Args:
+            name: name of the plugin
+            ov: :any:`ObjectVector` that we'll work with
+            dump_every: write a frame every this many time-steps
+            path: the trajectory is written to <path>/<ov_name>.mtraj
+            quantization_step: if positive, vertices are stored as multiples of this step relative to the center of mass of their object, on 16 bits.
+                Vertices further than 32767 steps from the center of mass are clamped.
+                If 0, vertices are stored in full precision.
+    
+
+    """
+    pass
+
 def createDumpObjectStats():
-    r"""createDumpObjectStats(state: MirState, name: str, ov: ParticleVectors.ObjectVector, dump_every: int, path: str) -> Tuple[Plugins.ObjStats, Plugins.ObjStatsDumper]
+    r"""createDumpObjectStats(state: MirState, name: str, ov: ParticleVectors.ObjectVector, dump_every: int, path: str, binary: bool = False, shape: bool = False) -> Tuple[Plugins.ObjStats, Plugins.ObjStatsDumper]
 
 
         Create :any:`ObjStats` plugin
@@ -590,13 +687,16 @@ def createDumpObjectStats():
             ov: :any:`ObjectVector` that we'll work with
             dump_every: write files every this many time-steps
             path: the files will look like this: <path>/<ov_name>_NNNNN.txt
+            binary: write fixed-size binary records into <path>/<ov_name>.bin instead of text.
+                The ``mir.records`` tool converts them to the text format.
+            shape: also write the shape descriptors of the objects, only for :any:`MembraneVector`
     
 
     """
     pass
 
 def createDumpParticles():
-    r"""createDumpParticles(state: MirState, name: str, pv: ParticleVectors.ParticleVector, dump_every: int, channels: List[Tuple[str, str]], path: str) -> Tuple[Plugins.ParticleSenderPlugin, Plugins.ParticleDumperPlugin]
+    r"""createDumpParticles(state: MirState, name: str, pv: ParticleVectors.ParticleVector, dump_every: int, channels: List[Tuple[str, str]], path: str, box_lo: float3 = float3(-inf, -inf, -inf), box_hi: float3 = float3(inf, inf, inf), sdf_wall: str = '', sdf_range: float2 = float2(-inf, 0), stride: int = 1, fraction: float = 1.0, seed: int = 0) -> Tuple[Plugins.ParticleSenderPlugin, Plugins.ParticleDumperPlugin]
 
 
         Create :any:`ParticleSenderPlugin` plugin
@@ -615,7 +715,17 @@ def createDumpParticles():
                 * 'scalar': 1 float per particle
                 * 'vector': 3 floats per particle
                 * 'tensor6': 6 floats per particle, symmetric tensor in order xx, xy, xz, yy, yz, zz
-                
+
+            box_lo: lower corner of the region to dump, in global coordinates
+            box_hi: upper corner of the region to dump, in global coordinates
+            sdf_wall: if not empty, name of an SDF-based wall; only the particles where its SDF is within **sdf_range** are dumped
+            sdf_range: range of the SDF values to dump, the fluid side of the wall by default
+            stride: only dump the particles whose id is a multiple of this
+            fraction: only dump randomly this fraction of the particles; the same particles are chosen at every dump
+            seed: seed of the random selection
+
+        The selection is performed on the device, only the selected particles are downloaded and written.
+        A particle is dumped if it satisfies all the criteria.
     
 
     """
@@ -674,7 +784,7 @@ def createDumpParticlesWithRodData():
     pass
 
 def createDumpXYZ():
-    r"""createDumpXYZ(state: MirState, name: str, pv: ParticleVectors.ParticleVector, dump_every: int, path: str) -> Tuple[Plugins.XYZPlugin, Plugins.XYZDumper]
+    r"""createDumpXYZ(state: MirState, name: str, pv: ParticleVectors.ParticleVector, dump_every: int, path: str, binary: bool = False) -> Tuple[Plugins.XYZPlugin, Plugins.XYZDumper]
 
 
         Create :any:`XYZPlugin` plugin
@@ -684,6 +794,8 @@ def createDumpXYZ():
             pvs: list of :any:`ParticleVector` that we'll work with
             dump_every: write files every this many time-steps
             path: the files will look like this: <path>/<pv_name>_NNNNN.xyz
+            binary: write fixed-size binary records into <path>/<pv_name>_NNNNN.bin instead of text.
+                The ``mir.records`` tool converts them to the XYZ format.
     
 
     """
@@ -780,7 +892,7 @@ def createMembraneExtraForce():
         Args:
             name: name of the plugin
             pv: :class:`ParticleVector` to which the force should be added
-            forces: array of forces, one force (3 floats) per vertex in a single mesh
+            forces: array of forces, one force (3 floats) per vertex in a single mesh, in the vertex order of the input mesh
     
 
     """
@@ -872,6 +984,27 @@ def createParticleChecker():
     """
     pass
 
+def createParticleCorrelator():
+    r"""createParticleCorrelator(state: MirState, name: str, pv: ParticleVectors.ParticleVector, quantity: str, sample_every: int, dump_every: int, levels: int = 8, points: int = 16, averaging: int = 2, path: str = 'correlators/') -> Tuple[Plugins.ParticleCorrelator, Plugins.MultiTauCorrelatorDumper]
+
+
+        Create :any:`ParticleCorrelator` plugin
+
+        Args:
+            name: name of the plugin, also the name of the output file
+            pv: :any:`ParticleVector` that we'll work with
+            quantity: 'msd' or 'vacf'
+            sample_every: sample the quantity every this many time-steps
+            dump_every: write the correlation every this many time-steps
+            levels: number of levels of the correlator
+            points: number of registers per level, multiple of **averaging**
+            averaging: number of samples averaged from one level to the next
+            path: the correlation is written to <path>/<name>.txt
+    
+
+    """
+    pass
+
 def createParticleDisplacement():
     r"""createParticleDisplacement(state: MirState, name: str, pv: ParticleVectors.ParticleVector, update_every: int) -> Tuple[Plugins.ParticleDisplacementPlugin, Plugins.PostprocessPlugin]
 
@@ -1023,6 +1156,26 @@ def createRateOutlet():
         
     
 
+    """
+    pass
+
+def createRdf():
+    r"""createRdf(state: MirState, name: str, pv: ParticleVectors.ParticleVector, max_distance: float, nbins: int, sample_every: int, dump_every: int, modes: List[int3] = [], path: str = 'rdf/') -> Tuple[Plugins.Rdf, Plugins.RdfDumper]
+
+
+        Create :any:`Rdf` plugin
+
+        Args:
+            name: name of the plugin, also the prefix of the output files
+            pv: the concerned :any:`ParticleVector`
+            max_distance: largest distance of the histogram, at most the largest interaction cut-off of **pv**
+            nbins: number of bins of the histogram
+            sample_every: sample every this many time-steps
+            dump_every: write the averages every this many time-steps, multiple of **sample_every**
+            modes: list of integer triplets :math:`\mathbf{n}`, the structure factor is computed at the wavevectors :math:`2 \pi (n_x / L_x, n_y / L_y, n_z / L_z)`
+            path: the results are written to <path>/<name>_NNNNN.txt
+    
+
     """
     pass
 
@@ -1041,6 +1194,26 @@ def createStats():
     """
     pass
 
+def createStressCorrelator():
+    r"""createStressCorrelator(state: MirState, name: str, pvs: List[ParticleVectors.ParticleVector], sample_every: int, dump_every: int, levels: int = 16, points: int = 16, averaging: int = 2, path: str = 'correlators/') -> Tuple[Plugins.StressCorrelator, Plugins.MultiTauCorrelatorDumper]
+
+
+        Create :any:`StressCorrelator` plugin
+
+        Args:
+            name: name of the plugin, also the name of the output file
+            pvs: list of :any:`ParticleVector` whose stresses are summed
+            sample_every: sample the stress every this many time-steps
+            dump_every: write the correlation every this many time-steps
+            levels: number of levels of the correlator
+            points: number of registers per level, multiple of **averaging**
+            averaging: number of samples averaged from one level to the next
+            path: the correlation is written to <path>/<name>.txt
+    
+
+    """
+    pass
+
 def createTemperaturize():
     r"""createTemperaturize(state: MirState, name: str, pv: ParticleVectors.ParticleVector, kBT: float, keepVelocity: bool) -> Tuple[Plugins.Temperaturize, Plugins.PostprocessPlugin]
 
@@ -47,6 +47,45 @@ class Box(Wall):
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+class Composite(Wall):
+    r"""
+        Union or intersection of several stationary SDF-based walls, baked at setup into a single SDF field.
+        Bounce-back, wall checks and frozen particles then evaluate one field lookup per particle instead of one SDF per component wall,
+        which pays off when the geometry is composed of many walls.
+
+        The component walls are only used to sample the geometry during setup: they must **not** be registered themselves.
+        Their velocity fields are ignored, the composite wall is always stationary.
+
+        After baking, the field is compared to the exact combination of the component walls on random points close to the surface,
+        and the largest deviation is reported in the log.
+    
+    """
+    def __init__():
+        r"""__init__(name: str, walls: List[Walls.Wall], mode: str = 'union', h: float3 = float3(0.25, 0.25, 0.25), error_samples: int = 100000) -> None
+
+
+            Args:
+                name: name of the wall
+                walls: list of the component walls
+                mode: how to combine the walls, "union" (a point is inside if it is inside of any wall) or "intersection" (inside of all the walls)
+                h: resolution of the baked SDF
+                error_samples: number of random samples per rank used to estimate the baking error; 0 to skip the estimate
+        
+
+        """
+        pass
+
+    def attachFrozenParticles():
+        r"""attachFrozenParticles(arg0: ParticleVectors.ParticleVector) -> None
+
+
+        Let the wall know that the following :any:`ParticleVector` should be treated as frozen.
+        As a result, its particles will not be removed from the inside of the wall.
+    
+
         """
         pass
 
@@ -223,7 +262,7 @@ class SDF(Wall):
     
     """
     def __init__():
-        r"""__init__(name: str, sdfFilename: str, h: float3 = float3(0.25, 0.25, 0.25)) -> None
+        r"""__init__(name: str, sdfFilename: str, h: float3 = float3(0.25, 0.25, 0.25), cache_folder: str = '') -> None
 
 
             Args:
@@ -232,6 +271,8 @@ class SDF(Wall):
                 h: resolution of the resampled SDF. 
                    In order to have a more accurate SDF representation, the initial function is resampled on a finer grid. 
                    The lower this value is, the more accurate the wall will be represented, however, the  more memory it will consume and the slower the execution will be.
+                cache_folder: if not empty, the resampled SDF piece of each rank is stored in this folder and reused by subsequent runs.
+                   The entries are identified by the content of the ``.sdf`` file, the resolution and the domain decomposition.
         
 
         """
@@ -27,7 +27,7 @@ class Mirheo:
     
     """
     def __init__():
-        r"""__init__(nranks: int3, domain: float3, dt: float, log_filename: str = 'log', debug_level: int = 3, checkpoint_every: int = 0, checkpoint_folder: str = 'restart/', checkpoint_mode: str = 'PingPong', cuda_aware_mpi: bool = False, no_splash: bool = False, comm_ptr: int = 0) -> None
+        r"""__init__(nranks: int3, domain: float3, dt: float, log_filename: str = 'log', debug_level: int = 3, checkpoint_every: int = 0, checkpoint_folder: str = 'restart/', checkpoint_mode: str = 'PingPong', cuda_aware_mpi: bool = False, no_splash: bool = False, comm_ptr: int = 0, compute_ranks_per_postprocess: int = 1) -> None
 
 
                 Create the Mirheo coordinator.
@@ -50,7 +50,7 @@ class Mirheo:
                     Flushing increases the runtime yet more, but it is required in order not to lose any messages in case of abnormal program abort.
                 
                 Args:
-                    nranks: number of MPI simulation tasks per axis: x,y,z. If postprocess is enabled, the same number of the postprocess tasks will be running
+                    nranks: number of MPI simulation tasks per axis: x,y,z. If postprocess is enabled, one postprocess task per ``compute_ranks_per_postprocess`` simulation tasks will be running
                     domain: size of the simulation domain in x,y,z. Periodic boundary conditions are applied at the domain boundaries. The domain will be split in equal chunks between the MPI ranks.
                         The largest chunk size that a single MPI rank can have depends on the total number of particles,
                         handlers and hardware, and is typically about :math:`120^3 - 200^3`.
@@ -69,6 +69,10 @@ class Mirheo:
                     cuda_aware_mpi: enable CUDA Aware MPI. The MPI library must support that feature, otherwise it may fail.
                     no_splash: don't display the splash screen when at the start-up.
                     comm_ptr: pointer to communicator. By default MPI_COMM_WORLD will be used
+                    compute_ranks_per_postprocess: maximum number of simulation tasks served by one postprocess task.
+                        The program must then be started with either only the simulation tasks (no postprocess),
+                        or with ``ceil(nranks.x * nranks.y * nranks.z / compute_ranks_per_postprocess)`` additional postprocess tasks.
+                        Each postprocess task serves a contiguous block of simulation tasks, and the block sizes differ by at most one.
         
 
         """
@@ -180,6 +184,9 @@ Returns ``True`` if the current rank is the root
                     integrator: this :any:`Integrator` will be used to construct the equilibrium particles distribution
                     number_density: target particle number density
                     nsteps: run this many steps to achieve equilibrium
+                    cache_folder: if not empty, the frozen particles of each rank are stored in this folder and reused by subsequent runs
+                        with the same walls, domain decomposition, density, number of steps, time step, integrator and interaction names and cutoffs.
+                        Other interaction parameters are not checked: clear the folder when changing them.
                             
                 Returns:
                     New :any:`ParticleVector` that will contain particles that are close to the wall boundary, but still inside the wall.
@@ -190,7 +197,7 @@ Returns ``True`` if the current rank is the root
         pass
 
     def makeFrozenWallParticles():
-        r"""makeFrozenWallParticles(pvName: str, walls: List[Wall], interactions: List[Interaction], integrator: Integrator, number_density: float, nsteps: int = 1000) -> ParticleVector
+        r"""makeFrozenWallParticles(pvName: str, walls: List[Wall], interactions: List[Interaction], integrator: Integrator, number_density: float, nsteps: int = 1000, cache_folder: str = '') -> ParticleVector
 
 
                 Create particles frozen inside the walls.
@@ -206,6 +213,9 @@ Returns ``True`` if the current rank is the root
                     integrator: this :any:`Integrator` will be used to construct the equilibrium particles distribution
                     number_density: target particle number density
                     nsteps: run this many steps to achieve equilibrium
+                    cache_folder: if not empty, the frozen particles of each rank are stored in this folder and reused by subsequent runs
+                        with the same walls, domain decomposition, density, number of steps, time step, integrator and interaction names and cutoffs.
+                        Other interaction parameters are not checked: clear the folder when changing them.
                             
                 Returns:
                     New :any:`ParticleVector` that will contain particles that are close to the wall boundary, but still inside the wall.
@@ -368,6 +378,27 @@ Register Plugins
         """
         pass
 
+    def setCellListOrdering():
+        r"""setCellListOrdering(ordering: str) -> None
+
+
+                Select how the cells of all the cell-lists are numbered.
+                Particles are sorted by cell, so this controls the memory layout of the particle data.
+                Orderings following a space-filling curve keep particles that are close in space close in memory,
+                which may improve the cache reuse of the pairwise interactions on large subdomains.
+                Must be called before the first :any:`run`.
+
+                Args:
+                    ordering: one of
+
+                        * **lexicographic**: x-major row order (default)
+                        * **morton**: Z-order curve over the cells
+                        * **hilbert**: Hilbert curve over the cells
+         
+
+        """
+        pass
+
     def setIntegrator():
         r"""setIntegrator(integrator: Integrator, pv: ParticleVector) -> None
 
@@ -395,6 +426,25 @@ Register Plugins
 
         
 
+        """
+        pass
+
+    def setPartialObjectHalo():
+        r"""setPartialObjectHalo(ov: ObjectVector) -> None
+
+
+                Only send the particles of the objects that are within the interaction cut-off of the subdomain faces to the neighbouring ranks,
+                instead of the whole objects.
+                This reduces the halo traffic of large membranes or rods spanning several subdomains.
+                The halo objects are then incomplete: they can interact through pairwise interactions,
+                but they can not be used by bouncers, belonging checkers or interactions needing the topology of the halo objects (e.g. rod binding).
+                Not available for rigid objects, whose halo already contains only the motions.
+                Must be called before the first :any:`run`.
+
+                Args:
+                    ov: the :any:`ObjectVector`
+         
+
         """
         pass
 
@@ -4,6 +4,7 @@
 #include <core/initial_conditions/from_array.h>
 #include <core/initial_conditions/interface.h>
 #include <core/initial_conditions/membrane.h>
+#include <core/initial_conditions/packing.h>
 #include <core/initial_conditions/restart.h>
 #include <core/initial_conditions/rigid.h>
 #include <core/initial_conditions/rod.h>
@@ -37,8 +38,8 @@ void exportInitialConditions(py::module& m)
         Can only be used with Membrane Object Vector, see :ref:`user-ic`. These IC will initialize the particles of each object
         according to the mesh associated with Membrane, and then the objects will be translated/rotated according to the provided initial conditions.
     )")
-        .def(py::init<const std::vector<ComQ>&, float>(),
-             "com_q"_a, "global_scale"_a=1.0, R"(
+        .def(py::init<const std::vector<ComQ>&, float, const std::vector<int>&>(),
+             "com_q"_a, "global_scale"_a=1.0, "mesh_types"_a=std::vector<int>(), R"(
             Args:
                 com_q:
                     List describing location and rotation of the created objects.               
@@ -49,6 +50,50 @@ void exportInitialConditions(py::module& m)
                 global_scale:
                     All the membranes will be scaled by that value. Useful to implement membranes growth so that they
                     can fill the space with high volume fraction                                        
+                mesh_types:
+                    Index of the mesh of each object, for a :any:`MembraneMesh` made of several meshes.
+                    One entry per entry of **com_q**; all the objects use the first mesh if empty.
+        )")
+        .def(py::init<std::shared_ptr<ObjectPacking>, float, const std::string&>(),
+             "packing"_a, "global_scale"_a=1.0, "save_to"_a="", R"(
+            Args:
+                packing:
+                    :any:`Packing` that generates the objects in parallel. If the packing could not reach
+                    the full size of the objects, they are created at the reached scale.
+                global_scale:
+                    All the membranes will be scaled by that value, on top of the packing scale
+                save_to:
+                    If not empty, the generated objects are written to that file, which can be given as **com_q_filename**
+        )")
+        .def(py::init<const std::string&, float>(),
+             "com_q_filename"_a, "global_scale"_a=1.0, R"(
+            Args:
+                com_q_filename:
+                    File written by a :any:`Packing`; each rank only reads its part of the file.
+                    The membranes are created at the scale reached by the packing.
+                global_scale:
+                    All the membranes will be scaled by that value, on top of the packing scale
+        )");
+
+    py::handlers_class<ObjectPacking>(m, "Packing", R"(
+        Generates the centers of mass and orientations of non-overlapping objects in parallel, see :ref:`user-ic`.
+        Can be given to :any:`Membrane` and :any:`Rigid` instead of a list of objects.
+
+        The objects are approximated by ellipsoids. Each rank generates the objects of its subdomain only,
+        placing them at random in cells processed in 8 colors, such that neighbouring cells are never filled at the same time.
+        The objects are first placed at **initial_scale** of their size, and then grown in **growth_steps** steps,
+        moving and rotating the overlapping ones. The growth stops at the last scale without overlaps.
+    )")
+        .def(py::init<float3, float, float, int, int, long>(),
+             "axes"_a, "number_density"_a, "initial_scale"_a=1.0, "growth_steps"_a=0,
+             "max_attempts"_a=100, "seed"_a=42, R"(
+            Args:
+                axes: semi-axes of the ellipsoid that encloses one object
+                number_density: number of objects per unit volume
+                initial_scale: size of the objects when they are placed, relative to their full size
+                growth_steps: number of steps to grow the objects from **initial_scale** to their full size
+                max_attempts: number of random trials to place one object or to remove one overlap
+                seed: seed of the random numbers
         )");
 
     py::handlers_class<RestartIC>(m, "Restart", pyic, R"(
@@ -113,6 +158,30 @@ void exportInitialConditions(py::module& m)
                 com_q:
                     List specifying initial Center-Of-Mass velocities of the bodies.               
                     One entry (list of 3 floats) in the list corresponds to one object 
+        )")
+        .def(py::init<std::shared_ptr<ObjectPacking>, const std::vector<float3>&, const std::string&>(),
+             "packing"_a, "coords"_a, "save_to"_a="", R"(
+            Args:
+                packing:
+                    :any:`Packing` that generates the objects in parallel; it must reach the full size of the objects
+                coords:
+                    Template that describes the positions of the body particles before translation or        
+                    rotation is applied.       
+                    The number of coordinates must be the same as in number of particles per object
+                    in the corresponding PV
+                save_to:
+                    If not empty, the generated objects are written to that file, which can be given as **com_q_filename**
+        )")
+        .def(py::init<const std::string&, const std::vector<float3>&>(),
+             "com_q_filename"_a, "coords"_a, R"(
+            Args:
+                com_q_filename:
+                    File written by a :any:`Packing` that reached the full size of the objects; each rank only reads its part of the file.
+                coords:
+                    Template that describes the positions of the body particles before translation or        
+                    rotation is applied.       
+                    The number of coordinates must be the same as in number of particles per object
+                    in the corresponding PV
         )");
     
 
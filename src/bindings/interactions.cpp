@@ -39,12 +39,12 @@ castToMap(const py::kwargs& kwargs, const std::string& intName)
 static std::shared_ptr<MembraneInteraction>
 createInteractionMembrane(const MirState *state, std::string name,
                           std::string shearDesc, std::string bendingDesc,
-                          bool stressFree, float growUntil, py::kwargs kwargs)
+                          bool stressFree, float growUntil, bool deterministic, bool perObject, py::kwargs kwargs)
 {
     auto parameters = castToMap(kwargs, name);
     
     return InteractionFactory::createInteractionMembrane
-        (state, name, shearDesc, bendingDesc, parameters, stressFree, growUntil);
+        (state, name, shearDesc, bendingDesc, parameters, stressFree, growUntil, deterministic, perObject);
 }
 
 static std::shared_ptr<RodInteraction>
@@ -355,7 +355,7 @@ void exportInteractions(py::module& m)
 
     pyMembraneForces.def(py::init(&createInteractionMembrane),
                          "state"_a, "name"_a, "shear_desc"_a, "bending_desc"_a,
-                         "stress_free"_a=false, "grow_until"_a=0.f, R"( 
+                         "stress_free"_a=false, "grow_until"_a=0.f, "deterministic"_a=false, "per_object"_a=false, R"( 
              Args:
                  name: name of the interaction
                  shear_desc: a string describing what shear force is used
@@ -363,6 +363,10 @@ void exportInteractions(py::module& m)
                  stress_free: if True, stress Free shape is used for the shear parameters
                  grow_until: the size increases linearly in time from half of the provided mesh 
                              to its full size after that time; the parameters are scaled accordingly with time
+                 deterministic: if True, the bending forces on the neighbours are stored per vertex and gathered
+                                in a second pass instead of being added with atomics; the membrane forces are then bit-reproducible
+                 per_object: if True, each membrane is handled by one thread block which caches its vertices in shared memory
+                             and computes its area and volume in the same kernel; limited to about 4000 vertices per membrane
 
              kwargs:
 
@@ -40,21 +40,21 @@ void exportMirheo(py::module& m)
         .def(py::init( [] (int3 nranks, float3 domain, float dt,
                            std::string log, int debuglvl, int checkpointEvery,
                            std::string checkpointFolder, std::string checkpointModeStr,
-                           bool cudaMPI, bool noSplash, long comm)
+                           bool cudaMPI, bool noSplash, long comm, int computeRanksPerPostprocess)
             {
                 LogInfo logInfo(log, debuglvl, noSplash);
                 auto checkpointMode = getCheckpointMode(checkpointModeStr);
                 CheckpointInfo checkpointInfo(checkpointEvery, checkpointFolder, checkpointMode);
                 
                 if (comm == 0) return std::make_unique<Mirheo> (      nranks, domain, dt, logInfo,
-                                                                      checkpointInfo, cudaMPI);
+                                                                      checkpointInfo, cudaMPI, computeRanksPerPostprocess);
                 else           return std::make_unique<Mirheo> (comm, nranks, domain, dt, logInfo,
-                                                                      checkpointInfo, cudaMPI);
+                                                                      checkpointInfo, cudaMPI, computeRanksPerPostprocess);
             } ),
             py::return_value_policy::take_ownership,
             "nranks"_a, "domain"_a, "dt"_a, "log_filename"_a="log", "debug_level"_a=3, "checkpoint_every"_a=0,
              "checkpoint_folder"_a="restart/", "checkpoint_mode"_a = "PingPong", "cuda_aware_mpi"_a=false,
-             "no_splash"_a=false, "comm_ptr"_a=0, R"(
+             "no_splash"_a=false, "comm_ptr"_a=0, "compute_ranks_per_postprocess"_a=1, R"(
                 Create the Mirheo coordinator.
                 
                 .. warning::
@@ -75,7 +75,7 @@ void exportMirheo(py::module& m)
                     Flushing increases the runtime yet more, but it is required in order not to lose any messages in case of abnormal program abort.
                 
                 Args:
-                    nranks: number of MPI simulation tasks per axis: x,y,z. If postprocess is enabled, the same number of the postprocess tasks will be running
+                    nranks: number of MPI simulation tasks per axis: x,y,z. If postprocess is enabled, one postprocess task per ``compute_ranks_per_postprocess`` simulation tasks will be running
                     domain: size of the simulation domain in x,y,z. Periodic boundary conditions are applied at the domain boundaries. The domain will be split in equal chunks between the MPI ranks.
                         The largest chunk size that a single MPI rank can have depends on the total number of particles,
                         handlers and hardware, and is typically about :math:`120^3 - 200^3`.
@@ -94,6 +94,10 @@ void exportMirheo(py::module& m)
                     cuda_aware_mpi: enable CUDA Aware MPI. The MPI library must support that feature, otherwise it may fail.
                     no_splash: don't display the splash screen when at the start-up.
                     comm_ptr: pointer to communicator. By default MPI_COMM_WORLD will be used
+                    compute_ranks_per_postprocess: maximum number of simulation tasks served by one postprocess task.
+                        The program must then be started with either only the simulation tasks (no postprocess),
+                        or with ``ceil(nranks.x * nranks.y * nranks.z / compute_ranks_per_postprocess)`` additional postprocess tasks.
+                        Each postprocess task serves a contiguous block of simulation tasks, and the block sizes differ by at most one.
         )")
         
         .def("registerParticleVector", &Mirheo::registerParticleVector,
@@ -182,6 +186,34 @@ void exportMirheo(py::module& m)
                     maximum_part_travel: maximum distance that one particle travels in one time step.
                         this should be as small as possible for performance reasons but large enough for correctness
          )")
+        .def("setCellListOrdering", &Mirheo::setCellListOrdering,
+             "ordering"_a, R"(
+                Select how the cells of all the cell-lists are numbered.
+                Particles are sorted by cell, so this controls the memory layout of the particle data.
+                Orderings following a space-filling curve keep particles that are close in space close in memory,
+                which may improve the cache reuse of the pairwise interactions on large subdomains.
+                Must be called before the first :any:`run`.
+
+                Args:
+                    ordering: one of
+
+                        * **lexicographic**: x-major row order (default)
+                        * **morton**: Z-order curve over the cells
+                        * **hilbert**: Hilbert curve over the cells
+         )")
+        .def("setPartialObjectHalo", &Mirheo::setPartialObjectHalo,
+             "ov"_a, R"(
+                Only send the particles of the objects that are within the interaction cut-off of the subdomain faces to the neighbouring ranks,
+                instead of the whole objects.
+                This reduces the halo traffic of large membranes or rods spanning several subdomains.
+                The halo objects are then incomplete: they can interact through pairwise interactions,
+                but they can not be used by bouncers, belonging checkers or interactions needing the topology of the halo objects (e.g. rod binding).
+                Not available for rigid objects, whose halo already contains only the motions.
+                Must be called before the first :any:`run`.
+
+                Args:
+                    ov: the :any:`ObjectVector`
+         )")
         .def("getState",       &Mirheo::getMirState,    "Return mirheo state")
         
         .def("dumpWalls2XDMF",    &Mirheo::dumpWalls2XDMF,
@@ -224,7 +256,7 @@ void exportMirheo(py::module& m)
         )")
         
         .def("makeFrozenWallParticles", &Mirheo::makeFrozenWallParticles,
-             "pvName"_a, "walls"_a, "interactions"_a, "integrator"_a, "number_density"_a, "nsteps"_a=1000, R"(
+             "pvName"_a, "walls"_a, "interactions"_a, "integrator"_a, "number_density"_a, "nsteps"_a=1000, "cache_folder"_a="", R"(
                 Create particles frozen inside the walls.
                 
                 .. note::
@@ -238,6 +270,9 @@ void exportMirheo(py::module& m)
                     integrator: this :any:`Integrator` will be used to construct the equilibrium particles distribution
                     number_density: target particle number density
                     nsteps: run this many steps to achieve equilibrium
+                    cache_folder: if not empty, the frozen particles of each rank are stored in this folder and reused by subsequent runs
+                        with the same walls, domain decomposition, density, number of steps, time step, integrator and interaction names and cutoffs.
+                        Other interaction parameters are not checked: clear the folder when changing them.
                             
                 Returns:
                     New :any:`ParticleVector` that will contain particles that are close to the wall boundary, but still inside the wall.
@@ -260,6 +295,9 @@ void exportMirheo(py::module& m)
                     integrator: this :any:`Integrator` will be used to construct the equilibrium particles distribution
                     number_density: target particle number density
                     nsteps: run this many steps to achieve equilibrium
+                    cache_folder: if not empty, the frozen particles of each rank are stored in this folder and reused by subsequent runs
+                        with the same walls, domain decomposition, density, number of steps, time step, integrator and interaction names and cutoffs.
+                        Other interaction parameters are not checked: clear the folder when changing them.
                             
                 Returns:
                     New :any:`ParticleVector` that will contain particles that are close to the wall boundary, but still inside the wall.
@@ -1,6 +1,7 @@
 #include "bindings.h"
 #include "class_wrapper.h"
 
+#include <core/mesh/loader.h>
 #include <core/mesh/membrane.h>
 #include <core/mesh/mesh.h>
 #include <core/pvs/membrane_vector.h>
@@ -88,38 +89,85 @@ void exportParticleVectors(py::module& m)
         Internally used class for desctibing a triangular mesh that can be used with the Membrane Interactions.
         In contrast with the simple :any:`Mesh`, this class precomputes some required quantities on the mesh, 
         including connectivity structures and stress-free quantities.        
+
+        The mesh files are read by one rank per node and broadcast to the other ranks.
+        Meshes created with identical data and reordering are the same object.
     )")
-        .def(py::init<const std::string&>(), "off_filename"_a, R"(
+        .def(py::init([](const std::string& offFilename, const std::string& reorder)
+        {
+            return MeshLoader::loadMembraneMesh(offFilename, MeshReordering::getMethod(reorder));
+        }), "off_filename"_a, "reorder"_a="none", R"(
             Create a mesh by reading the OFF file.
             The stress free shape is the input initial mesh
             
             Args:
-                off_filename: path of the OFF file
+                off_filename: path of the OFF file, or of a binary mesh written by :any:`writeBinary` (which can not be reordered)
+                reorder: renumbering of the vertices for memory locality, one of:
+
+                    * **none**: keep the order of the input
+                    * **rcm**: reverse Cuthill-McKee, minimizes the index distance between neighbouring vertices
+                    * **hilbert**: order along a Hilbert curve covering the mesh
+
+                    The dumps of :any:`createDumpMesh` are written in the input order, :any:`createDumpParticlesWithMesh` keeps the new order.
         )")
-        .def(py::init<const std::string&, const std::string&>(),
-             "off_initial_mesh"_a, "off_stress_free_mesh"_a, R"(
+        .def(py::init([](const std::string& offInitialMesh, const std::string& offStressFreeMesh, const std::string& reorder)
+        {
+            return MeshLoader::loadMembraneMesh(offInitialMesh, offStressFreeMesh, MeshReordering::getMethod(reorder));
+        }), "off_initial_mesh"_a, "off_stress_free_mesh"_a, "reorder"_a="none", R"(
             Create a mesh by reading the OFF file, with a different stress free shape.
             
             Args:
                 off_initial_mesh: path of the OFF file : initial mesh
                 off_stress_free_mesh: path of the OFF file : stress-free mesh)
+                reorder: renumbering of the vertices, see above
         )")
-        .def(py::init<const std::vector<float3>&, const std::vector<int3>&>(),
-             "vertices"_a, "faces"_a, R"(
+        .def(py::init([](const std::vector<float3>& vertices, const std::vector<int3>& faces, const std::string& reorder)
+        {
+            return MeshLoader::loadMembraneMesh(vertices, faces, MeshReordering::getMethod(reorder));
+        }), "vertices"_a, "faces"_a, "reorder"_a="none", R"(
             Create a mesh by giving coordinates and connectivity
         
             Args:
                 vertices: vertex coordinates
                 faces:    connectivity: one triangle per entry, each integer corresponding to the vertex indices
+                reorder: renumbering of the vertices, see above
         )")
-        .def(py::init<const std::vector<float3>&, const std::vector<float3>&, const std::vector<int3>&>(),
-             "vertices"_a, "stress_free_vertices"_a, "faces"_a, R"(
+        .def(py::init([](const std::vector<float3>& vertices, const std::vector<float3>& stressFreeVertices,
+                         const std::vector<int3>& faces, const std::string& reorder)
+        {
+            return MeshLoader::loadMembraneMesh(vertices, stressFreeVertices, faces, MeshReordering::getMethod(reorder));
+        }), "vertices"_a, "stress_free_vertices"_a, "faces"_a, "reorder"_a="none", R"(
             Create a mesh by giving coordinates and connectivity, with a different stress-free shape.
         
             Args:
                 vertices: vertex coordinates
                 stress_free_vertices: vertex coordinates of the stress-free shape
                 faces:    connectivity: one triangle per entry, each integer corresponding to the vertex indices
+                reorder: renumbering of the vertices, see above
+    )")
+        .def(py::init<const std::vector<std::shared_ptr<MembraneMesh>>&>(),
+             "meshes"_a, R"(
+            Combine several meshes into one, e.g. to simulate different cell types with the same :any:`MembraneVector`.
+            The type of each membrane is then given to the initial conditions (see :any:`InitialConditions.Membrane`).
+            All the membranes have as many particles as the largest mesh, the extra particles of the smaller ones are placeholders.
+
+            Args:
+                meshes: list of :any:`MembraneMesh`; the constraints on the area and volume of the membrane forces
+                    are relative to the stress-free shape of each mesh, the given totals correspond to the first one
+    )")
+        .def("getNtypes", &MembraneMesh::getNtypes, R"(
+            returns the number of meshes combined in this mesh.
+    )")
+        .def("getOriginalIds", &MembraneMesh::getOriginalIds, R"(
+            returns the index in the input of each vertex, empty if the vertices were not reordered.
+    )")
+        .def("writeBinary", &MembraneMesh::writeBinary, "filename"_a, R"(
+            Write the mesh in a binary format, together with its connectivity structures and stress-free quantities.
+            Creating a mesh from this file is faster than from an OFF file, as nothing needs to be recomputed.
+            The vertices keep their current order; the file is written by one rank only.
+
+            Args:
+                filename: path of the binary file
     )");
 
         
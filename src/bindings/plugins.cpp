@@ -8,10 +8,14 @@
 #include "bindings.h"
 #include "class_wrapper.h"
 
+#include <limits>
+
 using namespace pybind11::literals;
 
 void exportPlugins(py::module& m)
 {
+    constexpr float inf = std::numeric_limits<float>::infinity();
+
     py::handlers_class<SimulationPlugin>  pysim(m, "SimulationPlugin", R"(
         Base simulation plugin class
     )");
@@ -158,6 +162,21 @@ void exportPlugins(py::module& m)
     )");
 
     
+    py::handlers_class<MeshTrajectoryPlugin>(m, "MeshTrajectoryPlugin", pysim, R"(
+        This plugin will write the meshes of all the objects of the specified Object Vector into a single trajectory file.
+        The connectivity is written only once, then every frame contains the object ids, their centers of mass and the vertex positions.
+        The vertices can be stored as 16 bits integers relative to the center of mass of their object, which divides the file size by two.
+        Use the ``mir.mesh_traj`` tool to convert the trajectory into PLY or XDMF files.
+
+        .. note::
+            This plugin is inactive if postprocess is disabled
+    )");
+
+    py::handlers_class<MeshTrajectoryDumper>(m, "MeshTrajectoryDumper", pypost, R"(
+        Postprocess side plugin of :any:`MeshTrajectoryPlugin`.
+        Responsible for performing the I/O.
+    )");
+
     py::handlers_class<ObjStatsPlugin>(m, "ObjStats", pysim, R"(
         This plugin will write the coordinates of the centers of mass of the objects of the specified Object Vector.
         Instantaneous quantities (COM velocity, angular velocity, force, torque) are also written.
@@ -165,7 +184,18 @@ void exportPlugins(py::module& m)
         
         The file format is the following:
         
-        <object id> <simulation time> <COM>x3 [<quaternion>x4] <velocity>x3 <angular velocity>x3 <force>x3 <torque>x3
+        <object id> <simulation time> <COM>x3 [<quaternion>x4] <velocity>x3 <angular velocity>x3 <force>x3 <torque>x3 [<shape>x8]
+        
+        The binary variant stores the same fields as fixed-size records after a self-describing header.
+
+        For membranes, the shape descriptors can be computed on the device and appended to each line,
+        which is much more compact than dumping the meshes:
+
+        * area and volume
+        * eigenvalues :math:`\lambda_1 \geq \lambda_2 \geq \lambda_3` of the gyration tensor of the vertices
+        * asphericity :math:`\left[(\lambda_1-\lambda_2)^2 + (\lambda_2-\lambda_3)^2 + (\lambda_3-\lambda_1)^2\right] / \left[2 (\lambda_1+\lambda_2+\lambda_3)^2\right]`
+        * Taylor deformation index :math:`(a-c)/(a+c)`, with :math:`a = \sqrt{\lambda_1}` and :math:`c = \sqrt{\lambda_3}`
+        * angle between the x axis and the major axis projected on the x-y plane, in :math:`(-\pi/2, \pi/2]`
         
         .. note::
             Note that all the written values are *instantaneous*
@@ -210,6 +240,24 @@ void exportPlugins(py::module& m)
         To be used for debugging purpose.
     )");
 
+    py::handlers_class<ParticleCorrelatorPlugin>(m, "ParticleCorrelator", pysim, R"(
+        This plugin computes in situ a time correlation of a per-particle quantity, averaged over all the particles of a :any:`ParticleVector`:
+
+        * 'msd': mean square displacement :math:`\left\langle |\mathbf{r}(t+\tau) - \mathbf{r}(t)|^2 \right\rangle`
+        * 'vacf': velocity autocorrelation :math:`\left\langle \mathbf{v}(t) \cdot \mathbf{v}(t+\tau) \right\rangle`
+
+        The correlation is computed with the multi-tau algorithm: the samples are stored in levels of `points` registers,
+        each level averaging `averaging` samples of the previous one, so that the lags span :math:`points \times averaging^{levels-1}` samples.
+        Each particle keeps its registers in extra channels that follow it across the ranks, that is :math:`levels \times (points + 1)` vectors per particle.
+        The particle vector is expected to keep the same particles, e.g. no inlet nor outlet.
+    )");
+
+    py::handlers_class<MultiTauCorrelatorDumper>(m, "MultiTauCorrelatorDumper", pypost, R"(
+        Postprocess side plugin of :any:`ParticleCorrelator` and :any:`StressCorrelator`.
+        Merges the correlators of all the ranks and writes the lag, the correlation and the number of samples per lag.
+        The file is overwritten at every dump with the current estimate.
+    )");
+
     py::handlers_class<ParticleDragPlugin>(m, "ParticleDrag", pysim, R"(
         This plugin will add drag force :math:`\mathbf{f} = - C_d \mathbf{u}` to each particle of a specific PV every time-step.
     )");
@@ -299,6 +347,20 @@ void exportPlugins(py::module& m)
     )");
 
 
+    py::handlers_class<RdfPlugin>(m, "Rdf", pysim, R"(
+        This plugin computes in situ the radial distribution function :math:`g(r)` of a :any:`ParticleVector`
+        and, optionally, its static structure factor :math:`S(\mathbf{k}) = \left\langle |\sum_j e^{i \mathbf{k} \cdot \mathbf{r}_j}|^2 \right\rangle / N`.
+        The pair distances are binned on the device in one pass over the cell list and the halo of the particle vector,
+        hence the particle vector must interact with a cut-off at least as large as the largest distance.
+        The histograms are accumulated between two dumps.
+    )");
+
+    py::handlers_class<RdfDumper>(m, "RdfDumper", pypost, R"(
+        Postprocess side plugin of :any:`Rdf`.
+        Merges the histograms of all the ranks and writes one file per dump with :math:`g(r)` and :math:`S(\mathbf{k})`,
+        averaged over the samples since the previous dump.
+    )");
+
     py::handlers_class<SimulationStats>(m, "SimulationStats", pysim, R"(
         This plugin will report aggregate quantities of all the particles in the simulation:
         total number of particles in the simulation, average temperature and momentum, maximum velocity magnutide of a particle
@@ -313,6 +375,19 @@ void exportPlugins(py::module& m)
         Responsible for performing the data reductions and I/O.
     )");
 
+    py::handlers_class<StressCorrelatorPlugin>(m, "StressCorrelator", pysim, R"(
+        This plugin computes in situ the autocorrelation of the off-diagonal components of the volume averaged stress,
+        :math:`C(\tau) = \sum_{\alpha < \beta} \left\langle P_{\alpha\beta}(t) P_{\alpha\beta}(t+\tau) \right\rangle`,
+        with :math:`P_{\alpha\beta} = \frac{1}{V} \sum_i \left( m_i v_{i\alpha} v_{i\beta} + \frac{1}{2} \sum_j r_{ij\alpha} f_{ij\beta} \right)`
+        (kinetic and virial parts),
+        from which the viscosity follows with the Green-Kubo relation :math:`\eta = \frac{V}{3 k_BT} \int_0^\infty C(\tau) d\tau`.
+        The correlation is computed with the multi-tau algorithm on the first simulation rank.
+
+        .. note::
+            The stresses must be computed by the interactions at every sample, see the `stress` and `stress_period` arguments of the interactions.
+            The velocities are used as they are: the particle vectors must have no mean flow.
+    )");
+
     
     py::handlers_class<SimulationVelocityControl>(m, "VelocityControl", pysim, R"(
         This plugin applies a uniform force to all the particles of the target PVS in the specified area (rectangle).
@@ -552,8 +627,22 @@ void exportPlugins(py::module& m)
             path: the files will look like this: <path>/<ov_name>_NNNNN.ply
     )");
 
+    m.def("__createDumpMeshTrajectory", &PluginFactory::createDumpMeshTrajectoryPlugin, 
+          "compute_task"_a, "state"_a, "name"_a, "ov"_a, "dump_every"_a, "path"_a, "quantization_step"_a=0.f, R"(
+        Create :any:`MeshTrajectoryPlugin` plugin
+        
+        Args:
+            name: name of the plugin
+            ov: :any:`ObjectVector` that we'll work with
+            dump_every: write a frame every this many time-steps
+            path: the trajectory is written to <path>/<ov_name>.mtraj
+            quantization_step: if positive, vertices are stored as multiples of this step relative to the center of mass of their object, on 16 bits.
+                Vertices further than 32767 steps from the center of mass are clamped.
+                If 0, vertices are stored in full precision.
+    )");
+
     m.def("__createDumpObjectStats", &PluginFactory::createDumpObjStats, 
-          "compute_task"_a, "state"_a, "name"_a, "ov"_a, "dump_every"_a, "path"_a, R"(
+          "compute_task"_a, "state"_a, "name"_a, "ov"_a, "dump_every"_a, "path"_a, "binary"_a=false, "shape"_a=false, R"(
         Create :any:`ObjStats` plugin
         
         Args:
@@ -561,11 +650,17 @@ void exportPlugins(py::module& m)
             ov: :any:`ObjectVector` that we'll work with
             dump_every: write files every this many time-steps
             path: the files will look like this: <path>/<ov_name>_NNNNN.txt
+            binary: write fixed-size binary records into <path>/<ov_name>.bin instead of text.
+                The ``mir.records`` tool converts them to the text format.
+            shape: also write the shape descriptors of the objects, only for :any:`MembraneVector`
     )");
 
     m.def("__createDumpParticles", &PluginFactory::createDumpParticlesPlugin, 
           "compute_task"_a, "state"_a, "name"_a, "pv"_a, "dump_every"_a,
-          "channels"_a, "path"_a, R"(
+          "channels"_a, "path"_a,
+          "box_lo"_a = float3{-inf, -inf, -inf}, "box_hi"_a = float3{inf, inf, inf},
+          "sdf_wall"_a = "", "sdf_range"_a = float2{-inf, 0.f},
+          "stride"_a = 1, "fraction"_a = 1.f, "seed"_a = 0, R"(
         Create :any:`ParticleSenderPlugin` plugin
         
         Args:
@@ -582,7 +677,17 @@ void exportPlugins(py::module& m)
                 * 'scalar': 1 float per particle
                 * 'vector': 3 floats per particle
                 * 'tensor6': 6 floats per particle, symmetric tensor in order xx, xy, xz, yy, yz, zz
-                
+
+            box_lo: lower corner of the region to dump, in global coordinates
+            box_hi: upper corner of the region to dump, in global coordinates
+            sdf_wall: if not empty, name of an SDF-based wall; only the particles where its SDF is within **sdf_range** are dumped
+            sdf_range: range of the SDF values to dump, the fluid side of the wall by default
+            stride: only dump the particles whose id is a multiple of this
+            fraction: only dump randomly this fraction of the particles; the same particles are chosen at every dump
+            seed: seed of the random selection
+
+        The selection is performed on the device, only the selected particles are downloaded and written.
+        A particle is dumped if it satisfies all the criteria.
     )");
 
     m.def("__createDumpParticlesWithRodData", &PluginFactory::createDumpParticlesWithRodDataPlugin, 
@@ -630,7 +735,7 @@ void exportPlugins(py::module& m)
     )");
     
     m.def("__createDumpXYZ", &PluginFactory::createDumpXYZPlugin, 
-          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "dump_every"_a, "path"_a, R"(
+          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "dump_every"_a, "path"_a, "binary"_a=false, R"(
         Create :any:`XYZPlugin` plugin
         
         Args:
@@ -638,6 +743,8 @@ void exportPlugins(py::module& m)
             pvs: list of :any:`ParticleVector` that we'll work with
             dump_every: write files every this many time-steps
             path: the files will look like this: <path>/<pv_name>_NNNNN.xyz
+            binary: write fixed-size binary records into <path>/<pv_name>_NNNNN.bin instead of text.
+                The ``mir.records`` tool converts them to the XYZ format.
     )");
 
     m.def("__createExchangePVSFluxPlane", &PluginFactory::createExchangePVSFluxPlanePlugin,
@@ -704,7 +811,7 @@ void exportPlugins(py::module& m)
         Args:
             name: name of the plugin
             pv: :class:`ParticleVector` to which the force should be added
-            forces: array of forces, one force (3 floats) per vertex in a single mesh
+            forces: array of forces, one force (3 floats) per vertex in a single mesh, in the vertex order of the input mesh
     )");
 
     m.def("__createObjectPortalDestination", &PluginFactory::createObjectPortalDestination,
@@ -769,6 +876,23 @@ void exportPlugins(py::module& m)
             check_every: check every this amount of time steps
     )");
 
+    m.def("__createParticleCorrelator", &PluginFactory::createParticleCorrelatorPlugin,
+          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "quantity"_a, "sample_every"_a, "dump_every"_a,
+          "levels"_a = 8, "points"_a = 16, "averaging"_a = 2, "path"_a = "correlators/", R"(
+        Create :any:`ParticleCorrelator` plugin
+
+        Args:
+            name: name of the plugin, also the name of the output file
+            pv: :any:`ParticleVector` that we'll work with
+            quantity: 'msd' or 'vacf'
+            sample_every: sample the quantity every this many time-steps
+            dump_every: write the correlation every this many time-steps
+            levels: number of levels of the correlator
+            points: number of registers per level, multiple of **averaging**
+            averaging: number of samples averaged from one level to the next
+            path: the correlation is written to <path>/<name>.txt
+    )");
+
     m.def("__createParticleDisplacement", &PluginFactory::createParticleDisplacementPlugin, 
           "compute_task"_a, "state"_a, "name"_a, "pv"_a, "update_every"_a, R"(
         Create :any:`ParticleDisplacementPlugin`
@@ -856,6 +980,22 @@ void exportPlugins(py::module& m)
             Kp, Ki, Kd: PID controller coefficients
     )");
 
+    m.def("__createRdf", &PluginFactory::createRdfPlugin,
+          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "max_distance"_a, "nbins"_a,
+          "sample_every"_a, "dump_every"_a, "modes"_a = std::vector<int3>(), "path"_a = "rdf/", R"(
+        Create :any:`Rdf` plugin
+
+        Args:
+            name: name of the plugin, also the prefix of the output files
+            pv: the concerned :any:`ParticleVector`
+            max_distance: largest distance of the histogram, at most the largest interaction cut-off of **pv**
+            nbins: number of bins of the histogram
+            sample_every: sample every this many time-steps
+            dump_every: write the averages every this many time-steps, multiple of **sample_every**
+            modes: list of integer triplets :math:`\mathbf{n}`, the structure factor is computed at the wavevectors :math:`2 \pi (n_x / L_x, n_y / L_y, n_z / L_z)`
+            path: the results are written to <path>/<name>_NNNNN.txt
+    )");
+
     m.def("__createStats", &PluginFactory::createStatsPlugin,
           "compute_task"_a, "state"_a, "name"_a, "filename"_a="", "every"_a, R"(
         Create :any:`SimulationStats` plugin
@@ -866,6 +1006,22 @@ void exportPlugins(py::module& m)
             every: report to standard output every that many time-steps
     )");
 
+    m.def("__createStressCorrelator", &PluginFactory::createStressCorrelatorPlugin,
+          "compute_task"_a, "state"_a, "name"_a, "pvs"_a, "sample_every"_a, "dump_every"_a,
+          "levels"_a = 16, "points"_a = 16, "averaging"_a = 2, "path"_a = "correlators/", R"(
+        Create :any:`StressCorrelator` plugin
+
+        Args:
+            name: name of the plugin, also the name of the output file
+            pvs: list of :any:`ParticleVector` whose stresses are summed
+            sample_every: sample the stress every this many time-steps
+            dump_every: write the correlation every this many time-steps
+            levels: number of levels of the correlator
+            points: number of registers per level, multiple of **averaging**
+            averaging: number of samples averaged from one level to the next
+            path: the correlation is written to <path>/<name>.txt
+    )");
+
     m.def("__createTemperaturize", &PluginFactory::createTemperaturizePlugin,
           "compute_task"_a, "state"_a, "name"_a, "pv"_a, "kBT"_a, "keepVelocity"_a, R"(
         Create :any:`Temperaturize` plugin
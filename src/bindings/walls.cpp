@@ -3,6 +3,8 @@
 
 #include <core/walls/factory.h>
 
+#include <pybind11/stl.h>
+
 using namespace pybind11::literals;
 
 void exportWalls(py::module& m)
@@ -79,13 +81,36 @@ void exportWalls(py::module& m)
         The boundary is defined by the zero-level isosurface.
     )")
         .def(py::init(&WallFactory::createSDFWall),
-            "state"_a, "name"_a, "sdfFilename"_a, "h"_a = float3{0.25, 0.25, 0.25}, R"(
+            "state"_a, "name"_a, "sdfFilename"_a, "h"_a = float3{0.25, 0.25, 0.25}, "cache_folder"_a = "", R"(
             Args:
                 name: name of the wall
                 sdfFilename: name of the ``.sdf`` file
                 h: resolution of the resampled SDF. 
                    In order to have a more accurate SDF representation, the initial function is resampled on a finer grid. 
                    The lower this value is, the more accurate the wall will be represented, however, the  more memory it will consume and the slower the execution will be.
+                cache_folder: if not empty, the resampled SDF piece of each rank is stored in this folder and reused by subsequent runs.
+                   The entries are identified by the content of the ``.sdf`` file, the resolution and the domain decomposition.
+        )");
+        
+    py::handlers_class< SimpleStationaryWall<StationaryWall_Composite> >(m, "Composite", pywall, R"(
+        Union or intersection of several stationary SDF-based walls, baked at setup into a single SDF field.
+        Bounce-back, wall checks and frozen particles then evaluate one field lookup per particle instead of one SDF per component wall,
+        which pays off when the geometry is composed of many walls.
+
+        The component walls are only used to sample the geometry during setup: they must **not** be registered themselves.
+        Their velocity fields are ignored, the composite wall is always stationary.
+
+        After baking, the field is compared to the exact combination of the component walls on random points close to the surface,
+        and the largest deviation is reported in the log.
+    )")
+        .def(py::init(&WallFactory::createCompositeWall),
+            "state"_a, "name"_a, "walls"_a, "mode"_a = "union", "h"_a = float3{0.25, 0.25, 0.25}, "error_samples"_a = 100000, R"(
+            Args:
+                name: name of the wall
+                walls: list of the component walls
+                mode: how to combine the walls, "union" (a point is inside if it is inside of any wall) or "intersection" (inside of all the walls)
+                h: resolution of the baked SDF
+                error_samples: number of random samples per rank used to estimate the baking error; 0 to skip the estimate
         )");
         
     py::handlers_class< WallWithVelocity<StationaryWall_Cylinder, VelocityField_Rotate> >(m, "RotatingCylinder", pywall, R"(
@@ -82,64 +82,168 @@ __device__ static inline bool segmentTriangleQuickCheck(Triangle trNew, Triangle
     return true;
 }
 
-__device__ static inline void findBouncesInCell(int pstart, int pend, int globTrid,
-                                                Triangle tr, Triangle trOld,
-                                                PVviewWithOldParticles pvView,
-                                                MeshView mesh, TriangleTable triangleTable)
+//=================================================================================================================
+// Bounding volume hierarchy of the moving triangles
+//=================================================================================================================
+
+/**
+ * Complete binary tree over the triangles of one object, stored as a heap:
+ * the children of node i are 2i+1 and 2i+2 and the nleaves leaves are the last nodes.
+ * The leaves hold the triangles sorted along a space-filling curve of the mesh at rest,
+ * padded with empty leaves (-1) up to a power of two.
+ * The tree is shared by all the objects, each object has its own boxes.
+ */
+struct TriangleBVH
+{
+    int nleaves, nnodes;
+    const int *leafTriangles;
+    float3 *lower, *upper;
+};
+
+// padding of the boxes against round-off errors
+static constexpr float bvhTolerance = 1e-3f;
+
+// About maximum distance a particle can cover in one step
+static constexpr float maxParticleDisplacement = 0.2f;
+
+/**
+ * Recompute the boxes of the tree from the triangles swept between the old and new vertices.
+ * One block per object; the topology is kept, so this is linear in the number of triangles.
+ */
+__global__ void refitBVH(OVviewWithNewOldVertices objView, MeshView mesh, TriangleBVH bvh)
 {
+    const int objId = blockIdx.x;
+    const int base = objId * bvh.nnodes;
+    const int firstLeaf = bvh.nleaves - 1;
 
-#pragma unroll 2
-    for (int pid = pstart; pid < pend; pid++)
+    for (int i = threadIdx.x; i < bvh.nleaves; i += blockDim.x)
     {
-        Particle p;
-        pvView.readPosition   (p,    pid);
-        const auto rOld = pvView.readOldPosition(pid);
+        const int trid = bvh.leafTriangles[i];
 
-        if (segmentTriangleQuickCheck(tr, trOld, p.r, rOld))
-            triangleTable.push_back({pid, globTrid});
+        // empty boxes never overlap anything
+        float3 lo = make_float3( INFINITY);
+        float3 hi = make_float3(-INFINITY);
+
+        if (trid >= 0)
+        {
+            const int3 triangle = mesh.triangles[trid];
+            const Triangle tr =    readTriangle(objView.vertices    , mesh.nvertices*objId, triangle);
+            const Triangle trOld = readTriangle(objView.old_vertices, mesh.nvertices*objId, triangle);
+
+            lo = fmin_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2) - bvhTolerance;
+            hi = fmax_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2) + bvhTolerance;
+        }
+
+        bvh.lower[base + firstLeaf + i] = lo;
+        bvh.upper[base + firstLeaf + i] = hi;
+    }
+
+    __syncthreads();
+
+    // one level at a time, bottom up
+    for (int levelSize = bvh.nleaves / 2; levelSize >= 1; levelSize /= 2)
+    {
+        const int first = levelSize - 1;
+
+        for (int i = threadIdx.x; i < levelSize; i += blockDim.x)
+        {
+            const int node  = first + i;
+            const int left  = 2 * node + 1;
+            const int right = 2 * node + 2;
+
+            bvh.lower[base + node] = fminf(bvh.lower[base + left], bvh.lower[base + right]);
+            bvh.upper[base + node] = fmaxf(bvh.upper[base + left], bvh.upper[base + right]);
+        }
+
+        __syncthreads();
     }
 }
 
-__global__ void findBouncesInMesh(OVviewWithNewOldVertices objView,
-                                  PVviewWithOldParticles pvView,
-                                  MeshView mesh, CellListInfo cinfo,
-                                  TriangleTable triangleTable)
+__device__ static inline bool boxesOverlap(float3 lo0, float3 hi0, float3 lo1, float3 hi1)
 {
-    // About maximum distance a particle can cover in one step
-    constexpr float tol = 0.2f;
+    return lo0.x <= hi1.x && lo1.x <= hi0.x
+        && lo0.y <= hi1.y && lo1.y <= hi0.y
+        && lo0.z <= hi1.z && lo1.z <= hi0.z;
+}
 
-    // One THREAD per triangle
-    const int gid = blockIdx.x * blockDim.x + threadIdx.x;
-    const int objId = gid / mesh.ntriangles;
-    const int trid  = gid % mesh.ntriangles;
-    if (objId >= objView.nObjects) return;
+__device__ static inline void findBouncesOfParticle(int pid, int objId,
+                                                    OVviewWithNewOldVertices objView,
+                                                    PVviewWithOldParticles pvView,
+                                                    MeshView mesh, TriangleBVH bvh,
+                                                    TriangleTable triangleTable)
+{
+    // enough for 2^30 leaves
+    constexpr int maxStackSize = 32;
 
-    const int3 triangle = mesh.triangles[trid];
-    const Triangle tr =    readTriangle(objView.vertices    , mesh.nvertices*objId, triangle);
-    const Triangle trOld = readTriangle(objView.old_vertices, mesh.nvertices*objId, triangle);
+    Particle p;
+    pvView.readPosition(p, pid);
+    const auto rOld = pvView.readOldPosition(pid);
+
+    const float3 lo = fminf(p.r, rOld);
+    const float3 hi = fmaxf(p.r, rOld);
+
+    const int base = objId * bvh.nnodes;
+    const int firstLeaf = bvh.nleaves - 1;
+
+    int stack[maxStackSize];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const int node = stack[--stackSize];
+
+        if (!boxesOverlap(lo, hi, bvh.lower[base + node], bvh.upper[base + node]))
+            continue;
+
+        if (node < firstLeaf)
+        {
+            stack[stackSize++] = 2 * node + 1;
+            stack[stackSize++] = 2 * node + 2;
+            continue;
+        }
 
-    const float3 lo = fmin_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
-    const float3 hi = fmax_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
+        const int trid = bvh.leafTriangles[node - firstLeaf];
+        const int3 triangle = mesh.triangles[trid];
+        const Triangle tr =    readTriangle(objView.vertices    , mesh.nvertices*objId, triangle);
+        const Triangle trOld = readTriangle(objView.old_vertices, mesh.nvertices*objId, triangle);
 
-    const int3 cidLow  = cinfo.getCellIdAlongAxes(lo - tol);
-    const int3 cidHigh = cinfo.getCellIdAlongAxes(hi + tol);
+        if (segmentTriangleQuickCheck(tr, trOld, p.r, rOld))
+            triangleTable.push_back({pid, objId * mesh.ntriangles + trid});
+    }
+}
 
-    int3 cid3;
-#pragma unroll 2
-    for (cid3.z = cidLow.z; cid3.z <= cidHigh.z; cid3.z++)
-        for (cid3.y = cidLow.y; cid3.y <= cidHigh.y; cid3.y++)
-            {
-                cid3.x = cidLow.x;
-                const int cidLo = max(cinfo.encode(cid3), 0);
+/**
+ * blockIdx.x is the object, the rows of cells covered by the object are spread over gridDim.y blocks.
+ * The particles of these cells are tested against the refitted tree, only the triangles
+ * whose swept box overlaps the particle path are kept as candidates.
+ */
+__global__ void findBouncesInMesh(OVviewWithNewOldVertices objView,
+                                  PVviewWithOldParticles pvView,
+                                  MeshView mesh, CellListInfo cinfo,
+                                  TriangleBVH bvh, TriangleTable triangleTable)
+{
+    const int objId = blockIdx.x;
+    const int root = objId * bvh.nnodes;
+
+    // the particles may have left the box during the step
+    const int3 cidLow  = cinfo.getCellIdAlongAxes(bvh.lower[root] - maxParticleDisplacement);
+    const int3 cidHigh = cinfo.getCellIdAlongAxes(bvh.upper[root] + maxParticleDisplacement);
 
-                cid3.x = cidHigh.x;
-                const int cidHi = min(cinfo.encode(cid3)+1, cinfo.totcells);
+    const int nrowsY = cidHigh.y - cidLow.y + 1;
+    const int nrows  = nrowsY * (cidHigh.z - cidLow.z + 1);
 
-                const int pstart = cinfo.cellStarts[cidLo];
-                const int pend   = cinfo.cellStarts[cidHi];
+    for (int row = blockIdx.y; row < nrows; row += gridDim.y)
+    {
+        const int cellY = cidLow.y + row % nrowsY;
+        const int cellZ = cidLow.z + row / nrowsY;
 
-                findBouncesInCell(pstart, pend, gid, tr, trOld, pvView, mesh, triangleTable);
-            }
+        cinfo.forEachRowRange(cidLow.x, cidHigh.x, cellY, cellZ, [&](int pstart, int pend)
+        {
+            for (int pid = pstart + threadIdx.x; pid < pend; pid += blockDim.x)
+                findBouncesOfParticle(pid, objId, objView, pvView, mesh, bvh, triangleTable);
+        });
+    }
 }
 
 //=================================================================================================================
@@ -139,25 +139,17 @@ __global__ void findBounces(RVviewWithOldParticles rvView, float radius,
     const int3 cidLow  = cinfo.getCellIdAlongAxes(lo - (radius + tol));
     const int3 cidHigh = cinfo.getCellIdAlongAxes(hi + (radius + tol));
 
-    int3 cid3;
-
     #pragma unroll 2
-    for (cid3.z = cidLow.z; cid3.z <= cidHigh.z; ++cid3.z)
+    for (int cellZ = cidLow.z; cellZ <= cidHigh.z; ++cellZ)
     {
-        for (cid3.y = cidLow.y; cid3.y <= cidHigh.y; ++cid3.y)
+        for (int cellY = cidLow.y; cellY <= cidHigh.y; ++cellY)
         {
-            cid3.x = cidLow.x;
-            const int cidLo = max(cinfo.encode(cid3), 0);
-            
-            cid3.x = cidHigh.x;
-            const int cidHi = min(cinfo.encode(cid3)+1, cinfo.totcells);
-            
-            const int pstart = cinfo.cellStarts[cidLo];
-            const int pend   = cinfo.cellStarts[cidHi];
-            
-            findBouncesInCell(pstart, pend, gid, radius,
-                              segNew, segOld, pvView,
-                              segmentTable, collisionTimes);
+            cinfo.forEachRowRange(cidLow.x, cidHigh.x, cellY, cellZ, [&](int pstart, int pend)
+            {
+                findBouncesInCell(pstart, pend, gid, radius,
+                                  segNew, segOld, pvView,
+                                  segmentTable, collisionTimes);
+            });
         }
     }
 }
@@ -8,6 +8,10 @@
 #include <core/pvs/views/ov.h>
 #include <core/rigid/operations.h>
 #include <core/utils/kernel_launch.h>
+#include <core/utils/space_filling_curve.h>
+
+#include <algorithm>
+#include <numeric>
 
 /**
  * Create the bouncer
@@ -22,6 +26,52 @@ BounceFromMesh::BounceFromMesh(const MirState *state, const std::string& name, V
 
 BounceFromMesh::~BounceFromMesh() = default;
 
+/**
+ * Leaves of the BVH: the triangles sorted by the Morton key of their center
+ * in the mesh at rest, so that the subtrees enclose compact patches of the surface.
+ * The leaves are padded with empty ones (-1) up to a power of two
+ */
+static std::vector<int> sortTrianglesForBVH(const Mesh *mesh)
+{
+    constexpr int bits = 10;
+    constexpr float maxKey = (1 << bits) - 1;
+
+    const int ntriangles = mesh->getNtriangles();
+    const auto& vertices  = mesh->vertexCoordinates;
+    const auto& triangles = mesh->triangles;
+
+    auto center = [&](int trid)
+    {
+        const int3 t = triangles[trid];
+        return (make_float3(vertices[t.x]) + make_float3(vertices[t.y]) + make_float3(vertices[t.z])) / 3.0f;
+    };
+
+    float3 lo = center(0), hi = center(0);
+    for (int i = 1; i < ntriangles; ++i)
+    {
+        lo = fminf(lo, center(i));
+        hi = fmaxf(hi, center(i));
+    }
+    const float3 extent = fmaxf(hi - lo, make_float3(1e-6f));
+
+    std::vector<uint64_t> keys(ntriangles);
+    for (int i = 0; i < ntriangles; ++i)
+    {
+        const float3 x = (center(i) - lo) / extent * maxKey;
+        keys[i] = SpaceFillingCurve::mortonKey(static_cast<uint32_t>(x.x), static_cast<uint32_t>(x.y), static_cast<uint32_t>(x.z));
+    }
+
+    std::vector<int> order(ntriangles);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return keys[a] < keys[b]; });
+
+    int nleaves = 1;
+    while (nleaves < ntriangles) nleaves *= 2;
+    order.resize(nleaves, -1);
+
+    return order;
+}
+
 /**
  * @param ov will need an 'old_particles' per PARTICLE channel keeping positions
  * from the previous timestep.
@@ -31,6 +81,16 @@ void BounceFromMesh::setup(ObjectVector *ov)
 {
     Bouncer::setup(ov);
 
+    if (ov->mesh->getNtypes() > 1)
+        die("Bouncer '%s': bouncing from the mesh of several types of '%s' is not supported",
+            name.c_str(), ov->name.c_str());
+
+    const auto leaves = sortTrianglesForBVH(ov->mesh.get());
+    bvhLeaves = leaves.size();
+    bvhLeafTriangles.resize_anew(bvhLeaves);
+    std::copy(leaves.begin(), leaves.end(), bvhLeafTriangles.begin());
+    bvhLeafTriangles.uploadToDevice(defaultStream);
+
     // If the object is rigid, we need to collect the forces into the RigidMotion
     rov = dynamic_cast<RigidObjectVector*> (ov);
 
@@ -85,24 +145,6 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
 
     ov->findExtentAndCOM(stream, locality);
 
-    const int totalTriangles = ov->mesh->getNtriangles() * activeOV->nObjects;
-
-    // Set maximum possible number of _coarse_ and _fine_ collisions with triangles
-    // In case of crash, the estimate should be increased
-    const int maxCoarseCollisions = coarseCollisionsPerTri * totalTriangles;
-    coarseTable.collisionTable.resize_anew(maxCoarseCollisions);
-    coarseTable.nCollisions.clear(stream);
-    MeshBounceKernels::TriangleTable devCoarseTable { maxCoarseCollisions,
-                                                      coarseTable.nCollisions.devPtr(),
-                                                      coarseTable.collisionTable.devPtr() };
-    
-    int maxFineCollisions = fineCollisionsPerTri * totalTriangles;
-    fineTable.collisionTable.resize_anew(maxFineCollisions);
-    fineTable.nCollisions.clear(stream);
-    MeshBounceKernels::TriangleTable devFineTable { maxFineCollisions,
-                                                    fineTable.nCollisions.devPtr(),
-                                                    fineTable.collisionTable.devPtr() };
-
     // Setup collision times array. For speed and simplicity initial time will be 0,
     // and after the collisions detected its i-th element will be t_i-1.0f, where 0 <= t_i <= 1
     // is the collision time, or 0 if no collision with the particle found
@@ -110,6 +152,8 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
     collisionTimes.clear(stream);
 
     const int nthreads = 128;
+    // blocks sharing the rows of cells covered by one object in the candidates search
+    const int rowChunksPerObject = 16;
 
     // FIXME this is a hack
     if (rov)
@@ -124,37 +168,64 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
     OVviewWithNewOldVertices vertexView(ov, activeOV, stream);
     PVviewWithOldParticles pvView(pv, pv->local());
 
-    // Step 1, find all the candidate collisions
+    // Step 1, refit the hierarchy to the moved triangles
+    const int nnodes = 2 * bvhLeaves - 1;
+    bvhLower.resize_anew(nnodes * activeOV->nObjects);
+    bvhUpper.resize_anew(nnodes * activeOV->nObjects);
+    MeshBounceKernels::TriangleBVH bvh { bvhLeaves, nnodes, bvhLeafTriangles.devPtr(),
+                                         bvhLower.devPtr(), bvhUpper.devPtr() };
+
     SAFE_KERNEL_LAUNCH(
-            MeshBounceKernels::findBouncesInMesh,
-            getNblocks(totalTriangles, nthreads), nthreads, 0, stream,
-            vertexView, pvView, ov->mesh.get(), cl->cellInfo(), devCoarseTable );
+            MeshBounceKernels::refitBVH,
+            activeOV->nObjects, nthreads, 0, stream,
+            vertexView, ov->mesh.get(), bvh );
+
+    // Step 2, find all the candidate collisions
+    // the search is repeated with a large enough table if the previous size was too small
+    auto findCandidates = [&]()
+    {
+        coarseTable.nCollisions.clear(stream);
+        MeshBounceKernels::TriangleTable devCoarseTable { static_cast<int>(coarseTable.collisionTable.size()),
+                                                          coarseTable.nCollisions.devPtr(),
+                                                          coarseTable.collisionTable.devPtr() };
+        SAFE_KERNEL_LAUNCH(
+                MeshBounceKernels::findBouncesInMesh,
+                dim3(activeOV->nObjects, rowChunksPerObject), nthreads, 0, stream,
+                vertexView, pvView, ov->mesh.get(), cl->cellInfo(), bvh, devCoarseTable );
 
-    coarseTable.nCollisions.downloadFromDevice(stream);
-    debug("Found %d triangle collision candidates", coarseTable.nCollisions[0]);
+        coarseTable.nCollisions.downloadFromDevice(stream);
+        return coarseTable.nCollisions[0];
+    };
 
-    if (coarseTable.nCollisions[0] > maxCoarseCollisions)
-        die("Found too many triangle collision candidates (coarse) (%d, max %d),"
-            "something may be broken or you need to increase the estimate",
-            coarseTable.nCollisions[0], maxCoarseCollisions);
+    int nCoarseCollisions = findCandidates();
+
+    if (nCoarseCollisions > static_cast<int>(coarseTable.collisionTable.size()))
+    {
+        debug("Growing the table of triangle collision candidates to %d", nCoarseCollisions);
+        coarseTable.collisionTable.resize_anew(nCoarseCollisions);
+        nCoarseCollisions = findCandidates();
+    }
+
+    debug("Found %d triangle collision candidates", nCoarseCollisions);
+
+    // Step 3, filter the candidates; there are at most as many collisions as candidates
+    fineTable.collisionTable.resize_anew(nCoarseCollisions);
+    fineTable.nCollisions.clear(stream);
+    MeshBounceKernels::TriangleTable devFineTable { nCoarseCollisions,
+                                                    fineTable.nCollisions.devPtr(),
+                                                    fineTable.collisionTable.devPtr() };
 
-    // Step 2, filter the candidates
     SAFE_KERNEL_LAUNCH(
             MeshBounceKernels::refineCollisions,
-            getNblocks(coarseTable.nCollisions[0], nthreads), nthreads, 0, stream,
+            getNblocks(nCoarseCollisions, nthreads), nthreads, 0, stream,
             vertexView, pvView, ov->mesh.get(),
-            coarseTable.nCollisions[0], devCoarseTable.indices,
+            nCoarseCollisions, coarseTable.collisionTable.devPtr(),
             devFineTable, collisionTimes.devPtr() );
 
     fineTable.nCollisions.downloadFromDevice(stream);
     debug("Found %d precise triangle collisions", fineTable.nCollisions[0]);
 
-    if (fineTable.nCollisions[0] > maxFineCollisions)
-        die("Found too many triangle collisions (precise) (%d, max %d),"
-            "something may be broken or you need to increase the estimate",
-            fineTable.nCollisions[0], maxFineCollisions);
-
-    // Step 3, resolve the collisions    
+    // Step 4, resolve the collisions    
     mpark::visit([&](auto& bounceKernel)
     {
         bounceKernel.update(rng);
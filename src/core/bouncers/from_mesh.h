@@ -34,14 +34,19 @@ private:
     };
 
     /**
-     * Maximum supported number of collisions per step
-     * will be #bouncesPerTri * total number of triangles in mesh
+     * The collision tables grow with the number of collisions found,
+     * the candidates are searched again when the table was too small
      */
-    const float coarseCollisionsPerTri = 5.0f;
-    const float fineCollisionsPerTri = 1.0f;
-
     CollisionTableWrapper<int2> coarseTable, fineTable;
 
+    /**
+     * Bounding volume hierarchy over the triangles, see MeshBounceKernels::TriangleBVH.
+     * The tree is built once from the mesh and its boxes are refitted at every step
+     */
+    int bvhLeaves {0};
+    PinnedBuffer<int> bvhLeafTriangles;
+    DeviceBuffer<float3> bvhLower, bvhUpper;
+
     // times stored as int so that we can use atomicMax
     // note that times are always positive, thus guarantees ordering
     DeviceBuffer<int> collisionTimes;
@@ -58,6 +58,66 @@ __global__ void reorderPositionsAndCreateMap(PVview view, CellListInfo cinfo, fl
     cinfo.order[pid] = dstId;
 }
 
+// Octant sub-cells continue the space-filling curve inside the cells
+
+enum {BINS_PER_CELL = 8};
+
+inline __device__ int getBinId(const CellListInfo& cinfo, float4 pos)
+{
+    const float3 r = cinfo.invh * (make_float3(pos) + 0.5f*cinfo.localDomainSize);
+    const int3 cid3 = cinfo.getCellIdAlongAxes<CellListsProjection::Clamp>(make_float3(pos));
+    const float3 inCell = r - make_float3(cid3);
+
+    const int octant = (inCell.x >= 0.5f) | ((inCell.y >= 0.5f) << 1) | ((inCell.z >= 0.5f) << 2);
+    return cinfo.encode(cid3) * BINS_PER_CELL + octant;
+}
+
+__global__ void computeBinSizes(PVview view, CellListInfo cinfo, int *binSizes)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= view.size) return;
+
+    float4 coo = view.readPositionNoCache(pid);
+
+    if ( outgoingParticle(coo) ) return;
+
+    atomicAdd(binSizes + getBinId(cinfo, coo), 1);
+}
+
+__global__ void reorderPositionsByBinsAndCreateMap(PVview view, CellListInfo cinfo, const int *binStarts, int *binSizes,
+                                                   float4 *outPositions)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= view.size) return;
+
+    int dstId = INVALID;
+
+    float4 pos = view.readPositionNoCache(pid);
+
+    if ( !outgoingParticle(pos) )
+    {
+        const int bid = getBinId(cinfo, pos);
+        dstId = binStarts[bid] + atomicAdd(binSizes + bid, 1);
+    }
+
+    if (dstId != INVALID)
+        writeNoCache(outPositions + dstId, pos);
+
+    cinfo.order[pid] = dstId;
+}
+
+__global__ void binsToCells(const int *binStarts, CellListInfo cinfo)
+{
+    const int cid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (cid > cinfo.totcells) return;
+
+    const int start = binStarts[cid * BINS_PER_CELL];
+    cinfo.cellStarts[cid] = start;
+
+    if (cid < cinfo.totcells)
+        cinfo.cellSizes[cid] = binStarts[(cid+1) * BINS_PER_CELL] - start;
+}
+
 template <typename T>
 __global__ void reorderExtraDataPerParticle(int n, const T *inExtraData, CellListInfo cinfo, T *outExtraData)
 {
@@ -109,6 +169,13 @@ CellListInfo::CellListInfo(float3 h, float3 localDomainSize) :
     totcells = ncells.x * ncells.y * ncells.z;
 }
 
+int CellListInfo::getNeighbourSpan(float cutoff) const
+{
+    const float3 cellsPerCutoff = cutoff * invh;
+    const float maxCells = std::max( {cellsPerCutoff.x, cellsPerCutoff.y, cellsPerCutoff.z} );
+    return std::max(1, static_cast<int>( ceilf(maxCells - 1e-5f) ));
+}
+
 //=================================================================================
 // Basic cell-lists
 //=================================================================================
@@ -188,11 +255,22 @@ void CellList::_updateExtraDataChannels(__UNUSED cudaStream_t stream)
 void CellList::_computeCellSizes(cudaStream_t stream)
 {
     debug2("%s : Computing cell sizes for %d particles", makeName().c_str(), pv->local()->size());
-    cellSizes.clear(stream);
 
     PVview view(pv, pv->local());
-
     const int nthreads = 128;
+
+    if (ordering != SpaceFillingCurve::Ordering::Lexicographic)
+    {
+        binSizes.clear(stream);
+        SAFE_KERNEL_LAUNCH(
+            CellListKernels::computeBinSizes,
+            getNblocks(view.size, nthreads), nthreads, 0, stream,
+            view, cellInfo(), binSizes.devPtr() );
+        return;
+    }
+    
+    cellSizes.clear(stream);
+
     SAFE_KERNEL_LAUNCH(
             CellListKernels::computeCellSizes,
             getNblocks(view.size, nthreads), nthreads, 0, stream,
@@ -201,17 +279,22 @@ void CellList::_computeCellSizes(cudaStream_t stream)
 
 void CellList::_computeCellStarts(cudaStream_t stream)
 {
+    const bool withBins = ordering != SpaceFillingCurve::Ordering::Lexicographic;
+    int *sizes  = withBins ? binSizes .devPtr() : cellSizes .devPtr();
+    int *starts = withBins ? binStarts.devPtr() : cellStarts.devPtr();
+    const int n = withBins ? binStarts.size() : totcells+1;
+    
     // Scan is always working with the same number of cells
     // Memory requirements can't change
     size_t bufSize = scanBuffer.size();
     
     if (bufSize == 0)
     {
-        cub::DeviceScan::ExclusiveSum(nullptr, bufSize, cellSizes.devPtr(), cellStarts.devPtr(), totcells+1, stream);
+        cub::DeviceScan::ExclusiveSum(nullptr, bufSize, sizes, starts, n, stream);
         scanBuffer.resize_anew(bufSize);
     }
     cub::DeviceScan::ExclusiveSum(scanBuffer.devPtr(), bufSize,
-                                  cellSizes.devPtr(), cellStarts.devPtr(), totcells+1, stream);
+                                  sizes, starts, n, stream);
 }
 
 void CellList::_reorderPositionsAndCreateMap(cudaStream_t stream)
@@ -222,9 +305,28 @@ void CellList::_reorderPositionsAndCreateMap(cudaStream_t stream)
 
     order.resize_anew(view.size);
     particlesDataContainer->resize_anew(view.size);
-    cellSizes.clear(stream);
 
     const int nthreads = 128;
+
+    if (ordering != SpaceFillingCurve::Ordering::Lexicographic)
+    {
+        binSizes.clear(stream);
+
+        SAFE_KERNEL_LAUNCH(
+            CellListKernels::reorderPositionsByBinsAndCreateMap,
+            getNblocks(view.size, nthreads), nthreads, 0, stream,
+            view, cellInfo(), binStarts.devPtr(), binSizes.devPtr(),
+            particlesDataContainer->positions().devPtr() );
+
+        SAFE_KERNEL_LAUNCH(
+            CellListKernels::binsToCells,
+            getNblocks(totcells+1, nthreads), nthreads, 0, stream,
+            binStarts.devPtr(), cellInfo() );
+        return;
+    }
+    
+    cellSizes.clear(stream);
+
     SAFE_KERNEL_LAUNCH(
         CellListKernels::reorderPositionsAndCreateMap,
         getNblocks(view.size, nthreads), nthreads, 0, stream,
@@ -284,13 +386,51 @@ CellListInfo CellList::cellInfo()
     CellListInfo::cellStarts = cellStarts.devPtr();
     CellListInfo::order      = order.devPtr();
 
+    const bool lexicographic = ordering == SpaceFillingCurve::Ordering::Lexicographic;
+    CellListInfo::cellRanks   = lexicographic ? nullptr : cellRanks  .devPtr();
+    CellListInfo::rankedCells = lexicographic ? nullptr : rankedCells.devPtr();
+
     return *((CellListInfo*)this);
 }
 
+void CellList::setOrdering(SpaceFillingCurve::Ordering newOrdering)
+{
+    if (changedStamp != -1)
+        die("%s: the ordering of the cells can only be changed before the first build", makeName().c_str());
+
+    ordering = newOrdering;
+    if (ordering == SpaceFillingCurve::Ordering::Lexicographic)
+        return;
+
+    const auto ranks = SpaceFillingCurve::computeCellRanks(ncells, ordering);
+    
+    HostBuffer<int> ranksHost(totcells), rankedHost(totcells);
+    for (int cid = 0; cid < totcells; ++cid)
+    {
+        ranksHost [cid] = ranks[cid];
+        rankedHost[ranks[cid]] = cid;
+    }
+
+    cellRanks  .copy(ranksHost,  defaultStream);
+    rankedCells.copy(rankedHost, defaultStream);
+    CUDA_Check( cudaStreamSynchronize(defaultStream) );
+    
+    binStarts.resize_anew(totcells * CellListKernels::BINS_PER_CELL + 1);
+    binSizes .resize_anew(totcells * CellListKernels::BINS_PER_CELL + 1);
+    binSizes .clear(defaultStream);
+    scanBuffer.resize_anew(0);
+
+    debug("%s: cells are numbered along the %s curve", makeName().c_str(),
+          SpaceFillingCurve::getOrderingStr(ordering).c_str());
+}
+
 void CellList::build(cudaStream_t stream)
 {
+    // the channels must exist even if the build is skipped
     _updateExtraDataChannels(stream);
-        
+
+    // static particle vectors are not touched between explicit invalidations,
+    // most of the steps end here
     if (!_checkNeedBuild()) return;
     
     debug("building %s", makeName().c_str());
@@ -356,10 +496,11 @@ void CellList::gatherChannels(const std::vector<std::string>& channelNames, cuda
         
         auto& desc = localPV->dataPerParticle.getChannelDescOrDie(channelName);
         _reorderExtraDataEntry(channelName, &desc, stream);
+    }
 
-        // invalidate particle vector halo if any entry is active
+    // the gathered channels are sent with the final halo: re-exchange it only when some were updated
+    if (!channelNames.empty())
         pv->haloValid = false;
-    }
 }
 
 void CellList::clearChannels(const std::vector<std::string>& channelNames, cudaStream_t stream)
@@ -436,7 +577,7 @@ void PrimaryCellList::accumulateChannels(__UNUSED const std::vector<std::string>
 
 void PrimaryCellList::gatherChannels(const std::vector<std::string>& channelNames, __UNUSED cudaStream_t stream)
 {
-    // do not need to reorder data, but still invalidate halo
+    // do not need to reorder data, but the halo must carry the updated channels
     if (!channelNames.empty())
         pv->haloValid = false;
 }
@@ -6,6 +6,7 @@
 #include <core/pvs/particle_vector.h>
 #include <core/pvs/views/pv.h>
 #include <core/utils/cuda_common.h>
+#include <core/utils/space_filling_curve.h>
 
 #include <cstdint>
 #include <functional>
@@ -28,20 +29,38 @@ public:
 
     int *cellSizes, *cellStarts, *order;
 
+    /// cell ids along a space-filling curve, indexed by lexicographic id, and the inverse map;
+    /// nullptr for the lexicographic numbering
+    const int *cellRanks {nullptr}, *rankedCells {nullptr};
+
     CellListInfo(float3 h, float3 localDomainSize);
     CellListInfo(float rc, float3 localDomainSize);
 
+    /// number of cells to traverse in each direction to find all the neighbours within the given cut-off
+    int getNeighbourSpan(float cutoff) const;
+
 #ifdef __CUDACC__
 // ==========================================================================================================================================
 // Common cell functions
 // ==========================================================================================================================================
+    /// cells with consecutive x indices have consecutive ids,
+    /// a row of cells can then be traversed as a single range of particles
+    __device__ __host__ inline bool hasContiguousRows() const
+    {
+        return cellRanks == nullptr;
+    }
+
+    /// the cell indices must be inside the grid unless hasContiguousRows() is true
     __device__ __host__ inline int encode(int ix, int iy, int iz) const
     {
-        return (iz*ncells.y + iy)*ncells.x + ix;
+        const int cid = (iz*ncells.y + iy)*ncells.x + ix;
+        return hasContiguousRows() ? cid : cellRanks[cid];
     }
 
     __device__ __host__ inline void decode(int cid, int& ix, int& iy, int& iz) const
     {
+        if (!hasContiguousRows()) cid = rankedCells[cid];
+        
         ix = cid % ncells.x;
         iy = (cid / ncells.x) % ncells.y;
         iz = cid / (ncells.x * ncells.y);
@@ -83,6 +102,30 @@ public:
 
         return encode(id.x, id.y, id.z);
     }
+
+    /**
+     * Call func(pstart, pend) with the particle ranges of the cells
+     * from (xlo, y, z) to (xhi, y, z), y and z must be inside the grid.
+     * This is a single call with contiguous rows and one call per cell otherwise
+     */
+    template <typename Func>
+    __device__ inline void forEachRowRange(int xlo, int xhi, int y, int z, Func&& func) const
+    {
+        if (hasContiguousRows())
+        {
+            const int cidLo = max(encode(xlo, y, z), 0);
+            const int cidHi = min(encode(xhi, y, z)+1, totcells);
+            func(cellStarts[cidLo], cellStarts[cidHi]);
+        }
+        else
+        {
+            for (int x = max(xlo, 0); x <= min(xhi, ncells.x-1); ++x)
+            {
+                const int cid = encode(x, y, z);
+                func(cellStarts[cid], cellStarts[cid+1]);
+            }
+        }
+    }
 #endif
 };
 
@@ -97,6 +140,12 @@ public:
     
     CellListInfo cellInfo();
 
+    /**
+     * Number the cells along a space-filling curve and order the particles
+     * of every cell by octants. Must be called before the first build
+     */
+    void setOrdering(SpaceFillingCurve::Ordering ordering);
+
     virtual void build(cudaStream_t stream);
 
     virtual void accumulateChannels(const std::vector<std::string>& channelNames, cudaStream_t stream);
@@ -130,6 +179,10 @@ protected:
     DeviceBuffer<char> scanBuffer;
     DeviceBuffer<int> cellStarts, cellSizes, order;
 
+    SpaceFillingCurve::Ordering ordering {SpaceFillingCurve::Ordering::Lexicographic};
+    DeviceBuffer<int> cellRanks, rankedCells;
+    DeviceBuffer<int> binStarts, binSizes; // octants of the cells, only with a space-filling curve
+
     std::unique_ptr<LocalParticleVector> particlesDataContainer;
     LocalParticleVector *localPV; // will point to particlesDataContainer or pv->local() if Primary
     
@@ -1,5 +1,6 @@
 #include "exchange_helpers.h"
 
+#include <core/pvs/packers/partial_objects.h>
 #include <core/pvs/packers/rods.h>
 #include <core/utils/cuda_common.h>
 #include <core/utils/kernel_launch.h>
@@ -56,6 +57,7 @@ static void computeOffsetsSizeBytesDev(const BufferOffsetsSizesWrap& wrapData,
 {
     auto rp = dynamic_cast<RodPacker*>(pp);
     auto op = dynamic_cast<ObjectPacker*>(pp);
+    auto sp = dynamic_cast<PartialObjectPacker*>(pp);
 
     auto execute = [&](const auto& packerHandler)
     {
@@ -64,6 +66,7 @@ static void computeOffsetsSizeBytesDev(const BufferOffsetsSizesWrap& wrapData,
     
     if      (rp != nullptr) execute(rp->handler());
     else if (op != nullptr) execute(op->handler());
+    else if (sp != nullptr) execute(sp->handler());
     else                    execute(pp->handler());
 }
 
@@ -6,8 +6,10 @@
 
 #include <core/utils/kernel_launch.h>
 #include <core/pvs/object_vector.h>
+#include <core/pvs/rigid_object_vector.h>
 #include <core/pvs/rod_vector.h>
 #include <core/pvs/packers/objects.h>
+#include <core/pvs/packers/partial_objects.h>
 #include <core/pvs/views/ov.h>
 #include <core/logger.h>
 #include <core/utils/cuda_common.h>
@@ -20,6 +22,53 @@ enum class PackMode
 namespace ObjectHaloExchangeKernels
 {
 
+/// maximum number of halos an object can be sent to: all the neighbours
+constexpr int maxHalos = FragmentMapping::numFragments - 1;
+
+/// find to which halos the object with extents \p prop should go
+/// an object within rc of both faces of an axis (e.g. larger than the subdomain) goes to both sides
+/// @return the number of halos, at most maxHalos
+__device__ inline int getHaloBuffers(const COMandExtent& prop, const DomainInfo& domain, float rc,
+                                     short validHalos[maxHalos])
+{
+    const float3 L = domain.localSize;
+
+    const int3 lo {prop.low.x  < -0.5f*L.x + rc ? -1 : 0,
+                   prop.low.y  < -0.5f*L.y + rc ? -1 : 0,
+                   prop.low.z  < -0.5f*L.z + rc ? -1 : 0};
+
+    const int3 hi {prop.high.x >  0.5f*L.x - rc ?  1 : 0,
+                   prop.high.y >  0.5f*L.y - rc ?  1 : 0,
+                   prop.high.z >  0.5f*L.z - rc ?  1 : 0};
+
+    int nHalos = 0;
+
+    for (int ix = lo.x; ix <= hi.x; ++ix)
+        for (int iy = lo.y; iy <= hi.y; ++iy)
+            for (int iz = lo.z; iz <= hi.z; ++iz)
+            {
+                if (ix == 0 && iy == 0 && iz == 0) continue;
+                const int bufId = FragmentMapping::getId(ix, iy, iz);
+                validHalos[nHalos] = bufId;
+                nHalos++;
+            }
+
+    return nHalos;
+}
+
+/// true if \p r is within \p rc of all the faces towards direction \p dir
+__device__ inline bool isInHaloSlab(float3 r, float3 L, float rc, int3 dir)
+{
+    auto inSlab = [rc](float x, float l, int d)
+    {
+        if (d < 0) return x < -0.5f*l + rc;
+        if (d > 0) return x >  0.5f*l - rc;
+        return true;
+    };
+
+    return inSlab(r.x, L.x, dir.x) && inSlab(r.y, L.y, dir.y) && inSlab(r.z, L.z, dir.z);
+}
+
 template <PackMode packMode, class PackerHandler>
 __global__ void getObjectHaloAndMap(DomainInfo domain, OVview view, MapEntry *map,
                                     float rc, PackerHandler packer,
@@ -29,32 +78,10 @@ __global__ void getObjectHaloAndMap(DomainInfo domain, OVview view, MapEntry *ma
     const int tid   = threadIdx.x;
     
     int nHalos = 0;
-    short validHalos[7];
+    short validHalos[maxHalos];
 
     if (objId < view.nObjects)
-    {
-        // Find to which halos this object should go
-        auto prop = view.comAndExtents[objId];
-        int dx = 0, dy = 0, dz = 0;
-
-        if (prop.low.x  < -0.5f*domain.localSize.x + rc) dx = -1;
-        if (prop.low.y  < -0.5f*domain.localSize.y + rc) dy = -1;
-        if (prop.low.z  < -0.5f*domain.localSize.z + rc) dz = -1;
-
-        if (prop.high.x >  0.5f*domain.localSize.x - rc) dx = 1;
-        if (prop.high.y >  0.5f*domain.localSize.y - rc) dy = 1;
-        if (prop.high.z >  0.5f*domain.localSize.z - rc) dz = 1;
-
-        for (int ix = min(dx, 0); ix <= max(dx, 0); ++ix)
-            for (int iy = min(dy, 0); iy <= max(dy, 0); ++iy)
-                for (int iz = min(dz, 0); iz <= max(dz, 0); ++iz)
-                {
-                    if (ix == 0 && iy == 0 && iz == 0) continue;
-                    const int bufId = FragmentMapping::getId(ix, iy, iz);
-                    validHalos[nHalos] = bufId;
-                    nHalos++;
-                }
-    }
+        nHalos = getHaloBuffers(view.comAndExtents[objId], domain, rc, validHalos);
 
 
     // Copy objects to each halo
@@ -117,6 +144,138 @@ __global__ void unpackObjects(BufferOffsetsSizesWrap dataWrap, PackerHandler pac
     packer.blockUnpack(numElements, buffer, srcObjId, dstObjId);
 }
 
+/**
+ * Partial halos: only the particles of the object within rc of the faces are packed, one per element.
+ * Each block counts the particles of one object going to each buffer, then reserves space in the buffers
+ * and an object index in the buffers with a single atomic per buffer.
+ */
+template <PackMode packMode>
+__global__ void getPartialObjectHaloAndMap(DomainInfo domain, OVview view, MapEntry *map,
+                                           float rc, PartialObjectPackerHandler packer,
+                                           int *objectCounts, BufferOffsetsSizesWrap dataWrap)
+{
+    const int objId = blockIdx.x;
+    const int tid   = threadIdx.x;
+
+    int nHalos = 0;
+    short validHalos[maxHalos];
+
+    if (objId < view.nObjects)
+        nHalos = getHaloBuffers(view.comAndExtents[objId], domain, rc, validHalos);
+
+    __shared__ int blockSum  [FragmentMapping::numFragments];
+    __shared__ int blockStart[FragmentMapping::numFragments];
+    __shared__ int blockObjId[FragmentMapping::numFragments];
+
+    if (tid < FragmentMapping::numFragments)
+        blockSum[tid] = 0;
+    __syncthreads();
+
+    if (nHalos == 0) return;
+
+    for (int locId = tid; locId < view.objSize; locId += blockDim.x)
+    {
+        const int pid = objId * view.objSize + locId;
+        const float3 r = make_float3(view.readPosition(pid));
+
+        for (int i = 0; i < nHalos; ++i)
+        {
+            const int bufId = validHalos[i];
+            if (isInHaloSlab(r, domain.localSize, rc, FragmentMapping::getDir(bufId)))
+                atomicAdd(blockSum + bufId, 1);
+        }
+    }
+    __syncthreads();
+
+    if (tid < FragmentMapping::numFragments && blockSum[tid] > 0)
+    {
+        blockStart[tid] = atomicAdd(dataWrap.sizes + tid, blockSum[tid]);
+
+        if (packMode == PackMode::Pack)
+            blockObjId[tid] = atomicAdd(objectCounts + tid, 1);
+
+        // reused as a counter when packing
+        blockSum[tid] = 0;
+    }
+
+    if (packMode == PackMode::Query)
+        return;
+
+    __syncthreads();
+
+    for (int locId = tid; locId < view.objSize; locId += blockDim.x)
+    {
+        const int pid = objId * view.objSize + locId;
+        const float3 r = make_float3(view.readPosition(pid));
+
+        for (int i = 0; i < nHalos; ++i)
+        {
+            const int bufId = validHalos[i];
+            const int3 dir = FragmentMapping::getDir(bufId);
+
+            if (!isInHaloSlab(r, domain.localSize, rc, dir)) continue;
+
+            const int dstId = blockStart[bufId] + atomicAdd(blockSum + bufId, 1);
+            const int slot  = blockObjId[bufId] * view.objSize + locId;
+
+            auto shift = ExchangersCommon::getShift(domain.localSize, dir);
+            auto buffer = dataWrap.getBuffer(bufId);
+            const int numElements = dataWrap.offsets[bufId+1] - dataWrap.offsets[bufId];
+
+            packer.packShift(pid, dstId, slot, buffer, numElements, shift);
+            map[dataWrap.offsets[bufId] + dstId] = MapEntry(pid, bufId);
+        }
+    }
+}
+
+__device__ inline int getReceivedSlot(BufferOffsetsSizesWrap dataWrap, const PartialObjectPackerHandler& packer,
+                                      int bufId, int srcId)
+{
+    return packer.getSlot(srcId, dataWrap.getBuffer(bufId), dataWrap.sizes[bufId]);
+}
+
+__global__ void countPartialObjects(BufferOffsetsSizesWrap dataWrap, PartialObjectPackerHandler packer,
+                                    int objSize, int *objectCounts)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= dataWrap.offsets[dataWrap.nBuffers]) return;
+
+    const int bufId = dispatchThreadsPerBuffer(dataWrap.nBuffers, dataWrap.offsets, i);
+    const int slot  = getReceivedSlot(dataWrap, packer, bufId, i - dataWrap.offsets[bufId]);
+
+    atomicMax(objectCounts + bufId, slot / objSize + 1);
+}
+
+__global__ void markParticles(int n, float4 *positions, float4 *velocities)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= n) return;
+
+    Particle p;
+    p.r = make_float3(0.f);
+    p.u = make_float3(0.f);
+    p.setId(-1);
+    p.mark();
+
+    p.write2Float4(positions, velocities, pid);
+}
+
+__global__ void unpackPartialObjects(BufferOffsetsSizesWrap dataWrap, PartialObjectPackerHandler packer,
+                                     int objSize, const int *objectOffsets, int *haloParticleIds)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= dataWrap.offsets[dataWrap.nBuffers]) return;
+
+    const int bufId = dispatchThreadsPerBuffer(dataWrap.nBuffers, dataWrap.offsets, i);
+    const int srcId = i - dataWrap.offsets[bufId];
+    const int slot  = getReceivedSlot(dataWrap, packer, bufId, srcId);
+
+    const int dstPid = (objectOffsets[bufId] + slot / objSize) * objSize + slot % objSize;
+
+    packer.unpack(srcId, dstPid, dataWrap.getBuffer(bufId), dataWrap.sizes[bufId]);
+    haloParticleIds[i] = dstPid;
+}
+
 } // namespace ObjectHaloExchangeKernels
 
 
@@ -128,11 +287,13 @@ bool ObjectHaloExchanger::needExchange(int id)
 ObjectHaloExchanger::ObjectHaloExchanger() = default;
 ObjectHaloExchanger::~ObjectHaloExchanger() = default;
 
-void ObjectHaloExchanger::attach(ObjectVector *ov, float rc, const std::vector<std::string>& extraChannelNames)
+void ObjectHaloExchanger::attach(ObjectVector *ov, float rc, const std::vector<std::string>& extraChannelNames,
+                                 bool partial, bool fromMotions)
 {
     int id = objects.size();
     objects.push_back(ov);
     rcs.push_back(rc);
+    partials.push_back(partial);
 
     auto channels = extraChannelNames;
     channels.push_back(ChannelNames::positions);
@@ -144,31 +305,60 @@ void ObjectHaloExchanger::attach(ObjectVector *ov, float rc, const std::vector<s
     };
 
     std::unique_ptr<ObjectPacker> packer, unpacker;
+    std::unique_ptr<PartialObjectPacker> partialPacker, partialUnpacker;
 
-    if (auto rv = dynamic_cast<RodVector*>(ov))
+    if (partial)
+    {
+        for (const auto& name : extraChannelNames)
+            if (!ov->local()->dataPerParticle.checkChannelExists(name))
+                die("Partial halo of '%s' can only exchange particle channels, got '%s'",
+                    ov->name.c_str(), name.c_str());
+
+        partialPacker   = std::make_unique<PartialObjectPacker>(predicate);
+        partialUnpacker = std::make_unique<PartialObjectPacker>(predicate);
+    }
+    else if (auto rv = dynamic_cast<RodVector*>(ov))
     {
         packer   = std::make_unique<RodPacker>(predicate);
         unpacker = std::make_unique<RodPacker>(predicate);
     }
+    else if (fromMotions)
+    {
+        if (dynamic_cast<RigidObjectVector*>(ov) == nullptr)
+            die("Only the particles of rigid objects can be restored from the motions, got '%s'", ov->name.c_str());
+
+        // particles are restored from the motions on the receiving side
+        packer   = std::make_unique<RigidPacker>(predicate);
+        unpacker = std::make_unique<RigidPacker>(predicate);
+    }
     else
     {
         packer   = std::make_unique<ObjectPacker>(predicate);
         unpacker = std::make_unique<ObjectPacker>(predicate);
     }
 
-    auto helper = std::make_unique<ExchangeHelper>(ov->name, id, packer.get());
+    ParticlePacker *helperPacker = partial ?
+        static_cast<ParticlePacker*>(partialPacker.get()) :
+        static_cast<ParticlePacker*>(packer.get());
 
-    packers  .push_back(std::move(  packer));
-    unpackers.push_back(std::move(unpacker));
-    helpers  .push_back(std::move(  helper));
-    maps     .emplace_back();
+    auto helper = std::make_unique<ExchangeHelper>(ov->name, id, helperPacker);
+
+    packers         .push_back(std::move(         packer));
+    unpackers       .push_back(std::move(       unpacker));
+    partialPackers  .push_back(std::move(  partialPacker));
+    partialUnpackers.push_back(std::move(partialUnpacker));
+    helpers         .push_back(std::move(         helper));
+    maps            .emplace_back();
+    objectCounts    .emplace_back(FragmentMapping::numFragments);
+    objectOffsets   .emplace_back(FragmentMapping::numFragments + 1);
+    haloParticleIds .emplace_back();
 
     std::string allChannelNames = "";
     for (const auto& name : channels)
         allChannelNames += "'" + name + "' ";
     
-    info("Object vector '%s' (rc %f) was attached to halo exchanger with channels %s",
-         ov->name.c_str(), rc, allChannelNames.c_str());
+    info("Object vector '%s' (rc %f) was attached to %shalo exchanger with channels %s",
+         ov->name.c_str(), rc, partial ? "partial " : "", allChannelNames.c_str());
 }
 
 void ObjectHaloExchanger::prepareSizes(int id, cudaStream_t stream)
@@ -177,7 +367,6 @@ void ObjectHaloExchanger::prepareSizes(int id, cudaStream_t stream)
     auto lov = ov->local();
     auto rc  = rcs[id];
     auto helper = helpers[id].get();
-    auto packer = packers[id].get();
 
     ov->findExtentAndCOM(stream, ParticleVectorLocality::Local);
 
@@ -185,20 +374,41 @@ void ObjectHaloExchanger::prepareSizes(int id, cudaStream_t stream)
 
     OVview ovView(ov, lov);
     helper->send.sizes.clear(stream);
-    packer->update(lov, stream);
 
-    if (ovView.nObjects > 0)
+    if (partials[id])
     {
-        const int nthreads = 256;
+        auto packer = partialPackers[id].get();
+        packer->update(lov, stream);
 
-        mpark::visit([&](auto packerHandler)
+        if (ovView.nObjects > 0)
         {
+            const int nthreads = 256;
+
             SAFE_KERNEL_LAUNCH(
-                ObjectHaloExchangeKernels::getObjectHaloAndMap<PackMode::Query>,
+                ObjectHaloExchangeKernels::getPartialObjectHaloAndMap<PackMode::Query>,
                 ovView.nObjects, nthreads, 0, stream,
                 ov->state->domain, ovView, nullptr, rc,
-                packerHandler, helper->wrapSendData() );
-        }, ExchangersCommon::getHandler(packer));
+                packer->handler(), nullptr, helper->wrapSendData() );
+        }
+    }
+    else
+    {
+        auto packer = packers[id].get();
+        packer->update(lov, stream);
+
+        if (ovView.nObjects > 0)
+        {
+            const int nthreads = 256;
+
+            mpark::visit([&](auto packerHandler)
+            {
+                SAFE_KERNEL_LAUNCH(
+                    ObjectHaloExchangeKernels::getObjectHaloAndMap<PackMode::Query>,
+                    ovView.nObjects, nthreads, 0, stream,
+                    ov->state->domain, ovView, nullptr, rc,
+                    packerHandler, helper->wrapSendData() );
+            }, ExchangersCommon::getHandler(packer));
+        }
     }
 
     helper->computeSendOffsets_Dev2Dev(stream);
@@ -210,7 +420,6 @@ void ObjectHaloExchanger::prepareData(int id, cudaStream_t stream)
     auto lov = ov->local();
     auto rc  = rcs[id];
     auto helper = helpers[id].get();
-    auto packer = packers[id].get();
     auto& map = maps[id];
     
     const int nhalo = helper->send.offsets[helper->nBuffers];
@@ -220,24 +429,47 @@ void ObjectHaloExchanger::prepareData(int id, cudaStream_t stream)
     if (ovView.nObjects > 0)
     {
         const int nthreads = 256;
-        debug2("Downloading %d halo objects of '%s'", nhalo, ov->name.c_str());
+        debug2("Downloading %d halo %s of '%s'", nhalo,
+               partials[id] ? "particles" : "objects", ov->name.c_str());
 
         helper->resizeSendBuf();
         helper->send.sizes.clearDevice(stream);
-        
-        mpark::visit([&](const auto& packerHandler)
+
+        if (partials[id])
         {
+            auto packer = partialPackers[id].get();
+            objectCounts[id].clearDevice(stream);
+
             SAFE_KERNEL_LAUNCH(
-                ObjectHaloExchangeKernels::getObjectHaloAndMap<PackMode::Pack>,
+                ObjectHaloExchangeKernels::getPartialObjectHaloAndMap<PackMode::Pack>,
                 ovView.nObjects, nthreads, 0, stream,
                 ov->state->domain, ovView, map.devPtr(), rc,
-                packerHandler, helper->wrapSendData());
-        }, ExchangersCommon::getHandler(packer));
+                packer->handler(), objectCounts[id].devPtr(), helper->wrapSendData() );
+        }
+        else
+        {
+            auto packer = packers[id].get();
+
+            mpark::visit([&](const auto& packerHandler)
+            {
+                SAFE_KERNEL_LAUNCH(
+                    ObjectHaloExchangeKernels::getObjectHaloAndMap<PackMode::Pack>,
+                    ovView.nObjects, nthreads, 0, stream,
+                    ov->state->domain, ovView, map.devPtr(), rc,
+                    packerHandler, helper->wrapSendData());
+            }, ExchangersCommon::getHandler(packer));
+        }
     }
 }
 
 void ObjectHaloExchanger::combineAndUploadData(int id, cudaStream_t stream)
 {
+    if (partials[id])
+    {
+        combineAndUploadPartialData(id, stream);
+        return;
+    }
+
     auto ov       = objects[id];
     auto hov      = ov->halo();
     auto helper   = helpers[id].get();
@@ -262,6 +494,58 @@ void ObjectHaloExchanger::combineAndUploadData(int id, cudaStream_t stream)
     }, ExchangersCommon::getHandler(unpacker));
 }
 
+void ObjectHaloExchanger::combineAndUploadPartialData(int id, cudaStream_t stream)
+{
+    auto ov       = objects[id];
+    auto hov      = ov->halo();
+    auto helper   = helpers[id].get();
+    auto unpacker = partialUnpackers[id].get();
+    auto& counts  = objectCounts[id];
+    auto& objOffsets = objectOffsets[id];
+    auto& ids     = haloParticleIds[id];
+
+    const int objSize = ov->objSize;
+    const int totalRecvd = helper->recv.offsets[helper->nBuffers];
+
+    const int nthreads = 128;
+    const int nblocks  = getNblocks(totalRecvd, nthreads);
+
+    // the object indices are not sent, they are deduced from the slots of the particles
+    unpacker->update(hov, stream);
+    counts.clear(stream);
+
+    SAFE_KERNEL_LAUNCH(
+        ObjectHaloExchangeKernels::countPartialObjects,
+        nblocks, nthreads, 0, stream,
+        helper->wrapRecvData(), unpacker->handler(), objSize, counts.devPtr() );
+
+    counts.downloadFromDevice(stream, ContainersSynch::Synch);
+
+    objOffsets[0] = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+        objOffsets[i+1] = objOffsets[i] + counts[i];
+    objOffsets.uploadToDevice(stream);
+
+    const int nObjects = objOffsets[counts.size()];
+    debug2("Received %d particles of %d halo objects of '%s'", totalRecvd, nObjects, ov->name.c_str());
+
+    // particles that were not sent are marked, such that they never interact
+    hov->resize_anew(nObjects * objSize);
+    unpacker->update(hov, stream);
+    ids.resize_anew(totalRecvd);
+
+    SAFE_KERNEL_LAUNCH(
+        ObjectHaloExchangeKernels::markParticles,
+        getNblocks(hov->size(), nthreads), nthreads, 0, stream,
+        hov->size(), hov->positions().devPtr(), hov->velocities().devPtr() );
+
+    SAFE_KERNEL_LAUNCH(
+        ObjectHaloExchangeKernels::unpackPartialObjects,
+        nblocks, nthreads, 0, stream,
+        helper->wrapRecvData(), unpacker->handler(), objSize,
+        objOffsets.devPtr(), ids.devPtr() );
+}
+
 PinnedBuffer<int>& ObjectHaloExchanger::getSendOffsets(int id)
 {
     return helpers[id]->send.offsets;
@@ -276,3 +560,13 @@ DeviceBuffer<MapEntry>& ObjectHaloExchanger::getMap(int id)
 {
     return maps[id];
 }
+
+bool ObjectHaloExchanger::isPartial(int id) const
+{
+    return partials[id];
+}
+
+DeviceBuffer<int>& ObjectHaloExchanger::getHaloParticleIds(int id)
+{
+    return haloParticleIds[id];
+}
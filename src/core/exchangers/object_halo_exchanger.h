@@ -9,28 +9,53 @@
 
 class ObjectVector;
 class ObjectPacker;
+class PartialObjectPacker;
 class MapEntry;
 
+/**
+ * Sends the objects within rc of the subdomain faces to the neighbouring ranks.
+ *
+ * By default whole objects are sent.
+ * In partial mode, only the particles within rc of the faces are sent, with the particle channels only;
+ * the halo objects keep the usual layout and the particles that were not received are marked.
+ * The offsets and the map are then given in particles instead of objects.
+ * Partial halos can not be used when the objects topology is needed on the halo (bounce-back, belonging).
+ * Rigid objects can be sent without their particles, which are then placed back from the motions;
+ * this is only valid if the motions are up to date with the particles.
+ */
 class ObjectHaloExchanger : public Exchanger
 {
 public:
     ObjectHaloExchanger();
     ~ObjectHaloExchanger();
 
-    void attach(ObjectVector *ov, float rc, const std::vector<std::string>& extraChannelNames);
+    void attach(ObjectVector *ov, float rc, const std::vector<std::string>& extraChannelNames,
+                bool partial = false, bool fromMotions = false);
 
     PinnedBuffer<int>& getSendOffsets(int id);
     PinnedBuffer<int>& getRecvOffsets(int id);
     DeviceBuffer<MapEntry>& getMap   (int id);
 
+    bool isPartial(int id) const;
+
+    /// partial mode only: index in the halo object vector of each received particle
+    DeviceBuffer<int>& getHaloParticleIds(int id);
+
 protected:
     std::vector<float> rcs;
+    std::vector<bool> partials;
     std::vector<ObjectVector*> objects;
     std::vector<std::unique_ptr<ObjectPacker>> packers, unpackers;
+    std::vector<std::unique_ptr<PartialObjectPacker>> partialPackers, partialUnpackers;
     std::vector<DeviceBuffer<MapEntry>> maps;
 
+    std::vector<PinnedBuffer<int>> objectCounts, objectOffsets; ///< per buffer, partial mode only
+    std::vector<DeviceBuffer<int>> haloParticleIds;
+
     void prepareSizes(int id, cudaStream_t stream) override;
     void prepareData (int id, cudaStream_t stream) override;
     void combineAndUploadData(int id, cudaStream_t stream) override;
     bool needExchange(int id) override;
+
+    void combineAndUploadPartialData(int id, cudaStream_t stream);
 };
@@ -55,6 +55,40 @@ __global__ void unpack(BufferOffsetsSizesWrap dataWrap, PackerHandler packer)
 
     packer.blockUnpack(numElements, buffer, srcObjId, dstObjId);
 }
+
+// partial halos: one particle per element
+
+__global__ void packParticles(DomainInfo domain, ParticlePackerHandler packer, const MapEntry *map,
+                              int n, BufferOffsetsSizesWrap dataWrap)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+
+    auto mapEntry = map[i];
+
+    const int bufId  = mapEntry.getBufId();
+    const int srcPid = mapEntry.getId();
+    const int dstId  = i - dataWrap.offsets[bufId];
+    const int numElements = dataWrap.offsets[bufId+1] - dataWrap.offsets[bufId];
+
+    auto buffer = dataWrap.getBuffer(bufId);
+    auto dir   = FragmentMapping::getDir(bufId);
+    auto shift = ExchangersCommon::getShift(domain.localSize, dir);
+
+    packer.particles.packShift(srcPid, dstId, buffer, numElements, shift);
+}
+
+__global__ void unpackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerHandler packer,
+                                const int *haloParticleIds)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= dataWrap.offsets[dataWrap.nBuffers]) return;
+
+    const int bufId = dispatchThreadsPerBuffer(dataWrap.nBuffers, dataWrap.offsets, i);
+    const int srcId = i - dataWrap.offsets[bufId];
+
+    packer.particles.unpack(srcId, haloParticleIds[i], dataWrap.getBuffer(bufId), dataWrap.sizes[bufId]);
+}
 } // namespace ObjectHaloExtraExchangerKernels
 
 
@@ -85,32 +119,48 @@ void ObjectExtraExchanger::attach(ObjectVector *ov, const std::vector<std::strin
     };
     
     std::unique_ptr<ObjectPacker> packer, unpacker;
+    std::unique_ptr<ParticlePacker> particlePacker, particleUnpacker;
+    ParticlePacker *helperPacker;
 
-    if (rv == nullptr)
+    if (entangledHaloExchanger->isPartial(id))
     {
-        packer   = std::make_unique<ObjectPacker>(predicate);
-        unpacker = std::make_unique<ObjectPacker>(predicate);
+        particlePacker   = std::make_unique<ParticlePacker>(predicate);
+        particleUnpacker = std::make_unique<ParticlePacker>(predicate);
+        helperPacker = particlePacker.get();
     }
     else
     {
-        packer   = std::make_unique<RodPacker>(predicate);
-        unpacker = std::make_unique<RodPacker>(predicate);
+        if (rv == nullptr)
+        {
+            packer   = std::make_unique<ObjectPacker>(predicate);
+            unpacker = std::make_unique<ObjectPacker>(predicate);
+        }
+        else
+        {
+            packer   = std::make_unique<RodPacker>(predicate);
+            unpacker = std::make_unique<RodPacker>(predicate);
+        }
+        helperPacker = packer.get();
     }
 
-    auto   helper = std::make_unique<ExchangeHelper>(ov->name, id, packer.get());
+    auto   helper = std::make_unique<ExchangeHelper>(ov->name, id, helperPacker);
     
-    packers  .push_back(std::move(  packer));
-    unpackers.push_back(std::move(unpacker));
-    helpers  .push_back(std::move(  helper));
+    packers          .push_back(std::move(          packer));
+    unpackers        .push_back(std::move(        unpacker));
+    particlePackers  .push_back(std::move(  particlePacker));
+    particleUnpackers.push_back(std::move(particleUnpacker));
+    helpers          .push_back(std::move(          helper));
 }
 
 void ObjectExtraExchanger::prepareSizes(int id, cudaStream_t stream)
 {
     auto helper = helpers[id].get();
-    auto packer = packers[id].get();
     auto ov = objects[id];
 
-    packer->update(ov->local(), stream);
+    if (entangledHaloExchanger->isPartial(id))
+        particlePackers[id]->update(ov->local(), stream);
+    else
+        packers[id]->update(ov->local(), stream);
 
     const auto& offsets = entangledHaloExchanger->getSendOffsets(id);
 
@@ -122,13 +172,24 @@ void ObjectExtraExchanger::prepareData(int id, cudaStream_t stream)
 {
     auto ov     = objects[id];
     auto helper = helpers[id].get();
-    auto packer = packers[id].get();
     const auto& map = entangledHaloExchanger->getMap(id);
 
     helper->computeSendOffsets();
     helper->send.uploadInfosToDevice(stream);
     helper->resizeSendBuf();
 
+    if (entangledHaloExchanger->isPartial(id))
+    {
+        const int nthreads = 128;
+        SAFE_KERNEL_LAUNCH(
+            ObjectHaloExtraExchangerKernels::packParticles,
+            getNblocks(map.size(), nthreads), nthreads, 0, stream,
+            ov->state->domain, particlePackers[id]->handler(), map.devPtr(),
+            map.size(), helper->wrapSendData() );
+        return;
+    }
+
+    auto packer = packers[id].get();
     const int nthreads = 256;
     mpark::visit([&](auto packerHandler)
     {
@@ -145,12 +206,28 @@ void ObjectExtraExchanger::combineAndUploadData(int id, cudaStream_t stream)
     auto ov       = objects[id];
     auto hov      = ov->halo();
     auto helper   = helpers[id].get();
-    auto unpacker = unpackers[id].get();
 
     const auto& offsets = helper->recv.offsets;
     
     const int totalRecvd = offsets[helper->nBuffers];
 
+    if (entangledHaloExchanger->isPartial(id))
+    {
+        // the halo objects were already allocated by the halo exchanger
+        auto unpacker = particleUnpackers[id].get();
+        unpacker->update(hov, stream);
+
+        const int nthreads = 128;
+        SAFE_KERNEL_LAUNCH(
+            ObjectHaloExtraExchangerKernels::unpackParticles,
+            getNblocks(totalRecvd, nthreads), nthreads, 0, stream,
+            helper->wrapRecvData(), unpacker->handler(),
+            entangledHaloExchanger->getHaloParticleIds(id).devPtr() );
+        return;
+    }
+
+    auto unpacker = unpackers[id].get();
+
     hov->resize_anew(totalRecvd * ov->objSize);
     unpacker->update(hov, stream);
 
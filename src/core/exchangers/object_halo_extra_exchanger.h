@@ -10,6 +10,7 @@
 
 class ObjectVector;
 class ObjectPacker;
+class ParticlePacker;
 class ObjectHaloExchanger;
 
 class ObjectExtraExchanger : public Exchanger
@@ -24,6 +25,7 @@ protected:
     std::vector<ObjectVector*> objects;
     ObjectHaloExchanger *entangledHaloExchanger;
     std::vector<std::unique_ptr<ObjectPacker>> packers, unpackers;
+    std::vector<std::unique_ptr<ParticlePacker>> particlePackers, particleUnpackers; ///< partial halos
     
     void prepareSizes(int id, cudaStream_t stream) override;
     void prepareData (int id, cudaStream_t stream) override;
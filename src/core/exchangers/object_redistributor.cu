@@ -7,6 +7,7 @@
 #include <core/utils/kernel_launch.h>
 #include <core/pvs/particle_vector.h>
 #include <core/pvs/object_vector.h>
+#include <core/pvs/rigid_object_vector.h>
 #include <core/pvs/rod_vector.h>
 #include <core/pvs/views/ov.h>
 #include <core/pvs/packers/objects.h>
@@ -80,7 +81,7 @@ bool ObjectRedistributor::needExchange(int id)
     return !objects[id]->redistValid;
 }
 
-void ObjectRedistributor::attach(ObjectVector *ov)
+void ObjectRedistributor::attach(ObjectVector *ov, bool fromMotions)
 {
     const int id = objects.size();
     objects.push_back(ov);
@@ -90,9 +91,13 @@ void ObjectRedistributor::attach(ObjectVector *ov)
         return namedDesc.second->persistence == DataManager::PersistenceMode::Active;
     };
     
+    if (fromMotions && dynamic_cast<RigidObjectVector*>(ov) == nullptr)
+        die("Only the particles of rigid objects can be restored from the motions, got '%s'", ov->name.c_str());
+
     std::unique_ptr<ObjectPacker> packer;
-    if (auto rv = dynamic_cast<RodVector*>(ov)) packer = std::make_unique<RodPacker>   (predicate);
-    else                                        packer = std::make_unique<ObjectPacker>(predicate);
+    if      (auto rv = dynamic_cast<RodVector*>(ov)) packer = std::make_unique<RodPacker>   (predicate);
+    else if (fromMotions)                            packer = std::make_unique<RigidPacker> (predicate);
+    else                                             packer = std::make_unique<ObjectPacker>(predicate);
     
     auto helper = std::make_unique<ExchangeHelper>(ov->name, id, packer.get());
     
@@ -13,7 +13,8 @@ public:
     ObjectRedistributor();
     ~ObjectRedistributor();
 
-    void attach(ObjectVector *ov);
+    /// fromMotions: send only the motions of the rigid objects, their particles are placed back on the receiving rank
+    void attach(ObjectVector *ov, bool fromMotions = false);
     
 private:
     std::vector<ObjectVector*> objects;
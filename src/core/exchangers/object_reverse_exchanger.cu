@@ -55,6 +55,36 @@ __global__ void reverseUnpackAndAdd(PackerHandler packer, const MapEntry *map,
     packer.blockUnpackAddNonZero(numElements, buffer, srcObjId, dstObjId, eps);
 }
 
+// partial halos: one particle per element
+
+__global__ void reversePackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerHandler packer,
+                                     const int *haloParticleIds)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= dataWrap.offsets[dataWrap.nBuffers]) return;
+
+    const int bufId = dispatchThreadsPerBuffer(dataWrap.nBuffers, dataWrap.offsets, i);
+    const int dstId = i - dataWrap.offsets[bufId];
+
+    packer.particles.pack(haloParticleIds[i], dstId, dataWrap.getBuffer(bufId), dataWrap.sizes[bufId]);
+}
+
+__global__ void reverseUnpackAndAddParticles(ParticlePackerHandler packer, const MapEntry *map,
+                                             int n, BufferOffsetsSizesWrap dataWrap)
+{
+    constexpr float eps = 1e-6f;
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+
+    auto mapEntry = map[i];
+    const int bufId  = mapEntry.getBufId();
+    const int dstPid = mapEntry.getId();
+    const int srcId  = i - dataWrap.offsets[bufId];
+
+    packer.particles.unpackAtomicAddNonZero(srcId, dstPid, dataWrap.getBuffer(bufId),
+                                            dataWrap.sizes[bufId], eps);
+}
+
 } // namespace ObjectReverseExchangerKernels
 
 
@@ -80,23 +110,37 @@ void ObjectReverseExchanger::attach(ObjectVector *ov, std::vector<std::string> c
     };
 
     std::unique_ptr<ObjectPacker> packer, unpacker;
+    std::unique_ptr<ParticlePacker> particlePacker, particleUnpacker;
+    ParticlePacker *helperPacker;
 
-    if (rv == nullptr)
+    if (entangledHaloExchanger->isPartial(id))
     {
-        packer   = std::make_unique<ObjectPacker>(predicate);
-        unpacker = std::make_unique<ObjectPacker>(predicate);
+        particlePacker   = std::make_unique<ParticlePacker>(predicate);
+        particleUnpacker = std::make_unique<ParticlePacker>(predicate);
+        helperPacker = particlePacker.get();
     }
     else
     {
-        packer   = std::make_unique<RodPacker>(predicate);
-        unpacker = std::make_unique<RodPacker>(predicate);
+        if (rv == nullptr)
+        {
+            packer   = std::make_unique<ObjectPacker>(predicate);
+            unpacker = std::make_unique<ObjectPacker>(predicate);
+        }
+        else
+        {
+            packer   = std::make_unique<RodPacker>(predicate);
+            unpacker = std::make_unique<RodPacker>(predicate);
+        }
+        helperPacker = packer.get();
     }
     
-    auto helper = std::make_unique<ExchangeHelper>(ov->name, id, packer.get());
+    auto helper = std::make_unique<ExchangeHelper>(ov->name, id, helperPacker);
     
-    packers  .push_back(std::move(  packer));
-    unpackers.push_back(std::move(unpacker));
-    helpers  .push_back(std::move(  helper));
+    packers          .push_back(std::move(          packer));
+    unpackers        .push_back(std::move(        unpacker));
+    particlePackers  .push_back(std::move(  particlePacker));
+    particleUnpackers.push_back(std::move(particleUnpacker));
+    helpers          .push_back(std::move(          helper));
 
     std::string allChannelNames = channelNames.size() ? "channels " : "no channels.";
     for (const auto& name : channelNames)
@@ -125,16 +169,34 @@ void ObjectReverseExchanger::prepareData(int id, cudaStream_t stream)
     auto ov     = objects[id];
     auto hov    = ov->halo();
     auto helper = helpers[id].get();
-    auto packer = packers[id].get();
     
     debug2("Preparing '%s' data to reverse send", ov->name.c_str());
 
-    packer->update(hov, stream);
-
     helper->computeSendOffsets();
     helper->send.uploadInfosToDevice(stream);
     helper->resizeSendBuf();
 
+    if (entangledHaloExchanger->isPartial(id))
+    {
+        auto packer = particlePackers[id].get();
+        packer->update(hov, stream);
+
+        const int nSendParticles = helper->send.offsets[helper->nBuffers];
+        const int nthreads = 128;
+
+        SAFE_KERNEL_LAUNCH(
+            ObjectReverseExchangerKernels::reversePackParticles,
+            getNblocks(nSendParticles, nthreads), nthreads, 0, stream,
+            helper->wrapSendData(), packer->handler(),
+            entangledHaloExchanger->getHaloParticleIds(id).devPtr() );
+
+        debug2("Will send back data for %d particles", nSendParticles);
+        return;
+    }
+
+    auto packer = packers[id].get();
+    packer->update(hov, stream);
+
     const auto& offsets = helper->send.offsets;
     const int nSendObj = offsets[helper->nBuffers];
     
@@ -159,12 +221,28 @@ void ObjectReverseExchanger::combineAndUploadData(int id, cudaStream_t stream)
     auto ov       = objects[id];
     auto lov      = ov->local();
     auto helper   =   helpers[id].get();
-    auto unpacker = unpackers[id].get();
 
-    unpacker->update(lov, stream);
-    
     int totalRecvd = helper->recv.offsets[helper->nBuffers];
     auto& map = entangledHaloExchanger->getMap(id);
+
+    if (entangledHaloExchanger->isPartial(id))
+    {
+        auto unpacker = particleUnpackers[id].get();
+        unpacker->update(lov, stream);
+
+        debug("Updating data for %d '%s' particles", totalRecvd, ov->name.c_str());
+
+        const int nthreads = 128;
+        SAFE_KERNEL_LAUNCH(
+            ObjectReverseExchangerKernels::reverseUnpackAndAddParticles,
+            getNblocks(map.size(), nthreads), nthreads, 0, stream,
+            unpacker->handler(), map.devPtr(), map.size(),
+            helper->wrapRecvData());
+        return;
+    }
+
+    auto unpacker = unpackers[id].get();
+    unpacker->update(lov, stream);
     
     debug("Updating data for %d '%s' objects", totalRecvd, ov->name.c_str());
 
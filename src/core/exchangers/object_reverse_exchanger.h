@@ -10,6 +10,7 @@
 class ObjectVector;
 class ObjectHaloExchanger;
 class ObjectPacker;
+class ParticlePacker;
 
 class ObjectReverseExchanger : public Exchanger
 {
@@ -23,6 +24,7 @@ protected:
     std::vector<ObjectVector*> objects;    
     ObjectHaloExchanger *entangledHaloExchanger;
     std::vector<std::unique_ptr<ObjectPacker>> packers, unpackers;        
+    std::vector<std::unique_ptr<ParticlePacker>> particlePackers, particleUnpackers; ///< partial halos
     
     void prepareSizes(int id, cudaStream_t stream) override;
     void prepareData (int id, cudaStream_t stream) override;
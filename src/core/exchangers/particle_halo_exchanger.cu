@@ -24,7 +24,7 @@ namespace ParticleHaloExchangersKernels
 {
 
 template <PackMode packMode>
-__global__ void getHalo(const CellListInfo cinfo, DomainInfo domain,
+__global__ void getHalo(const CellListInfo cinfo, DomainInfo domain, int layers,
                         ParticlePackerHandler packer, BufferOffsetsSizesWrap dataWrap)
 {
     const int gid = blockIdx.x*blockDim.x + threadIdx.x;
@@ -33,7 +33,7 @@ __global__ void getHalo(const CellListInfo cinfo, DomainInfo domain,
     int cid;
     int dx, dy, dz;
 
-    bool valid = distributeThreadsToFaceCell(cid, dx, dy, dz, gid, faceId, cinfo);
+    bool valid = distributeThreadsToFaceCell(cid, dx, dy, dz, gid, faceId, cinfo, layers);
 
     int pstart = valid ? cinfo.cellStarts[cid]   : 0;
     int pend   = valid ? cinfo.cellStarts[cid+1] : 0;
@@ -136,12 +136,20 @@ __global__ void unpackParticles(BufferOffsetsSizesWrap dataWrap, ParticlePackerH
 ParticleHaloExchanger::ParticleHaloExchanger() = default;
 ParticleHaloExchanger::~ParticleHaloExchanger() = default;
 
-void ParticleHaloExchanger::attach(ParticleVector *pv, CellList *cl, const std::vector<std::string>& extraChannelNames)
+void ParticleHaloExchanger::attach(ParticleVector *pv, CellList *cl, float rc, const std::vector<std::string>& extraChannelNames)
 {
     const int id = particles.size();
     particles.push_back(pv);
     cellLists.push_back(cl);
 
+    // the cells may be smaller than the cut-off: send several layers of cells in that case
+    const int layers = cl->getNeighbourSpan(rc);
+    haloLayers.push_back(layers);
+
+    if (2 * layers > std::min({cl->ncells.x, cl->ncells.y, cl->ncells.z}))
+        warn("Particle halo exchanger: local domain of pv '%s' is too small for the cut-off %g",
+             pv->name.c_str(), rc);
+
     auto channels = extraChannelNames;
     channels.push_back(ChannelNames::positions);
     channels.push_back(ChannelNames::velocities);
@@ -162,8 +170,8 @@ void ParticleHaloExchanger::attach(ParticleVector *pv, CellList *cl, const std::
     std::string msg_channels = channels.empty() ? "no channels." : "with channels: ";
     for (const auto& ch : channels) msg_channels += "'" + ch + "' ";
     
-    info("Particle halo exchanger takes pv '%s' with celllist of rc = %g, %s",
-         pv->name.c_str(), cl->rc, msg_channels.c_str());
+    info("Particle halo exchanger takes pv '%s' with celllist of rc = %g (%d layers for rc = %g), %s",
+         pv->name.c_str(), cl->rc, layers, rc, msg_channels.c_str());
 }
 
 void ParticleHaloExchanger::prepareSizes(int id, cudaStream_t stream)
@@ -172,6 +180,7 @@ void ParticleHaloExchanger::prepareSizes(int id, cudaStream_t stream)
     auto cl = cellLists[id];
     auto helper = helpers[id].get();
     auto packer = packers[id].get();
+    const int layers = haloLayers[id];
 
     debug2("Counting halo particles of '%s'", pv->name.c_str());
 
@@ -185,12 +194,12 @@ void ParticleHaloExchanger::prepareSizes(int id, cudaStream_t stream)
         const int maxdim = std::max({cl->ncells.x, cl->ncells.y, cl->ncells.z});
         const int nthreads = 64;
         const int nfaces   = 6;
-        const dim3 nblocks = dim3(getNblocks(maxdim*maxdim, nthreads), nfaces, 1);
+        const dim3 nblocks = dim3(getNblocks(layers*maxdim*maxdim, nthreads), nfaces, 1);
 
         SAFE_KERNEL_LAUNCH(
             ParticleHaloExchangersKernels::getHalo<PackMode::Query>,
             nblocks, nthreads, 0, stream,
-            cl->cellInfo(), pv->state->domain,
+            cl->cellInfo(), pv->state->domain, layers,
             packer->handler(), helper->wrapSendData() );
     }
 
@@ -203,6 +212,7 @@ void ParticleHaloExchanger::prepareData(int id, cudaStream_t stream)
     auto cl = cellLists[id];
     auto helper = helpers[id].get();
     auto packer = packers[id].get();
+    const int layers = haloLayers[id];
 
     int nEntities = helper->send.offsets[helper->nBuffers];
     
@@ -215,7 +225,7 @@ void ParticleHaloExchanger::prepareData(int id, cudaStream_t stream)
         const int maxdim = std::max({cl->ncells.x, cl->ncells.y, cl->ncells.z});
         const int nthreads = 64;
         const int nfaces   = 6;
-        const dim3 nblocks = dim3(getNblocks(maxdim*maxdim, nthreads), nfaces, 1);
+        const dim3 nblocks = dim3(getNblocks(layers*maxdim*maxdim, nthreads), nfaces, 1);
 
         helper->resizeSendBuf();
         helper->send.sizes.clearDevice(stream);
@@ -223,7 +233,7 @@ void ParticleHaloExchanger::prepareData(int id, cudaStream_t stream)
         SAFE_KERNEL_LAUNCH(
             ParticleHaloExchangersKernels::getHalo<PackMode::Pack>,
             nblocks, nthreads, 0, stream,
-            cl->cellInfo(), pv->state->domain,
+            cl->cellInfo(), pv->state->domain, layers,
             packer->handler(), helper->wrapSendData() );
     }
 }
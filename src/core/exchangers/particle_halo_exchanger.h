@@ -12,10 +12,11 @@ public:
     ParticleHaloExchanger();
     ~ParticleHaloExchanger();
     
-    void attach(ParticleVector *pv, CellList *cl, const std::vector<std::string>& extraChannelNames);
+    void attach(ParticleVector *pv, CellList *cl, float rc, const std::vector<std::string>& extraChannelNames);
 
 private:
     std::vector<CellList*> cellLists;
+    std::vector<int> haloLayers;
     std::vector<ParticleVector*> particles;
     std::vector<std::unique_ptr<ParticlePacker>> packers, unpackers;
 
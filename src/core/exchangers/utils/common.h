@@ -1,10 +1,11 @@
 #pragma once
 
+#include <core/pvs/packers/rigid.h>
 #include <core/pvs/packers/rods.h>
 
 #include <extern/variant/include/mpark/variant.hpp>
 
-using VarPackHandler = mpark::variant<ObjectPackerHandler, RodPackerHandler>;
+using VarPackHandler = mpark::variant<ObjectPackerHandler, RodPackerHandler, RigidPackerHandler>;
 
 namespace ExchangersCommon
 {
@@ -32,9 +33,11 @@ __device__ inline float3 getShift(float3 L, int3 dir)
 
 inline VarPackHandler getHandler(ObjectPacker *packer)
 {
-    auto rod = dynamic_cast<RodPacker*>(packer);
+    auto rod   = dynamic_cast<RodPacker*>  (packer);
+    auto rigid = dynamic_cast<RigidPacker*>(packer);
 
-    if (rod) return rod->handler();
+    if (rod)   return rod->handler();
+    if (rigid) return rigid->handler();
     return packer->handler();
 }
 
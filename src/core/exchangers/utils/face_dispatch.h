@@ -11,9 +11,12 @@
  * @param dx: returned direction (-1, 0 or 1) along x
  * @param dy: returned direction (-1, 0 or 1) along y
  * @param dz: returned direction (-1, 0 or 1) along z
+ * @param layers: thickness of the face in cells; 
+ *                the first layers*faceSize threads are participating
  * @return true if the thread is participating, false otherwise
  */
-__device__ inline bool distributeThreadsToFaceCell(int& cid, int& dx, int& dy, int& dz, int gid, int faceId, CellListInfo cinfo)
+__device__ inline bool distributeThreadsToFaceCell(int& cid, int& dx, int& dy, int& dz, int gid, int faceId, CellListInfo cinfo,
+                                                   int layers = 1)
 {
     const int3 ncells = cinfo.ncells;
 
@@ -21,41 +24,46 @@ __device__ inline bool distributeThreadsToFaceCell(int& cid, int& dx, int& dy, i
 
     if (faceId <= 1)  // x
     {
-        if (gid >= ncells.y * ncells.z) valid = false;
-        dx = faceId * (ncells.x - 1);
-        dy = gid % ncells.y;
-        dz = gid / ncells.y;
+        const int layer = gid / (ncells.y * ncells.z);
+        const int fid   = gid % (ncells.y * ncells.z);
+        if (layer >= layers) valid = false;
+        dx = faceId == 0 ? layer : ncells.x - 1 - layer;
+        dy = fid % ncells.y;
+        dz = fid / ncells.y;
     }
     else if (faceId <= 3)  // y
     {
-        if (gid >= ncells.x * ncells.z) valid = false;
-        dx = gid % ncells.x;
-        dy = (faceId - 2) * (ncells.y - 1);
-        dz = gid / ncells.x;
+        const int layer = gid / (ncells.x * ncells.z);
+        const int fid   = gid % (ncells.x * ncells.z);
+        if (layer >= layers) valid = false;
+        dx = fid % ncells.x;
+        dy = faceId == 2 ? layer : ncells.y - 1 - layer;
+        dz = fid / ncells.x;
     }
     else   // z
     {
-        if (gid >= ncells.x * ncells.y) valid = false;
-        dx = gid % ncells.x;
-        dy = gid / ncells.x;
-        dz = (faceId - 4) * (ncells.z - 1);
+        const int layer = gid / (ncells.x * ncells.y);
+        const int fid   = gid % (ncells.x * ncells.y);
+        if (layer >= layers) valid = false;
+        dx = fid % ncells.x;
+        dy = fid / ncells.x;
+        dz = faceId == 4 ? layer : ncells.z - 1 - layer;
     }
 
-    cid = cinfo.encode(dx, dy, dz);
-
-    valid &= cid < cinfo.totcells;
+    valid &= dx >= 0 && dx < ncells.x && dy >= 0 && dy < ncells.y && dz >= 0 && dz < ncells.z;
+    cid = valid ? cinfo.encode(dx, dy, dz) : -1;
 
     // Find side directions
-    if (dx == 0) dx = -1;
-    else if (dx == ncells.x-1) dx = 1;
+    if (dx < layers) dx = -1;
+    else if (dx >= ncells.x - layers) dx = 1;
     else dx = 0;
 
-    if (dy == 0) dy = -1;
-    else if (dy == ncells.y-1) dy = 1;
+    if (dy < layers) dy = -1;
+    else if (dy >= ncells.y - layers) dy = 1;
     else dy = 0;
 
-    if (dz == 0) dz = -1;
-    else if (dz == ncells.z-1) dz = 1;
+    if (dz < layers) dz = -1;
+    else if (dz >= ncells.z - layers) dz = 1;
     else dz = 0;
 
     // Exclude cells already covered by other faceIds
@@ -2,8 +2,11 @@
 
 #include <fstream>
 #include <texture_types.h>
-#include <core/utils/kernel_launch.h>
+#include <core/utils/cache.h>
 #include <core/utils/cuda_common.h>
+#include <core/utils/folders.h>
+#include <core/utils/kernel_launch.h>
+#include <plugins/utils/simple_serializer.h>
 
 namespace InterpolateKernels
 {
@@ -264,9 +267,29 @@ static LocalSdfPiece prepareRelevantSdfPiece(const std::vector<float>& fullSdfDa
     return sdfPiece;
 }
 
-FieldFromFile::FieldFromFile(const MirState *state, std::string name, std::string fieldFileName, float3 h) :
+static std::string getCacheFileName(const std::string& fieldFileName, const std::string& cacheFolder,
+                                    const DomainInfo& domain, float3 h, int3 resolution, const MPI_Comm& comm)
+{
+    constexpr int root = 0;
+    Cache::Key key;
+
+    // only the root hashes the file, the key is then extended per rank
+    if (getRank(comm) == root)
+        key.addFileContents(fieldFileName);
+    MPI_Check( MPI_Bcast(&key, sizeof(key), MPI_BYTE, root, comm) );
+
+    key.add(domain.globalSize).add(domain.globalStart).add(domain.localSize)
+        .add(h).add(resolution).add(getNranks(comm));
+
+    createFoldersCollective(comm, cacheFolder);
+    return Cache::rankFileName(cacheFolder, "field", key, comm);
+}
+
+FieldFromFile::FieldFromFile(const MirState *state, std::string name, std::string fieldFileName, float3 h,
+                             std::string cacheFolder) :
     Field(state, name, h),
-    fieldFileName(fieldFileName)
+    fieldFileName(fieldFileName),
+    cacheFolder(cacheFolder)
 {}
 
 FieldFromFile::~FieldFromFile() = default;
@@ -290,6 +313,14 @@ void FieldFromFile::setup(const MPI_Comm& comm)
     MPI_Check( MPI_Comm_size(comm, &nranks) );
     MPI_Check( MPI_Comm_rank(comm, &rank) );
 
+    std::string cacheFileName;
+    if (!cacheFolder.empty())
+    {
+        cacheFileName = getCacheFileName(fieldFileName, cacheFolder, domain, h, resolution, comm);
+        if (loadFromCache(cacheFileName, comm))
+            return;
+    }
+
     // Read header
     auto headerInfo = readHeader(fieldFileName, comm);
     const float3 initialSdfH = domain.globalSize / make_float3(headerInfo.resolution-1);
@@ -322,4 +353,48 @@ void FieldFromFile::setup(const MPI_Comm& comm)
             fieldRawData.devPtr(), resolution, h, sdfPiece.offset, lenScalingFactor );
 
     setupArrayTexture(fieldRawData.devPtr());
+
+    if (!cacheFolder.empty())
+        storeToCache(cacheFileName, fieldRawData.devPtr());
+}
+
+bool FieldFromFile::loadFromCache(const std::string& cacheFileName, const MPI_Comm& comm)
+{
+    std::vector<char> blob;
+    PinnedBuffer<float> fieldRawData;
+    int3 cachedResolution {0, 0, 0};
+
+    bool found = Cache::load(cacheFileName, blob);
+    if (found)
+    {
+        SimpleSerializer::deserialize(blob, cachedResolution, fieldRawData);
+        found = cachedResolution.x == resolution.x &&
+                cachedResolution.y == resolution.y &&
+                cachedResolution.z == resolution.z &&
+                fieldRawData.size() == multiplyComps(resolution);
+    }
+
+    // the other path is collective, all the ranks must agree
+    if (!Cache::allRanks(comm, found))
+    {
+        info("Field '%s': no complete cache entry, reading '%s'", name.c_str(), fieldFileName.c_str());
+        return false;
+    }
+
+    info("Field '%s': using cached interpolated field '%s'", name.c_str(), cacheFileName.c_str());
+    fieldRawData.uploadToDevice(defaultStream);
+    setupArrayTexture(fieldRawData.devPtr());
+    return true;
+}
+
+void FieldFromFile::storeToCache(const std::string& cacheFileName, const float *fieldDevPtr)
+{
+    PinnedBuffer<float> fieldRawData(multiplyComps(resolution));
+    CUDA_Check( cudaMemcpy(fieldRawData.hostPtr(), fieldDevPtr, fieldRawData.size() * sizeof(float), cudaMemcpyDeviceToHost) );
+
+    std::vector<char> blob;
+    SimpleSerializer::serialize(blob, resolution, fieldRawData);
+    Cache::store(cacheFileName, blob);
+
+    debug("Field '%s': stored interpolated field in '%s'", name.c_str(), cacheFileName.c_str());
 }
@@ -3,7 +3,8 @@
 class FieldFromFile : public Field
 {
 public:    
-    FieldFromFile(const MirState *state, std::string name, std::string fieldFileName, float3 h);
+    FieldFromFile(const MirState *state, std::string name, std::string fieldFileName, float3 h,
+                  std::string cacheFolder = "");
     ~FieldFromFile();
 
     FieldFromFile(FieldFromFile&&);
@@ -13,4 +14,9 @@ public:
 protected:
     
     std::string fieldFileName;
+    std::string cacheFolder; ///< if not empty, interpolated per-rank pieces are stored there and reused
+
+private:
+    bool loadFromCache(const std::string& cacheFileName, const MPI_Comm& comm);
+    void storeToCache(const std::string& cacheFileName, const float *fieldDevPtr);
 };
@@ -4,11 +4,27 @@
 #include <core/pvs/particle_vector.h>
 #include <core/utils/quaternion.h>
 
+#include <algorithm>
 #include <fstream>
 #include <random>
 
-MembraneIC::MembraneIC(const std::vector<ComQ>& com_q, float globalScale) :
-    com_q(com_q),
+MembraneIC::MembraneIC(const std::vector<ComQ>& com_q, float globalScale,
+                       const std::vector<int>& meshTypes) :
+    positions(com_q),
+    globalScale(globalScale),
+    meshTypes(meshTypes)
+{
+    if (!meshTypes.empty() && meshTypes.size() != com_q.size())
+        die("Membrane IC: got %d mesh types for %d objects", (int) meshTypes.size(), (int) com_q.size());
+}
+
+MembraneIC::MembraneIC(std::shared_ptr<ObjectPacking> packing, float globalScale, const std::string& saveTo) :
+    positions(packing, saveTo),
+    globalScale(globalScale)
+{}
+
+MembraneIC::MembraneIC(const std::string& comqFileName, float globalScale) :
+    positions(comqFileName),
     globalScale(globalScale)
 {}
 
@@ -29,10 +45,15 @@ MembraneIC::~MembraneIC() = default;
  * shifted to the COM and rotated according to Q.
  *
  * The RBCs with COM outside of an MPI process's domain will be discarded on
- * that process.
+ * that process. Generated or read in parallel, each process only gets its own
+ * RBCs, see ObjectPositions.
  *
  * Set unique id to all the particles and also write unique cell ids into
  * 'ids' per-object channel
+ *
+ * With a mesh of several types, the particles beyond the vertices of the type
+ * of an object are marked placeholders, and the types are written into the
+ * 'mesh_types' per-object channel
  */
 void MembraneIC::exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream)
 {
@@ -42,43 +63,80 @@ void MembraneIC::exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t str
     if (ov == nullptr)
         die("RBCs can only be generated out of rbc object vectors");
 
+    const auto mesh = static_cast<const MembraneMesh*>(ov->mesh.get());
+    const int ntypes = mesh->getNtypes();
+    const int objSize = mesh->getNvertices();
+
+    if (ntypes == 1 && !meshTypes.empty())
+        die("Mesh types given for the membranes '%s' with a single mesh", ov->name.c_str());
+
+    const auto local = positions.getLocal(comm, domain);
+    const float scale = globalScale * local.scale;
+
+    if (local.scale < 1.0f)
+        info("The membranes '%s' are placed at %g of their size", ov->name.c_str(), local.scale);
+
+    std::vector<int> localTypes;
+
     // Local number of objects
     int nObjs=0;
 
-    for (auto& entry : com_q)
+    for (size_t k = 0; k < local.com_q.size(); ++k)
     {
+        const auto& entry = local.com_q[k];
+        const int objId = local.ids[k];
         float3 com = entry.r;
         float4 q   = entry.q;
 
+        const int type = (meshTypes.empty() || objId < 0) ? 0 : meshTypes[objId];
+        if (type < 0 || type >= ntypes)
+            die("Membrane %d of '%s' has mesh type %d, expected a type in [0, %d)",
+                objId, ov->name.c_str(), type, ntypes);
+
+        const int nvertices = mesh->getMeshType(type).getNvertices();
+
         q = normalize(q);
 
-        if (domain.globalStart.x <= com.x && com.x < domain.globalStart.x + domain.localSize.x &&
-            domain.globalStart.y <= com.y && com.y < domain.globalStart.y + domain.localSize.y &&
-            domain.globalStart.z <= com.z && com.z < domain.globalStart.z + domain.localSize.z)
+        com = domain.global2local(com);
+        const int oldSize = ov->local()->size();
+        ov->local()->resize(oldSize + objSize, stream);
+
+        auto& pos = ov->local()->positions();
+        auto& vel = ov->local()->velocities();
+        
+        for (int i = 0; i < objSize; i++)
         {
-            com = domain.global2local(com);
-            const int oldSize = ov->local()->size();
-            ov->local()->resize(oldSize + ov->mesh->getNvertices(), stream);
-
-            auto& pos = ov->local()->positions();
-            auto& vel = ov->local()->velocities();
-            
-            for (int i = 0; i < ov->mesh->getNvertices(); i++)
-            {
-                const float3 r = Quaternion::rotate(make_float3( ov->mesh->vertexCoordinates[i] * globalScale ), q) + com;
-                const Particle p {{r.x, r.y, r.z, 0.f}, make_float4(0.f)};
+            Particle p {make_float4(0.f), make_float4(0.f)};
 
-                pos[oldSize + i] = p.r2Float4();
-                vel[oldSize + i] = p.u2Float4();
+            if (i < nvertices)
+            {
+                const float4 vertex = mesh->vertexCoordinates[type * objSize + i];
+                const float3 r = Quaternion::rotate(make_float3( vertex * scale ), q) + com;
+                p.r = r;
+            }
+            else
+            {
+                p.mark();
             }
 
-            nObjs++;
+            pos[oldSize + i] = p.r2Float4();
+            vel[oldSize + i] = p.u2Float4();
         }
+
+        localTypes.push_back(type);
+        nObjs++;
     }
 
     ov->local()->positions().uploadToDevice(stream);
     ov->local()->velocities().uploadToDevice(stream);
     ov->local()->computeGlobalIds(comm, stream);
+
+    if (ntypes > 1)
+    {
+        auto types = ov->local()->dataPerObject.getData<int>(ChannelNames::meshTypes);
+        std::copy(localTypes.begin(), localTypes.end(), types->begin());
+        types->uploadToDevice(stream);
+    }
     ov->local()->dataPerParticle.getData<float4>(ChannelNames::oldPositions)->copy(ov->local()->positions(), stream);
 
     info("Initialized %d '%s' membranes", nObjs, ov->name.c_str());
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "interface.h"
+#include "object_positions.h"
 
 #include <core/datatypes.h>
 
+#include <memory>
 #include <mpi.h>
 #include <string>
 #include <vector>
@@ -17,12 +19,22 @@ class ParticleVector;
 class MembraneIC : public InitialConditions
 {
 public:
-    MembraneIC(const std::vector<ComQ>& com_q, float globalScale = 1.0f);
+    /// meshTypes gives the mesh type of each object, all the objects are of type 0 if it is empty
+    MembraneIC(const std::vector<ComQ>& com_q, float globalScale = 1.0f,
+               const std::vector<int>& meshTypes = {});
+
+    /// objects generated in parallel, saved to saveTo unless empty; they are scaled down if the packing did not reach full size
+    MembraneIC(std::shared_ptr<ObjectPacking> packing, float globalScale = 1.0f, const std::string& saveTo = "");
+
+    /// objects read from a file written by a packing, see ObjectPositions
+    MembraneIC(const std::string& comqFileName, float globalScale = 1.0f);
+
     ~MembraneIC();
 
     void exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream) override;
 
 private:
-    std::vector<ComQ> com_q;
+    ObjectPositions positions;
     float globalScale;
+    std::vector<int> meshTypes;
 };
@@ -0,0 +1,199 @@
+#include "object_positions.h"
+
+#include <core/logger.h>
+#include <core/utils/cuda_common.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+ObjectPositions::ObjectPositions(const std::vector<ComQ>& com_q) :
+    com_q(com_q)
+{}
+
+ObjectPositions::ObjectPositions(std::shared_ptr<ObjectPacking> packing, const std::string& saveTo) :
+    packing(packing),
+    saveTo(saveTo)
+{
+    if (packing == nullptr)
+        die("Object positions: got an empty packing");
+}
+
+ObjectPositions::ObjectPositions(const std::string& fileName) :
+    fileName(fileName)
+{}
+
+ObjectPositions::Local ObjectPositions::getLocal(const MPI_Comm& comm, const DomainInfo& domain) const
+{
+    Local local;
+    local.scale = 1.0f;
+
+    if (packing)
+    {
+        auto result = packing->generate(comm, domain);
+        local.com_q = std::move(result.com_q);
+        local.scale = result.scale;
+
+        if (!saveTo.empty())
+            write(comm, saveTo, local.com_q, local.scale);
+    }
+    else if (!fileName.empty())
+    {
+        return readLocal(comm, domain, fileName);
+    }
+    else
+    {
+        for (size_t i = 0; i < com_q.size(); ++i)
+        {
+            if (domain.inSubDomain(com_q[i].r))
+            {
+                local.com_q.push_back(com_q[i]);
+                local.ids.push_back(i);
+            }
+        }
+        return local;
+    }
+
+    local.ids.assign(local.com_q.size(), -1);
+    return local;
+}
+
+static const char fileMagic[8] = {'M', 'I', 'R', 'C', 'O', 'M', 'Q', '\0'};
+static constexpr int floatsPerObject = 7;
+static constexpr MPI_Offset headerSize = sizeof(fileMagic) + sizeof(int64_t) + sizeof(float);
+
+void ObjectPositions::write(const MPI_Comm& comm, const std::string& fileName, const std::vector<ComQ>& local, float scale)
+{
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
+
+    int64_t n = local.size(), offset = 0, total = 0;
+    MPI_Check( MPI_Exscan(&n, &offset, 1, MPI_INT64_T, MPI_SUM, comm) );
+    MPI_Check( MPI_Allreduce(&n, &total, 1, MPI_INT64_T, MPI_SUM, comm) );
+    if (rank == 0) offset = 0;
+
+    std::vector<float> data;
+    data.reserve(n * floatsPerObject);
+    for (const auto& o : local)
+        data.insert(data.end(), {o.r.x, o.r.y, o.r.z, o.q.x, o.q.y, o.q.z, o.q.w});
+
+    MPI_File f;
+    MPI_Check( MPI_File_open(comm, fileName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &f) );
+    MPI_Check( MPI_File_set_size(f, 0) );
+
+    if (rank == 0)
+    {
+        char header[headerSize];
+        memcpy(header, fileMagic, sizeof(fileMagic));
+        memcpy(header + sizeof(fileMagic), &total, sizeof(total));
+        memcpy(header + sizeof(fileMagic) + sizeof(total), &scale, sizeof(scale));
+        MPI_Check( MPI_File_write_at(f, 0, header, headerSize, MPI_BYTE, MPI_STATUS_IGNORE) );
+    }
+
+    const MPI_Offset start = headerSize + offset * floatsPerObject * sizeof(float);
+    MPI_Check( MPI_File_write_at_all(f, start, data.data(), data.size(), MPI_FLOAT, MPI_STATUS_IGNORE) );
+    MPI_Check( MPI_File_close(&f) );
+
+    info("Wrote %lld objects at scale %g to '%s'", static_cast<long long>(total), scale, fileName.c_str());
+}
+
+ObjectPositions::Local ObjectPositions::readLocal(const MPI_Comm& comm, const DomainInfo& domain, const std::string& fileName)
+{
+    int rank, nranks;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
+    MPI_Check( MPI_Comm_size(comm, &nranks) );
+
+    MPI_File f;
+    if (MPI_File_open(comm, fileName.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &f) != MPI_SUCCESS)
+        die("Could not open the objects file '%s'", fileName.c_str());
+
+    char header[headerSize];
+    MPI_Check( MPI_File_read_at_all(f, 0, header, headerSize, MPI_BYTE, MPI_STATUS_IGNORE) );
+
+    if (memcmp(header, fileMagic, sizeof(fileMagic)) != 0)
+        die("'%s' is not an objects file", fileName.c_str());
+
+    int64_t total;
+    float scale;
+    memcpy(&total, header + sizeof(fileMagic), sizeof(total));
+    memcpy(&scale, header + sizeof(fileMagic) + sizeof(total), sizeof(scale));
+
+    if (total < 0 || !(scale > 0.0f && scale <= 1.0f))
+        die("Corrupted objects file '%s': %lld objects at scale %g",
+            fileName.c_str(), static_cast<long long>(total), scale);
+
+    // contiguous part of the file for this rank
+    const int64_t begin = total * rank / nranks;
+    const int64_t end   = total * (rank + 1) / nranks;
+
+    std::vector<float> data((end - begin) * floatsPerObject);
+    const MPI_Offset start = headerSize + begin * floatsPerObject * sizeof(float);
+    MPI_Check( MPI_File_read_at_all(f, start, data.data(), data.size(), MPI_FLOAT, MPI_STATUS_IGNORE) );
+    MPI_Check( MPI_File_close(&f) );
+
+    // send each object to the rank of its subdomain
+    int dims[3], periods[3], coords[3];
+    MPI_Check( MPI_Cart_get(comm, 3, dims, periods, coords) );
+
+    auto owner = [&](const float *v)
+    {
+        const float r[3] = {v[0], v[1], v[2]};
+        const float G[3] = {domain.globalSize.x, domain.globalSize.y, domain.globalSize.z};
+        int c[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            const float x = r[i] - std::floor(r[i] / G[i]) * G[i];
+            c[i] = std::min(dims[i] - 1, static_cast<int>(x / G[i] * dims[i]));
+        }
+
+        int dest;
+        MPI_Check( MPI_Cart_rank(comm, c, &dest) );
+        return dest;
+    };
+
+    std::vector< std::vector<float> > outgoing(nranks);
+    for (size_t i = 0; i < data.size(); i += floatsPerObject)
+    {
+        auto& buf = outgoing[owner(&data[i])];
+        buf.insert(buf.end(), &data[i], &data[i] + floatsPerObject);
+    }
+
+    std::vector<int> sendCounts(nranks), recvCounts(nranks), sendDispls(nranks), recvDispls(nranks);
+    std::vector<float> sendBuf;
+    for (int i = 0; i < nranks; ++i)
+    {
+        sendCounts[i] = outgoing[i].size();
+        sendDispls[i] = sendBuf.size();
+        sendBuf.insert(sendBuf.end(), outgoing[i].begin(), outgoing[i].end());
+    }
+
+    MPI_Check( MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm) );
+
+    int recvTotal = 0;
+    for (int i = 0; i < nranks; ++i)
+    {
+        recvDispls[i] = recvTotal;
+        recvTotal += recvCounts[i];
+    }
+
+    std::vector<float> recvBuf(recvTotal);
+    MPI_Check( MPI_Alltoallv(sendBuf.data(), sendCounts.data(), sendDispls.data(), MPI_FLOAT,
+                             recvBuf.data(), recvCounts.data(), recvDispls.data(), MPI_FLOAT, comm) );
+
+    Local local;
+    local.scale = scale;
+    for (int i = 0; i < recvTotal; i += floatsPerObject)
+    {
+        const float *v = &recvBuf[i];
+        float3 r {v[0], v[1], v[2]};
+        r -= domain.globalSize * floorf(r / domain.globalSize);
+        local.com_q.push_back({r, {v[3], v[4], v[5], v[6]}});
+    }
+    local.ids.assign(local.com_q.size(), -1);
+
+    debug("Read %d objects of the local subdomain out of %lld from '%s'",
+          static_cast<int>(local.com_q.size()), static_cast<long long>(total), fileName.c_str());
+
+    return local;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "packing.h"
+
+#include <core/datatypes.h>
+#include <core/domain.h>
+
+#include <memory>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+/**
+ * Centers of mass and orientations of the objects created by an initial condition.
+ * They are either given as a list, known to all the ranks,
+ * generated in parallel by an ObjectPacking, or read from a file written by a previous packing.
+ * In the last two cases, each rank only holds the objects of its subdomain.
+ */
+class ObjectPositions
+{
+public:
+    ObjectPositions(const std::vector<ComQ>& com_q);
+
+    /// the generated objects are written to saveTo, unless it is empty
+    ObjectPositions(std::shared_ptr<ObjectPacking> packing, const std::string& saveTo = "");
+
+    ObjectPositions(const std::string& fileName);
+
+    struct Local
+    {
+        std::vector<ComQ> com_q; ///< centers in global coordinates
+        std::vector<int> ids;    ///< index in the given list of each object, -1 if there is no list
+        float scale;             ///< size of the objects relative to their template
+    };
+
+    /// objects whose center of mass is in the local subdomain; collective over the Cartesian communicator comm
+    Local getLocal(const MPI_Comm& comm, const DomainInfo& domain) const;
+
+    /**
+     * Parallel binary file of the objects: a header with the total number of objects and the scale
+     * reached by the packing, then 7 floats per object (center of mass and quaternion).
+     * Collective; the objects are written in the order of the ranks.
+     */
+    static void write(const MPI_Comm& comm, const std::string& fileName, const std::vector<ComQ>& local, float scale);
+
+    /// each rank reads a contiguous part of the file and sends the objects to the ranks that own them
+    static Local readLocal(const MPI_Comm& comm, const DomainInfo& domain, const std::string& fileName);
+
+private:
+    std::vector<ComQ> com_q;
+    std::shared_ptr<ObjectPacking> packing;
+    std::string saveTo;
+    std::string fileName;
+};
@@ -0,0 +1,478 @@
+#include "packing.h"
+
+#include <core/logger.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/quaternion.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+ObjectPacking::ObjectPacking(float3 axes, float numberDensity, float initialScale,
+                             int growthSteps, int maxAttempts, long seed) :
+    axes(axes),
+    numberDensity(numberDensity),
+    initialScale(initialScale),
+    growthSteps(growthSteps),
+    maxAttempts(maxAttempts),
+    seed(seed)
+{
+    if (axes.x <= 0.f || axes.y <= 0.f || axes.z <= 0.f)
+        die("Packing: the semi-axes must be positive, got %g %g %g", axes.x, axes.y, axes.z);
+
+    if (numberDensity <= 0.f)
+        die("Packing: the number density must be positive, got %g", numberDensity);
+
+    if (initialScale <= 0.f || initialScale > 1.f)
+        die("Packing: the initial scale must be in (0, 1], got %g", initialScale);
+
+    if (growthSteps < 0 || maxAttempts < 1)
+        die("Packing: got %d growth steps and %d attempts", growthSteps, maxAttempts);
+}
+
+using Matrix = std::array<double, 9>;
+
+static inline float component(float3 v, int i)
+{
+    return i == 0 ? v.x : (i == 1 ? v.y : v.z);
+}
+
+// R diag(a^2) R^T, the columns of R are the rotated axes
+static Matrix shapeMatrix(float3 axes, float scale, float4 q)
+{
+    const float3 e[3] = {Quaternion::rotate(make_float3(1.f, 0.f, 0.f), q),
+                         Quaternion::rotate(make_float3(0.f, 1.f, 0.f), q),
+                         Quaternion::rotate(make_float3(0.f, 0.f, 1.f), q)};
+
+    Matrix m {};
+    for (int k = 0; k < 3; ++k)
+    {
+        const double a = scale * component(axes, k);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                m[3*i + j] += a * a * component(e[k], i) * component(e[k], j);
+    }
+    return m;
+}
+
+// r^T C^{-1} r for a symmetric positive definite C
+static double inverseQuadraticForm(const Matrix& c, const double r[3])
+{
+    const double c00 = c[4]*c[8] - c[5]*c[7];
+    const double c01 = c[5]*c[6] - c[3]*c[8];
+    const double c02 = c[3]*c[7] - c[4]*c[6];
+    const double c11 = c[0]*c[8] - c[2]*c[6];
+    const double c12 = c[1]*c[6] - c[0]*c[7];
+    const double c22 = c[0]*c[4] - c[1]*c[3];
+
+    const double det = c[0]*c00 + c[1]*c01 + c[2]*c02;
+
+    const double q = r[0]*r[0]*c00 + r[1]*r[1]*c11 + r[2]*r[2]*c22
+        + 2.0 * (r[0]*r[1]*c01 + r[0]*r[2]*c02 + r[1]*r[2]*c12);
+
+    return q / det;
+}
+
+bool ObjectPacking::overlap(float3 axes, float scale, const ComQ& a, const ComQ& b)
+{
+    const float amax = scale * std::max({axes.x, axes.y, axes.z});
+    const float amin = scale * std::min({axes.x, axes.y, axes.z});
+
+    const float3 d = b.r - a.r;
+    const float dist2 = dot(d, d);
+
+    if (dist2 >= 4.f * amax * amax) return false;
+    if (dist2 <  4.f * amin * amin) return true;
+
+    const Matrix A = shapeMatrix(axes, scale, a.q);
+    const Matrix B = shapeMatrix(axes, scale, b.q);
+    const double r[3] = {d.x, d.y, d.z};
+
+    // the ellipsoids are disjoint iff max_l F(l) >= 1, F is concave
+    auto F = [&](double l)
+    {
+        Matrix c;
+        for (int i = 0; i < 9; ++i)
+            c[i] = (1.0 - l) * A[i] + l * B[i];
+        return l * (1.0 - l) * inverseQuadraticForm(c, r);
+    };
+
+    // golden section search
+    const double g = 0.5 * (std::sqrt(5.0) - 1.0);
+    double lo = 0.0, hi = 1.0;
+    double x1 = hi - g * (hi - lo), x2 = lo + g * (hi - lo);
+    double f1 = F(x1), f2 = F(x2);
+
+    for (int iter = 0; iter < 40; ++iter)
+    {
+        if (f1 >= 1.0 || f2 >= 1.0)
+            return false;
+
+        if (f1 < f2)
+        {
+            lo = x1;
+            x1 = x2; f1 = f2;
+            x2 = lo + g * (hi - lo); f2 = F(x2);
+        }
+        else
+        {
+            hi = x2;
+            x2 = x1; f2 = f1;
+            x1 = hi - g * (hi - lo); f1 = F(x1);
+        }
+    }
+    return std::max(f1, f2) < 1.0;
+}
+
+namespace
+{
+
+/// cells of the subdomain, each with the objects whose center is inside, plus one layer of halo cells
+struct CellGrid
+{
+    int3 n;      ///< number of local cells
+    float3 h;    ///< cell size
+    float3 L;    ///< subdomain size
+    int3 start;  ///< global index of the first local cell
+    std::vector< std::vector<ComQ> > cells;
+
+    int index(int3 c) const
+    {
+        return ((c.z + 1) * (n.y + 2) + (c.y + 1)) * (n.x + 2) + (c.x + 1);
+    }
+
+    float3 lowerCorner(int3 c) const
+    {
+        return -0.5f * L + make_float3(c) * h;
+    }
+
+    bool inside(int3 c, float3 r) const
+    {
+        const float3 lo = lowerCorner(c);
+        const float3 hi = lo + h;
+        return lo.x <= r.x && r.x < hi.x &&
+               lo.y <= r.y && r.y < hi.y &&
+               lo.z <= r.z && r.z < hi.z;
+    }
+
+    /// same colored cells do not touch, the total number of cells is even in each direction
+    int color(int3 c) const
+    {
+        const int3 g = start + c;
+        return (g.x & 1) + 2 * (g.y & 1) + 4 * (g.z & 1);
+    }
+
+    template <typename Op>
+    void forEachLocal(Op op) const
+    {
+        for (int z = 0; z < n.z; ++z)
+            for (int y = 0; y < n.y; ++y)
+                for (int x = 0; x < n.x; ++x)
+                    op(make_int3(x, y, z));
+    }
+};
+
+} // anonymous namespace
+
+static int getNcells(float L, float diameter, int nranks)
+{
+    int n = static_cast<int>(std::floor(L / diameter));
+
+    // the colors alternate across the periodic boundaries
+    if ((n * nranks) % 2 != 0)
+        --n;
+
+    return n;
+}
+
+static void exchangeHalo(CellGrid& grid, const MPI_Comm& comm)
+{
+    int dims[3], periods[3], coords[3];
+    MPI_Check( MPI_Cart_get(comm, 3, dims, periods, coords) );
+
+    auto neighbour = [&](int3 d)
+    {
+        int c[3] = {coords[0] + d.x, coords[1] + d.y, coords[2] + d.z};
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!periods[i] && (c[i] < 0 || c[i] >= dims[i]))
+                return MPI_PROC_NULL;
+            c[i] = (c[i] + dims[i]) % dims[i];
+        }
+
+        int rank;
+        MPI_Check( MPI_Cart_rank(comm, c, &rank) );
+        return rank;
+    };
+
+    for (int z = -1; z <= grid.n.z; ++z)
+        for (int y = -1; y <= grid.n.y; ++y)
+            for (int x = -1; x <= grid.n.x; ++x)
+                if (x < 0 || y < 0 || z < 0 || x == grid.n.x || y == grid.n.y || z == grid.n.z)
+                    grid.cells[grid.index({x, y, z})].clear();
+
+    // first and last cell of the local range sent in direction d
+    auto sendRange = [](int d, int n)
+    {
+        return d < 0 ? make_int2(0, 1) : (d > 0 ? make_int2(n - 1, n) : make_int2(0, n));
+    };
+
+    // halo index on the side the objects coming in direction d arrive to
+    auto recvIndex = [](int d, int n, float r, float L, float h)
+    {
+        if (d > 0) return -1;
+        if (d < 0) return n;
+        return std::min(n - 1, std::max(0, static_cast<int>(std::floor((r + 0.5f * L) / h))));
+    };
+
+    constexpr int floatsPerObject = 7;
+    const int tag = 1542;
+
+    std::vector<float> sendBuf, recvBuf;
+
+    for (int dz = -1; dz <= 1; ++dz)
+    for (int dy = -1; dy <= 1; ++dy)
+    for (int dx = -1; dx <= 1; ++dx)
+    {
+        const int3 d {dx, dy, dz};
+        if (dx == 0 && dy == 0 && dz == 0) continue;
+
+        const int2 rx = sendRange(dx, grid.n.x);
+        const int2 ry = sendRange(dy, grid.n.y);
+        const int2 rz = sendRange(dz, grid.n.z);
+
+        // positions in the frame of the receiver
+        const float3 shift = make_float3(d) * grid.L;
+
+        sendBuf.clear();
+        for (int z = rz.x; z < rz.y; ++z)
+            for (int y = ry.x; y < ry.y; ++y)
+                for (int x = rx.x; x < rx.y; ++x)
+                    for (const auto& o : grid.cells[grid.index({x, y, z})])
+                    {
+                        const float3 r = o.r - shift;
+                        sendBuf.insert(sendBuf.end(), {r.x, r.y, r.z, o.q.x, o.q.y, o.q.z, o.q.w});
+                    }
+
+        const int dest = neighbour(d);
+        const int src  = neighbour(make_int3(-dx, -dy, -dz));
+
+        int sendCount = sendBuf.size(), recvCount = 0;
+        MPI_Check( MPI_Sendrecv(&sendCount, 1, MPI_INT, dest, tag,
+                                &recvCount, 1, MPI_INT, src,  tag, comm, MPI_STATUS_IGNORE) );
+
+        recvBuf.resize(recvCount);
+        MPI_Check( MPI_Sendrecv(sendBuf.data(), sendCount, MPI_FLOAT, dest, tag,
+                                recvBuf.data(), recvCount, MPI_FLOAT, src,  tag, comm, MPI_STATUS_IGNORE) );
+
+        for (int i = 0; i < recvCount; i += floatsPerObject)
+        {
+            const float *v = &recvBuf[i];
+            const ComQ o {{v[0], v[1], v[2]}, {v[3], v[4], v[5], v[6]}};
+
+            const int3 c {recvIndex(dx, grid.n.x, o.r.x, grid.L.x, grid.h.x),
+                          recvIndex(dy, grid.n.y, o.r.y, grid.L.y, grid.h.y),
+                          recvIndex(dz, grid.n.z, o.r.z, grid.L.z, grid.h.z)};
+
+            grid.cells[grid.index(c)].push_back(o);
+        }
+    }
+}
+
+/// true if o overlaps with any object of its cell c or the neighbouring cells, except the one at (c, skip)
+static bool overlapsAny(const CellGrid& grid, float3 axes, float scale, const ComQ& o, int3 c, int skip)
+{
+    for (int dz = -1; dz <= 1; ++dz)
+    for (int dy = -1; dy <= 1; ++dy)
+    for (int dx = -1; dx <= 1; ++dx)
+    {
+        const int3 cc = c + make_int3(dx, dy, dz);
+        const auto& cell = grid.cells[grid.index(cc)];
+        const bool self = (dx == 0 && dy == 0 && dz == 0);
+
+        for (int i = 0; i < static_cast<int>(cell.size()); ++i)
+        {
+            if (self && i == skip) continue;
+            if (ObjectPacking::overlap(axes, scale, o, cell[i]))
+                return true;
+        }
+    }
+    return false;
+}
+
+static std::mt19937 cellGenerator(long seed, int3 globalCell, int stage)
+{
+    std::seed_seq seq {static_cast<unsigned>(seed), static_cast<unsigned>(seed >> 32),
+                       static_cast<unsigned>(globalCell.x), static_cast<unsigned>(globalCell.y),
+                       static_cast<unsigned>(globalCell.z), static_cast<unsigned>(stage)};
+    return std::mt19937(seq);
+}
+
+static constexpr int maxSweeps = 10;
+
+static float4 randomQuaternion(std::mt19937& gen)
+{
+    std::normal_distribution<float> normal;
+    float4 q {normal(gen), normal(gen), normal(gen), normal(gen)};
+    return normalize(q);
+}
+
+ObjectPacking::Result ObjectPacking::generate(const MPI_Comm& comm, const DomainInfo& domain) const
+{
+    int dims[3], periods[3], coords[3];
+    MPI_Check( MPI_Cart_get(comm, 3, dims, periods, coords) );
+
+    const float diameter = 2.f * std::max({axes.x, axes.y, axes.z});
+    const float minAxis  = std::min({axes.x, axes.y, axes.z});
+
+    CellGrid grid;
+    grid.L = domain.localSize;
+    grid.n = {getNcells(grid.L.x, diameter, dims[0]),
+              getNcells(grid.L.y, diameter, dims[1]),
+              getNcells(grid.L.z, diameter, dims[2])};
+
+    if (grid.n.x < 1 || grid.n.y < 1 || grid.n.z < 1)
+        die("Packing: the subdomain %g x %g x %g is too small for objects of size %g",
+            grid.L.x, grid.L.y, grid.L.z, diameter);
+
+    grid.h = grid.L / make_float3(grid.n);
+    grid.start = make_int3(coords[0], coords[1], coords[2]) * grid.n;
+    grid.cells.resize((grid.n.x + 2) * (grid.n.y + 2) * (grid.n.z + 2));
+
+    const float cellVolume = grid.h.x * grid.h.y * grid.h.z;
+    const float expected = numberDensity * cellVolume;
+    long requested = 0;
+
+    // random sequential addition at the initial scale
+    for (int color = 0; color < 8; ++color)
+    {
+        grid.forEachLocal([&](int3 c)
+        {
+            if (grid.color(c) != color) return;
+
+            auto gen = cellGenerator(seed, grid.start + c, 0);
+            std::uniform_real_distribution<float> u(0.f, 1.f);
+
+            const int target = static_cast<int>(expected) + (u(gen) < expected - std::floor(expected) ? 1 : 0);
+            const float3 lo = grid.lowerCorner(c);
+            auto& cell = grid.cells[grid.index(c)];
+            requested += target;
+
+            for (int attempt = 0; attempt < maxAttempts * target && static_cast<int>(cell.size()) < target; ++attempt)
+            {
+                ComQ o;
+                o.r = lo + grid.h * make_float3(u(gen), u(gen), u(gen));
+                o.q = randomQuaternion(gen);
+
+                // the float corner may round onto the next cell
+                if (!grid.inside(c, o.r)) continue;
+
+                if (!overlapsAny(grid, axes, initialScale, o, c, -1))
+                    cell.push_back(o);
+            }
+        });
+
+        exchangeHalo(grid, comm);
+    }
+
+    long placed = 0;
+    grid.forEachLocal([&](int3 c) { placed += grid.cells[grid.index(c)].size(); });
+
+    long counts[2] = {placed, requested};
+    MPI_Check( MPI_Allreduce(MPI_IN_PLACE, counts, 2, MPI_LONG, MPI_SUM, comm) );
+
+    if (counts[0] < counts[1])
+        warn("Packing: placed %ld objects out of %ld, increase the number of attempts or lower the initial scale",
+             counts[0], counts[1]);
+    else
+        info("Packing: placed %ld objects at scale %g", counts[0], initialScale);
+
+    // grow the objects, relaxing the ones that overlap at the next scale
+    float scale = initialScale;
+
+    for (int step = 1; step <= growthSteps && scale < 1.f; ++step)
+    {
+        const float next = initialScale + (1.f - initialScale) * step / growthSteps;
+        const float maxMove = 0.5f * next * minAxis;
+        long overlapping = 0;
+
+        // an object may only find room once its neighbours have moved
+        for (int sweep = 0; sweep < maxSweeps; ++sweep)
+        {
+            for (int color = 0; color < 8; ++color)
+            {
+                grid.forEachLocal([&](int3 c)
+                {
+                    if (grid.color(c) != color) return;
+
+                    auto gen = cellGenerator(seed, grid.start + c, step * maxSweeps + sweep);
+                    std::uniform_real_distribution<float> u(-1.f, 1.f);
+                    std::normal_distribution<float> normal(0.f, 0.1f);
+
+                    auto& cell = grid.cells[grid.index(c)];
+
+                    for (int i = 0; i < static_cast<int>(cell.size()); ++i)
+                    {
+                        if (!overlapsAny(grid, axes, next, cell[i], c, i))
+                            continue;
+
+                        for (int attempt = 0; attempt < maxAttempts; ++attempt)
+                        {
+                            ComQ o;
+                            o.r = cell[i].r + maxMove * make_float3(u(gen), u(gen), u(gen));
+                            o.q = normalize(cell[i].q + make_float4(normal(gen), normal(gen), normal(gen), normal(gen)));
+
+                            // the objects stay in their cell, hence on their rank
+                            if (!grid.inside(c, o.r)) continue;
+
+                            if (!overlapsAny(grid, axes, next, o, c, i))
+                            {
+                                cell[i] = o;
+                                break;
+                            }
+                        }
+                    }
+                });
+
+                exchangeHalo(grid, comm);
+            }
+
+            // the objects that did not move were not overlapping at the current scale
+            overlapping = 0;
+            grid.forEachLocal([&](int3 c)
+            {
+                const auto& cell = grid.cells[grid.index(c)];
+                for (int i = 0; i < static_cast<int>(cell.size()); ++i)
+                    if (overlapsAny(grid, axes, next, cell[i], c, i))
+                        ++overlapping;
+            });
+
+            MPI_Check( MPI_Allreduce(MPI_IN_PLACE, &overlapping, 1, MPI_LONG, MPI_SUM, comm) );
+
+            if (overlapping == 0)
+                break;
+        }
+
+        if (overlapping > 0)
+        {
+            info("Packing: %ld objects still overlap at scale %g, stopping the growth at scale %g",
+                 overlapping, next, scale);
+            break;
+        }
+
+        scale = next;
+        debug("Packing: grew the objects to scale %g", scale);
+    }
+
+    Result result;
+    result.scale = scale;
+
+    grid.forEachLocal([&](int3 c)
+    {
+        for (const auto& o : grid.cells[grid.index(c)])
+            result.com_q.push_back({domain.local2global(o.r), o.q});
+    });
+
+    return result;
+}
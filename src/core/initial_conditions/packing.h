@@ -0,0 +1,47 @@
+#pragma once
+
+#include <core/datatypes.h>
+#include <core/domain.h>
+
+#include <mpi.h>
+#include <vector>
+
+/**
+ * Parallel generation of the positions and orientations of non-overlapping objects.
+ *
+ * The objects are approximated by ellipsoids of the given semi-axes.
+ * Each rank only generates the objects of its subdomain: the subdomain is split into cells
+ * at least as large as one object, and the cells are processed in 8 colors such that two
+ * cells of the same color never touch; the objects of the boundary cells are exchanged with
+ * the neighbouring ranks after each color.
+ *
+ * The objects are placed at the initial scale; growth steps then inflate them towards their
+ * full size, moving and rotating the overlapping ones within their cell.
+ * The growth stops at the last scale for which the objects do not overlap.
+ */
+class ObjectPacking
+{
+public:
+    ObjectPacking(float3 axes, float numberDensity, float initialScale = 1.0f,
+                  int growthSteps = 0, int maxAttempts = 100, long seed = 42);
+
+    struct Result
+    {
+        std::vector<ComQ> com_q; ///< objects of the local subdomain, centers in global coordinates
+        float scale;             ///< size of the objects relative to the given axes
+    };
+
+    /// collective over the Cartesian communicator comm
+    Result generate(const MPI_Comm& comm, const DomainInfo& domain) const;
+
+    /// Perram-Wertheim overlap test of two ellipsoids with the given semi-axes, scaled by scale
+    static bool overlap(float3 axes, float scale, const ComQ& a, const ComQ& b);
+
+private:
+    float3 axes;
+    float numberDensity;
+    float initialScale;
+    int growthSteps;
+    int maxAttempts;
+    long seed;
+};
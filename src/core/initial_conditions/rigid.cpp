@@ -37,14 +37,14 @@ RigidIC::RigidIC(const std::vector<ComQ>& com_q, const std::string& xyzfname) :
 {}
 
 RigidIC::RigidIC(const std::vector<ComQ>& com_q, const std::vector<float3>& coords) :
-    com_q(com_q),
+    positions(com_q),
     coords(coords)
 {}
 
 RigidIC::RigidIC(const std::vector<ComQ>& com_q,
                  const std::vector<float3>& coords,
                  const std::vector<float3>& comVelocities) :
-    com_q(com_q),
+    positions(com_q),
     coords(coords),
     comVelocities(comVelocities)
 {
@@ -52,6 +52,17 @@ RigidIC::RigidIC(const std::vector<ComQ>& com_q,
         die("Incompatible sizes of initial positions and rotations");
 }
 
+RigidIC::RigidIC(std::shared_ptr<ObjectPacking> packing, const std::vector<float3>& coords,
+                 const std::string& saveTo) :
+    positions(packing, saveTo),
+    coords(coords)
+{}
+
+RigidIC::RigidIC(const std::string& comqFileName, const std::vector<float3>& coords) :
+    positions(comqFileName),
+    coords(coords)
+{}
+
 RigidIC::~RigidIC() = default;
 
 
@@ -94,30 +105,27 @@ static void checkInitialPositions(const DomainInfo& domain,
 }
 
 static std::vector<RigidMotion> createMotions(const DomainInfo& domain,
-                                              const std::vector<ComQ>& com_q,
+                                              const ObjectPositions::Local& local,
                                               const std::vector<float3>& comVelocities)
 {
     std::vector<RigidMotion> motions;
 
-    for (size_t i = 0; i < com_q.size(); ++i)
+    for (size_t i = 0; i < local.com_q.size(); ++i)
     {
-        const auto& entry = com_q[i];
+        const auto& entry = local.com_q[i];
+        const int id = local.ids[i];
         
         // Zero everything at first
         RigidMotion motion{};
         
-        motion.r = make_rigidReal3( entry.r );
+        motion.r = make_rigidReal3( domain.global2local(entry.r) );
         motion.q = make_rigidReal4( entry.q );
         motion.q = normalize(motion.q);
         
-        if (i < comVelocities.size())
-            motion.vel = {comVelocities[i].x, comVelocities[i].y, comVelocities[i].z};
-
-        if (domain.inSubDomain(motion.r))
-        {
-            motion.r = make_rigidReal3( domain.global2local(make_float3(motion.r)) );
-            motions.push_back(motion);
-        }
+        if (id >= 0 && id < static_cast<int>(comVelocities.size()))
+            motion.vel = {comVelocities[id].x, comVelocities[id].y, comVelocities[id].z};
+
+        motions.push_back(motion);
     }
     return motions;
 }
@@ -149,7 +157,13 @@ void RigidIC::exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream
         die("Object size and XYZ initial conditions don't match in size for '%s': %d vs %d",
             rov->name.c_str(), rov->objSize, rov->initialPositions.size());
 
-    const auto motions = createMotions(domain, com_q, comVelocities);
+    const auto local = positions.getLocal(comm, domain);
+
+    if (local.scale < 1.0f)
+        die("The packing of the rigid objects '%s' only reached %g of their size, "
+            "use more growth steps or a lower number density", rov->name.c_str(), local.scale);
+
+    const auto motions = createMotions(domain, local, comVelocities);
     const auto nObjs = motions.size();
     
     lrov->resize_anew(nObjs * rov->objSize);
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "interface.h"
+#include "object_positions.h"
 
 #include <core/datatypes.h>
 
+#include <memory>
+#include <string>
 #include <vector>
 #include <vector_types.h>
 
@@ -15,12 +18,19 @@ public:
     RigidIC(const std::vector<ComQ>& com_q, const std::vector<float3>& coords,
             const std::vector<float3>& comVelocities);
 
+    /// objects generated in parallel, saved to saveTo unless empty; the packing must reach the full size
+    RigidIC(std::shared_ptr<ObjectPacking> packing, const std::vector<float3>& coords,
+            const std::string& saveTo = "");
+
+    /// objects read from a file written by a packing, see ObjectPositions
+    RigidIC(const std::string& comqFileName, const std::vector<float3>& coords);
+
     void exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream) override;
 
     ~RigidIC();
 
 private:
-    std::vector<ComQ> com_q;
+    ObjectPositions positions;
     std::vector<float3> coords;
     std::vector<float3> comVelocities;
 };
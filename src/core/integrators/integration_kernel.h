@@ -30,7 +30,9 @@ __global__ void integrate(PVviewWithOldParticles pvView, const float dt, Transfo
 
     Particle p(pos, vel);
 
-    transform(p, frc.v, pvView.invMass, dt);
+    // marked particles are placeholders and stay in place
+    if (!p.isMarked())
+        transform(p, frc.v, pvView.invMass, dt);
 
     writeNoCache(pvView.positions  + pid, p.r2Float4());
     writeNoCache(pvView.velocities + pid, p.u2Float4());
@@ -13,7 +13,5 @@ void Integrator::setPrerequisites(__UNUSED ParticleVector *pv)
 
 void Integrator::invalidatePV(ParticleVector *pv)
 {
-    pv->haloValid   = false;
-    pv->redistValid = false;
-    pv->cellListStamp++;
+    pv->invalidate();
 }
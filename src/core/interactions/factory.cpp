@@ -85,7 +85,7 @@ std::shared_ptr<MembraneInteraction>
 InteractionFactory::createInteractionMembrane(const MirState *state, std::string name,
                                               std::string shearDesc, std::string bendingDesc,
                                               const MapParams& parameters,
-                                              bool stressFree, float growUntil)
+                                              bool stressFree, float growUntil, bool deterministic, bool perObject)
 {
     VarBendingParams bendingParams;
     VarShearParams shearParams;
@@ -103,7 +103,7 @@ InteractionFactory::createInteractionMembrane(const MirState *state, std::string
 
     desc.checkAllRead();
     return std::make_shared<MembraneInteraction>
-        (state, name, commonPrms, bendingParams, shearParams, stressFree, growUntil);
+        (state, name, commonPrms, bendingParams, shearParams, stressFree, growUntil, deterministic, perObject);
 }
 
 static RodParameters readRodParameters(ParametersWrap& desc)
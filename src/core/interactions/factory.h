@@ -28,7 +28,7 @@ std::shared_ptr<MembraneInteraction>
 createInteractionMembrane(const MirState *state, std::string name,
                           std::string shearDesc, std::string bendingDesc,
                           const MapParams& parameters,
-                          bool stressFree, float growUntil);
+                          bool stressFree, float growUntil, bool deterministic, bool perObject);
 
 std::shared_ptr<RodInteraction>
 createInteractionRod(const MirState *state, std::string name, std::string stateUpdate,
@@ -15,14 +15,15 @@
 
 namespace MembraneInteractionKernels
 {
-__global__ void computeAreaAndVolume(OVviewWithAreaVolume view, MeshView mesh)
+__global__ void computeAreaAndVolume(OVviewWithAreaVolume view, MembraneMeshView mesh)
 {
     int objId = blockIdx.x;
     int offset = objId * mesh.nvertices;
+    const int3 *triangles = mesh.triangles + mesh.firstTriangle(objId);
     float2 a_v = make_float2(0.0f);
 
     for (int i = threadIdx.x; i < mesh.ntriangles; i += blockDim.x) {
-        int3 ids = mesh.triangles[i];
+        int3 ids = triangles[i];
 
         auto v0 = make_real3(make_float3( view.readPosition(offset + ids.x) ));
         auto v1 = make_real3(make_float3( view.readPosition(offset + ids.y) ));
@@ -32,17 +33,19 @@ __global__ void computeAreaAndVolume(OVviewWithAreaVolume view, MeshView mesh)
         a_v.y += triangleSignedVolume(v0, v1, v2);
     }
 
-    a_v = warpReduce( a_v, [] (float a, float b) { return a+b; } );
+    a_v = blockSum(a_v);
 
-    if (laneId() == 0)
-        atomicAdd(&view.area_volumes[objId], a_v);
+    if (threadIdx.x == 0)
+        view.area_volumes[objId] = a_v;
 }
 } // namespace MembraneInteractionKernels
 
 MembraneInteraction::MembraneInteraction(const MirState *state, std::string name, CommonMembraneParameters commonParams,
                                          VarBendingParams bendingParams, VarShearParams shearParams,
-                                         bool stressFree, float growUntil) :
-    Interaction(state, name, /* default cutoff rc */ 1.0)
+                                         bool stressFree, float growUntil, bool deterministic, bool perObject) :
+    Interaction(state, name, /* default cutoff rc */ 1.0),
+    stressFree(stressFree),
+    perObject(perObject)
 {
     mpark::visit([&](auto bePrms, auto shPrms)
     {                     
@@ -53,14 +56,14 @@ MembraneInteraction::MembraneInteraction(const MirState *state, std::string name
             using TriangleForce = typename decltype(shPrms)::TriangleForce <StressFreeState::Active>;
             
             impl = std::make_unique<MembraneInteractionImpl<TriangleForce, DihedralForce>>
-                (state, name, commonParams, shPrms, bePrms, growUntil);
+                (state, name, commonParams, shPrms, bePrms, growUntil, deterministic, perObject);
         }
         else                         
         {
             using TriangleForce = typename decltype(shPrms)::TriangleForce <StressFreeState::Inactive>;
             
             impl = std::make_unique<MembraneInteractionImpl<TriangleForce, DihedralForce>>
-                (state, name, commonParams, shPrms, bePrms, growUntil);
+                (state, name, commonParams, shPrms, bePrms, growUntil, deterministic, perObject);
         }
         
     }, bendingParams, shearParams);
@@ -77,6 +80,11 @@ void MembraneInteraction::setPrerequisites(ParticleVector *pv1, ParticleVector *
     if (ov == nullptr)
         die("Internal membrane forces can only be computed with a MembraneVector");
 
+    // the equilibrium lengths and areas of each type are only known in the stress-free mode
+    if (ov->mesh->getNtypes() > 1 && !stressFree)
+        die("Membrane forces '%s': the mesh of '%s' has several types, this requires stress_free=True",
+            name.c_str(), ov->name.c_str());
+
     ov->requireDataPerObject<float2>(ChannelNames::areaVolumes, DataManager::PersistenceMode::None);
 
     impl->setPrerequisites(pv1, pv2, cl1, cl2);
@@ -108,6 +116,8 @@ bool MembraneInteraction::isSelfObjectInteraction() const
 
 void MembraneInteraction::precomputeQuantities(ParticleVector *pv1, cudaStream_t stream)
 {
+    if (perObject) return;
+
     auto ov = dynamic_cast<MembraneVector *>(pv1);
 
     if (ov->objSize != ov->mesh->getNvertices())
@@ -119,12 +129,8 @@ void MembraneInteraction::precomputeQuantities(ParticleVector *pv1, cudaStream_t
 
     OVviewWithAreaVolume view(ov, ov->local());
 
-    MembraneMeshView mesh(static_cast<MembraneMesh*>(ov->mesh.get()));
+    MembraneMeshView mesh(static_cast<MembraneMesh*>(ov->mesh.get()), ov->getMeshTypes(ov->local()));
 
-    ov->local()
-        ->dataPerObject.getData<float2>(ChannelNames::areaVolumes)
-        ->clearDevice(stream);
-    
     const int nthreads = 128;
     SAFE_KERNEL_LAUNCH(MembraneInteractionKernels::computeAreaAndVolume,
                        view.nObjects, nthreads, 0, stream,
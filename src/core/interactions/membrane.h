@@ -19,7 +19,8 @@ class MembraneInteraction : public Interaction
 public:
 
     MembraneInteraction(const MirState *state, std::string name, CommonMembraneParameters commonParams,
-                        VarBendingParams bendingParams, VarShearParams shearParams, bool stressFree, float growUntil);
+                        VarBendingParams bendingParams, VarShearParams shearParams, bool stressFree, float growUntil,
+                        bool deterministic = false, bool perObject = false);
     ~MembraneInteraction();
     
     void setPrerequisites(ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2) override;
@@ -34,7 +35,10 @@ protected:
     /**
      * compute quantities used by the force kernels.
      * this is called before every force kernel (see implementation of @ref local)
-     * default: compute area and volume of each cell
+     * default: compute area and volume of each cell, unless they are computed by the per-object force kernel
      */
     virtual void precomputeQuantities(ParticleVector *pv1, cudaStream_t stream);
+
+    bool stressFree; ///< required by meshes of several types
+    bool perObject;  ///< the area and volume are then computed by the force kernel
 };
@@ -64,17 +64,18 @@ __device__ inline real3 _ffluct(real3 v1, real3 v2, int i1, int i2,
     return (mean0var1 * parameters.sigma_rnd / length(x21)) * x21;
 }
 
-template <class TriangleInteraction>
+template <class TriangleInteraction, class View>
 __device__ inline real3 bondTriangleForce(
         const TriangleInteraction& triangleInteraction,
         ParticleReal p, int locId, int rbcId,
-        const OVviewWithAreaVolume& view,
+        const View& view,
         const MembraneMeshView& mesh,
         const GPU_CommonMembraneParameters& parameters)
 {
     real3 f0 = make_real3(0.0_r);
-    const int startId = mesh.maxDegree * locId;
-    const int degree = mesh.degrees[locId];
+    const int meshVertex = mesh.vertexId(rbcId, locId);
+    const int startId = mesh.maxDegree * meshVertex;
+    const int degree = mesh.degrees[meshVertex];
 
     int idv0 = rbcId * mesh.nvertices + locId;
     int idv1 = rbcId * mesh.nvertices + mesh.adjacent[startId];
@@ -83,6 +84,14 @@ __device__ inline real3 bondTriangleForce(
     real totArea   = view.area_volumes[rbcId].x;
     real totVolume = view.area_volumes[rbcId].y;
 
+    // the constraints of each type are relative to its own stress-free area and volume
+    if (mesh.relativeAreaVolumes != nullptr)
+    {
+        const float2 rel = mesh.relativeAreaVolumes[mesh.getType(rbcId)];
+        totArea   /= rel.x;
+        totVolume /= rel.y;
+    }
+
 #pragma unroll 2
     for (int i = 0; i < degree; i++)
     {
@@ -108,16 +117,23 @@ __device__ inline real3 bondTriangleForce(
     return f0;
 }
 
-template <class DihedralInteraction>
+/**
+ * bending force on the vertex \p locId;
+ * the force on the previous vertex of each dihedral of the ring is passed to
+ * \p neighbourForce(i, idv1, f1), with i the position of that vertex in the ring
+ */
+template <class DihedralInteraction, class DihedralView, class NeighbourForceOp>
 __device__ inline real3 dihedralForce(int locId, int rbcId,
-                                       const typename DihedralInteraction::ViewType& view,
+                                       const DihedralView& view,
                                        DihedralInteraction& dihedralInteraction,
-                                       const MembraneMeshView& mesh)
+                                       const MembraneMeshView& mesh,
+                                       NeighbourForceOp neighbourForce)
 {
     const int offset = rbcId * mesh.nvertices;
 
-    const int startId = mesh.maxDegree * locId;
-    const int degree = mesh.degrees[locId];
+    const int meshVertex = mesh.vertexId(rbcId, locId);
+    const int startId = mesh.maxDegree * meshVertex;
+    const int degree = mesh.degrees[meshVertex];
 
     int idv0 = offset + locId;
     int idv1 = offset + mesh.adjacent[startId];
@@ -150,7 +166,7 @@ __device__ inline real3 dihedralForce(int locId, int rbcId,
 
         f0 += dihedralInteraction(v0, v1, v2, v3, f1);
 
-        atomicAdd(view.forces + idv1, make_float3(f1));
+        neighbourForce(i, idv1, f1);
             
         v1   = v2  ; v2   = v3  ;
         idv1 = idv2; idv2 = idv3;
@@ -158,6 +174,32 @@ __device__ inline real3 dihedralForce(int locId, int rbcId,
     return f0;
 }
 
+template <class TriangleInteraction, class DihedralInteraction,
+          class View, class DihedralView, class NeighbourForceOp>
+__device__ inline real3 vertexForce(int pid,
+                                    const TriangleInteraction& triangleInteraction,
+                                    DihedralInteraction& dihedralInteraction,
+                                    const DihedralView& dihedralView,
+                                    const View& view,
+                                    const MembraneMeshView& mesh,
+                                    const GPU_CommonMembraneParameters& parameters,
+                                    NeighbourForceOp neighbourForce)
+{
+    const int locId = pid % mesh.nvertices;
+    const int rbcId = pid / mesh.nvertices;
+
+    // placeholder particle of an object smaller than the largest mesh type
+    if (mesh.degrees[mesh.vertexId(rbcId, locId)] == 0)
+        return make_real3(0.0_r);
+
+    auto p = fetchParticle(view, pid);
+
+    real3 f;
+    f  = bondTriangleForce(triangleInteraction, p, locId, rbcId, view, mesh, parameters);
+    f += dihedralForce(locId, rbcId, dihedralView, dihedralInteraction, mesh, neighbourForce);
+    return f;
+}
+
 template <class TriangleInteraction, class DihedralInteraction>
 __global__ void computeMembraneForces(TriangleInteraction triangleInteraction,
                                       DihedralInteraction dihedralInteraction,
@@ -170,16 +212,195 @@ __global__ void computeMembraneForces(TriangleInteraction triangleInteraction,
     assert(view.objSize == mesh.nvertices);
 
     const int pid = threadIdx.x + blockDim.x * blockIdx.x;
-    const int locId = pid % mesh.nvertices;
-    const int rbcId = pid / mesh.nvertices;
+    if (pid >= view.nObjects * mesh.nvertices) return;
+
+    auto scatter = [&view] (__UNUSED int i, int idv1, real3 f1)
+    {
+        atomicAdd(view.forces + idv1, make_float3(f1));
+    };
+
+    const real3 f = vertexForce(pid, triangleInteraction, dihedralInteraction, dihedralView,
+                                view, mesh, parameters, scatter);
+
+    atomicAdd(view.forces + pid, make_float3(f));
+}
+
+/**
+ * view reading the positions of the object handled by the current block from shared memory;
+ * all the other quantities are read from the global view
+ */
+template <class BaseView>
+struct CachedObjectView : public BaseView
+{
+    const float3 *cachedPositions; ///< positions of the object, indexed by vertex
+    int offset;                    ///< index of the first particle of the object
+
+    __D__ CachedObjectView(const BaseView& view, const float3 *cachedPositions, int offset) :
+        BaseView(view),
+        cachedPositions(cachedPositions),
+        offset(offset)
+    {}
+
+    __D__ inline float4 readPosition(int i) const
+    {
+        return make_float4(cachedPositions[i - offset], 0.f);
+    }
 
+    __D__ inline Particle readParticle(int i) const
+    {
+        Particle p;
+        p.r = cachedPositions[i - offset];
+        p.readVelocity(this->velocities, i);
+        return p;
+    }
+};
+
+/// scratch space of the deterministic membrane forces
+struct MembraneForcesScratch
+{
+    real3 *vertexForces;    ///< force computed by each vertex on itself, one per vertex
+    real3 *neighbourForces; ///< bending forces on the ring of each vertex, maxDegree per vertex
+};
+
+/**
+ * first pass of the deterministic membrane forces:
+ * same as computeMembraneForces but the forces are stored in the scratch buffers instead of being added
+ */
+template <class TriangleInteraction, class DihedralInteraction>
+__global__ void computeMembraneForcesToScratch(TriangleInteraction triangleInteraction,
+                                               DihedralInteraction dihedralInteraction,
+                                               typename DihedralInteraction::ViewType dihedralView,
+                                               OVviewWithAreaVolume view,
+                                               MembraneMeshView mesh,
+                                               GPU_CommonMembraneParameters parameters,
+                                               MembraneForcesScratch scratch)
+{
+    assert(view.objSize == mesh.nvertices);
+
+    const int pid = threadIdx.x + blockDim.x * blockIdx.x;
     if (pid >= view.nObjects * mesh.nvertices) return;
 
-    auto p = fetchParticle(view, pid);
+    real3 *ringForces = scratch.neighbourForces + pid * mesh.maxDegree;
 
-    real3 f;
-    f  = bondTriangleForce(triangleInteraction, p, locId, rbcId, view, mesh, parameters);
-    f += dihedralForce(locId, rbcId, dihedralView, dihedralInteraction, mesh);
+    auto store = [ringForces] (int i, __UNUSED int idv1, real3 f1)
+    {
+        ringForces[i] = f1;
+    };
+
+    scratch.vertexForces[pid] = vertexForce(pid, triangleInteraction, dihedralInteraction, dihedralView,
+                                            view, mesh, parameters, store);
+}
+
+/**
+ * one block per object: the positions of the object are cached in shared memory,
+ * the area and volume of the object are computed first (replaces computeAreaAndVolume),
+ * then the forces on all the vertices.
+ * The forces are added with atomics, or stored in the scratch buffers if scratch.vertexForces is set
+ * (first pass of the deterministic forces).
+ * Requires mesh.nvertices float3 of dynamic shared memory.
+ */
+template <class TriangleInteraction, class DihedralInteraction>
+__global__ void computeMembraneForcesPerObject(TriangleInteraction triangleInteraction,
+                                               DihedralInteraction dihedralInteraction,
+                                               typename DihedralInteraction::ViewType dihedralView,
+                                               OVviewWithAreaVolume view,
+                                               MembraneMeshView mesh,
+                                               GPU_CommonMembraneParameters parameters,
+                                               MembraneForcesScratch scratch)
+{
+    assert(view.objSize == mesh.nvertices);
+
+    extern __shared__ float3 cachedPositions[];
+
+    const int rbcId  = blockIdx.x;
+    const int offset = rbcId * mesh.nvertices;
+
+    for (int i = threadIdx.x; i < mesh.nvertices; i += blockDim.x)
+        cachedPositions[i] = make_float3(view.readPosition(offset + i));
+
+    __syncthreads();
+
+    float2 a_v = make_float2(0.0f);
+    const int3 *triangles = mesh.triangles + mesh.firstTriangle(rbcId);
+
+    for (int i = threadIdx.x; i < mesh.ntriangles; i += blockDim.x)
+    {
+        const int3 ids = triangles[i];
+
+        const auto v0 = make_real3(cachedPositions[ids.x]);
+        const auto v1 = make_real3(cachedPositions[ids.y]);
+        const auto v2 = make_real3(cachedPositions[ids.z]);
+
+        a_v.x += triangleArea(v0, v1, v2);
+        a_v.y += triangleSignedVolume(v0, v1, v2);
+    }
+
+    a_v = blockSum(a_v);
+
+    // the global writes of the block are visible to the block after the barrier
+    if (threadIdx.x == 0)
+        view.area_volumes[rbcId] = a_v;
+
+    __syncthreads();
+
+    const CachedObjectView<OVviewWithAreaVolume> cachedView(view, cachedPositions, offset);
+    const CachedObjectView<typename DihedralInteraction::ViewType> cachedDihedralView(dihedralView, cachedPositions, offset);
+
+    for (int locId = threadIdx.x; locId < mesh.nvertices; locId += blockDim.x)
+    {
+        const int pid = offset + locId;
+
+        if (scratch.vertexForces == nullptr)
+        {
+            auto scatter = [&view] (__UNUSED int i, int idv1, real3 f1)
+            {
+                atomicAdd(view.forces + idv1, make_float3(f1));
+            };
+
+            const real3 f = vertexForce(pid, triangleInteraction, dihedralInteraction, cachedDihedralView,
+                                        cachedView, mesh, parameters, scatter);
+
+            atomicAdd(view.forces + pid, make_float3(f));
+        }
+        else
+        {
+            real3 *ringForces = scratch.neighbourForces + pid * mesh.maxDegree;
+
+            auto store = [ringForces] (int i, __UNUSED int idv1, real3 f1)
+            {
+                ringForces[i] = f1;
+            };
+
+            scratch.vertexForces[pid] = vertexForce(pid, triangleInteraction, dihedralInteraction, cachedDihedralView,
+                                                    cachedView, mesh, parameters, store);
+        }
+    }
+}
+
+/**
+ * second pass of the deterministic membrane forces:
+ * each vertex sums its own force and the forces stored for it by its neighbours, always in the ring order.
+ * The result is added with a single atomic per vertex, since other interactions may add forces concurrently.
+ */
+__global__ void gatherMembraneForces(OVview view, MembraneMeshView mesh, MembraneForcesScratch scratch)
+{
+    const int pid = threadIdx.x + blockDim.x * blockIdx.x;
+    if (pid >= view.nObjects * mesh.nvertices) return;
+
+    const int locId  = pid % mesh.nvertices;
+    const int offset = pid - locId;
+
+    const int meshVertex = mesh.vertexId(pid / mesh.nvertices, locId);
+    const int startId = mesh.maxDegree * meshVertex;
+    const int degree  = mesh.degrees[meshVertex];
+
+    real3 f = scratch.vertexForces[pid];
+
+    for (int i = 0; i < degree; ++i)
+    {
+        const int idv = offset + mesh.adjacent[startId + i];
+        f += scratch.neighbourForces[idv * mesh.maxDegree + mesh.reverseAdjacent[startId + i]];
+    }
 
     atomicAdd(view.forces + pid, make_float3(f));
 }
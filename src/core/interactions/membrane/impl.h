@@ -70,13 +70,15 @@ public:
     MembraneInteractionImpl(const MirState *state, std::string name, CommonMembraneParameters parameters,
                             typename TriangleInteraction::ParametersType triangleParams,
                             typename DihedralInteraction::ParametersType dihedralParams,
-                            float growUntil, long seed = 42424242) :
+                            float growUntil, bool deterministic, bool perObject, long seed = 42424242) :
         Interaction(state, name, 1.0f),
         parameters(parameters),
         scaleFromTime( [growUntil] (float t) { return min(1.0f, 0.5f + 0.5f * (t / growUntil)); } ),
         dihedralParams(dihedralParams),
         triangleParams(triangleParams),
-        stepGen(seed)
+        stepGen(seed),
+        deterministic(deterministic),
+        perObject(perObject)
     {}
 
     ~MembraneInteractionImpl() = default;
@@ -105,7 +107,7 @@ public:
         OVviewWithAreaVolume view(ov, ov->local());
         typename DihedralInteraction::ViewType dihedralView(ov, ov->local());
         auto mesh = static_cast<MembraneMesh *>(ov->mesh.get());
-        MembraneMeshView meshView(mesh);
+        MembraneMeshView meshView(mesh, ov->getMeshTypes(ov->local()));
 
         const int nthreads = 128;
         const int nblocks  = getNblocks(view.size, nthreads);
@@ -115,12 +117,50 @@ public:
         DihedralInteraction dihedralInteraction(dihedralParams, scale);
         TriangleInteraction triangleInteraction(triangleParams, mesh, scale);
 
-        SAFE_KERNEL_LAUNCH(MembraneForcesKernels::computeMembraneForces,
-                           nblocks, nthreads, 0, stream,
-                           triangleInteraction,
-                           dihedralInteraction, dihedralView,
-                           view, meshView, devParams);
-
+        MembraneForcesKernels::MembraneForcesScratch scratch {nullptr, nullptr};
+
+        if (deterministic)
+        {
+            vertexForces   .resize_anew(view.size);
+            neighbourForces.resize_anew(view.size * meshView.maxDegree);
+
+            scratch = {vertexForces.devPtr(), neighbourForces.devPtr()};
+        }
+
+        if (perObject)
+        {
+            // the area and volume are computed in the same kernel
+            const size_t shMemSize = meshView.nvertices * sizeof(float3);
+
+            SAFE_KERNEL_LAUNCH(MembraneForcesKernels::computeMembraneForcesPerObject,
+                               view.nObjects, nthreads, shMemSize, stream,
+                               triangleInteraction,
+                               dihedralInteraction, dihedralView,
+                               view, meshView, devParams, scratch);
+        }
+        else if (deterministic)
+        {
+            SAFE_KERNEL_LAUNCH(MembraneForcesKernels::computeMembraneForcesToScratch,
+                               nblocks, nthreads, 0, stream,
+                               triangleInteraction,
+                               dihedralInteraction, dihedralView,
+                               view, meshView, devParams, scratch);
+        }
+        else
+        {
+            SAFE_KERNEL_LAUNCH(MembraneForcesKernels::computeMembraneForces,
+                               nblocks, nthreads, 0, stream,
+                               triangleInteraction,
+                               dihedralInteraction, dihedralView,
+                               view, meshView, devParams);
+        }
+
+        if (deterministic)
+        {
+            SAFE_KERNEL_LAUNCH(MembraneForcesKernels::gatherMembraneForces,
+                               nblocks, nthreads, 0, stream,
+                               view, meshView, scratch);
+        }
     }
 
     void halo(__UNUSED ParticleVector *pv1,
@@ -132,6 +172,17 @@ public:
 
     void setPrerequisites(ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2) override
     {
+        auto ov = dynamic_cast<MembraneVector*>(pv1);
+        const int nvertices = ov->mesh->getNvertices();
+
+        // default limit of the shared memory per block, minus the static shared memory of the kernel
+        const int maxVerticesPerObject = (48 * 1024 - 32 * sizeof(float2)) / sizeof(float3);
+
+        if (perObject && nvertices > maxVerticesPerObject)
+            die("Membrane forces '%s': the objects of '%s' have %d vertices, "
+                "at most %d can be cached in shared memory with the per-object kernel",
+                name.c_str(), ov->name.c_str(), nvertices, maxVerticesPerObject);
+
         setPrerequisitesPerEnergy(dihedralParams, pv1, pv2, cl1, cl2);
         setPrerequisitesPerEnergy(triangleParams, pv1, pv2, cl1, cl2);
     }
@@ -164,4 +215,9 @@ protected:
     typename DihedralInteraction::ParametersType dihedralParams;
     typename TriangleInteraction::ParametersType triangleParams;
     StepRandomGen stepGen;
+
+    bool deterministic; ///< gather the forces per vertex instead of scattering them with atomics
+    DeviceBuffer<real3> vertexForces, neighbourForces;
+
+    bool perObject; ///< one block per object, with the positions of the object in shared memory
 };
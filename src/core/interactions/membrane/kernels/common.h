@@ -21,6 +21,36 @@ __D__ inline real triangleSignedVolume(real3 v0, real3 v1, real3 v2)
          - v0.x*v1.z*v2.y - v0.y*v1.x*v2.z + v0.x*v1.y*v2.z);
 }
 
+#ifdef __CUDACC__
+/**
+ * sum of the partial sums (e.g. areas and volumes) of the threads of the block.
+ * The partial sums are added in a fixed order, so that the result is reproducible.
+ * @return the sum in thread 0, undefined in the other threads
+ */
+template <typename T>
+__device__ inline T blockSum(T partial)
+{
+    __shared__ T warpSums[32];
+
+    partial = warpReduce( partial, [] (float a, float b) { return a+b; } );
+
+    if (laneId() == 0)
+        warpSums[threadIdx.x / warpSize] = partial;
+
+    __syncthreads();
+
+    T total = partial;
+
+    if (threadIdx.x == 0)
+    {
+        const int nwarps = (blockDim.x + warpSize - 1) / warpSize;
+        for (int i = 1; i < nwarps; ++i)
+            total += warpSums[i];
+    }
+    return total;
+}
+#endif // __CUDACC__
+
 __D__ inline real supplementaryDihedralAngle(real3 v0, real3 v1, real3 v2, real3 v3)
 {
     /*
@@ -9,7 +9,9 @@ public:
     using VertexType = real3;
     using ViewType   = OVview;
 
-    __D__ inline VertexType fetchVertex(const ViewType& view, int i) const
+    /// templated so that views caching the positions can be used, see CachedObjectView
+    template <class View>
+    __D__ inline VertexType fetchVertex(const View& view, int i) const
     {
         return make_real3(Float3_int(view.readPosition(i)).v);
     }
@@ -28,7 +30,8 @@ public:
     using VertexType = VertexWithMeanCurvature;
     using ViewType   = OVviewWithJuelicherQuants;
 
-    __D__ inline VertexType fetchVertex(const ViewType& view, int i) const
+    template <class View>
+    __D__ inline VertexType fetchVertex(const View& view, int i) const
     {
         return {VertexFetcher::fetchVertex(view, i),
                 real(view.vertexMeanCurvatures[i])};
@@ -20,6 +20,9 @@ inline void setPrerequisitesPerEnergy(const JuelicherBendingParameters&, Particl
                                       __UNUSED CellList *cl2)
 {
     auto ov = dynamic_cast<MembraneVector*>(pv1);
+
+    if (ov->mesh->getNtypes() > 1)
+        die("Juelicher bending is not supported with the mesh of several types of '%s'", ov->name.c_str());
     
     ov->requireDataPerObject<float>(ChannelNames::lenThetaTot, DataManager::PersistenceMode::None);
 
@@ -39,16 +42,17 @@ __device__ inline real compute_lenTheta(real3 v0, real3 v1, real3 v2, real3 v3)
     return len * theta;
 }
 
+// one block per object, the total is summed in a fixed order so that the forces are reproducible
 __global__ void computeAreasAndCurvatures(OVviewWithJuelicherQuants view, MembraneMeshView mesh)
 {
-    int rbcId = blockIdx.y;
-    int idv0  = blockIdx.x * blockDim.x + threadIdx.x;
+    int rbcId = blockIdx.x;
     int offset = rbcId * mesh.nvertices;
 
-    real lenTheta = 0;
+    real lenThetaSum = 0;
     
-    if (idv0 < mesh.nvertices)
+    for (int idv0 = threadIdx.x; idv0 < mesh.nvertices; idv0 += blockDim.x)
     {        
+        real lenTheta = 0;
         int startId = mesh.maxDegree * idv0;
         int degree = mesh.degrees[idv0];
         
@@ -76,12 +80,14 @@ __global__ void computeAreasAndCurvatures(OVviewWithJuelicherQuants view, Membra
         
         view.vertexAreas          [offset + idv0] = area;
         view.vertexMeanCurvatures [offset + idv0] = lenTheta / (4 * area);
+
+        lenThetaSum += lenTheta;
     }
     
-    lenTheta = warpReduce( lenTheta, [] (real a, real b) { return a+b; } );
+    const float lenThetaTot = blockSum((float) lenThetaSum);
 
-    if (laneId() == 0)
-        atomicAdd(&view.lenThetaTot[rbcId], (float) lenTheta);
+    if (threadIdx.x == 0)
+        view.lenThetaTot[rbcId] = lenThetaTot;
 }
 } // namespace InteractionMembraneJuelicherKernels
 
@@ -99,19 +105,14 @@ inline void precomputeQuantitiesPerEnergy(const JuelicherBendingParameters&, Par
     debug("Computing vertex areas and curvatures for %d cells of '%s'",
           ov->local()->nObjects, ov->name.c_str());
 
-    ov->local()->dataPerObject.getData<float>(ChannelNames::lenThetaTot)->clear(stream);
-
     OVviewWithJuelicherQuants view(ov, ov->local());
 
     MembraneMeshView mesh(static_cast<MembraneMesh*>(ov->mesh.get()));
 
     const int nthreads = 128;    
 
-    dim3 threads(nthreads, 1);
-    dim3 blocks(getNblocks(mesh.nvertices, nthreads), view.nObjects);
-        
     SAFE_KERNEL_LAUNCH(
         InteractionMembraneJuelicherKernels::computeAreasAndCurvatures,
-        blocks, threads, 0, stream,
+        view.nObjects, nthreads, 0, stream,
         view, mesh );
 }
@@ -101,12 +101,15 @@ __device__ inline void computeCell(
  *        \code float3 interaction(const Particle dst, int dstId, const Particle src, int srcId) \endcode
  *        The return value is the force acting on the first particle.
  *        The second one experiences the opposite force.
+ * @param span number of cells to traverse in each direction, larger than 1
+ *        when the cells are smaller than the cut-off,
+ *        see CellListInfo::getNeighbourSpan()
  */
 template<typename Interaction>
 __launch_bounds__(128, 16)
 __global__ void computeSelfInteractions(
         CellListInfo cinfo, typename Interaction::ViewType view,
-        const float rc2, Interaction interaction)
+        const float rc2, Interaction interaction, const int span)
 {
     const int dstId = blockIdx.x*blockDim.x + threadIdx.x;
     if (dstId >= view.size) return;
@@ -117,28 +120,52 @@ __global__ void computeSelfInteractions(
 
     const int3 cell0 = cinfo.getCellIdAlongAxes(interaction.getPosition(dstP));
 
-    for (int cellZ = cell0.z-1; cellZ <= cell0.z+1; cellZ++)
+    for (int cellZ = cell0.z-span; cellZ <= cell0.z+span; cellZ++)
     {
-        for (int cellY = cell0.y-1; cellY <= cell0.y; cellY++)
+        for (int cellY = cell0.y-span; cellY <= cell0.y; cellY++)
         {
             if ( !(cellY >= 0 && cellY < cinfo.ncells.y && cellZ >= 0 && cellZ < cinfo.ncells.z) ) continue;
             if (cellY == cell0.y && cellZ > cell0.z) continue;
+
+            const bool ownRow = cellY == cell0.y && cellZ == cell0.z;
+
+            if (cinfo.hasContiguousRows())
+            {
+                const int midCellId = cinfo.encode(cell0.x, cellY, cellZ);
+                int rowStart  = max(midCellId-span, 0);
+                int rowEnd    = min(midCellId+span+1, cinfo.totcells);
             
-            const int midCellId = cinfo.encode(cell0.x, cellY, cellZ);
-            int rowStart  = max(midCellId-1, 0);
-            int rowEnd    = min(midCellId+2, cinfo.totcells);
-            
-            if ( cellY == cell0.y && cellZ == cell0.z ) rowEnd = midCellId + 1; // this row is already partly covered
+                if (ownRow) rowEnd = midCellId + 1; // this row is already partly covered
             
-            const int pstart = cinfo.cellStarts[rowStart];
-            const int pend   = cinfo.cellStarts[rowEnd];
+                const int pstart = cinfo.cellStarts[rowStart];
+                const int pend   = cinfo.cellStarts[rowEnd];
             
-            if (cellY == cell0.y && cellZ == cell0.z)
-                computeCell<InteractionOut::NeedAcc, InteractionOut::NeedAcc, InteractionWith::Self>
-                    (pstart, pend, dstP, dstId, view, rc2, interaction, accumulator);
+                if (ownRow)
+                    computeCell<InteractionOut::NeedAcc, InteractionOut::NeedAcc, InteractionWith::Self>
+                        (pstart, pend, dstP, dstId, view, rc2, interaction, accumulator);
+                else
+                    computeCell<InteractionOut::NeedAcc, InteractionOut::NeedAcc, InteractionWith::Other>
+                        (pstart, pend, dstP, dstId, view, rc2, interaction, accumulator);
+            }
             else
-                computeCell<InteractionOut::NeedAcc, InteractionOut::NeedAcc, InteractionWith::Other>
-                    (pstart, pend, dstP, dstId, view, rc2, interaction, accumulator);
+            {
+                // cells of a row are not contiguous in memory: same half-shell, one cell at a time
+                const int xEnd = ownRow ? cell0.x : min(cell0.x+span, cinfo.ncells.x-1);
+
+                for (int cellX = max(cell0.x-span, 0); cellX <= xEnd; cellX++)
+                {
+                    const int cid = cinfo.encode(cellX, cellY, cellZ);
+                    const int pstart = cinfo.cellStarts[cid];
+                    const int pend   = cinfo.cellStarts[cid+1];
+
+                    if (ownRow && cellX == cell0.x)
+                        computeCell<InteractionOut::NeedAcc, InteractionOut::NeedAcc, InteractionWith::Self>
+                            (pstart, pend, dstP, dstId, view, rc2, interaction, accumulator);
+                    else
+                        computeCell<InteractionOut::NeedAcc, InteractionOut::NeedAcc, InteractionWith::Other>
+                            (pstart, pend, dstP, dstId, view, rc2, interaction, accumulator);
+                }
+            }
         }
     }
 
@@ -173,15 +200,20 @@ __global__ void computeSelfInteractions(
  *         One out of \p NeedDstAcc or \p NeedSrcAcc should be true.
  * @tparam NeedSrcAcc if true, compute forces for source particles.
  *         One out of \p NeedDstAcc or \p NeedSrcAcc should be true.
+ * @param span number of cells to traverse in each direction,
+ *        see computeSelfInteractions()
+ *
  * @tparam Variant performance related parameter. \e true is better for
  * densely mixed stuff, \e false is better for halo
+ *
+ * This is the only external variant supporting \p span larger than 1
  */
 template<InteractionOut NeedDstAcc, InteractionOut NeedSrcAcc, InteractionMode Variant, typename Interaction>
 __launch_bounds__(128, 16)
 __global__ void computeExternalInteractions_1tpp(
         typename Interaction::ViewType dstView, CellListInfo srcCinfo,
         typename Interaction::ViewType srcView,
-        const float rc2, Interaction interaction)
+        const float rc2, Interaction interaction, const int span)
 {
     static_assert(NeedDstAcc == InteractionOut::NeedAcc || NeedSrcAcc == InteractionOut::NeedAcc,
                   "External interactions should return at least some accelerations");
@@ -195,15 +227,15 @@ __global__ void computeExternalInteractions_1tpp(
 
     const int3 cell0 = srcCinfo.getCellIdAlongAxes<CellListsProjection::NoClamp>(interaction.getPosition(dstP));
 
-    for (int cellZ = cell0.z-1; cellZ <= cell0.z+1; cellZ++)
-        for (int cellY = cell0.y-1; cellY <= cell0.y+1; cellY++)
-            if (Variant == InteractionMode::RowWise)
+    for (int cellZ = cell0.z-span; cellZ <= cell0.z+span; cellZ++)
+        for (int cellY = cell0.y-span; cellY <= cell0.y+span; cellY++)
+            if (Variant == InteractionMode::RowWise && srcCinfo.hasContiguousRows())
             {
                 if ( !(cellY >= 0 && cellY < srcCinfo.ncells.y && cellZ >= 0 && cellZ < srcCinfo.ncells.z) ) continue;
 
                 const int midCellId = srcCinfo.encode(cell0.x, cellY, cellZ);
-                int rowStart  = max(midCellId-1, 0);
-                int rowEnd    = min(midCellId+2, srcCinfo.totcells);
+                int rowStart  = max(midCellId-span, 0);
+                int rowEnd    = min(midCellId+span+1, srcCinfo.totcells);
 
                 if (rowStart >= rowEnd) continue;
                 
@@ -217,7 +249,7 @@ __global__ void computeExternalInteractions_1tpp(
             {
                 if ( !(cellY >= 0 && cellY < srcCinfo.ncells.y && cellZ >= 0 && cellZ < srcCinfo.ncells.z) ) continue;
 
-                for (int cellX = max(cell0.x-1, 0); cellX <= min(cell0.x+1, srcCinfo.ncells.x-1); cellX++)
+                for (int cellX = max(cell0.x-span, 0); cellX <= min(cell0.x+span, srcCinfo.ncells.x-1); cellX++)
                 {
                     const int cid = srcCinfo.encode(cellX, cellY, cellZ);
                     const int pstart = srcCinfo.cellStarts[cid];
@@ -264,7 +296,7 @@ __global__ void computeExternalInteractions_3tpp(
     int cellZ = cell0.z + dircode;
 
     for (int cellY = cell0.y-1; cellY <= cell0.y+1; cellY++)
-        if (Variant == InteractionMode::RowWise)
+        if (Variant == InteractionMode::RowWise && srcCinfo.hasContiguousRows())
         {
             if ( !(cellY >= 0 && cellY < srcCinfo.ncells.y && cellZ >= 0 && cellZ < srcCinfo.ncells.z) ) continue;
 
@@ -331,7 +363,7 @@ __global__ void computeExternalInteractions_9tpp(
     int cellZ = cell0.z + dircode / 3 - 1;
     int cellY = cell0.y + dircode % 3 - 1;
 
-    if (Variant == InteractionMode::RowWise)
+    if (Variant == InteractionMode::RowWise && srcCinfo.hasContiguousRows())
     {
         if ( !(cellY >= 0 && cellY < srcCinfo.ncells.y && cellZ >= 0 && cellZ < srcCinfo.ncells.z) ) return;
 
@@ -170,7 +170,9 @@ private:
      * Convenience macro wrapper
      *
      * Select one of the available kernels for external interaction depending
-     * on the number of particles involved, report it and call
+     * on the number of particles involved, report it and call.
+     * Only the one thread per particle variant can traverse more than the
+     * nearest cells, it is always used when the cells are smaller than #rc
      */
     #define DISPATCH_EXTERNAL(P1, P2, P3, TPP, INTERACTION_FUNCTION)                \
     do{ debug2("Dispatched to "#TPP" thread(s) per particle variant");              \
@@ -179,11 +181,20 @@ private:
                 getNblocks(TPP*dstView.size, nth), nth, 0, stream,                  \
                 dstView, cl2->cellInfo(), srcView, rc*rc, INTERACTION_FUNCTION); } while (0)
 
+    #define DISPATCH_EXTERNAL_1TPP(P1, P2, P3, INTERACTION_FUNCTION)                \
+    do{ debug2("Dispatched to 1 thread(s) per particle variant, span %d", span);    \
+        SAFE_KERNEL_LAUNCH(                                                         \
+                computeExternalInteractions_1tpp<P1 COMMA P2 COMMA P3>,             \
+                getNblocks(dstView.size, nth), nth, 0, stream,                      \
+                dstView, cl2->cellInfo(), srcView, rc*rc, INTERACTION_FUNCTION,     \
+                span); } while (0)
+
     #define CHOOSE_EXTERNAL(P1, P2, P3, INTERACTION_FUNCTION)                                        \
-        do{  if (dstView.size < 1000  ) { DISPATCH_EXTERNAL(P1, P2, P3, 27, INTERACTION_FUNCTION); } \
+        do{  if (span > 1             ) { DISPATCH_EXTERNAL_1TPP(P1, P2, P3, INTERACTION_FUNCTION);    } \
+        else if (dstView.size < 1000  ) { DISPATCH_EXTERNAL(P1, P2, P3, 27, INTERACTION_FUNCTION); } \
         else if (dstView.size < 10000 ) { DISPATCH_EXTERNAL(P1, P2, P3, 9,  INTERACTION_FUNCTION); } \
         else if (dstView.size < 400000) { DISPATCH_EXTERNAL(P1, P2, P3, 3,  INTERACTION_FUNCTION); } \
-        else                            { DISPATCH_EXTERNAL(P1, P2, P3, 1,  INTERACTION_FUNCTION); } } while(0)
+        else                            { DISPATCH_EXTERNAL_1TPP(P1, P2, P3, INTERACTION_FUNCTION);    } } while(0)
 
 
     /**
@@ -228,7 +239,7 @@ private:
             SAFE_KERNEL_LAUNCH(
                                computeSelfInteractions,
                                getNblocks(np, nth), nth, 0, stream,
-                               cinfo, view, rc*rc, pair.handler());
+                               cinfo, view, rc*rc, pair.handler(), cl1->getNeighbourSpan(rc));
         }
         else /*  External interaction */
         {
@@ -240,6 +251,7 @@ private:
             auto srcView = cl2->getView<ViewType>();
 
             const int nth = 128;
+            const int span = cl2->getNeighbourSpan(rc);
             if (np1 > 0 && np2 > 0)
                 CHOOSE_EXTERNAL(InteractionOut::NeedAcc, InteractionOut::NeedAcc, InteractionMode::RowWise, pair.handler());
         }
@@ -257,12 +269,13 @@ private:
 
         const int np1 = pv1->halo()->size();  // note halo here
         const int np2 = pv2->local()->size();
-        debug("Computing halo forces for %s(halo) - %s (%d - %d particles) with rc = %g", pv1->name.c_str(), pv2->name.c_str(), np1, np2, cl2->rc);
+        debug("Computing halo forces for %s(halo) - %s (%d - %d particles) with rc = %g", pv1->name.c_str(), pv2->name.c_str(), np1, np2, rc);
 
         ViewType dstView(pv1, pv1->halo());
         auto srcView = cl2->getView<ViewType>();
         
         const int nth = 128;
+        const int span = cl2->getNeighbourSpan(rc);
         if (np1 > 0 && np2 > 0)
             if (dynamic_cast<ObjectVector*>(pv1) == nullptr) // don't need forces for pure particle halo
                 CHOOSE_EXTERNAL(InteractionOut::NoAcc,   InteractionOut::NeedAcc, InteractionMode::Dilute, pair.handler() );
@@ -96,11 +96,23 @@ float InteractionManager::getLargestCutoff() const
     {
         if (!prototype.cl1)
             continue;
-        rc = std::max(rc, prototype.cl1->rc);
+
+        // cut-off rounded up to the size of the cells that would fit it
+        const CellListInfo fitted(prototype.interaction->rc, prototype.cl1->localDomainSize);
+        rc = std::max(rc, fitted.rc);
     }
     return rc;
 }
 
+float InteractionManager::getLargestCutoff(ParticleVector *pv) const
+{
+    float rc = 0.f;
+    for (const auto& prototype : interactions)
+        if (prototype.pv1 == pv || prototype.pv2 == pv)
+            rc = std::max(rc, prototype.interaction->rc);
+    return rc;
+}
+
 std::vector<std::string> InteractionManager::getInputChannels(ParticleVector *pv) const
 {
     return _getExtraChannels(pv, inputChannels);
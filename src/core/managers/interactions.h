@@ -20,6 +20,7 @@ public:
     
     CellList* getLargestCellList(ParticleVector *pv) const;
     float getLargestCutoff() const;
+    float getLargestCutoff(ParticleVector *pv) const;
 
     std::vector<std::string> getInputChannels(ParticleVector *pv) const;
     std::vector<std::string> getOutputChannels(ParticleVector *pv) const;
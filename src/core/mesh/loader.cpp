@@ -0,0 +1,175 @@
+#include "loader.h"
+
+#include <core/logger.h>
+#include <core/utils/cache.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+namespace MeshLoader
+{
+
+static MPI_Comm nodeComm = MPI_COMM_NULL; ///< ranks sharing a node, the first one reads the files
+static bool writer = true;                ///< the rank that writes the files
+
+/// membrane meshes that are alive, by content key
+static std::map<std::string, std::weak_ptr<MembraneMesh>> sharedMeshes;
+
+void setCommunicator(MPI_Comm comm)
+{
+    if (nodeComm != MPI_COMM_NULL)
+        MPI_Check( MPI_Comm_free(&nodeComm) );
+
+    writer = true;
+
+    if (comm == MPI_COMM_NULL)
+        return;
+
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
+    MPI_Check( MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm) );
+
+    writer = (rank == 0);
+}
+
+static void broadcast(std::vector<char>& data, long& size, int root, MPI_Comm comm)
+{
+    MPI_Check( MPI_Bcast(&size, 1, MPI_LONG, root, comm) );
+
+    if (size < 0)
+        return;
+
+    data.resize(size);
+
+    // the counts of MPI are ints
+    const long chunk = 1 << 30;
+    for (long start = 0; start < size; start += chunk)
+    {
+        const int count = std::min(chunk, size - start);
+        MPI_Check( MPI_Bcast(data.data() + start, count, MPI_BYTE, root, comm) );
+    }
+}
+
+std::vector<char> readFile(const std::string& fileName)
+{
+    constexpr int root = 0;
+
+    std::vector<char> data;
+    long size = -1;
+
+    int nodeRank = root;
+    if (nodeComm != MPI_COMM_NULL)
+        MPI_Check( MPI_Comm_rank(nodeComm, &nodeRank) );
+
+    if (nodeRank == root)
+    {
+        debug("Reading mesh file '%s'", fileName.c_str());
+        if (Cache::load(fileName, data))
+            size = data.size();
+    }
+
+    if (nodeComm != MPI_COMM_NULL)
+        broadcast(data, size, root, nodeComm);
+
+    if (size < 0)
+        die("Mesh file '%s' not found or not readable", fileName.c_str());
+
+    return data;
+}
+
+void writeFile(const std::string& fileName, const std::vector<char>& data)
+{
+    if (!writer)
+        return;
+
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file.write(data.data(), data.size()).good())
+        die("Could not write mesh file '%s'", fileName.c_str());
+
+    debug("Wrote mesh file '%s'", fileName.c_str());
+}
+
+template <typename Create>
+static std::shared_ptr<MembraneMesh> getShared(const Cache::Key& key, Create create)
+{
+    const std::string id = key.str();
+
+    if (auto mesh = sharedMeshes[id].lock())
+    {
+        debug("Sharing the membrane mesh %s with identical contents", id.c_str());
+        return mesh;
+    }
+
+    auto mesh = create();
+    sharedMeshes[id] = mesh;
+
+    // forget the meshes that were freed
+    for (auto it = sharedMeshes.begin(); it != sharedMeshes.end(); )
+    {
+        if (it->second.expired()) it = sharedMeshes.erase(it);
+        else                      ++it;
+    }
+
+    return mesh;
+}
+
+std::shared_ptr<MembraneMesh> loadMembraneMesh(const std::string& fileName,
+                                               MembraneMesh::Reordering reordering)
+{
+    const auto contents = readFile(fileName);
+
+    Cache::Key key;
+    key.add(std::string("file")).add(contents).add(reordering);
+
+    return getShared(key, [&]()
+    {
+        return std::make_shared<MembraneMesh>(fileName, contents, reordering);
+    });
+}
+
+std::shared_ptr<MembraneMesh> loadMembraneMesh(const std::string& initialMesh,
+                                               const std::string& stressFreeMesh,
+                                               MembraneMesh::Reordering reordering)
+{
+    const auto initialContents    = readFile(initialMesh);
+    const auto stressFreeContents = readFile(stressFreeMesh);
+
+    Cache::Key key;
+    key.add(std::string("files")).add(initialContents).add(stressFreeContents).add(reordering);
+
+    return getShared(key, [&]()
+    {
+        return std::make_shared<MembraneMesh>(initialMesh, initialContents,
+                                              stressFreeMesh, stressFreeContents, reordering);
+    });
+}
+
+std::shared_ptr<MembraneMesh> loadMembraneMesh(const std::vector<float3>& vertices,
+                                               const std::vector<int3>& faces,
+                                               MembraneMesh::Reordering reordering)
+{
+    Cache::Key key;
+    key.add(std::string("vertices")).add(vertices).add(faces).add(reordering);
+
+    return getShared(key, [&]()
+    {
+        return std::make_shared<MembraneMesh>(vertices, faces, reordering);
+    });
+}
+
+std::shared_ptr<MembraneMesh> loadMembraneMesh(const std::vector<float3>& vertices,
+                                               const std::vector<float3>& stressFreeVertices,
+                                               const std::vector<int3>& faces,
+                                               MembraneMesh::Reordering reordering)
+{
+    Cache::Key key;
+    key.add(std::string("stress free vertices")).add(vertices).add(stressFreeVertices).add(faces).add(reordering);
+
+    return getShared(key, [&]()
+    {
+        return std::make_shared<MembraneMesh>(vertices, stressFreeVertices, faces, reordering);
+    });
+}
+
+} // namespace MeshLoader
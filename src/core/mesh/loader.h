@@ -0,0 +1,46 @@
+#pragma once
+
+#include "membrane.h"
+
+#include <mpi.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Reading of the mesh files at startup.
+ * Once a communicator is set, all its ranks must load the same meshes in the same order:
+ * each file is read by a single rank per node and broadcast to the other ranks of the node.
+ * Membrane meshes with the same contents and the same reordering are shared instead of being
+ * built again, as long as one of them is alive.
+ */
+namespace MeshLoader
+{
+
+/// set the ranks that load the meshes collectively, MPI_COMM_NULL to read the files on every rank
+void setCommunicator(MPI_Comm comm);
+
+/// contents of the file, read once per node; dies on all the ranks if the file cannot be read
+std::vector<char> readFile(const std::string& fileName);
+
+/// write the data on one rank only; does nothing on the other ranks
+void writeFile(const std::string& fileName, const std::vector<char>& data);
+
+std::shared_ptr<MembraneMesh> loadMembraneMesh(const std::string& fileName,
+                                               MembraneMesh::Reordering reordering);
+
+std::shared_ptr<MembraneMesh> loadMembraneMesh(const std::string& initialMesh,
+                                               const std::string& stressFreeMesh,
+                                               MembraneMesh::Reordering reordering);
+
+std::shared_ptr<MembraneMesh> loadMembraneMesh(const std::vector<float3>& vertices,
+                                               const std::vector<int3>& faces,
+                                               MembraneMesh::Reordering reordering);
+
+std::shared_ptr<MembraneMesh> loadMembraneMesh(const std::vector<float3>& vertices,
+                                               const std::vector<float3>& stressFreeVertices,
+                                               const std::vector<int3>& faces,
+                                               MembraneMesh::Reordering reordering);
+
+} // namespace MeshLoader
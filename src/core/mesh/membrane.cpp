@@ -1,19 +1,45 @@
 #include "membrane.h"
+#include "loader.h"
 
 #include <core/utils/cuda_common.h>
 #include <core/utils/helper_math.h>
+#include <plugins/utils/simple_serializer.h>
 
-#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <map>
 #include <unordered_map>
 #include <vector>
 
+using EdgeMapPerVertex = std::vector< std::map<int, int> >;
+static const int NOT_SET = -1;
+
 MembraneMesh::MembraneMesh()
 {}
 
-MembraneMesh::MembraneMesh(const std::string& initialMesh) :
-    Mesh(initialMesh)
+MembraneMesh::MembraneMesh(const std::string& initialMesh, Reordering reordering) :
+    MembraneMesh(initialMesh, MeshLoader::readFile(initialMesh), reordering)
+{}
+
+MembraneMesh::MembraneMesh(const std::string& fileName, const std::vector<char>& contents, Reordering reordering)
 {
+    if (isBinary(contents))
+    {
+        // the adjacency and the stress-free quantities depend on the order
+        if (reordering != Reordering::None)
+            die("Binary mesh '%s' cannot be reordered, its vertices keep the order they were written in",
+                fileName.c_str());
+
+        _readBinary(fileName, contents);
+        return;
+    }
+
+    _initFromOff(fileName, contents);
+
+    if (reordering != Reordering::None)
+        _reorderVertices(reordering);
+
     findAdjacent();
     _computeInitialQuantities(vertexCoordinates);
 }
@@ -37,50 +63,357 @@ static bool sameFaces(const PinnedBuffer<int3>& facesA, const PinnedBuffer<int3>
     return true;
 }
 
-MembraneMesh::MembraneMesh(const std::string& initialMesh, const std::string& stressFreeMesh) :
-    Mesh(initialMesh)
+MembraneMesh::MembraneMesh(const std::string& initialMesh, const std::string& stressFreeMesh,
+                           Reordering reordering) :
+    MembraneMesh(initialMesh, MeshLoader::readFile(initialMesh),
+                 stressFreeMesh, MeshLoader::readFile(stressFreeMesh), reordering)
+{}
+
+MembraneMesh::MembraneMesh(const std::string& initialMesh, const std::vector<char>& initialContents,
+                           const std::string& stressFreeMesh, const std::vector<char>& stressFreeContents,
+                           Reordering reordering)
 {
-    Mesh stressFree(stressFreeMesh);
+    if (isBinary(initialContents) || isBinary(stressFreeContents))
+        die("Binary meshes already hold their stress-free quantities, "
+            "they can not be combined with a stress-free mesh ('%s' and '%s')",
+            initialMesh.c_str(), stressFreeMesh.c_str());
+
+    _initFromOff(initialMesh, initialContents);
+    Mesh stressFree(stressFreeMesh, stressFreeContents);
 
     if (!sameFaces(triangles, stressFree.triangles))
         die("Must pass meshes with same connectivity for initial positions and stressFree vertices");
     
     if (vertexCoordinates.size() != stressFree.vertexCoordinates.size())
         die("Must pass same number of vertices for initial positions and stressFree vertices");
+
+    if (reordering != Reordering::None)
+    {
+        const auto order = _reorderVertices(reordering);
+        MeshReordering::permute(order, stressFree.vertexCoordinates);
+    }
     
     findAdjacent();
     _computeInitialQuantities(stressFree.vertexCoordinates);
 }
 
 MembraneMesh::MembraneMesh(const std::vector<float3>& vertices,
-                           const std::vector<int3>& faces) :
+                           const std::vector<int3>& faces,
+                           Reordering reordering) :
     Mesh(vertices, faces)
 {
+    if (reordering != Reordering::None)
+        _reorderVertices(reordering);
+
     findAdjacent();
     _computeInitialQuantities(vertexCoordinates);
 }
 
 MembraneMesh::MembraneMesh(const std::vector<float3>& vertices,
                            const std::vector<float3>& stressFreeVertices,
-                           const std::vector<int3>& faces) :
+                           const std::vector<int3>& faces,
+                           Reordering reordering) :
     Mesh(vertices, faces)
 {
     if (vertices.size() != stressFreeVertices.size())
         die("Must pass same number of vertices for initial positions and stressFree vertices");
     
     Mesh stressFreeMesh(stressFreeVertices, faces);
+
+    if (reordering != Reordering::None)
+    {
+        const auto order = _reorderVertices(reordering);
+        MeshReordering::permute(order, stressFreeMesh.vertexCoordinates);
+    }
+
     findAdjacent();
     _computeInitialQuantities(stressFreeMesh.vertexCoordinates);
 }
 
+MembraneMesh::MembraneMesh(const std::vector<std::shared_ptr<MembraneMesh>>& types) :
+    types(types)
+{
+    if (types.empty())
+        die("A membrane mesh needs at least one mesh type");
+
+    maxDegree = 0;
+    for (const auto& m : types)
+    {
+        if (m == nullptr || m->getNtypes() != 1)
+            die("The mesh types must be single membrane meshes");
+
+        nvertices  = std::max(nvertices,  m->getNvertices());
+        ntriangles = std::max(ntriangles, m->getNtriangles());
+        maxDegree  = std::max(maxDegree,  m->getMaxDegree());
+    }
+
+    const int ntypes = types.size();
+
+    vertexCoordinates.resize_anew(ntypes * nvertices);
+    triangles        .resize_anew(ntypes * ntriangles);
+    degrees          .resize_anew(ntypes * nvertices);
+
+    for (auto buffer : {&adjacent, &reverseAdjacent})
+        buffer->resize_anew(ntypes * nvertices * maxDegree);
+
+    for (auto buffer : {&initialLengths, &initialAreas, &initialDotProducts})
+        buffer->resize_anew(ntypes * nvertices * maxDegree);
+
+    std::fill(vertexCoordinates.begin(), vertexCoordinates.end(), make_float4(0.f));
+    std::fill(triangles        .begin(), triangles        .end(), make_int3(0, 0, 0));
+    std::fill(degrees          .begin(), degrees          .end(), 0);
+    std::fill(adjacent         .begin(), adjacent         .end(), NOT_SET);
+    std::fill(reverseAdjacent  .begin(), reverseAdjacent  .end(), NOT_SET);
+
+    relativeAreaVolumes.resize_anew(ntypes);
+
+    for (int t = 0; t < ntypes; ++t)
+    {
+        const auto& m = *types[t];
+
+        std::copy(m.vertexCoordinates.begin(), m.vertexCoordinates.end(), &vertexCoordinates[t * nvertices]);
+        std::copy(m.triangles        .begin(), m.triangles        .end(), &triangles        [t * ntriangles]);
+        std::copy(m.degrees          .begin(), m.degrees          .end(), &degrees          [t * nvertices]);
+
+        // the rings are strided by the largest degree of all the types
+        for (int v = 0; v < m.getNvertices(); ++v)
+        {
+            for (int j = 0; j < m.degrees[v]; ++j)
+            {
+                const int src = v * m.getMaxDegree() + j;
+                const int dst = (t * nvertices + v) * maxDegree + j;
+
+                adjacent          [dst] = m.adjacent          [src];
+                reverseAdjacent   [dst] = m.reverseAdjacent   [src];
+                initialLengths    [dst] = m.initialLengths    [src];
+                initialAreas      [dst] = m.initialAreas      [src];
+                initialDotProducts[dst] = m.initialDotProducts[src];
+            }
+        }
+
+        const float2 av0 = types[0]->stressFreeAreaVolume;
+        relativeAreaVolumes[t] = make_float2(m.stressFreeAreaVolume.x / av0.x,
+                                             m.stressFreeAreaVolume.y / av0.y);
+
+        debug("Membrane mesh type %d: %d vertices, %d triangles, stress-free area and volume %g x, %g x the first type",
+              t, m.getNvertices(), m.getNtriangles(), relativeAreaVolumes[t].x, relativeAreaVolumes[t].y);
+    }
+
+    stressFreeAreaVolume = types[0]->stressFreeAreaVolume;
+
+    vertexCoordinates .uploadToDevice(defaultStream);
+    triangles         .uploadToDevice(defaultStream);
+    adjacent          .uploadToDevice(defaultStream);
+    degrees           .uploadToDevice(defaultStream);
+    reverseAdjacent   .uploadToDevice(defaultStream);
+    initialLengths    .uploadToDevice(defaultStream);
+    initialAreas      .uploadToDevice(defaultStream);
+    initialDotProducts.uploadToDevice(defaultStream);
+    relativeAreaVolumes.uploadToDevice(defaultStream);
+}
 
 MembraneMesh::MembraneMesh(MembraneMesh&&) = default;
 MembraneMesh& MembraneMesh::operator=(MembraneMesh&&) = default;
 
 MembraneMesh::~MembraneMesh() = default;
 
-using EdgeMapPerVertex = std::vector< std::map<int, int> >;
-static const int NOT_SET = -1;
+int MembraneMesh::getNtypes() const
+{
+    return types.empty() ? 1 : types.size();
+}
+
+const MembraneMesh& MembraneMesh::getMeshType(int type) const
+{
+    if (type < 0 || type >= getNtypes())
+        die("Membrane mesh type %d out of range [0, %d)", type, getNtypes());
+
+    return types.empty() ? *this : *types[type];
+}
+
+static const char binaryMagic[8] = {'M', 'I', 'R', 'M', 'E', 'S', 'H', '\0'};
+static const int binaryVersion = 1;
+
+bool MembraneMesh::isBinary(const std::vector<char>& contents)
+{
+    return contents.size() >= sizeof(binaryMagic) &&
+        std::equal(std::begin(binaryMagic), std::end(binaryMagic), contents.begin());
+}
+
+void MembraneMesh::writeBinary(const std::string& fileName) const
+{
+    if (getNtypes() > 1)
+        die("Membrane meshes made of several types can not be written in binary format ('%s')", fileName.c_str());
+
+    std::vector<char> payload;
+    SimpleSerializer::serialize(payload, binaryVersion, nvertices, ntriangles, maxDegree,
+                                vertexCoordinates, triangles, originalIds,
+                                degrees, adjacent, reverseAdjacent,
+                                initialLengths, initialAreas, initialDotProducts, stressFreeAreaVolume);
+
+    std::vector<char> data(std::begin(binaryMagic), std::end(binaryMagic));
+    data.insert(data.end(), payload.begin(), payload.end());
+
+    MeshLoader::writeFile(fileName, data);
+}
+
+namespace
+{
+/**
+ * Reads the layout of SimpleSerializer (scalars, and containers prefixed by their size),
+ * checking every length against the size of the file before reading
+ */
+class BinaryMeshReader
+{
+public:
+    BinaryMeshReader(const std::string& fileName, const std::vector<char>& contents, size_t offset) :
+        fileName(fileName),
+        contents(contents),
+        offset(offset)
+    {}
+
+    template <typename T>
+    void read(T& v)
+    {
+        _require(sizeof(T));
+        memcpy(&v, contents.data() + offset, sizeof(T));
+        offset += sizeof(T);
+    }
+
+    template <typename T>
+    void read(PinnedBuffer<T>& v)
+    {
+        v.resize_anew(_readSize<T>());
+        _readData(v.data(), v.size());
+    }
+
+    template <typename T>
+    void read(std::vector<T>& v)
+    {
+        v.resize(_readSize<T>());
+        _readData(v.data(), v.size());
+    }
+
+    template <typename Arg, typename... Args>
+    void read(Arg& arg, Args&... args)
+    {
+        read(arg);
+        read(args...);
+    }
+
+    bool finished() const { return offset == contents.size(); }
+
+private:
+    void _require(size_t nbytes) const
+    {
+        if (nbytes > contents.size() - offset)
+            die("Binary mesh '%s' is truncated", fileName.c_str());
+    }
+
+    template <typename T>
+    int _readSize()
+    {
+        int n;
+        read(n);
+        if (n < 0)
+            die("Binary mesh '%s' is corrupted: negative array size %d", fileName.c_str(), n);
+        _require(static_cast<size_t>(n) * sizeof(T));
+        return n;
+    }
+
+    template <typename T>
+    void _readData(T *dst, size_t n)
+    {
+        memcpy(dst, contents.data() + offset, n * sizeof(T));
+        offset += n * sizeof(T);
+    }
+
+    const std::string& fileName;
+    const std::vector<char>& contents;
+    size_t offset;
+};
+} // anonymous namespace
+
+void MembraneMesh::_readBinary(const std::string& fileName, const std::vector<char>& contents)
+{
+    BinaryMeshReader reader(fileName, contents, sizeof(binaryMagic));
+
+    int version;
+    reader.read(version);
+
+    if (version != binaryVersion)
+        die("Binary mesh '%s' has version %d, expected %d", fileName.c_str(), version, binaryVersion);
+
+    reader.read(nvertices, ntriangles, maxDegree);
+
+    if (nvertices < 0 || ntriangles < 0 || maxDegree < 0)
+        die("Binary mesh '%s' is corrupted: %d vertices, %d triangles, max degree %d",
+            fileName.c_str(), nvertices, ntriangles, maxDegree);
+
+    reader.read(vertexCoordinates, triangles, originalIds,
+                degrees, adjacent, reverseAdjacent,
+                initialLengths, initialAreas, initialDotProducts, stressFreeAreaVolume);
+
+    if (!reader.finished())
+        die("Binary mesh '%s' is corrupted: unexpected data at the end of the file", fileName.c_str());
+
+    auto checkSize = [&](const char *what, size_t size, int64_t expected)
+    {
+        if (static_cast<int64_t>(size) != expected)
+            die("Binary mesh '%s' is corrupted: %s has %zu entries, expected %lld",
+                fileName.c_str(), what, size, static_cast<long long>(expected));
+    };
+
+    const int64_t ringSize = static_cast<int64_t>(nvertices) * maxDegree;
+
+    checkSize("vertices",            vertexCoordinates .size(), nvertices);
+    checkSize("triangles",           triangles         .size(), ntriangles);
+    checkSize("degrees",             degrees           .size(), nvertices);
+    checkSize("adjacent",            adjacent          .size(), ringSize);
+    checkSize("reverseAdjacent",     reverseAdjacent   .size(), ringSize);
+    checkSize("initialLengths",      initialLengths    .size(), ringSize);
+    checkSize("initialAreas",        initialAreas      .size(), ringSize);
+    checkSize("initialDotProducts",  initialDotProducts.size(), ringSize);
+
+    if (!originalIds.empty())
+    {
+        checkSize("originalIds", originalIds.size(), nvertices);
+
+        for (auto id : originalIds)
+            if (id < 0 || id >= nvertices)
+                die("Binary mesh '%s' is corrupted: original vertex id %d out of range", fileName.c_str(), id);
+    }
+
+    // the kernels index the rings without further checks
+    for (int v = 0; v < nvertices; ++v)
+    {
+        if (degrees[v] < 0 || degrees[v] > maxDegree)
+            die("Binary mesh '%s' is corrupted: vertex %d has degree %d, max degree is %d",
+                fileName.c_str(), v, degrees[v], maxDegree);
+
+        for (int i = 0; i < degrees[v]; ++i)
+        {
+            const int u = adjacent       [v * maxDegree + i];
+            const int j = reverseAdjacent[v * maxDegree + i];
+
+            if (u < 0 || u >= nvertices || j < 0 || j >= maxDegree)
+                die("Binary mesh '%s' is corrupted: bad ring of vertex %d", fileName.c_str(), v);
+        }
+    }
+
+    _check();
+
+    debug("Read binary mesh '%s': %d vertices, %d triangles, max degree %d",
+          fileName.c_str(), nvertices, ntriangles, maxDegree);
+
+    vertexCoordinates .uploadToDevice(defaultStream);
+    triangles         .uploadToDevice(defaultStream);
+    adjacent          .uploadToDevice(defaultStream);
+    degrees           .uploadToDevice(defaultStream);
+    reverseAdjacent   .uploadToDevice(defaultStream);
+    initialLengths    .uploadToDevice(defaultStream);
+    initialAreas      .uploadToDevice(defaultStream);
+    initialDotProducts.uploadToDevice(defaultStream);
+}
 
 static void findDegrees(const EdgeMapPerVertex& adjacentPairs, PinnedBuffer<int>& degrees)
 {
@@ -115,6 +448,30 @@ static void findNearestNeighbours(const EdgeMapPerVertex& adjacentPairs, int max
     }
 }
 
+static void findReverseAdjacent(const PinnedBuffer<int>& adjacent, const PinnedBuffer<int>& degrees,
+                                int maxDegree, PinnedBuffer<int>& reverseAdjacent)
+{
+    const int nvertices = degrees.size();
+
+    reverseAdjacent.resize_anew(nvertices * maxDegree);
+    std::fill(reverseAdjacent.begin(), reverseAdjacent.end(), NOT_SET);
+
+    for (int v = 0; v < nvertices; ++v)
+    {
+        for (int i = 0; i < degrees[v]; ++i)
+        {
+            const int u = adjacent[maxDegree*v + i];
+            const int *uadjacent = &adjacent[maxDegree*u];
+
+            const auto it = std::find(uadjacent, uadjacent + degrees[u], v);
+            if (it == uadjacent + degrees[u])
+                die("Mesh connectivity is not symmetric: %d is adjacent to %d but not the opposite", u, v);
+
+            reverseAdjacent[maxDegree*v + i] = it - uadjacent;
+        }
+    }
+}
+
 void MembraneMesh::findAdjacent()
 {
     /*
@@ -138,9 +495,11 @@ void MembraneMesh::findAdjacent()
 
     findDegrees(adjacentPairs, degrees);
     findNearestNeighbours(adjacentPairs, maxDegree, adjacent);
+    findReverseAdjacent(adjacent, degrees, maxDegree, reverseAdjacent);
     
     adjacent.uploadToDevice(defaultStream);
     degrees.uploadToDevice(defaultStream);
+    reverseAdjacent.uploadToDevice(defaultStream);
 }
 
 void MembraneMesh::_computeInitialQuantities(const PinnedBuffer<float4>& vertices)
@@ -148,6 +507,7 @@ void MembraneMesh::_computeInitialQuantities(const PinnedBuffer<float4>& vertice
     _computeInitialLengths(vertices);
     _computeInitialAreas(vertices);
     _computeInitialDotProducts(vertices);
+    _computeStressFreeAreaVolume(vertices);
 }
 
 void MembraneMesh::_computeInitialLengths(const PinnedBuffer<float4>& vertices)
@@ -220,13 +580,36 @@ void MembraneMesh::_computeInitialDotProducts(const PinnedBuffer<float4>& vertic
     initialDotProducts.uploadToDevice(defaultStream);
 }
 
+void MembraneMesh::_computeStressFreeAreaVolume(const PinnedBuffer<float4>& vertices)
+{
+    double area = 0.0, volume = 0.0;
+
+    for (const auto& t : triangles)
+    {
+        const float3 v0 = make_float3(vertices[t.x]);
+        const float3 v1 = make_float3(vertices[t.y]);
+        const float3 v2 = make_float3(vertices[t.z]);
 
-MembraneMeshView::MembraneMeshView(const MembraneMesh *m) :
+        area   += computeArea(v0, v1, v2);
+        volume += dot(v0, cross(v1, v2)) / 6.f;
+    }
+
+    stressFreeAreaVolume = make_float2(area, volume);
+}
+
+
+MembraneMeshView::MembraneMeshView(const MembraneMesh *m, const int *meshTypes) :
     MeshView(m),
     maxDegree          (m->getMaxDegree()),
     adjacent           (m->adjacent.devPtr()),
     degrees            (m->degrees.devPtr()),
+    reverseAdjacent    (m->reverseAdjacent.devPtr()),
     initialLengths     (m->initialLengths.devPtr()),
     initialAreas       (m->initialAreas.devPtr()),
-    initialDotProducts (m->initialDotProducts.devPtr())
-{}
+    initialDotProducts (m->initialDotProducts.devPtr()),
+    meshTypes          (meshTypes),
+    relativeAreaVolumes(m->getNtypes() > 1 ? m->relativeAreaVolumes.devPtr() : nullptr)
+{
+    if (m->getNtypes() > 1 && meshTypes == nullptr)
+        die("The mesh types of the objects are required with a mesh of %d types", m->getNtypes());
+}
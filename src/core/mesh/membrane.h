@@ -3,21 +3,47 @@
 #include "mesh.h"
 
 #include <core/containers.h>
+#include <core/utils/cpu_gpu_defines.h>
+
+#include <memory>
+#include <vector>
 
 class MembraneMesh : public Mesh
 {
 public:
     MembraneMesh();
 
-    MembraneMesh(const std::string& initialMesh);
-    MembraneMesh(const std::string& initialMesh, const std::string& stressFreeMesh);
+    // the vertices (and the stress-free vertices) are optionally renumbered for memory locality,
+    // see getOriginalIds() for the input order
+    using Reordering = MeshReordering::Method;
+
+    MembraneMesh(const std::string& initialMesh, Reordering reordering = Reordering::None);
+    MembraneMesh(const std::string& initialMesh, const std::string& stressFreeMesh,
+                 Reordering reordering = Reordering::None);
+
+    /// from the contents of a file already read, either OFF or the binary format of writeBinary()
+    MembraneMesh(const std::string& fileName, const std::vector<char>& contents, Reordering reordering);
+    MembraneMesh(const std::string& initialMesh, const std::vector<char>& initialContents,
+                 const std::string& stressFreeMesh, const std::vector<char>& stressFreeContents,
+                 Reordering reordering);
 
     MembraneMesh(const std::vector<float3>& vertices,
-                 const std::vector<int3>& faces);
+                 const std::vector<int3>& faces,
+                 Reordering reordering = Reordering::None);
     
     MembraneMesh(const std::vector<float3>& vertices,
                  const std::vector<float3>& stressFreeVertices,
-                 const std::vector<int3>& faces);
+                 const std::vector<int3>& faces,
+                 Reordering reordering = Reordering::None);
+
+    /**
+     * Several meshes in one, the objects of a MembraneVector choose their mesh type independently.
+     * Every type is padded to the largest number of vertices and triangles:
+     * the per-vertex quantities of type t start at vertex t * getNvertices(),
+     * its triangles at t * getNtriangles().
+     * Padding vertices have no neighbours and padding triangles are degenerate.
+     */
+    MembraneMesh(const std::vector<std::shared_ptr<MembraneMesh>>& types);
 
     MembraneMesh(MembraneMesh&&);
     MembraneMesh& operator=(MembraneMesh&&);
@@ -25,8 +51,28 @@ public:
     ~MembraneMesh();
 
     PinnedBuffer<int> adjacent, degrees;
+    PinnedBuffer<int> reverseAdjacent; ///< for each entry of adjacent: position of the vertex in the ring of that neighbour
     PinnedBuffer<float> initialLengths, initialAreas, initialDotProducts;
 
+    /// total area and volume of the stress-free shape
+    float2 stressFreeAreaVolume {0.f, 0.f};
+
+    /// stress-free area and volume of each type relative to the first one, empty with a single type
+    PinnedBuffer<float2> relativeAreaVolumes;
+
+    int getNtypes() const override;
+    const MembraneMesh& getMeshType(int type) const;
+
+    /**
+     * Write the mesh with its adjacency and stress-free quantities,
+     * such that reading it back does not need to recompute them.
+     * The vertices are stored in their current order, together with the original ids.
+     */
+    void writeBinary(const std::string& fileName) const;
+
+    /// true if the contents of a file are in the binary format of writeBinary()
+    static bool isBinary(const std::vector<char>& contents);
+
 
 protected:
     void findAdjacent();
@@ -35,15 +81,40 @@ protected:
     void _computeInitialLengths(const PinnedBuffer<float4>& vertices);
     void _computeInitialAreas(const PinnedBuffer<float4>& vertices);
     void _computeInitialDotProducts(const PinnedBuffer<float4>& vertices); /// used in Lim to determine if cos(phi) < 0
+    void _computeStressFreeAreaVolume(const PinnedBuffer<float4>& vertices);
+
+    void _readBinary(const std::string& fileName, const std::vector<char>& contents);
+
+    std::vector<std::shared_ptr<MembraneMesh>> types; ///< empty with a single type
 };
 
 struct MembraneMeshView : public MeshView
 {
     int maxDegree;
 
-    int *adjacent, *degrees;
+    int *adjacent, *degrees, *reverseAdjacent;
     float *initialLengths, *initialAreas, *initialDotProducts;
 
-    MembraneMeshView(const MembraneMesh *m);
+    const int *meshTypes;        ///< type of each object, nullptr with a single type
+    float2 *relativeAreaVolumes; ///< nullptr with a single type
+
+    MembraneMeshView(const MembraneMesh *m, const int *meshTypes = nullptr);
+
+    __D__ inline int getType(int objId) const
+    {
+        return meshTypes == nullptr ? 0 : meshTypes[objId];
+    }
+
+    /// index of the vertex locId of the object objId in the per-vertex quantities of the mesh
+    __D__ inline int vertexId(int objId, int locId) const
+    {
+        return getType(objId) * nvertices + locId;
+    }
+
+    /// index of the first triangle of the object objId
+    __D__ inline int firstTriangle(int objId) const
+    {
+        return getType(objId) * ntriangles;
+    }
 };
 
@@ -1,22 +1,21 @@
 #include "mesh.h"
+#include "loader.h"
 
 #include <core/utils/cuda_common.h>
 
-#include <fstream>
+#include <sstream>
 #include <vector>
 
 Mesh::Mesh()
 {}
 
-Mesh::Mesh(const std::string& fname)
-{
-    _readOff(fname);
-    _check();
-
-    vertexCoordinates.uploadToDevice(defaultStream);
-    triangles.uploadToDevice(defaultStream);
+Mesh::Mesh(const std::string& fname) :
+    Mesh(fname, MeshLoader::readFile(fname))
+{}
 
-    _computeMaxDegree();
+Mesh::Mesh(const std::string& fname, const std::vector<char>& offContents)
+{
+    _initFromOff(fname, offContents);
 }
 
 Mesh::Mesh(const std::vector<float3>& vertices, const std::vector<int3>& faces)
@@ -58,6 +57,11 @@ const int& Mesh::getMaxDegree() const {
     return maxDegree;
 }
 
+int Mesh::getNtypes() const
+{
+    return 1;
+}
+
 PyTypes::VectorOfFloat3 Mesh::getVertices()
 {
     vertexCoordinates.downloadFromDevice(defaultStream, ContainersSynch::Synch);
@@ -86,6 +90,21 @@ PyTypes::VectorOfInt3 Mesh::getTriangles()
     return ret;
 }
 
+const std::vector<int>& Mesh::getOriginalIds() const
+{
+    return originalIds;
+}
+
+std::vector<int3> Mesh::getOriginalTriangles() const
+{
+    std::vector<int3> faces(triangles.begin(), triangles.end());
+
+    if (!originalIds.empty())
+        for (auto& t : faces)
+            t = make_int3(originalIds[t.x], originalIds[t.y], originalIds[t.z]);
+
+    return faces;
+}
 
 void Mesh::_computeMaxDegree()
 {
@@ -115,13 +134,11 @@ void Mesh::_check() const
     }
 }
 
-void Mesh::_readOff(const std::string& fname)
+void Mesh::_readOff(const std::string& fname, const std::vector<char>& contents)
 {
-   std::ifstream fin(fname);
-    if (!fin.good())
-        die("Mesh file '%s' not found", fname.c_str());
+    std::istringstream fin(std::string(contents.begin(), contents.end()));
 
-    debug("Reading mesh from file '%s'", fname.c_str());
+    debug("Parsing OFF mesh '%s'", fname.c_str());
 
     std::string line;
     std::getline(fin, line); // OFF header
@@ -149,6 +166,48 @@ void Mesh::_readOff(const std::string& fname)
     }
 }
 
+void Mesh::_initFromOff(const std::string& fname, const std::vector<char>& contents)
+{
+    _readOff(fname, contents);
+    _check();
+
+    vertexCoordinates.uploadToDevice(defaultStream);
+    triangles.uploadToDevice(defaultStream);
+
+    _computeMaxDegree();
+}
+
+std::vector<int> Mesh::_reorderVertices(MeshReordering::Method method)
+{
+    std::vector<float3> vertices(nvertices);
+    for (int i = 0; i < nvertices; ++i)
+        vertices[i] = make_float3(vertexCoordinates[i].x, vertexCoordinates[i].y, vertexCoordinates[i].z);
+
+    const std::vector<int3> faces(triangles.begin(), triangles.end());
+
+    const auto order  = MeshReordering::computeOrder(method, vertices, faces);
+    const auto newIds = MeshReordering::invert(order);
+
+    MeshReordering::permute(order, vertexCoordinates);
+
+    for (auto& t : triangles)
+        t = make_int3(newIds[t.x], newIds[t.y], newIds[t.z]);
+
+    // compose with a previous reordering
+    if (originalIds.empty())
+        originalIds = order;
+    else
+        MeshReordering::permute(order, originalIds);
+
+    vertexCoordinates.uploadToDevice(defaultStream);
+    triangles.uploadToDevice(defaultStream);
+
+    debug("Reordered the %d vertices of the mesh with method '%s'",
+          nvertices, MeshReordering::getMethodStr(method).c_str());
+
+    return order;
+}
+
 
 MeshView::MeshView(const Mesh *m) :
     nvertices  (m->getNvertices()),
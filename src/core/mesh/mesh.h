@@ -1,5 +1,7 @@
 #pragma once
 
+#include "reordering.h"
+
 #include <core/containers.h>
 #include <core/utils/pytypes.h>
 
@@ -14,6 +16,7 @@ public:
 
     Mesh();
     Mesh(const std::string& filename);
+    Mesh(const std::string& filename, const std::vector<char>& offContents); ///< from the contents of an OFF file already read
     Mesh(const std::vector<float3>& vertices, const std::vector<int3>& faces);
 
     Mesh(Mesh&&);
@@ -25,18 +28,32 @@ public:
     const int& getNvertices() const;
     const int& getMaxDegree() const;
 
+    /// number of different meshes held by this object, see MembraneMesh
+    virtual int getNtypes() const;
+
     PyTypes::VectorOfFloat3 getVertices();
     PyTypes::VectorOfInt3  getTriangles();
 
+    /// original index of each vertex, empty if the vertices were not reordered
+    const std::vector<int>& getOriginalIds() const;
+
+    /// triangles with the vertex indices of the input mesh
+    std::vector<int3> getOriginalTriangles() const;
+
 protected:
     // max degree of a vertex in mesh
     int maxDegree {-1};
     void _computeMaxDegree();
     void _check() const;
-    void _readOff(const std::string& fname);
+    void _readOff(const std::string& fname, const std::vector<char>& contents);
+    void _initFromOff(const std::string& fname, const std::vector<char>& contents);
+
+    /// renumber the vertices on the host and upload the result; @return the new order (order[newId] = oldId)
+    std::vector<int> _reorderVertices(MeshReordering::Method method);
 
 protected:
     int nvertices{0}, ntriangles{0};
+    std::vector<int> originalIds;
 };
 
 
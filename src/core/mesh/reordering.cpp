@@ -0,0 +1,234 @@
+#include "reordering.h"
+
+#include <core/logger.h>
+#include <core/utils/space_filling_curve.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <queue>
+
+namespace MeshReordering
+{
+
+Method getMethod(const std::string& name)
+{
+    if (name == "none")    return Method::None;
+    if (name == "rcm")     return Method::ReverseCuthillMcKee;
+    if (name == "hilbert") return Method::Hilbert;
+
+    die("Unknown mesh reordering '%s', expected one of 'none', 'rcm' or 'hilbert'", name.c_str());
+    return Method::None;
+}
+
+std::string getMethodStr(Method method)
+{
+    switch (method)
+    {
+    case Method::None:                return "none";
+    case Method::ReverseCuthillMcKee: return "rcm";
+    case Method::Hilbert:             return "hilbert";
+    }
+    return "unknown";
+}
+
+using Adjacency = std::vector< std::vector<int> >;
+
+static Adjacency computeAdjacency(int nvertices, const std::vector<int3>& triangles)
+{
+    Adjacency adjacency(nvertices);
+
+    auto addEdge = [&adjacency] (int a, int b)
+    {
+        adjacency[a].push_back(b);
+        adjacency[b].push_back(a);
+    };
+
+    for (const auto& t : triangles)
+    {
+        addEdge(t.x, t.y);
+        addEdge(t.y, t.z);
+        addEdge(t.z, t.x);
+    }
+
+    for (auto& neighbours : adjacency)
+    {
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    }
+    return adjacency;
+}
+
+// breadth first traversal of the connected component of root;
+// returns the vertices of the last level, sets the number of levels
+static std::vector<int> lastLevel(const Adjacency& adjacency, int root, int& nlevels)
+{
+    std::vector<int> depth(adjacency.size(), -1);
+    std::queue<int> queue;
+
+    depth[root] = 0;
+    queue.push(root);
+    int maxDepth = 0;
+
+    while (!queue.empty())
+    {
+        const int v = queue.front();
+        queue.pop();
+        maxDepth = std::max(maxDepth, depth[v]);
+
+        for (int u : adjacency[v])
+        {
+            if (depth[u] >= 0) continue;
+            depth[u] = depth[v] + 1;
+            queue.push(u);
+        }
+    }
+
+    std::vector<int> last;
+    for (size_t v = 0; v < depth.size(); ++v)
+        if (depth[v] == maxDepth)
+            last.push_back(v);
+
+    nlevels = maxDepth + 1;
+    return last;
+}
+
+// George & Liu heuristic: move the root to the far end of the component
+// as long as this increases the number of levels
+static int findPseudoPeripheralVertex(const Adjacency& adjacency, int root)
+{
+    auto degreeLess = [&adjacency] (int a, int b)
+    {
+        return adjacency[a].size() < adjacency[b].size();
+    };
+
+    int nlevels;
+    auto last = lastLevel(adjacency, root, nlevels);
+
+    while (true)
+    {
+        const int candidate = *std::min_element(last.begin(), last.end(), degreeLess);
+
+        int candidateLevels;
+        auto candidateLast = lastLevel(adjacency, candidate, candidateLevels);
+
+        if (candidateLevels <= nlevels)
+            return root;
+
+        root    = candidate;
+        nlevels = candidateLevels;
+        last    = std::move(candidateLast);
+    }
+}
+
+static std::vector<int> reverseCuthillMcKee(int nvertices, const std::vector<int3>& triangles)
+{
+    const auto adjacency = computeAdjacency(nvertices, triangles);
+
+    auto degreeLess = [&adjacency] (int a, int b)
+    {
+        const size_t da = adjacency[a].size(), db = adjacency[b].size();
+        return da < db || (da == db && a < b);
+    };
+
+    // each connected component starts from its vertex of lowest degree
+    std::vector<int> candidates(nvertices);
+    std::iota(candidates.begin(), candidates.end(), 0);
+    std::sort(candidates.begin(), candidates.end(), degreeLess);
+
+    std::vector<bool> numbered(nvertices, false);
+    std::vector<int> order;
+    order.reserve(nvertices);
+
+    std::vector<int> neighbours;
+
+    for (int start : candidates)
+    {
+        if (numbered[start]) continue;
+
+        const int root = findPseudoPeripheralVertex(adjacency, start);
+        numbered[root] = true;
+        order.push_back(root);
+
+        for (size_t head = order.size() - 1; head < order.size(); ++head)
+        {
+            neighbours.clear();
+            for (int u : adjacency[order[head]])
+                if (!numbered[u])
+                    neighbours.push_back(u);
+
+            std::sort(neighbours.begin(), neighbours.end(), degreeLess);
+
+            for (int u : neighbours)
+            {
+                numbered[u] = true;
+                order.push_back(u);
+            }
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+static std::vector<int> hilbertOrder(const std::vector<float3>& vertices)
+{
+    const int nvertices = vertices.size();
+    const int bits = 10;
+
+    float3 lo = vertices[0], hi = vertices[0];
+    for (const auto& r : vertices)
+    {
+        lo = make_float3(std::min(lo.x, r.x), std::min(lo.y, r.y), std::min(lo.z, r.z));
+        hi = make_float3(std::max(hi.x, r.x), std::max(hi.y, r.y), std::max(hi.z, r.z));
+    }
+
+    const float extent = std::max({hi.x - lo.x, hi.y - lo.y, hi.z - lo.z, 1e-6f});
+    const float scale = ((1 << bits) - 1) / extent;
+
+    std::vector<uint64_t> keys(nvertices);
+    for (int i = 0; i < nvertices; ++i)
+    {
+        const auto& r = vertices[i];
+        keys[i] = SpaceFillingCurve::hilbertKey(static_cast<uint32_t>((r.x - lo.x) * scale),
+                                                static_cast<uint32_t>((r.y - lo.y) * scale),
+                                                static_cast<uint32_t>((r.z - lo.z) * scale), bits);
+    }
+
+    std::vector<int> order(nvertices);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys] (int a, int b) { return keys[a] < keys[b]; });
+    return order;
+}
+
+std::vector<int> computeOrder(Method method,
+                              const std::vector<float3>& vertices,
+                              const std::vector<int3>& triangles)
+{
+    const int nvertices = vertices.size();
+
+    if (nvertices == 0 || method == Method::None)
+    {
+        std::vector<int> order(nvertices);
+        std::iota(order.begin(), order.end(), 0);
+        return order;
+    }
+
+    switch (method)
+    {
+    case Method::ReverseCuthillMcKee: return reverseCuthillMcKee(nvertices, triangles);
+    case Method::Hilbert:             return hilbertOrder(vertices);
+    default: die("Unknown mesh reordering %d", static_cast<int>(method));
+    }
+    return {};
+}
+
+std::vector<int> invert(const std::vector<int>& order)
+{
+    std::vector<int> inverse(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        inverse[order[i]] = i;
+    return inverse;
+}
+
+} // namespace MeshReordering
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cuda_runtime.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * Renumbering of the vertices of a mesh.
+ * Neighbouring vertices get close indices, which improves the memory locality
+ * of the kernels that loop over the vertices and read their neighbours.
+ */
+namespace MeshReordering
+{
+
+enum class Method {None, ReverseCuthillMcKee, Hilbert};
+
+Method getMethod(const std::string& name);
+std::string getMethodStr(Method method);
+
+/**
+ * New order of the vertices: order[newId] = oldId.
+ * ReverseCuthillMcKee minimizes the bandwidth of the vertex adjacency,
+ * Hilbert sorts the vertices along a Hilbert curve covering their bounding box.
+ * The result is the identity for Method::None.
+ */
+std::vector<int> computeOrder(Method method,
+                              const std::vector<float3>& vertices,
+                              const std::vector<int3>& triangles);
+
+/// inverse of a permutation: inverse[order[i]] = i
+std::vector<int> invert(const std::vector<int>& order);
+
+/// data[i] <- data[order[i]]
+template <class Container>
+void permute(const std::vector<int>& order, Container& data)
+{
+    const std::vector<typename Container::value_type> copy(data.begin(), data.end());
+
+    for (size_t i = 0; i < order.size(); ++i)
+        data[i] = copy[order[i]];
+}
+
+} // namespace MeshReordering
@@ -6,13 +6,17 @@
 #include <core/integrators/interface.h>
 #include <core/interactions/interface.h>
 #include <core/logger.h>
+#include <core/mesh/loader.h>
 #include <core/object_belonging/interface.h>
 #include <core/postproc.h>
 #include <core/pvs/object_vector.h>
 #include <core/pvs/particle_vector.h>
 #include <core/simulation.h>
+#include <core/utils/cache.h>
 #include <core/utils/cuda_common.h>
 #include <core/utils/folders.h>
+#include <core/utils/postprocess_ranks.h>
+#include <core/utils/space_filling_curve.h>
 #include <core/version.h>
 #include <core/walls/interface.h>
 #include <core/walls/simple_stationary_wall.h>
@@ -64,7 +68,7 @@ static void selectIntraNodeGPU(const MPI_Comm& source)
 }
 
 void Mirheo::init(int3 nranks3D, float3 globalDomainSize, float dt, LogInfo logInfo,
-                  CheckpointInfo checkpointInfo, bool gpuAwareMPI)
+                  CheckpointInfo checkpointInfo, bool gpuAwareMPI, int computeRanksPerPostprocess)
 {
     int nranks;
 
@@ -75,9 +79,20 @@ void Mirheo::init(int3 nranks3D, float3 globalDomainSize, float dt, LogInfo logI
     MPI_Check( MPI_Comm_size(comm, &nranks) );
     MPI_Check( MPI_Comm_rank(comm, &rank) );
 
-    if      (nranks3D.x * nranks3D.y * nranks3D.z     == nranks) noPostprocess = true;
-    else if (nranks3D.x * nranks3D.y * nranks3D.z * 2 == nranks) noPostprocess = false;
-    else die("Asked for %d x %d x %d processes, but provided %d", nranks3D.x, nranks3D.y, nranks3D.z, nranks);
+    // all the ranks run the same script, hence they create the same meshes
+    MeshLoader::setCommunicator(comm);
+
+    if (computeRanksPerPostprocess < 1)
+        die("Each postprocess rank must serve at least one simulation rank, got %d", computeRanksPerPostprocess);
+
+    const int nCompute = nranks3D.x * nranks3D.y * nranks3D.z;
+    const int nPost = PostprocessRanks::nPostprocessRanks(nCompute, computeRanksPerPostprocess);
+
+    if      (nCompute         == nranks) noPostprocess = true;
+    else if (nCompute + nPost == nranks) noPostprocess = false;
+    else die("Asked for %d x %d x %d simulation processes and %d simulation processes per postprocess process, "
+             "so expecting %d (without postprocess) or %d processes, but provided %d",
+             nranks3D.x, nranks3D.y, nranks3D.z, computeRanksPerPostprocess, nCompute, nCompute + nPost, nranks);
 
     if (rank == 0 && !logInfo.noSplash)
         sayHello();
@@ -97,15 +112,22 @@ void Mirheo::init(int3 nranks3D, float3 globalDomainSize, float dt, LogInfo logI
         return;
     }
 
-    info("Program started, splitting communicator");
+    info("Program started, splitting communicator into %d simulation and %d postprocess ranks", nCompute, nPost);
 
     MPI_Comm splitComm;
-    
-    computeTask = rank % 2;
+
+    // every postprocess rank comes right after the block of simulation ranks it serves,
+    // so that they are likely to share a node
+    int group = 0;
+    while (PostprocessRanks::firstComputeRank(group + 1, nCompute, nPost) + group + 1 <= rank)
+        ++group;
+
+    const int groupPostRank = PostprocessRanks::firstComputeRank(group + 1, nCompute, nPost) + group;
+    computeTask = (rank == groupPostRank) ? 1 : 0;
     MPI_Check( MPI_Comm_split(comm, computeTask, rank, &splitComm) );
 
     const int localLeader  = 0;
-    const int remoteLeader = isComputeTask() ? 1 : 0;
+    const int remoteLeader = isComputeTask() ? PostprocessRanks::nComputeRanks(0, nCompute, nPost) : 0;
     const int tag = 42;
 
     if (isComputeTask())
@@ -152,29 +174,32 @@ void Mirheo::initLogger(MPI_Comm comm, LogInfo logInfo)
 }
 
 Mirheo::Mirheo(int3 nranks3D, float3 globalDomainSize, float dt,
-               LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI)
+               LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI,
+               int computeRanksPerPostprocess)
 {
     MPI_Init(nullptr, nullptr);
     MPI_Comm_dup(MPI_COMM_WORLD, &comm);
     initializedMpi = true;
 
-    init(nranks3D, globalDomainSize, dt, logInfo, checkpointInfo, gpuAwareMPI);
+    init(nranks3D, globalDomainSize, dt, logInfo, checkpointInfo, gpuAwareMPI, computeRanksPerPostprocess);
 }
 
 Mirheo::Mirheo(long commAddress, int3 nranks3D, float3 globalDomainSize, float dt,
-               LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI)
+               LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI,
+               int computeRanksPerPostprocess)
 {
     // see https://stackoverflow.com/questions/49259704/pybind11-possible-to-use-mpi4py
     MPI_Comm comm = *((MPI_Comm*) commAddress);
     MPI_Comm_dup(comm, &this->comm);
-    init(nranks3D, globalDomainSize, dt, logInfo, checkpointInfo, gpuAwareMPI);    
+    init(nranks3D, globalDomainSize, dt, logInfo, checkpointInfo, gpuAwareMPI, computeRanksPerPostprocess);    
 }
 
 Mirheo::Mirheo(MPI_Comm comm, int3 nranks3D, float3 globalDomainSize, float dt,
-               LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI)
+               LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI,
+               int computeRanksPerPostprocess)
 {
     MPI_Comm_dup(comm, &this->comm);
-    init(nranks3D, globalDomainSize, dt, logInfo, checkpointInfo, gpuAwareMPI);
+    init(nranks3D, globalDomainSize, dt, logInfo, checkpointInfo, gpuAwareMPI, computeRanksPerPostprocess);
 }
 
 static void safeCommFree(MPI_Comm *comm)
@@ -190,6 +215,8 @@ Mirheo::~Mirheo()
     sim.reset();
     post.reset();
 
+    MeshLoader::setCommunicator(MPI_COMM_NULL);
+
     safeCommFree(&comm);
     safeCommFree(&cartComm);
     safeCommFree(&ioComm);
@@ -301,6 +328,24 @@ void Mirheo::setWallBounce(Wall *wall, ParticleVector *pv, float maximumPartTrav
         sim->setWallBounce(wall->name, pv->name, maximumPartTravel);
 }
 
+void Mirheo::setCellListOrdering(const std::string& ordering)
+{
+    checkNotInitialized();
+
+    const auto order = SpaceFillingCurve::getOrdering(ordering);
+    
+    if (isComputeTask())
+        sim->setCellListOrdering(order);
+}
+
+void Mirheo::setPartialObjectHalo(ObjectVector *ov)
+{
+    checkNotInitialized();
+
+    if (isComputeTask())
+        sim->setPartialObjectHalo(ov->name);
+}
+
 MirState* Mirheo::getState()
 {
     return state.get();
@@ -364,7 +409,8 @@ std::shared_ptr<ParticleVector> Mirheo::makeFrozenWallParticles(std::string pvNa
                                                                std::vector<std::shared_ptr<Wall>> walls,
                                                                std::vector<std::shared_ptr<Interaction>> interactions,
                                                                std::shared_ptr<Integrator> integrator,
-                                                               float density, int nsteps)
+                                                               float density, int nsteps,
+                                                               const std::string& cacheFolder)
 {
     checkNotInitialized();
     
@@ -393,46 +439,73 @@ std::shared_ptr<ParticleVector> Mirheo::makeFrozenWallParticles(std::string pvNa
         info("Working with wall '%s'", wall->name.c_str());   
     }
 
-    MirState stateCpy = *getState();
-    
-    Simulation wallsim(sim->cartComm, MPI_COMM_NULL, getState());
-
     float mass = 1.0;
     auto pv = std::make_shared<ParticleVector>(getState(), pvName, mass);
-    auto ic = std::make_shared<UniformIC>(density);
+
+    std::string cacheFileName;
+    bool fromCache = false;
+    
+    if (!cacheFolder.empty())
+    {
+        // interaction parameters other than the cutoff are not part of the key
+        Cache::Key key;
+        key.add(density).add(nsteps).add(mass).add(state->dt).add(integrator->name);
+        for (auto& interaction : interactions)
+            key.add(interaction->name).add(interaction->rc);
+        WallHelpers::addWallsToCacheKey(sdfWalls, state->domain, key);
+
+        createFoldersCollective(sim->cartComm, cacheFolder);
+        cacheFileName = Cache::rankFileName(cacheFolder, "frozen", key, sim->cartComm);
+        fromCache = WallHelpers::loadFrozenParticles(cacheFileName, pv.get(), sim->cartComm);
+    }
+
+    if (!fromCache)
+    {
+        MirState stateCpy = *getState();
+    
+        Simulation wallsim(sim->cartComm, MPI_COMM_NULL, getState());
+
+        auto ic = std::make_shared<UniformIC>(density);
     
-    wallsim.registerParticleVector(pv, ic);
+        wallsim.registerParticleVector(pv, ic);
     
-    wallsim.registerIntegrator(integrator);
+        wallsim.registerIntegrator(integrator);
     
-    wallsim.setIntegrator (integrator->name,  pv->name);
+        wallsim.setIntegrator (integrator->name,  pv->name);
 
-    for (auto& interaction : interactions) {
-        wallsim.registerInteraction(interaction);        
-        wallsim.setInteraction(interaction->name, pv->name, pv->name);
-    }
+        for (auto& interaction : interactions) {
+            wallsim.registerInteraction(interaction);        
+            wallsim.setInteraction(interaction->name, pv->name, pv->name);
+        }
     
-    wallsim.init();
-    wallsim.run(nsteps);
+        wallsim.init();
+        wallsim.run(nsteps);
 
-    float effectiveCutoff = wallsim.getMaxEffectiveCutoff();
+        float effectiveCutoff = wallsim.getMaxEffectiveCutoff();
     
-    const float wallThicknessTolerance = 0.2f;
-    const float wallLevelSet = 0.0f;
-    float wallThickness = effectiveCutoff + wallThicknessTolerance;
+        const float wallThicknessTolerance = 0.2f;
+        const float wallLevelSet = 0.0f;
+        float wallThickness = effectiveCutoff + wallThicknessTolerance;
 
-    info("wall thickness is set to %g", wallThickness);
+        info("wall thickness is set to %g", wallThickness);
     
-    WallHelpers::freezeParticlesInWalls(sdfWalls, pv.get(), wallLevelSet, wallLevelSet + wallThickness);
-    info("\n");
+        WallHelpers::freezeParticlesInWalls(sdfWalls, pv.get(), wallLevelSet, wallLevelSet + wallThickness);
+        info("\n");
+
+        if (!cacheFolder.empty())
+            WallHelpers::storeFrozenParticles(cacheFileName, pv.get());
+
+        // go back to initial state
+        *state = stateCpy;
+    }
 
+    // frozen particles are not integrated: their halo and cell-lists are only rebuilt after an invalidation
+    pv->invalidate();
+    
     sim->registerParticleVector(pv, nullptr);
 
     for (auto &wall : walls)
         wall->attachFrozen(pv.get());
-
-    // go back to initial state
-    *state = stateCpy;
     
     return pv;
 }
@@ -35,13 +35,16 @@ class Mirheo
 {
 public:
     Mirheo(int3 nranks3D, float3 globalDomainSize, float dt,
-           LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI=false);
+           LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI=false,
+           int computeRanksPerPostprocess=1);
 
     Mirheo(long commAddress, int3 nranks3D, float3 globalDomainSize, float dt,
-           LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI=false);
+           LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI=false,
+           int computeRanksPerPostprocess=1);
 
     Mirheo(MPI_Comm comm, int3 nranks3D, float3 globalDomainSize, float dt,
-           LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI=false);
+           LogInfo logInfo, CheckpointInfo checkpointInfo, bool gpuAwareMPI=false,
+           int computeRanksPerPostprocess=1);
 
     ~Mirheo();
     
@@ -71,6 +74,9 @@ public:
     void setBouncer     (Bouncer *bouncer, ObjectVector *ov, ParticleVector *pv);
     void setWallBounce  (Wall *wall, ParticleVector *pv, float maximumPartTravel = 0.25f);
 
+    void setCellListOrdering(const std::string& ordering);
+    void setPartialObjectHalo(ObjectVector *ov);
+
     MirState* getState();
     const MirState* getState() const;
     std::shared_ptr<MirState> getMirState();
@@ -82,7 +88,8 @@ public:
                                                             std::vector<std::shared_ptr<Wall>> walls,
                                                             std::vector<std::shared_ptr<Interaction>> interactions,
                                                             std::shared_ptr<Integrator> integrator,
-                                                            float density, int nsteps);
+                                                            float density, int nsteps,
+                                                            const std::string& cacheFolder = "");
 
     std::shared_ptr<ParticleVector> makeFrozenRigidParticles(std::shared_ptr<ObjectBelongingChecker> checker,
                                                              std::shared_ptr<ObjectVector> shape,
@@ -119,7 +126,7 @@ private:
     MPI_Comm interComm {MPI_COMM_NULL}; ///< intercommunicator between postprocess and simulation
 
     void init(int3 nranks3D, float3 globalDomainSize, float dt, LogInfo logInfo,
-              CheckpointInfo checkpointInfo, bool gpuAwareMPI);
+              CheckpointInfo checkpointInfo, bool gpuAwareMPI, int computeRanksPerPostprocess);
     void initLogger(MPI_Comm comm, LogInfo logInfo);
     void sayHello();
     void setup();
@@ -147,6 +147,10 @@ __global__ void insideMesh(const OVview ovView, const MeshView mesh, const float
 
 void MeshBelongingChecker::tagInner(ParticleVector *pv, CellList *cl, cudaStream_t stream)
 {
+    if (ov->mesh->getNtypes() > 1)
+        die("Belonging checker '%s': the mesh of several types of '%s' is not supported",
+            name.c_str(), ov->name.c_str());
+
     tags.resize_anew(pv->local()->size());
     tags.clearDevice(stream);
 
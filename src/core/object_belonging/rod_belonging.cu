@@ -58,23 +58,15 @@ __global__ void setInsideTags(RVview rvView, float radius, PVview pvView, CellLi
     const int3 cidLow  = cinfo.getCellIdAlongAxes(lo - (radius + tol));
     const int3 cidHigh = cinfo.getCellIdAlongAxes(hi + (radius + tol));
 
-    int3 cid3;
-
     #pragma unroll 2
-    for (cid3.z = cidLow.z; cid3.z <= cidHigh.z; ++cid3.z)
+    for (int cellZ = cidLow.z; cellZ <= cidHigh.z; ++cellZ)
     {
-        for (cid3.y = cidLow.y; cid3.y <= cidHigh.y; ++cid3.y)
+        for (int cellY = cidLow.y; cellY <= cidHigh.y; ++cellY)
         {
-            cid3.x = cidLow.x;
-            int cidLo = max(cinfo.encode(cid3), 0);
-            
-            cid3.x = cidHigh.x;
-            int cidHi = min(cinfo.encode(cid3)+1, cinfo.totcells);
-            
-            int pstart = cinfo.cellStarts[cidLo];
-            int pend   = cinfo.cellStarts[cidHi];
-            
-            setTagsCell(pstart, pend, radius, r0, r1, pvView, tags);
+            cinfo.forEachRowRange(cidLow.x, cidHigh.x, cellY, cellZ, [&](int pstart, int pend)
+            {
+                setTagsCell(pstart, pend, radius, r0, r1, pvView, tags);
+            });
         }
     }
 }
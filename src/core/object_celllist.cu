@@ -0,0 +1,178 @@
+#include "object_celllist.h"
+
+#include <core/logger.h>
+#include <core/pvs/object_vector.h>
+#include <core/pvs/views/ov.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/kernel_launch.h>
+
+#include <extern/cub/cub/device/device_scan.cuh>
+
+#include <algorithm>
+
+namespace ObjectCellListKernels
+{
+
+__global__ void computeCellSizesAndReach(OVview view, CellListInfo cinfo, float3 *maxReach)
+{
+    const int objId = blockIdx.x * blockDim.x + threadIdx.x;
+    if (objId >= view.nObjects) return;
+
+    const auto e = view.comAndExtents[objId];
+    const float3 reach = fmaxf(e.high - e.com, e.com - e.low);
+
+    // non negative floats are ordered as their bits
+    atomicMax((int*) &maxReach->x, __float_as_int(reach.x));
+    atomicMax((int*) &maxReach->y, __float_as_int(reach.y));
+    atomicMax((int*) &maxReach->z, __float_as_int(reach.z));
+
+    const int cid = cinfo.getCellId<CellListsProjection::Clamp>(e.com);
+    atomicAdd(cinfo.cellSizes + cid, 1);
+}
+
+__global__ void sortObjectIds(OVview view, CellListInfo cinfo, int *sortedIds)
+{
+    const int objId = blockIdx.x * blockDim.x + threadIdx.x;
+    if (objId >= view.nObjects) return;
+
+    const int cid = cinfo.getCellId<CellListsProjection::Clamp>(view.comAndExtents[objId].com);
+    const int dstId = cinfo.cellStarts[cid] + atomicAdd(cinfo.cellSizes + cid, 1);
+    sortedIds[dstId] = objId;
+}
+
+__global__ void findOverlappingPairs(ObjectCellListInfo cinfo, float margin,
+                                     int maxPairs, int *nPairs, int2 *pairs)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= cinfo.nObjects) return;
+
+    const auto e = cinfo.comAndExtents[i];
+
+    cinfo.forEachObjectOverlapping(e.low - margin, e.high + margin, [&](int j)
+    {
+        if (j <= i) return;
+
+        const int id = atomicAdd(nPairs, 1);
+        if (id < maxPairs)
+            pairs[id] = {i, j};
+    });
+}
+
+} // namespace ObjectCellListKernels
+
+//=================================================================================
+// Info
+//=================================================================================
+
+// there is at least one cell in each direction
+ObjectCellListInfo::ObjectCellListInfo(float rc, float3 localDomainSize) :
+    CellListInfo(std::min({rc, localDomainSize.x, localDomainSize.y, localDomainSize.z}), localDomainSize)
+{}
+
+//=================================================================================
+// Object cell-lists
+//=================================================================================
+
+ObjectCellList::ObjectCellList(ObjectVector *ov, float rc, float3 localDomainSize) :
+    ObjectCellListInfo(rc, localDomainSize),
+    ov(ov)
+{
+    cellSizes. resize_anew(totcells + 1);
+    cellStarts.resize_anew(totcells + 1);
+    reach.resize_anew(1);
+
+    debug("Initialized %s object cell-list with %dx%dx%d cells", ov->name.c_str(), ncells.x, ncells.y, ncells.z);
+}
+
+ObjectCellList::~ObjectCellList() = default;
+
+ObjectCellListInfo ObjectCellList::cellInfo()
+{
+    CellListInfo::cellSizes  = cellSizes.devPtr();
+    CellListInfo::cellStarts = cellStarts.devPtr();
+    objectIds = sortedIds.devPtr();
+    maxReach  = reach.devPtr();
+
+    return *((ObjectCellListInfo*)this);
+}
+
+void ObjectCellList::build(ParticleVectorLocality locality, cudaStream_t stream)
+{
+    ov->findExtentAndCOM(stream, locality);
+
+    OVview view(ov, ov->get(locality));
+    nObjects = view.nObjects;
+    comAndExtents = view.comAndExtents;
+
+    debug2("Building the object cell-list of %d %s objects (%s)",
+           nObjects, ov->name.c_str(), getParticleVectorLocalityStr(locality).c_str());
+
+    sortedIds.resize_anew(nObjects);
+    auto info = cellInfo();
+
+    const int nthreads = 128;
+    const int nblocks = getNblocks(nObjects, nthreads);
+
+    cellSizes.clear(stream);
+    reach.clear(stream);
+
+    SAFE_KERNEL_LAUNCH(
+            ObjectCellListKernels::computeCellSizesAndReach,
+            nblocks, nthreads, 0, stream,
+            view, info, reach.devPtr() );
+
+    // the number of cells does not change, neither does the scan buffer
+    size_t bufSize = scanBuffer.size();
+
+    if (bufSize == 0)
+    {
+        cub::DeviceScan::ExclusiveSum(nullptr, bufSize, cellSizes.devPtr(), cellStarts.devPtr(), totcells+1, stream);
+        scanBuffer.resize_anew(bufSize);
+    }
+    cub::DeviceScan::ExclusiveSum(scanBuffer.devPtr(), bufSize,
+                                  cellSizes.devPtr(), cellStarts.devPtr(), totcells+1, stream);
+
+    cellSizes.clear(stream);
+
+    SAFE_KERNEL_LAUNCH(
+            ObjectCellListKernels::sortObjectIds,
+            nblocks, nthreads, 0, stream,
+            view, info, sortedIds.devPtr() );
+}
+
+int ObjectCellList::findOverlappingPairs(float margin, cudaStream_t stream)
+{
+    const int nthreads = 128;
+    auto info = cellInfo();
+
+    // the search is repeated with a large enough table if the previous one was too small
+    auto find = [&]()
+    {
+        nPairs.clear(stream);
+
+        SAFE_KERNEL_LAUNCH(
+                ObjectCellListKernels::findOverlappingPairs,
+                getNblocks(nObjects, nthreads), nthreads, 0, stream,
+                info, margin, static_cast<int>(pairs.size()), nPairs.devPtr(), pairs.devPtr() );
+
+        nPairs.downloadFromDevice(stream);
+        return nPairs[0];
+    };
+
+    int n = find();
+
+    if (n > static_cast<int>(pairs.size()))
+    {
+        debug("Growing the table of %s object pairs to %d", ov->name.c_str(), n);
+        pairs.resize_anew(n);
+        n = find();
+    }
+
+    debug2("Found %d overlapping pairs of %s objects", n, ov->name.c_str());
+    return n;
+}
+
+const DeviceBuffer<int2>& ObjectCellList::getPairs() const
+{
+    return pairs;
+}
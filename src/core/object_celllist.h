@@ -0,0 +1,91 @@
+#pragma once
+
+#include "celllist.h"
+
+#include <core/containers.h>
+#include <core/datatypes.h>
+#include <core/pvs/particle_vector.h>
+
+class ObjectVector;
+
+/**
+ * Cell-lists of the objects of an ObjectVector, binned by their center of mass.
+ *
+ * An object may extend over several cells: a query looks into the cells
+ * enlarged by the largest distance between the center of mass and the extents
+ * of the objects, and tests the extents of the objects found there.
+ * The results do not depend on the cell size, which only changes the cost;
+ * a size close to the one of the objects is a good choice.
+ */
+class ObjectCellListInfo : public CellListInfo
+{
+public:
+    ObjectCellListInfo(float rc, float3 localDomainSize);
+
+    int nObjects {0};
+    const COMandExtent *comAndExtents {nullptr};
+    const int *objectIds {nullptr};   ///< ids of the objects sorted by cells, see cellStarts
+    const float3 *maxReach {nullptr}; ///< largest distance from the center of mass to the extents along each axis
+
+#ifdef __CUDACC__
+    __device__ static inline bool overlap(float3 lo0, float3 hi0, float3 lo1, float3 hi1)
+    {
+        return lo0.x <= hi1.x && lo1.x <= hi0.x
+            && lo0.y <= hi1.y && lo1.y <= hi0.y
+            && lo0.z <= hi1.z && lo1.z <= hi0.z;
+    }
+
+    /// call func(objId) for every object whose extents overlap the box [lo, hi]
+    template <typename Func>
+    __device__ inline void forEachObjectOverlapping(float3 lo, float3 hi, Func&& func) const
+    {
+        const float3 reach = *maxReach;
+        const int3 cidLow  = getCellIdAlongAxes(lo - reach);
+        const int3 cidHigh = getCellIdAlongAxes(hi + reach);
+
+        for (int cellZ = cidLow.z; cellZ <= cidHigh.z; ++cellZ)
+            for (int cellY = cidLow.y; cellY <= cidHigh.y; ++cellY)
+                forEachRowRange(cidLow.x, cidHigh.x, cellY, cellZ, [&](int start, int end)
+                {
+                    for (int i = start; i < end; ++i)
+                    {
+                        const int objId = objectIds[i];
+                        const auto& e = comAndExtents[objId];
+                        if (overlap(lo, hi, e.low, e.high))
+                            func(objId);
+                    }
+                });
+    }
+#endif
+};
+
+class ObjectCellList : public ObjectCellListInfo
+{
+public:
+    ObjectCellList(ObjectVector *ov, float rc, float3 localDomainSize);
+    ~ObjectCellList();
+
+    ObjectCellListInfo cellInfo();
+
+    /// bin the objects of the given locality, after computing their center of mass and extents
+    void build(ParticleVectorLocality locality, cudaStream_t stream);
+
+    /**
+     * Find the pairs of objects of the last build whose extents are at most margin apart along each axis.
+     * Each pair is given once as (i, j) with i < j, in no particular order.
+     * The pairs table grows as needed.
+     * @return the number of pairs, stored at the beginning of getPairs()
+     */
+    int findOverlappingPairs(float margin, cudaStream_t stream);
+    const DeviceBuffer<int2>& getPairs() const;
+
+protected:
+    ObjectVector *ov;
+
+    DeviceBuffer<char> scanBuffer;
+    DeviceBuffer<int> cellStarts, cellSizes, sortedIds;
+    DeviceBuffer<float3> reach;
+
+    PinnedBuffer<int> nPairs {1};
+    DeviceBuffer<int2> pairs;
+};
@@ -2,6 +2,7 @@
 
 #include <core/logger.h>
 #include <core/utils/common.h>
+#include <core/utils/postprocess_ranks.h>
 
 #include <mpi.h>
 #include <vector>
@@ -21,6 +22,7 @@ void Postprocess::registerPlugin(std::shared_ptr<PostprocessPlugin> plugin, int
 {
     info("New plugin registered: %s", plugin->name.c_str());
     plugin->setTag(tag);
+    pluginIdByTag[tag] = plugins.size();
     plugins.push_back( std::move(plugin) );
 }
 
@@ -34,29 +36,6 @@ void Postprocess::init()
     }
 }
 
-static std::vector<int> findGloballyReady(std::vector<MPI_Request>& requests, std::vector<MPI_Status>& statuses, MPI_Comm comm)
-{
-    int index;
-    MPI_Status stat;
-    MPI_Check( MPI_Waitany(requests.size(), requests.data(), &index, &stat) );
-    statuses[index] = stat;    
-
-    std::vector<int> mask(requests.size(), 0);
-    mask[index] = 1;
-    MPI_Check( MPI_Allreduce(MPI_IN_PLACE, mask.data(), mask.size(), MPI_INT, MPI_MAX, comm) );
-
-    std::vector<int> ids;
-    for (size_t i = 0; i < mask.size(); ++i)
-        if (mask[i] > 0)
-        {
-            ids.push_back(i);
-            if (requests[i] != MPI_REQUEST_NULL)
-                MPI_Check( MPI_Wait(&requests[i], &statuses[i]) );
-        }
-    
-    return ids;
-}
-
 static void safeCancelAndFreeRequest(MPI_Request& req)
 {
     if (req != MPI_REQUEST_NULL)
@@ -68,31 +47,24 @@ static void safeCancelAndFreeRequest(MPI_Request& req)
 
 void Postprocess::run()
 {
-    int endMsg {0}, checkpointId {0};
-
     std::vector<MPI_Request> requests;
     for (auto& pl : plugins)
         requests.push_back(pl->waitData());
 
-    const int stoppingReqIndex = requests.size();
-    requests.push_back( listenSimulation(stoppingTag, &endMsg) );
-
-    const int checkpointReqIndex = requests.size();
-    requests.push_back( listenSimulation(checkpointTag, &checkpointId) );
-
-    std::vector<MPI_Status> statuses(requests.size());
-    
     info("Postprocess is listening to messages now");
+
+    // Every postprocess rank receives the same sequence of events from its simulation ranks,
+    // hence the plugins execute their collective operations in the same order without global synchronization
     while (true)
     {
-        const auto readyIds = findGloballyReady(requests, statuses, comm);
+        const auto events = receiveEvents();
 
-        for (const auto& index : readyIds)
+        for (size_t i = 0; i < events.size(); ++i)
         {
-            if (index == stoppingReqIndex)
+            const int event = events[i];
+            
+            if (event == stoppingEvent)
             {
-                if (endMsg != stoppingMsg) die("Received wrong stopping message");
-    
                 info("Postprocess got a stopping message and will stop now");    
                 
                 for (auto& req : requests)
@@ -100,32 +72,50 @@ void Postprocess::run()
                 
                 return;
             }
-            else if (index == checkpointReqIndex)
+            else if (event == checkpointEvent)
             {
+                if (++i >= events.size())
+                    die("Received a checkpoint event without checkpoint id");
+
                 debug2("Postprocess got a request for checkpoint, executing now");
-                checkpoint(checkpointId);
-                requests[index] = listenSimulation(checkpointTag, &checkpointId);
+                checkpoint(events[i]);
             }
             else
             {
-                debug2("Postprocess got a request from plugin '%s', executing now", plugins[index]->name.c_str());
-                plugins[index]->recv();
-                plugins[index]->deserialize();
-                requests[index] = plugins[index]->waitData();
+                auto it = pluginIdByTag.find(event);
+                if (it == pluginIdByTag.end())
+                    die("Received data announcement for unknown plugin tag %d", event);
+                
+                const size_t id = it->second;
+                debug2("Postprocess got a request from plugin '%s', executing now", plugins[id]->name.c_str());
+                MPI_Check( MPI_Wait(&requests[id], MPI_STATUS_IGNORE) );
+                plugins[id]->recv();
+                plugins[id]->deserialize();
+                requests[id] = plugins[id]->waitData();
             }
         }
     }
 }
 
-MPI_Request Postprocess::listenSimulation(int tag, int *msg) const
+std::vector<int> Postprocess::receiveEvents() const
 {
-    int rank;
-    MPI_Request req;
-    
-    MPI_Check( MPI_Comm_rank(comm, &rank) );    
-    MPI_Check( MPI_Irecv(msg, 1, MPI_INT, rank, tag, interComm, &req) );
+    int rank, nranks, nSimRanks;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
+    MPI_Check( MPI_Comm_size(comm, &nranks) );
+    MPI_Check( MPI_Comm_remote_size(interComm, &nSimRanks) );
+
+    // the first simulation rank of the served block sends the events
+    const int source = PostprocessRanks::firstComputeRank(rank, nSimRanks, nranks);
 
-    return req;
+    MPI_Status status;
+    int count;
+    MPI_Check( MPI_Probe(source, postprocessEventsTag, interComm, &status) );
+    MPI_Check( MPI_Get_count(&status, MPI_INT, &count) );
+
+    std::vector<int> events(count);
+    MPI_Check( MPI_Recv(events.data(), count, MPI_INT, source, postprocessEventsTag, interComm, MPI_STATUS_IGNORE) );
+    
+    return events;
 }
 
 void Postprocess::restart(const std::string& folder)
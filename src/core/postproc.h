@@ -3,6 +3,7 @@
 #include <core/mirheo_object.h>
 #include <plugins/interface.h>
 
+#include <map>
 #include <memory>
 #include <mpi.h>
 
@@ -20,7 +21,7 @@ public:
     void checkpoint(int checkpointId);
 
 private:
-    MPI_Request listenSimulation(int tag, int *msg) const;
+    std::vector<int> receiveEvents() const;
     
     using MirObject::restart;
     using MirObject::checkpoint;
@@ -30,6 +31,7 @@ private:
     MPI_Comm interComm;
     
     std::vector< std::shared_ptr<PostprocessPlugin> > plugins;
+    std::map<int, size_t> pluginIdByTag;
 
     std::string checkpointFolder;
 };
@@ -5,7 +5,18 @@ MembraneVector::MembraneVector(const MirState *state, std::string name, float ma
                   std::make_unique<LocalObjectVector>(this, mptr->getNvertices(), nObjects),
                   std::make_unique<LocalObjectVector>(this, mptr->getNvertices(), 0) )
 {
+    if (mptr->getNtypes() > 1)
+        requireDataPerObject<int>(ChannelNames::meshTypes, DataManager::PersistenceMode::Active);
+
     mesh = std::move(mptr);
 }
 
 MembraneVector::~MembraneVector() = default;
+
+const int* MembraneVector::getMeshTypes(LocalObjectVector *lov) const
+{
+    if (!lov->dataPerObject.checkChannelExists(ChannelNames::meshTypes))
+        return nullptr;
+
+    return lov->dataPerObject.getData<int>(ChannelNames::meshTypes)->devPtr();
+}
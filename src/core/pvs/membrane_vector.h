@@ -9,6 +9,14 @@
 class MembraneVector: public ObjectVector
 {
 public:
+    /**
+     * With a mesh of several types, every object stores its type in the ChannelNames::meshTypes channel
+     * and has as many particles as the largest type: the particles beyond the vertices of its type
+     * are marked placeholders, ignored by the cell lists and the integrators.
+     */
     MembraneVector(const MirState *state, std::string name, float mass, std::shared_ptr<MembraneMesh> mptr, int nObjects = 0);
     ~MembraneVector();
+
+    /// mesh type of each object of lov on the device, nullptr if the mesh has a single type
+    const int* getMeshTypes(LocalObjectVector *lov) const;
 };
@@ -23,25 +23,31 @@ __global__ void minMaxCom(OVview ovView)
     float3 mymin = make_float3( 1e+10f);
     float3 mymax = make_float3(-1e+10f);
     float3 mycom = make_float3(0);
+    int mycount = 0;
 
 #pragma unroll 3
     for (int i = laneId; i < ovView.objSize; i += warpSize)
     {
         const int offset = objId * ovView.objSize + i;
 
-        const float3 coo = make_float3(ovView.readPosition(offset));
+        const Float3_int coo(ovView.readPosition(offset));
 
-        mymin = fminf(mymin, coo);
-        mymax = fmaxf(mymax, coo);
-        mycom += coo;
+        // placeholders of objects smaller than objSize
+        if (coo.isMarked()) continue;
+
+        mymin = fminf(mymin, coo.v);
+        mymax = fmaxf(mymax, coo.v);
+        mycom += coo.v;
+        ++mycount;
     }
 
-    mycom = warpReduce( mycom, [] (float a, float b) { return a+b; } );
-    mymin = warpReduce( mymin, [] (float a, float b) { return fmin(a, b); } );
-    mymax = warpReduce( mymax, [] (float a, float b) { return fmax(a, b); } );
+    mycom   = warpReduce( mycom,   [] (float a, float b) { return a+b; } );
+    mymin   = warpReduce( mymin,   [] (float a, float b) { return fmin(a, b); } );
+    mymax   = warpReduce( mymax,   [] (float a, float b) { return fmax(a, b); } );
+    mycount = warpReduce( mycount, [] (int a, int b) { return a+b; } );
 
     if (laneId == 0)
-        ovView.comAndExtents[objId] = {mycom / ovView.objSize, mymin, mymax};
+        ovView.comAndExtents[objId] = {mycom / max(mycount, 1), mymin, mymax};
 }
 
 } // namespace ObjectVectorKernels
@@ -245,4 +251,5 @@ void ObjectVector::restart(MPI_Comm comm, const std::string& path)
     _restartObjectData(comm, path, ms);
     
     local()->resize(ms.newSize * objSize, defaultStream);
+    invalidate();
 }
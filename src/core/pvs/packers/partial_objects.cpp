@@ -0,0 +1,20 @@
+#include "partial_objects.h"
+
+PartialObjectPacker::PartialObjectPacker(PackPredicate predicate) :
+    ParticlePacker(predicate)
+{}
+
+PartialObjectPacker::~PartialObjectPacker() = default;
+
+PartialObjectPackerHandler PartialObjectPacker::handler()
+{
+    PartialObjectPackerHandler ph;
+    ph.particles = particleData.handler();
+    return ph;
+}
+
+size_t PartialObjectPacker::getSizeBytes(int numElements) const
+{
+    return ParticlePacker::getSizeBytes(numElements) +
+        getPaddedSize<int>(numElements);
+}
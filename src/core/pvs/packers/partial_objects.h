@@ -0,0 +1,49 @@
+#pragma once
+
+#include "particles.h"
+
+/**
+ * Packs a subset of the particles of objects, one particle per element.
+ * Each packed particle carries its slot: objSize times the index of its object
+ * in the buffer plus its index within the object.
+ * The receiver can hence place the particles in objects with the usual layout.
+ */
+struct PartialObjectPackerHandler : public ParticlePackerHandler
+{
+    inline __D__ size_t getSizeBytes(int numElements) const
+    {
+        return ParticlePackerHandler::getSizeBytes(numElements) +
+            getPaddedSize<int>(numElements);
+    }
+
+    inline __D__ size_t packShift(int srcPid, int dstId, int slot, char *buffer,
+                                  int numElements, float3 shift) const
+    {
+        const size_t offsetBytes = particles.packShift(srcPid, dstId, buffer, numElements, shift);
+        reinterpret_cast<int*>(buffer + offsetBytes)[dstId] = slot;
+        return offsetBytes + getPaddedSize<int>(numElements);
+    }
+
+    /// slot of the packed particle \p srcId
+    inline __D__ int getSlot(int srcId, const char *buffer, int numElements) const
+    {
+        const size_t offsetBytes = particles.getSizeBytes(numElements);
+        return reinterpret_cast<const int*>(buffer + offsetBytes)[srcId];
+    }
+
+    inline __D__ size_t unpack(int srcId, int dstPid, const char *buffer, int numElements) const
+    {
+        return particles.unpack(srcId, dstPid, buffer, numElements) +
+            getPaddedSize<int>(numElements);
+    }
+};
+
+class PartialObjectPacker : public ParticlePacker
+{
+public:
+    PartialObjectPacker(PackPredicate predicate);
+    ~PartialObjectPacker();
+
+    PartialObjectPackerHandler handler();
+    size_t getSizeBytes(int numElements) const override;
+};
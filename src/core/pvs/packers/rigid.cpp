@@ -0,0 +1,62 @@
+#include "rigid.h"
+
+#include <core/pvs/rigid_object_vector.h>
+
+static bool isRestoredParticleChannel(const std::string& name)
+{
+    return name == ChannelNames::positions || name == ChannelNames::velocities;
+}
+
+static bool isRequiredObjectChannel(const std::string& name)
+{
+    return name == ChannelNames::motions || name == ChannelNames::globalIds;
+}
+
+RigidPacker::RigidPacker(PackPredicate predicate) :
+    ObjectPacker(predicate)
+{
+    particlePredicate = [predicate](const DataManager::NamedChannelDesc& namedDesc)
+    {
+        return predicate(namedDesc) && !isRestoredParticleChannel(namedDesc.first);
+    };
+
+    objectPredicate = [predicate](const DataManager::NamedChannelDesc& namedDesc)
+    {
+        return predicate(namedDesc) || isRequiredObjectChannel(namedDesc.first);
+    };
+}
+
+RigidPacker::~RigidPacker() = default;
+
+void RigidPacker::update(LocalParticleVector *lpv, cudaStream_t stream)
+{
+    auto lrov = dynamic_cast<LocalRigidObjectVector*>(lpv);
+    if (lrov == nullptr) die("Must pass local rigid object vector to rigid packer update");
+
+    auto rov = dynamic_cast<RigidObjectVector*>(lrov->pv);
+    if (rov == nullptr) die("Local rigid object vector must belong to a rigid object vector");
+
+    particleData.updateChannels(lrov->dataPerParticle, particlePredicate, stream);
+    objectData  .updateChannels(lrov->dataPerObject,   objectPredicate,   stream);
+    objSize = lrov->objSize;
+
+    positions        = lrov->positions ().devPtr();
+    velocities       = lrov->velocities().devPtr();
+    motions          = lrov->dataPerObject.getData<RigidMotion>(ChannelNames::motions  )->devPtr();
+    globalIds        = lrov->dataPerObject.getData<int64_t>    (ChannelNames::globalIds)->devPtr();
+    initialPositions = rov->initialPositions.devPtr();
+}
+
+RigidPackerHandler RigidPacker::handler()
+{
+    RigidPackerHandler rh;
+    rh.particles        = particleData.handler();
+    rh.objSize          = objSize;
+    rh.objects          = objectData.handler();
+    rh.positions        = positions;
+    rh.velocities       = velocities;
+    rh.motions          = motions;
+    rh.globalIds        = globalIds;
+    rh.initialPositions = initialPositions;
+    return rh;
+}
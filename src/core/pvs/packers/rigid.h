@@ -0,0 +1,80 @@
+#pragma once
+
+#include "objects.h"
+
+#include <core/rigid/utils.h>
+
+class LocalRigidObjectVector;
+
+/**
+ * Packs rigid objects without their particle positions and velocities:
+ * only the motions, the global ids of the objects and the other selected channels are sent.
+ * The particles are placed back from the initial positions and the motions when unpacking.
+ */
+struct RigidPackerHandler : public ObjectPackerHandler
+{
+    float4 *positions             {nullptr};
+    float4 *velocities            {nullptr};
+    const RigidMotion *motions    {nullptr};
+    const int64_t *globalIds      {nullptr}; ///< of the objects
+    const float4 *initialPositions{nullptr};
+
+#ifdef __CUDACC__
+    inline __device__ size_t blockPack(int numElements, char *buffer,
+                                       int srcObjId, int dstObjId) const
+    {
+        return blockApply<PackOp>({}, numElements, buffer, srcObjId, dstObjId);
+    }
+
+    inline __device__ size_t blockPackShift(int numElements, char *buffer,
+                                            int srcObjId, int dstObjId, float3 shift) const
+    {
+        return blockApply<PackShiftOp>({shift}, numElements, buffer, srcObjId, dstObjId);
+    }
+
+    inline __device__ size_t blockUnpack(int numElements, const char *buffer,
+                                         int srcObjId, int dstObjId) const
+    {
+        const size_t offsetBytes = blockApply<UnpackOp>({}, numElements, buffer, srcObjId, dstObjId);
+        blockRestoreParticles(dstObjId);
+        return offsetBytes;
+    }
+
+protected:
+
+    /// must be called after the motion and global id of the object are unpacked and visible to the block
+    inline __device__ void blockRestoreParticles(int objId) const
+    {
+        const auto motion = toSingleMotion(motions[objId]);
+        const int64_t startId = globalIds[objId] * objSize;
+
+        for (int pid = threadIdx.x; pid < objSize; pid += blockDim.x)
+        {
+            Particle p;
+            p.r = rigidParticlePosition(motion, make_float3(initialPositions[pid]));
+            p.u = rigidParticleVelocity(motion, p.r);
+            p.setId(startId + pid);
+
+            p.write2Float4(positions, velocities, objId * objSize + pid);
+        }
+    }
+#endif // __CUDACC__
+};
+
+class RigidPacker : public ObjectPacker
+{
+public:
+    RigidPacker(PackPredicate predicate);
+    ~RigidPacker();
+
+    void update(LocalParticleVector *lpv, cudaStream_t stream) override;
+    RigidPackerHandler handler();
+
+protected:
+    PackPredicate particlePredicate, objectPredicate;
+
+    float4 *positions, *velocities;
+    const RigidMotion *motions;
+    const int64_t *globalIds;
+    const float4 *initialPositions;
+};
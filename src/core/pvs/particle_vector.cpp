@@ -205,6 +205,7 @@ void ParticleVector::setCoordinates_vector(const std::vector<float3>& coordinate
     }
     
     pos.uploadToDevice(defaultStream);
+    invalidate();
 }
 
 void ParticleVector::setVelocities_vector(const std::vector<float3>& velocities)
@@ -226,6 +227,7 @@ void ParticleVector::setVelocities_vector(const std::vector<float3>& velocities)
     }
     
     vel.uploadToDevice(defaultStream);
+    invalidate();
 }
 
 void ParticleVector::setForces_vector(const std::vector<float3>& forces)
@@ -348,6 +350,14 @@ void ParticleVector::restart(MPI_Comm comm, const std::string& path)
     constexpr int particleChunkSize = 1;
     auto ms = _restartParticleData(comm, path, particleChunkSize);
     local()->resize(ms.newSize, defaultStream);
+    invalidate();
+}
+
+void ParticleVector::invalidate()
+{
+    haloValid   = false;
+    redistValid = false;
+    cellListStamp++;
 }
 
 
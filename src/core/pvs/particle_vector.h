@@ -70,6 +70,9 @@ public:
     void checkpoint(MPI_Comm comm, const std::string& path, int checkpointId) override;
     void restart   (MPI_Comm comm, const std::string& path) override;
 
+    /// mark the particles as modified: halo, redistribution and cell-lists will be recomputed
+    void invalidate();
+    
     
     // Python getters / setters
     // Use default blocking stream
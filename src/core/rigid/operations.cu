@@ -3,7 +3,6 @@
 
 #include <core/pvs/rigid_object_vector.h>
 #include <core/pvs/views/rov.h>
-#include <core/utils/quaternion.h>
 #include <core/utils/cuda_common.h>
 #include <core/utils/kernel_launch.h>
 
@@ -65,12 +64,12 @@ __global__ void applyRigidMotion(ROVview ovView, const float4 *initialPositions)
     ovView.readPosition(p, pid);
 
     // Some explicit conversions for double precision
-    p.r = motion.r + Quaternion::rotate( make_float3(initialPositions[locId]), motion.q );
+    p.r = rigidParticlePosition(motion, make_float3(initialPositions[locId]));
 
     if (action == RigidOperations::ApplyTo::PositionsAndVelocities)
     {
         ovView.readVelocity(p, pid);
-        p.u = motion.vel + cross(motion.omega, p.r - motion.r);
+        p.u = rigidParticleVelocity(motion, p.r);
         ovView.writeParticle(pid, p);
     }
     else
@@ -2,6 +2,8 @@
 
 #include <core/datatypes.h>
 #include <core/utils/cpu_gpu_defines.h>
+#include <core/utils/helper_math.h>
+#include <core/utils/quaternion.h>
 
 inline __HD__ SingleRigidMotion toSingleMotion(const DoubleRigidMotion& dm)
 {
@@ -32,3 +34,15 @@ inline __HD__ RigidReal4 make_rigidReal4(R4 a)
 {
     return {RigidReal(a.x), RigidReal(a.y), RigidReal(a.z), RigidReal(a.w)};
 }
+
+/// position of the particle of initial position \p r0 (in the object frame) of an object moving with \p motion
+inline __HD__ float3 rigidParticlePosition(const SingleRigidMotion& motion, float3 r0)
+{
+    return motion.r + Quaternion::rotate(r0, motion.q);
+}
+
+/// velocity of the particle at position \p r of an object moving with \p motion
+inline __HD__ float3 rigidParticleVelocity(const SingleRigidMotion& motion, float3 r)
+{
+    return motion.vel + cross(motion.omega, r - motion.r);
+}
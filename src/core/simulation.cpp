@@ -4,7 +4,9 @@
 #include <core/celllist.h>
 #include <core/initial_conditions/interface.h>
 #include <core/integrators/interface.h>
+#include <core/integrators/rigid_vv.h>
 #include <core/interactions/interface.h>
+#include <core/interactions/obj_rod_binding.h>
 #include <core/managers/interactions.h>
 #include <core/exchangers/api.h>
 #include <core/object_belonging/interface.h>
@@ -12,10 +14,12 @@
 #include <core/pvs/particle_vector.h>
 #include <core/task_scheduler.h>
 #include <core/utils/folders.h>
+#include <core/utils/postprocess_ranks.h>
 #include <core/utils/restart_helpers.h>
 #include <core/walls/interface.h>
 #include <core/mirheo_state.h>
 #include <plugins/interface.h>
+#include <plugins/utils/reduction_service.h>
 
 #include <algorithm>
 #include <cuda_profiler_api.h>
@@ -122,7 +126,8 @@ Simulation::Simulation(const MPI_Comm &cartComm, const MPI_Comm &interComm, MirS
     tasks(std::make_unique<SimulationTasks>()),
     interactionsIntermediate(std::make_unique<InteractionManager>()),
     interactionsFinal(std::make_unique<InteractionManager>()),
-    gpuAwareMPI(gpuAwareMPI)
+    gpuAwareMPI(gpuAwareMPI),
+    reductionService(std::make_unique<ReductionService>(state))
 {
     createFoldersCollective(cartComm, checkpointInfo.folder);
 
@@ -206,6 +211,11 @@ CellList* Simulation::gelCellList(ParticleVector* pv) const
         return clvecIt->second[0].get();
 }
 
+ReductionService* Simulation::getReductionService() const
+{
+    return reductionService.get();
+}
+
 MPI_Comm Simulation::getCartComm() const
 {
     return cartComm;
@@ -425,6 +435,21 @@ void Simulation::setObjectBelongingChecker(const std::string& checkerName, const
             objName.c_str(), checkerName.c_str());        
 }
 
+void Simulation::setCellListOrdering(SpaceFillingCurve::Ordering ordering)
+{
+    cellListOrdering = ordering;
+}
+
+void Simulation::setPartialObjectHalo(const std::string& ovName)
+{
+    auto ov = getOVbyNameOrDie(ovName);
+
+    if (dynamic_cast<RigidObjectVector*>(ov))
+        die("Partial halos are not supported for rigid objects such as '%s'", ovName.c_str());
+
+    partialHaloObjectVectors.insert(ov);
+}
+
 
 void Simulation::applyObjectBelongingChecker(const std::string& checkerName, const std::string& source,
                                              const std::string& inside, const std::string& outside,
@@ -474,18 +499,6 @@ void Simulation::applyObjectBelongingChecker(const std::string& checkerName, con
     belongingCorrectionPrototypes.push_back({checker, getPVbyName(inside), getPVbyName(outside), checkEvery});
 }
 
-static void sortDescendingOrder(std::vector<float>& v)
-{
-    std::sort(v.begin(), v.end(), [] (float a, float b) { return a > b; });
-}
-
-// assume sorted array (ascending or descending)
-static void removeDuplicatedElements(std::vector<float>& v, float tolerance)
-{
-    auto it = std::unique(v.begin(), v.end(), [=] (float a, float b) { return fabs(a - b) < tolerance; });
-    v.resize( std::distance(v.begin(), it) );    
-}
-
 void Simulation::prepareCellLists()
 {
     info("Preparing cell-lists");
@@ -500,27 +513,28 @@ void Simulation::prepareCellLists()
         cutOffMap[prototype.pv2].push_back(rc);
     }
 
+    // One cell-list per pv, with cells fitting the smallest cut-off:
+    // larger cut-offs traverse several cells in each direction instead of
+    // sorting another copy of the particles.
+    // The cells are not made smaller than maxCellListSpan times the largest cut-off
     for (auto& cutoffPair : cutOffMap)
     {
         auto& pv      = cutoffPair.first;
         auto& cutoffs = cutoffPair.second;
 
-        sortDescendingOrder(cutoffs);
-        removeDuplicatedElements(cutoffs, rcTolerance);
-
-        bool primary = true;
+        const float rcMin = *std::min_element(cutoffs.begin(), cutoffs.end());
+        const float rcMax = *std::max_element(cutoffs.begin(), cutoffs.end());
+        const float rc = std::max(rcMin, rcMax / maxCellListSpan - rcTolerance);
 
         // Don't use primary cell-lists with ObjectVectors
-        if (dynamic_cast<ObjectVector*>(pv))
-            primary = false;
+        const bool primary = dynamic_cast<ObjectVector*>(pv) == nullptr;
 
-        for (auto rc : cutoffs)
-        {
-            cellListMap[pv].push_back(primary ?
-                    std::make_unique<PrimaryCellList>(pv, rc, state->domain.localSize) :
-                    std::make_unique<CellList>       (pv, rc, state->domain.localSize));
-            primary = false;
-        }
+        cellListMap[pv].push_back(primary ?
+                std::make_unique<PrimaryCellList>(pv, rc, state->domain.localSize) :
+                std::make_unique<CellList>       (pv, rc, state->domain.localSize));
+
+        debug("Cell-list of pv '%s' has cells of size %g for cut-offs between %g and %g",
+              pv->name.c_str(), cellListMap[pv].back()->rc, rcMin, rcMax);
     }
 
     for (auto& pv : particleVectors)
@@ -541,22 +555,16 @@ void Simulation::prepareCellLists()
                  std::make_unique<CellList>       (pvptr, defaultRc, state->domain.localSize));
         }
     }
-}
 
-// Choose a CL with smallest but bigger than rc cell
-static CellList* selectBestClist(std::vector<std::unique_ptr<CellList>>& cellLists, float rc, float tolerance)
-{
-    float minDiff = 1e6;
-    CellList* best = nullptr;
-    
-    for (auto& cl : cellLists) {
-        float diff = cl->rc - rc;
-        if (diff > -tolerance && diff < minDiff) {
-            best    = cl.get();
-            minDiff = diff;
-        }
+    if (cellListOrdering != SpaceFillingCurve::Ordering::Lexicographic)
+    {
+        info("Numbering the cells of all cell-lists in %s order",
+             SpaceFillingCurve::getOrderingStr(cellListOrdering).c_str());
+
+        for (auto& entry : cellListMap)
+            for (auto& cl : entry.second)
+                cl->setOrdering(cellListOrdering);
     }
-    return best;
 }
 
 void Simulation::prepareInteractions()
@@ -565,17 +573,12 @@ void Simulation::prepareInteractions()
 
     for (auto& prototype : interactionPrototypes)
     {
-        auto  rc = prototype.rc;
         auto pv1 = prototype.pv1;
         auto pv2 = prototype.pv2;
 
-        auto& clVec1 = cellListMap[pv1];
-        auto& clVec2 = cellListMap[pv2];
-
-        CellList *cl1, *cl2;
-
-        cl1 = selectBestClist(clVec1, rc, rcTolerance);
-        cl2 = selectBestClist(clVec2, rc, rcTolerance);
+        // all the interactions of a pv share its single cell-list
+        CellList *cl1 = cellListMap[pv1][0].get();
+        CellList *cl2 = cellListMap[pv2][0].get();
         
         auto inter = prototype.interaction;
 
@@ -654,6 +657,9 @@ void Simulation::preparePlugins()
         debug("Setup and handshake of plugin %s", pl->name.c_str());
         pl->setup(this, cartComm, interComm);
         pl->handshake();
+
+        // the handshake is received directly, it is not an event of the postprocess
+        pl->popSentFlag();
     }
     info("done Preparing plugins");
 }
@@ -686,6 +692,46 @@ std::vector<std::string> Simulation::getExtraDataToExchange(ObjectVector *ov)
     return {channels.begin(), channels.end()};
 }
 
+bool Simulation::usesPartialHalo(ObjectVector *ov) const
+{
+    if (partialHaloObjectVectors.find(ov) == partialHaloObjectVectors.end())
+        return false;
+
+    // bounce-back and belonging checks need the whole objects in the halo
+    for (const auto& entry : bouncerMap)
+        if (entry.second->getObjectVector() == ov)
+            die("Object vector '%s' has a partial halo and can not be used for bounce-back ('%s')",
+                ov->name.c_str(), entry.first.c_str());
+
+    for (const auto& entry : belongingCheckerMap)
+        if (entry.second->getObjectVector() == ov)
+            die("Object vector '%s' has a partial halo and can not be used by belonging checker '%s'",
+                ov->name.c_str(), entry.first.c_str());
+
+    // the binding reads the ids of the halo objects, which are not sent with a partial halo
+    for (const auto& prototype : interactionPrototypes)
+        if ((prototype.pv1 == ov || prototype.pv2 == ov) &&
+            dynamic_cast<ObjectRodBindingInteraction*>(prototype.interaction) != nullptr)
+            die("Object vector '%s' has a partial halo and can not be used by the object-rod binding '%s'",
+                ov->name.c_str(), prototype.interaction->name.c_str());
+
+    return true;
+}
+
+// only the rigid integrator keeps the motions in sync with the particles;
+// the objects moved by other integrators (e.g. Translate, Oscillate) are sent with their particles
+bool Simulation::restoresFromMotions(ObjectVector *ov) const
+{
+    if (dynamic_cast<RigidObjectVector*>(ov) == nullptr)
+        return false;
+
+    auto it = pvsIntegratorMap.find(ov->name);
+    if (it == pvsIntegratorMap.end())
+        return false;
+
+    return dynamic_cast<IntegratorVVRigid*>(integratorMap.at(it->second).get()) != nullptr;
+}
+
 std::vector<std::string> Simulation::getDataToSendBack(const std::vector<std::string>& extraOut,
                                                        ObjectVector *ov)
 {
@@ -733,15 +779,20 @@ void Simulation::prepareEngines()
         auto extraOut = interactionsFinal       ->getOutputChannels(pvPtr);
 
         auto cl = cellListVec[0].get();
+
+        const float rcInt = interactionsIntermediate->getLargestCutoff(pvPtr);
+        const float rcOut = interactionsFinal       ->getLargestCutoff(pvPtr);
         
         if (auto ov = dynamic_cast<ObjectVector*>(pvPtr))
         {
-            objRedistImp->attach(ov);
+            const bool fromMotions = restoresFromMotions(ov);
+            objRedistImp->attach(ov, fromMotions);
 
             auto extraToExchange = getExtraDataToExchange(ov);
             auto reverseExchange = getDataToSendBack(extraInt, ov);
+            const float rcHalo = std::max({cl->rc, rcInt, rcOut});
 
-            objHaloFinalImp->attach(ov, cl->rc, extraToExchange); // always active because of bounce back; TODO: check if bounce back is active
+            objHaloFinalImp->attach(ov, rcHalo, extraToExchange, usesPartialHalo(ov), fromMotions); // always active because of bounce back; TODO: check if bounce back is active
             objHaloReverseFinalImp->attach(ov, extraOut);
 
             objHaloIntermediateImp->attach(ov, extraInt);
@@ -752,10 +803,10 @@ void Simulation::prepareEngines()
             partRedistImp->attach(pvPtr, cl);
             
             if (clInt != nullptr)
-                partHaloIntermediateImp->attach(pvPtr, clInt, {});
+                partHaloIntermediateImp->attach(pvPtr, clInt, rcInt, {});
 
             if (clOut != nullptr)
-                partHaloFinalImp->attach(pvPtr, clOut, extraInt);
+                partHaloFinalImp->attach(pvPtr, clOut, rcOut, extraInt);
         }
     }
     
@@ -1213,6 +1264,7 @@ void Simulation::run(int nsteps)
                 "Timestep: %d, simulation time: %f", state->currentStep, state->currentTime);
 
         scheduler->run();
+        announcePluginMessages();
         
         state->currentTime += state->dt;
     }
@@ -1226,15 +1278,37 @@ void Simulation::run(int nsteps)
     for (auto& pl : plugins)
         pl->finalize();
 
-    notifyPostProcess(stoppingTag, stoppingMsg);
+    notifyPostProcess({stoppingEvent});
+}
+
+void Simulation::announcePluginMessages()
+{
+    // all simulation ranks send the same plugin messages at a given step
+    std::vector<int> events;
+    for (auto& pl : plugins)
+        if (pl->popSentFlag())
+            events.push_back(pl->getTag());
+
+    if (!events.empty())
+        notifyPostProcess(events);
 }
 
-void Simulation::notifyPostProcess(int tag, int msg) const
+void Simulation::notifyPostProcess(const std::vector<int>& events) const
 {
     if (interComm != MPI_COMM_NULL)
     {
-        MPI_Check( MPI_Ssend(&msg, 1, MPI_INT, rank, tag, interComm) );
-        debug("notify postprocess with tag %d and message %d", tag, msg);
+        // only the first simulation rank served by each postprocess rank notifies it
+        int nranks, nPostRanks;
+        MPI_Check( MPI_Comm_size(cartComm, &nranks) );
+        MPI_Check( MPI_Comm_remote_size(interComm, &nPostRanks) );
+
+        const int dest = PostprocessRanks::postRank(rank, nranks, nPostRanks);
+        if (PostprocessRanks::firstComputeRank(dest, nranks, nPostRanks) != rank)
+            return;
+
+        // small message, usually sent eagerly; the order is kept by MPI
+        MPI_Check( MPI_Send(events.data(), events.size(), MPI_INT, dest, postprocessEventsTag, interComm) );
+        debug("notify postprocess with %d events, first is %d", static_cast<int>(events.size()), events[0]);
     }
 }
 
@@ -1329,7 +1403,7 @@ void Simulation::checkpoint()
 
     advanceCheckpointId(checkpointId, checkpointInfo.mode);
 
-    notifyPostProcess(checkpointTag, checkpointId);
+    notifyPostProcess({checkpointEvent, checkpointId});
     
     CUDA_Check( cudaDeviceSynchronize() );
 }
@@ -6,10 +6,12 @@
 #include <core/logger.h>
 #include <core/exchangers/exchanger_interfaces.h>
 #include <core/mirheo_object.h>
+#include <core/utils/space_filling_curve.h>
 
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -27,6 +29,7 @@ class InitialConditions;
 class Bouncer;
 class ObjectBelongingChecker;
 class SimulationPlugin;
+class ReductionService;
 struct SimulationTasks;
 
 class Simulation : protected MirObject
@@ -56,6 +59,8 @@ public:
     void setWallBounce             (const std::string& wallName,        const std::string& pvName, float maximumPartTravel);
     void setObjectBelongingChecker (const std::string& checkerName,     const std::string& objName);
 
+    void setCellListOrdering(SpaceFillingCurve::Ordering ordering);
+    void setPartialObjectHalo(const std::string& ovName);
 
     void applyObjectBelongingChecker(const std::string& checkerName,
                                      const std::string& source, const std::string& inside, const std::string& outside,
@@ -65,7 +70,7 @@ public:
     void init();
     void run(int nsteps);
 
-    void notifyPostProcess(int tag, int msg) const;
+    void notifyPostProcess(const std::vector<int>& events) const;
 
     std::vector<ParticleVector*> getParticleVectors() const;
 
@@ -80,6 +85,9 @@ public:
 
     CellList* gelCellList(ParticleVector* pv) const;
 
+    /// reductions over the particle vectors shared by the plugins
+    ReductionService* getReductionService() const;
+
     void startProfiler() const;
     void stopProfiler() const;
 
@@ -155,6 +163,10 @@ private:
     MirState *state;
     
     static constexpr float rcTolerance = 1e-5;
+    static constexpr int maxCellListSpan = 2;
+
+    SpaceFillingCurve::Ordering cellListOrdering {SpaceFillingCurve::Ordering::Lexicographic};
+    std::set<ObjectVector*> partialHaloObjectVectors;
 
     int checkpointId {0};
     const CheckpointInfo checkpointInfo;
@@ -183,6 +195,7 @@ private:
     MapShared <ObjectBelongingChecker> belongingCheckerMap;
     
     std::vector< std::shared_ptr<SimulationPlugin> > plugins;
+    std::unique_ptr<ReductionService> reductionService;
 
     std::map<ParticleVector*, std::vector< std::unique_ptr<CellList> >> cellListMap;
 
@@ -203,6 +216,8 @@ private:
 
     std::vector<std::string> getExtraDataToExchange(ObjectVector *ov);
     std::vector<std::string> getDataToSendBack(const std::vector<std::string>& extraOut, ObjectVector *ov);
+    bool usesPartialHalo(ObjectVector *ov) const;
+    bool restoresFromMotions(ObjectVector *ov) const;
     
     void prepareCellLists();
     void prepareInteractions();
@@ -210,6 +225,8 @@ private:
     void prepareWalls();
     void preparePlugins();
     void prepareEngines();
+
+    void announcePluginMessages();
     
     void execSplitters();
 
@@ -0,0 +1,96 @@
+#include "cache.h"
+#include "folders.h"
+
+#include <core/logger.h>
+
+#include <cstdio>
+#include <fstream>
+
+namespace Cache
+{
+
+Key& Key::add(const void *data, size_t size)
+{
+    constexpr uint64_t prime = 1099511628211ull;
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    
+    for (size_t i = 0; i < size; ++i)
+    {
+        value ^= bytes[i];
+        value *= prime;
+    }
+    return *this;
+}
+
+Key& Key::add(const std::string& s)
+{
+    add(s.size());
+    return add(s.data(), s.size());
+}
+
+Key& Key::addFileContents(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.good())
+        die("'%s': file not found or not accessible", fileName.c_str());
+
+    std::vector<char> buffer(1 << 20);
+    while (file)
+    {
+        file.read(buffer.data(), buffer.size());
+        add(buffer.data(), file.gcount());
+    }
+    return *this;
+}
+
+std::string Key::str() const
+{
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(value));
+    return buf;
+}
+
+std::string rankFileName(const std::string& folder, const std::string& prefix, const Key& key, const MPI_Comm& comm)
+{
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
+    return makePath(folder) + prefix + "_" + key.str() + "_" + getStrZeroPadded(rank) + ".bin";
+}
+
+bool load(const std::string& fileName, std::vector<char>& data)
+{
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    if (!file.good())
+        return false;
+
+    const auto size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    
+    data.resize(size);
+    return file.read(data.data(), size).good();
+}
+
+void store(const std::string& fileName, const std::vector<char>& data)
+{
+    const std::string tmpName = fileName + ".tmp";
+    {
+        std::ofstream file(tmpName, std::ios::binary);
+        if (!file.write(data.data(), data.size()).good())
+        {
+            warn("Could not write cache file '%s'", tmpName.c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tmpName.c_str(), fileName.c_str()) != 0)
+        warn("Could not move cache file '%s' to '%s'", tmpName.c_str(), fileName.c_str());
+}
+
+bool allRanks(const MPI_Comm& comm, bool local)
+{
+    int all = local;
+    MPI_Check( MPI_Allreduce(MPI_IN_PLACE, &all, 1, MPI_INT, MPI_LAND, comm) );
+    return all;
+}
+
+} // namespace Cache
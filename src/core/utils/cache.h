@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <mpi.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Helpers for the on-disk cache of expensive setup steps.
+ * Cached blobs are stored per rank and are identified by a content-based key
+ * that has to include everything the cached data depends on.
+ */
+namespace Cache
+{
+
+/// 64-bit FNV-1a hash of the data the cached entry depends on
+class Key
+{
+public:
+    Key& add(const void *data, size_t size);
+    Key& add(const std::string& s);
+    Key& addFileContents(const std::string& fileName);
+
+    template <typename T>
+    Key& add(const T& v)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be hashed");
+        return add(&v, sizeof(T));
+    }
+
+    template <typename T>
+    Key& add(const std::vector<T>& v)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be hashed");
+        add(v.size());
+        return add(v.data(), v.size() * sizeof(T));
+    }
+
+    std::string str() const;
+    
+private:
+    uint64_t value {14695981039346656037ull};
+};
+
+/// name of the cache file of the calling rank: <folder>/<prefix>_<key>_<rank>.bin
+std::string rankFileName(const std::string& folder, const std::string& prefix, const Key& key, const MPI_Comm& comm);
+
+/// read the whole file; return false if it does not exist or cannot be read
+bool load(const std::string& fileName, std::vector<char>& data);
+
+/// write the data to a temporary file and rename it, such that readers never see partial entries
+void store(const std::string& fileName, const std::vector<char>& data);
+
+/// true if local is true on all ranks of comm; used to take collective cache hit/miss decisions
+bool allRanks(const MPI_Comm& comm, bool local);
+
+} // namespace Cache
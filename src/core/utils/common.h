@@ -22,6 +22,7 @@ static const std::string motions     = "motions";
 static const std::string oldMotions  = "old_motions";
 static const std::string comExtents  = "com_extents";
 static const std::string areaVolumes = "area_volumes";
+static const std::string meshTypes   = "mesh_types";
     
 // per object, specific to Juelicher bending + ADE    
 static const std::string areas          = "areas";
@@ -72,9 +73,12 @@ struct CheckpointInfo
     CheckpointIdAdvanceMode mode;
 };
 
-// tag used to stop the postprocess side to stop
-constexpr int stoppingTag = 424242;
-constexpr int stoppingMsg = -1;
+// tag of the messages announcing the events of the postprocess side:
+// a list of plugin tags, for the plugins that sent data, or one of the special events below
+constexpr int postprocessEventsTag = 424242;
 
-// tag used to tell the postprocess side to dump checkpoint 
-constexpr int checkpointTag = 434343;
+// tell the postprocess side to stop
+constexpr int stoppingEvent = -1;
+
+// tell the postprocess side to dump checkpoint, followed by the checkpoint id
+constexpr int checkpointEvent = -2;
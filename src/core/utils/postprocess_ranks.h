@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ * Mapping between the simulation and the postprocess ranks.
+ * Each postprocess rank serves a contiguous block of simulation ranks,
+ * the block sizes differ by at most one.
+ * Ranks are given in the simulation and postprocess communicators respectively.
+ */
+namespace PostprocessRanks
+{
+
+/// number of postprocess ranks when each of them serves at most \p computePerPost simulation ranks
+inline int nPostprocessRanks(int nCompute, int computePerPost)
+{
+    return (nCompute + computePerPost - 1) / computePerPost;
+}
+
+/// first simulation rank served by the postprocess rank \p postRank
+inline int firstComputeRank(int postRank, int nCompute, int nPost)
+{
+    return static_cast<int>(static_cast<long long>(postRank) * nCompute / nPost);
+}
+
+/// number of simulation ranks served by the postprocess rank \p postRank
+inline int nComputeRanks(int postRank, int nCompute, int nPost)
+{
+    return firstComputeRank(postRank + 1, nCompute, nPost) - firstComputeRank(postRank, nCompute, nPost);
+}
+
+/// postprocess rank serving the simulation rank \p computeRank
+inline int postRank(int computeRank, int nCompute, int nPost)
+{
+    return static_cast<int>((static_cast<long long>(computeRank + 1) * nPost - 1) / nCompute);
+}
+
+} // namespace PostprocessRanks
@@ -0,0 +1,131 @@
+#include "space_filling_curve.h"
+
+#include <core/logger.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace SpaceFillingCurve
+{
+
+Ordering getOrdering(const std::string& name)
+{
+    if (name == "lexicographic") return Ordering::Lexicographic;
+    if (name == "morton")        return Ordering::Morton;
+    if (name == "hilbert")       return Ordering::Hilbert;
+
+    die("Unknown cell ordering '%s', expected one of 'lexicographic', 'morton' or 'hilbert'", name.c_str());
+    return Ordering::Lexicographic;
+}
+
+std::string getOrderingStr(Ordering ordering)
+{
+    switch (ordering)
+    {
+    case Ordering::Lexicographic: return "lexicographic";
+    case Ordering::Morton:        return "morton";
+    case Ordering::Hilbert:       return "hilbert";
+    }
+    return "unknown";
+}
+
+// insert two zero bits between every bit of the lowest 21 bits of x
+static uint64_t spreadBits(uint32_t x)
+{
+    uint64_t v = x & 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffull;
+    v = (v | v << 16) & 0x1f0000ff0000ffull;
+    v = (v | v <<  8) & 0x100f00f00f00f00full;
+    v = (v | v <<  4) & 0x10c30c30c30c30c3ull;
+    v = (v | v <<  2) & 0x1249249249249249ull;
+    return v;
+}
+
+uint64_t mortonKey(uint32_t ix, uint32_t iy, uint32_t iz)
+{
+    return spreadBits(ix) | (spreadBits(iy) << 1) | (spreadBits(iz) << 2);
+}
+
+// J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 381 (2004)
+uint64_t hilbertKey(uint32_t ix, uint32_t iy, uint32_t iz, int bits)
+{
+    uint32_t X[3] = {iz, iy, ix};
+    const uint32_t M = 1u << (bits - 1);
+
+    // inverse undo
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+        const uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (X[i] & Q)
+            {
+                X[0] ^= P;
+            }
+            else
+            {
+                const uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for (int i = 1; i < 3; ++i)
+        X[i] ^= X[i-1];
+
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+        if (X[2] & Q)
+            t ^= Q - 1;
+
+    for (int i = 0; i < 3; ++i)
+        X[i] ^= t;
+
+    // the transposed form stores the key bits across the three coordinates
+    uint64_t key = 0;
+    for (int b = bits - 1; b >= 0; --b)
+        for (int i = 0; i < 3; ++i)
+            key = (key << 1) | ((X[i] >> b) & 1);
+
+    return key;
+}
+
+std::vector<int> computeCellRanks(int3 ncells, Ordering ordering)
+{
+    const int totcells = ncells.x * ncells.y * ncells.z;
+    std::vector<int> ranks(totcells);
+
+    if (ordering == Ordering::Lexicographic)
+    {
+        std::iota(ranks.begin(), ranks.end(), 0);
+        return ranks;
+    }
+
+    const int maxn = std::max({ncells.x, ncells.y, ncells.z});
+    int bits = 1;
+    while ((1 << bits) < maxn) ++bits;
+
+    std::vector<uint64_t> keys(totcells);
+    for (int iz = 0; iz < ncells.z; ++iz)
+        for (int iy = 0; iy < ncells.y; ++iy)
+            for (int ix = 0; ix < ncells.x; ++ix)
+            {
+                const int cid = (iz*ncells.y + iy)*ncells.x + ix;
+                keys[cid] = (ordering == Ordering::Morton) ?
+                    mortonKey(ix, iy, iz) : hilbertKey(ix, iy, iz, bits);
+            }
+
+    std::vector<int> cellsAlongCurve(totcells);
+    std::iota(cellsAlongCurve.begin(), cellsAlongCurve.end(), 0);
+    std::sort(cellsAlongCurve.begin(), cellsAlongCurve.end(),
+              [&keys](int a, int b) { return keys[a] < keys[b]; });
+
+    for (int rank = 0; rank < totcells; ++rank)
+        ranks[cellsAlongCurve[rank]] = rank;
+
+    return ranks;
+}
+
+} // namespace SpaceFillingCurve
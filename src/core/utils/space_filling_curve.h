@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Numbering of the cells of a 3D grid along a space-filling curve.
+ * Cells that are close in space get close indices,
+ * which improves the memory locality of the particles sorted by cells.
+ */
+namespace SpaceFillingCurve
+{
+
+enum class Ordering {Lexicographic, Morton, Hilbert};
+
+Ordering getOrdering(const std::string& name);
+std::string getOrderingStr(Ordering ordering);
+
+/// position of the point (ix, iy, iz) along the Z-order curve
+uint64_t mortonKey(uint32_t ix, uint32_t iy, uint32_t iz);
+
+/// position of the point (ix, iy, iz) along the Hilbert curve covering a cube of side 2^bits
+uint64_t hilbertKey(uint32_t ix, uint32_t iy, uint32_t iz, int bits);
+
+/**
+ * Rank of every cell along the curve.
+ * The result is a permutation of [0, ncells.x*ncells.y*ncells.z),
+ * indexed by the lexicographic cell id (x fastest).
+ * Grids that are not cubes of side 2^n are covered by the enclosing cube,
+ * the ranks remain dense.
+ */
+std::vector<int> computeCellRanks(int3 ncells, Ordering ordering);
+
+} // namespace SpaceFillingCurve
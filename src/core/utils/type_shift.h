@@ -1,5 +1,6 @@
 #pragma once
 
+#include <core/datatypes.h>
 #include <core/domain.h>
 #include <core/utils/cpu_gpu_defines.h>
 #include <core/utils/type_map.h>
@@ -18,7 +19,8 @@ template <typename T>
 __HD__ inline void apply(__UNUSED T& var, __UNUSED float3 shift) {}
 
 __HD__ inline void apply(float3&      var, float3 shift) {_add(var,   shift);}
-__HD__ inline void apply(float4&      var, float3 shift) {_add(var,   shift);}
+// marked positions are placeholders and must stay marked
+__HD__ inline void apply(float4&      var, float3 shift) {if (!Float3_int(var).isMarked()) _add(var, shift);}
 __HD__ inline void apply(double3&     var, float3 shift) {_add(var,   shift);}
 __HD__ inline void apply(double4&     var, float3 shift) {_add(var,   shift);}
 __HD__ inline void apply(RigidMotion& var, float3 shift) {_add(var.r, shift);}
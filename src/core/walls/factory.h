@@ -4,6 +4,7 @@
 
 #include "simple_stationary_wall.h"
 #include "stationary_walls/box.h"
+#include "stationary_walls/composite.h"
 #include "stationary_walls/cylinder.h"
 #include "stationary_walls/plane.h"
 #include "stationary_walls/sdf.h"
@@ -13,6 +14,8 @@
 #include "velocity_field/translate.h"
 #include "wall_with_velocity.h"
 
+#include <core/logger.h>
+
 #include <memory>
 
 class ParticleVector;
@@ -55,12 +58,37 @@ createPlaneWall(const MirState *state, const std::string& name, float3 normal, f
 }
 
 inline std::shared_ptr<SimpleStationaryWall<StationaryWall_SDF>>
-createSDFWall(const MirState *state, const std::string& name, const std::string& sdfFilename, float3 h)
+createSDFWall(const MirState *state, const std::string& name, const std::string& sdfFilename, float3 h,
+              const std::string& cacheFolder)
 {
-    StationaryWall_SDF sdf(state, sdfFilename, h);
+    StationaryWall_SDF sdf(state, sdfFilename, h, cacheFolder);
     return std::make_shared<SimpleStationaryWall<StationaryWall_SDF>> (name, state, std::move(sdf));
 }
 
+inline std::shared_ptr<SimpleStationaryWall<StationaryWall_Composite>>
+createCompositeWall(const MirState *state, const std::string& name, const std::vector<std::shared_ptr<Wall>>& walls,
+                    const std::string& mode, float3 h, long nErrorSamplesPerRank)
+{
+    StationaryWall_Composite::Mode m;
+    if      (mode == "union")        m = StationaryWall_Composite::Mode::Union;
+    else if (mode == "intersection") m = StationaryWall_Composite::Mode::Intersection;
+    else die("Unknown composite wall mode '%s' for wall '%s'; valid modes are 'union' and 'intersection'",
+             mode.c_str(), name.c_str());
+
+    std::vector<std::shared_ptr<SDF_basedWall>> sdfWalls;
+    for (auto& wall : walls)
+    {
+        auto sdfWall = std::dynamic_pointer_cast<SDF_basedWall>(wall);
+        if (sdfWall == nullptr)
+            die("Only sdf-based walls can be combined, got wall '%s' in composite wall '%s'",
+                wall->name.c_str(), name.c_str());
+        sdfWalls.push_back(std::move(sdfWall));
+    }
+
+    StationaryWall_Composite composite(state, name, std::move(sdfWalls), m, h, nErrorSamplesPerRank);
+    return std::make_shared<SimpleStationaryWall<StationaryWall_Composite>> (name, state, std::move(composite));
+}
+
 // Moving walls
 
 inline std::shared_ptr<WallWithVelocity<StationaryWall_Cylinder, VelocityField_Rotate>>
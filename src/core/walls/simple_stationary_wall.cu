@@ -2,6 +2,7 @@
 
 #include "common_kernels.h"
 #include "stationary_walls/box.h"
+#include "stationary_walls/composite.h"
 #include "stationary_walls/cylinder.h"
 #include "stationary_walls/plane.h"
 #include "stationary_walls/sdf.h"
@@ -79,6 +80,9 @@ __global__ void packRemainingObjects(OVview view, ObjectPackerHandler packer, ch
     for (int i = laneId; i < view.objSize; i += warpSize)
     {
         Particle p(view.readParticle(objId * view.objSize + i));
+
+        // placeholders of objects smaller than objSize are outside of the domain
+        if (p.isMarked()) continue;
         
         if (checker(p.r) > -tolerance)
         {
@@ -179,6 +183,8 @@ __global__ void checkInside(PVview view, int *nInside, const InsideWallChecker c
 
     Float3_int coo(view.readPosition(pid));
 
+    if (coo.isMarked()) return;
+
     float v = checker(coo.v);
 
     if (v > checkTolerance) atomicAggInc(nInside);
@@ -424,9 +430,7 @@ void SimpleStationaryWall<InsideWallChecker>::removeInner(ParticleVector *pv)
         }
     }
 
-    pv->haloValid   = false;
-    pv->redistValid = false;
-    pv->cellListStamp++;
+    pv->invalidate();
 
     info("Wall '%s' has removed inner entities of pv '%s', keeping %d out of %d particles",
          name.c_str(), pv->name.c_str(), pv->local()->size(), oldSize);
@@ -565,6 +569,7 @@ template class SimpleStationaryWall<StationaryWall_Cylinder>;
 template class SimpleStationaryWall<StationaryWall_SDF>;
 template class SimpleStationaryWall<StationaryWall_Plane>;
 template class SimpleStationaryWall<StationaryWall_Box>;
+template class SimpleStationaryWall<StationaryWall_Composite>;
 
 
 
@@ -0,0 +1,202 @@
+#include "composite.h"
+
+#include <core/logger.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/kernel_launch.h>
+#include <core/walls/interface.h>
+
+#include <algorithm>
+#include <cmath>
+#include <curand_kernel.h>
+
+namespace CompositeWallKernels
+{
+__global__ void gridPositions(int3 resolution, float3 h, float3 extendedDomainSize, float3 *positions)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= resolution.x * resolution.y * resolution.z) return;
+
+    const int ix = i % resolution.x;
+    const int iy = (i / resolution.x) % resolution.y;
+    const int iz = i / (resolution.x * resolution.y);
+
+    positions[i] = make_float3(ix, iy, iz) * h - 0.5f * extendedDomainSize;
+}
+
+__global__ void randomPositions(int n, float3 *positions, long seed, float3 localSize)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+
+    curandState_t state;
+    curand_init(seed, i, 0, &state);
+
+    float3 r;
+    r.x = localSize.x * (curand_uniform(&state) - 0.5f);
+    r.y = localSize.y * (curand_uniform(&state) - 0.5f);
+    r.z = localSize.z * (curand_uniform(&state) - 0.5f);
+
+    positions[i] = r;
+}
+
+__global__ void initSdfs(int n, float *sdfs, float val)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i < n) sdfs[i] = val;
+}
+
+template <StationaryWall_Composite::Mode mode>
+__global__ void mergeSdfs(int n, const float *sdfs, float *merged)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+
+    if (mode == StationaryWall_Composite::Mode::Union)
+        merged[i] = max(sdfs[i], merged[i]);
+    else
+        merged[i] = min(sdfs[i], merged[i]);
+}
+
+__global__ void evaluateField(int n, const float3 *positions, FieldDeviceHandler field, float *sdfs)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i < n) sdfs[i] = field(positions[i]);
+}
+} // namespace CompositeWallKernels
+
+
+class FieldFromWalls : public Field
+{
+public:
+    FieldFromWalls(const MirState *state, std::string name, std::vector<std::shared_ptr<SDF_basedWall>> walls,
+                   StationaryWall_Composite::Mode mode, float3 h) :
+        Field(state, name, h),
+        walls(walls),
+        mode(mode)
+    {}
+
+    void setup(const MPI_Comm& comm) override
+    {
+        info("Baking %d walls into the field '%s'", (int) walls.size(), name.c_str());
+
+        CUDA_Check( cudaDeviceSynchronize() );
+
+        MPI_Comm wallComm = comm;
+        for (auto& wall : walls)
+            wall->setup(wallComm);
+
+        const int n = resolution.x * resolution.y * resolution.z;
+        DeviceBuffer<float3> positions(n);
+        DeviceBuffer<float> merged(n);
+
+        const int nthreads = 128;
+        SAFE_KERNEL_LAUNCH(
+            CompositeWallKernels::gridPositions,
+            getNblocks(n, nthreads), nthreads, 0, defaultStream,
+            resolution, h, extendedDomainSize, positions.devPtr() );
+
+        computeAnalytic(positions, merged);
+
+        setupArrayTexture(merged.devPtr());
+    }
+
+    void computeAnalytic(DeviceBuffer<float3>& positions, DeviceBuffer<float>& merged) const
+    {
+        const int n = positions.size();
+        const int nthreads = 128;
+        const int nblocks = getNblocks(n, nthreads);
+        const float initial = (mode == StationaryWall_Composite::Mode::Union) ? -1e5f : 1e5f;
+
+        DeviceBuffer<float> sdfs(n);
+        merged.resize_anew(n);
+
+        SAFE_KERNEL_LAUNCH(
+            CompositeWallKernels::initSdfs,
+            nblocks, nthreads, 0, defaultStream,
+            n, merged.devPtr(), initial );
+
+        for (auto& wall : walls)
+        {
+            wall->sdfPerPosition(&positions, &sdfs, defaultStream);
+
+            if (mode == StationaryWall_Composite::Mode::Union)
+                SAFE_KERNEL_LAUNCH(
+                    CompositeWallKernels::mergeSdfs<StationaryWall_Composite::Mode::Union>,
+                    nblocks, nthreads, 0, defaultStream,
+                    n, sdfs.devPtr(), merged.devPtr() );
+            else
+                SAFE_KERNEL_LAUNCH(
+                    CompositeWallKernels::mergeSdfs<StationaryWall_Composite::Mode::Intersection>,
+                    nblocks, nthreads, 0, defaultStream,
+                    n, sdfs.devPtr(), merged.devPtr() );
+        }
+    }
+
+    /// Compare the baked field against the analytic walls on random points of the local domain.
+    /// Only the points close to the surface matter for bounce and frozen layers
+    float estimateMaxError(const MPI_Comm& comm, long nSamples) const
+    {
+        const float surfaceBand = 2.0f * std::max(h.x, std::max(h.y, h.z));
+        const int n = nSamples;
+        const int nthreads = 128;
+
+        DeviceBuffer<float3> positions(n);
+        DeviceBuffer<float> analytic(n);
+        PinnedBuffer<float> exact, baked(n);
+
+        SAFE_KERNEL_LAUNCH(
+            CompositeWallKernels::randomPositions,
+            getNblocks(n, nthreads), nthreads, 0, defaultStream,
+            n, positions.devPtr(), 424242, state->domain.localSize );
+
+        computeAnalytic(positions, analytic);
+        exact.copy(analytic, defaultStream);
+
+        SAFE_KERNEL_LAUNCH(
+            CompositeWallKernels::evaluateField,
+            getNblocks(n, nthreads), nthreads, 0, defaultStream,
+            n, positions.devPtr(), handler(), baked.devPtr() );
+
+        baked.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+        float maxError = 0.f;
+        for (int i = 0; i < n; ++i)
+            if (fabsf(exact[i]) < surfaceBand)
+                maxError = std::max(maxError, fabsf(exact[i] - baked[i]));
+
+        MPI_Check( MPI_Allreduce(MPI_IN_PLACE, &maxError, 1, MPI_FLOAT, MPI_MAX, comm) );
+        return maxError;
+    }
+
+private:
+    std::vector<std::shared_ptr<SDF_basedWall>> walls;
+    StationaryWall_Composite::Mode mode;
+};
+
+
+StationaryWall_Composite::StationaryWall_Composite(const MirState *state, std::string name, std::vector<std::shared_ptr<SDF_basedWall>> walls,
+                                                   Mode mode, float3 sdfH, long nErrorSamplesPerRank) :
+    impl(new FieldFromWalls(state, "field_"+name, walls, mode, sdfH)),
+    nErrorSamplesPerRank(nErrorSamplesPerRank)
+{}
+
+StationaryWall_Composite::StationaryWall_Composite(StationaryWall_Composite&&) = default;
+
+StationaryWall_Composite::~StationaryWall_Composite() = default;
+
+const FieldDeviceHandler& StationaryWall_Composite::handler() const
+{
+    return impl->handler();
+}
+
+void StationaryWall_Composite::setup(MPI_Comm& comm, __UNUSED DomainInfo domain)
+{
+    impl->setup(comm);
+
+    if (nErrorSamplesPerRank > 0)
+    {
+        maxError = impl->estimateMaxError(comm, nErrorSamplesPerRank);
+        info("Composite wall field '%s': max deviation from the analytic walls near the surface is %g",
+             impl->name.c_str(), maxError);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <core/field/interface.h>
+
+#include <memory>
+#include <vector>
+
+class SDF_basedWall;
+class FieldFromWalls;
+
+/**
+ * Union or intersection of several SDF-based walls,
+ * baked once at setup into a single field texture.
+ * Evaluating the resulting SDF costs one field lookup
+ * regardless of the number of component walls.
+ */
+class StationaryWall_Composite
+{
+public:
+    enum class Mode {Union, Intersection};
+
+    StationaryWall_Composite(const MirState *state, std::string name, std::vector<std::shared_ptr<SDF_basedWall>> walls,
+                             Mode mode, float3 sdfH, long nErrorSamplesPerRank = 100000);
+    StationaryWall_Composite(StationaryWall_Composite&&);
+    ~StationaryWall_Composite();
+
+    void setup(MPI_Comm& comm, DomainInfo domain);
+
+    const FieldDeviceHandler& handler() const;
+
+    /// maximum difference between the baked and the analytic SDF near the wall surface, over all ranks
+    float getMaxError() const { return maxError; }
+
+private:
+    std::unique_ptr<FieldFromWalls> impl;
+    long nErrorSamplesPerRank;
+    float maxError {0.f};
+};
@@ -1,7 +1,7 @@
 #include "sdf.h"
 
-StationaryWall_SDF::StationaryWall_SDF(const MirState *state, std::string sdfFileName, float3 sdfH) :
-    impl(new FieldFromFile(state, "field_"+sdfFileName, sdfFileName, sdfH))
+StationaryWall_SDF::StationaryWall_SDF(const MirState *state, std::string sdfFileName, float3 sdfH, std::string cacheFolder) :
+    impl(new FieldFromFile(state, "field_"+sdfFileName, sdfFileName, sdfH, cacheFolder))
 {}
 
 StationaryWall_SDF::StationaryWall_SDF(StationaryWall_SDF&&) = default;
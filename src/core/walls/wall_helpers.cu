@@ -4,11 +4,13 @@
 #include <core/logger.h>
 #include <core/pvs/particle_vector.h>
 #include <core/pvs/views/pv.h>
+#include <core/utils/cache.h>
 #include <core/utils/cuda_common.h>
 #include <core/utils/folders.h>
 #include <core/utils/kernel_launch.h>
 #include <core/walls/simple_stationary_wall.h>
 #include <core/xdmf/xdmf.h>
+#include <plugins/utils/simple_serializer.h>
 
 #include <curand_kernel.h>
 
@@ -249,3 +251,61 @@ double WallHelpers::volumeInsideWalls(std::vector<SDF_basedWall*> walls, DomainI
     
     return totVolume;
 }
+
+void WallHelpers::addWallsToCacheKey(std::vector<SDF_basedWall*> walls, DomainInfo domain, Cache::Key& key)
+{
+    const float3 gridH {0.5f, 0.5f, 0.5f};
+    PinnedBuffer<float> sdfs;
+
+    key.add(domain.globalSize).add(domain.globalStart).add(domain.localSize);
+    
+    for (auto& wall : walls)
+    {
+        wall->sdfOnGrid(gridH, &sdfs, defaultStream);
+        sdfs.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+        key.add(sdfs.hostPtr(), sdfs.size() * sizeof(float));
+    }
+}
+
+bool WallHelpers::loadFrozenParticles(const std::string& fileName, ParticleVector *pv, MPI_Comm comm)
+{
+    std::vector<char> blob;
+    PinnedBuffer<float4> positions, velocities;
+
+    bool found = Cache::load(fileName, blob);
+    if (found)
+    {
+        SimpleSerializer::deserialize(blob, positions, velocities);
+        found = positions.size() == velocities.size();
+    }
+
+    if (!Cache::allRanks(comm, found))
+        return false;
+
+    info("Using %d cached frozen particles from '%s'", positions.size(), fileName.c_str());
+
+    positions .uploadToDevice(defaultStream);
+    velocities.uploadToDevice(defaultStream);
+    
+    pv->local()->resize(positions.size(), defaultStream);
+    std::swap(positions,  pv->local()->positions());
+    std::swap(velocities, pv->local()->velocities());
+
+    CUDA_Check( cudaDeviceSynchronize() );
+    return true;
+}
+
+void WallHelpers::storeFrozenParticles(const std::string& fileName, ParticleVector *pv)
+{
+    auto& positions  = pv->local()->positions();
+    auto& velocities = pv->local()->velocities();
+
+    positions .downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    velocities.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    std::vector<char> blob;
+    SimpleSerializer::serialize(blob, positions, velocities);
+    Cache::store(fileName, blob);
+
+    debug("Stored %d frozen particles in '%s'", positions.size(), fileName.c_str());
+}
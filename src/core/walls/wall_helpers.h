@@ -10,6 +10,8 @@
 class SDF_basedWall;
 class ParticleVector;
 
+namespace Cache { class Key; }
+
 namespace WallHelpers
 {
 
@@ -20,4 +22,11 @@ void dumpWalls2XDMF(std::vector<SDF_basedWall*> walls, float3 gridH, DomainInfo
 
 double volumeInsideWalls(std::vector<SDF_basedWall*> walls, DomainInfo domain, MPI_Comm comm, long nSamplesPerRank);
 
+/// add the walls SDF sampled on a grid of the local domain to the key, such that any change of the geometry changes the key
+void addWallsToCacheKey(std::vector<SDF_basedWall*> walls, DomainInfo domain, Cache::Key& key);
+
+/// collective; return true and fill pv only if all the ranks have a valid cache entry
+bool loadFrozenParticles(const std::string& fileName, ParticleVector *pv, MPI_Comm comm);
+void storeFrozenParticles(const std::string& fileName, ParticleVector *pv);
+
 } // namespace WallHelpers
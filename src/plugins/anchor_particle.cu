@@ -165,6 +165,14 @@ void AnchorParticlesStatsPlugin::deserialize()
 
     SimpleSerializer::deserialize(data, currentTime, nsamples, forces);
 
+    for (const auto& other : otherData)
+    {
+        std::vector<double3> otherForces;
+        SimpleSerializer::deserialize(other, currentTime, nsamples, otherForces);
+        for (size_t i = 0; i < forces.size(); ++i)
+            forces[i] += otherForces[i];
+    }
+
     MPI_Check( MPI_Reduce( (rank == 0 ? MPI_IN_PLACE : forces.data()),  forces.data(),  3 * forces.size(),  MPI_DOUBLE, MPI_SUM, 0, comm) );
 
     if (activated && rank == 0)
@@ -30,6 +30,11 @@ void UniformCartesianDumper::handshake()
     std::vector<int> sizes;
     std::vector<std::string> names;
     SimpleSerializer::deserialize(data, nranks3D, rank3D, resolution, h, sizes, names);
+
+    // each rank writes exactly one block of the grid
+    if (nSimulationRanks != 1)
+        die("Plugin '%s' needs one simulation rank per postprocess rank, got %d",
+            name.c_str(), nSimulationRanks);
         
     int ranksArr[] = {nranks3D.x, nranks3D.y, nranks3D.z};
     int periods[] = {0, 0, 0};
@@ -0,0 +1,454 @@
+#include "correlators.h"
+#include "utils/simple_serializer.h"
+#include "utils/time_stamp.h"
+
+#include <core/pvs/particle_vector.h>
+#include <core/pvs/views/pv.h>
+#include <core/simulation.h>
+#include <core/utils/common.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/folders.h>
+#include <core/utils/kernel_launch.h>
+
+namespace CorrelatorKernels
+{
+
+constexpr int maxLevels = 32;
+
+struct ActiveLevels
+{
+    int n;
+    int slot  [maxLevels];
+    int nvalid[maxLevels];
+};
+
+__global__ void savePositions(PVview view, float4 *savedPositions)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= view.size) return;
+
+    savedPositions[i] = view.readPosition(i);
+}
+
+// saved positions are shifted with the particles, the displacement is the same in all the frames
+__global__ void unwrapPositions(PVview view, float4 *savedPositions, float3 *unwrapped)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= view.size) return;
+
+    Float3_int pos(view.readPosition(i));
+    Float3_int oldPos(savedPositions[i]);
+
+    unwrapped[i] += pos.v - oldPos.v;
+    savedPositions[i] = pos.toFloat4();
+}
+
+// all the threads of a warp take part in the reductions, even past the last particle
+template <MultiTau::Kind kind>
+__global__ void correlate(PVview view, const float3 *unwrapped, float3 **registers, float3 **accumulators,
+                          ActiveLevels levels, MultiTau::Layout layout, double *sums)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    const bool valid = i < view.size;
+
+    float3 x = make_float3(0.f);
+    if (valid)
+        x = unwrapped != nullptr ? unwrapped[i] : make_float3(view.readVelocity(i));
+
+    for (int l = 0; l < levels.n; ++l)
+    {
+        float3 **regs = registers + l * layout.npoints;
+        const int slot = levels.slot[l];
+
+        if (valid) regs[slot][i] = x;
+
+        for (int k = layout.firstLag(l); k < levels.nvalid[l]; ++k)
+        {
+            const int j = (slot - k + layout.npoints) % layout.npoints;
+            double c = 0.0;
+
+            if (valid)
+            {
+                const float3 y = regs[j][i];
+                c = kind == MultiTau::Kind::Product ? dot(x, y) : dot(x - y, x - y);
+            }
+
+            c = warpReduce(c, [](double a, double b) { return a+b; });
+
+            if (laneId() == 0)
+                atomicAdd(sums + l * layout.npoints + k, c);
+        }
+
+        // the average over the last samples goes to the next level
+        if (l + 1 < layout.nlevels && valid)
+        {
+            float3 acc = accumulators[l][i] + x;
+            if (l + 1 < levels.n)
+            {
+                x = acc / layout.averaging;
+                acc = make_float3(0.f);
+            }
+            accumulators[l][i] = acc;
+        }
+    }
+}
+
+/// virial and kinetic contributions of the particles to the off-diagonal stresses
+__global__ void totalOffDiagonalStress(PVview view, const Stress *stresses, double3 *total)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    double3 s = make_double3(0.0, 0.0, 0.0);
+
+    if (i < view.size)
+    {
+        const Stress st = stresses[i];
+        const float3 u = make_float3(view.readVelocity(i));
+        const float  m = view.mass;
+
+        s = make_double3(st.xy + m * u.x * u.y,
+                         st.xz + m * u.x * u.z,
+                         st.yz + m * u.y * u.z);
+    }
+
+    s = warpReduce(s, [](double a, double b) { return a+b; });
+
+    if (laneId() == 0)
+        atomicAdd(total, s);
+}
+
+} // namespace CorrelatorKernels
+
+static std::vector<double> lagTimes(const MultiTau::Layout& layout, float sampleTime)
+{
+    std::vector<double> lags(layout.size());
+    for (int l = 0; l < layout.nlevels; ++l)
+        for (int k = 0; k < layout.npoints; ++k)
+            lags[l * layout.npoints + k] = layout.lag(l, k) * sampleTime;
+    return lags;
+}
+
+static void checkLayout(const MultiTau::Layout& layout)
+{
+    layout.check();
+    if (layout.nlevels > CorrelatorKernels::maxLevels)
+        die("Multi-tau correlator: at most %d levels are supported, got %d",
+            CorrelatorKernels::maxLevels, layout.nlevels);
+}
+
+//=================================================================================
+
+ParticleCorrelatorPlugin::ParticleCorrelatorPlugin(const MirState *state, std::string name, std::string pvName, Quantity quantity,
+                                                   int sampleEvery, int dumpEvery, MultiTau::Layout layout) :
+    SimulationPlugin(state, name),
+    pvName(pvName),
+    quantity(quantity),
+    sampleEvery(sampleEvery),
+    dumpEvery(dumpEvery),
+    layout(layout),
+    schedule(layout),
+    unwrappedChannelName(name + "_unwrapped_positions"),
+    savedPositionChannelName(name + "_saved_positions"),
+    counts(layout.size(), 0.0)
+{
+    checkLayout(layout);
+}
+
+ParticleCorrelatorPlugin::~ParticleCorrelatorPlugin() = default;
+
+std::string ParticleCorrelatorPlugin::registerName(int level, int slot) const
+{
+    return name + "_register_" + std::to_string(level) + "_" + std::to_string(slot);
+}
+
+std::string ParticleCorrelatorPlugin::accumulatorName(int level) const
+{
+    return name + "_accumulator_" + std::to_string(level);
+}
+
+void ParticleCorrelatorPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    SimulationPlugin::setup(simulation, comm, interComm);
+
+    pv = simulation->getPVbyNameOrDie(pvName);
+    auto& manager = pv->local()->dataPerParticle;
+
+    registers   .resize_anew(layout.size());
+    accumulators.resize_anew(layout.nlevels - 1);
+
+    for (int l = 0; l < layout.nlevels; ++l)
+    {
+        for (int j = 0; j < layout.npoints; ++j)
+        {
+            pv->requireDataPerParticle<float3>(registerName(l, j), DataManager::PersistenceMode::Active);
+            manager.getData<float3>(registerName(l, j))->clear(defaultStream);
+        }
+
+        if (l + 1 < layout.nlevels)
+        {
+            pv->requireDataPerParticle<float3>(accumulatorName(l), DataManager::PersistenceMode::Active);
+            manager.getData<float3>(accumulatorName(l))->clear(defaultStream);
+        }
+    }
+
+    if (quantity == Quantity::MSD)
+    {
+        pv->requireDataPerParticle<float3>(unwrappedChannelName, DataManager::PersistenceMode::Active);
+        pv->requireDataPerParticle<float4>(savedPositionChannelName,
+                                           DataManager::PersistenceMode::Active,
+                                           DataManager::ShiftMode::Active);
+
+        manager.getData<float3>(unwrappedChannelName)->clear(defaultStream);
+
+        PVview view(pv, pv->local());
+        const int nthreads = 128;
+
+        SAFE_KERNEL_LAUNCH(
+            CorrelatorKernels::savePositions,
+            getNblocks(view.size, nthreads), nthreads, 0, defaultStream,
+            view, manager.getData<float4>(savedPositionChannelName)->devPtr() );
+    }
+
+    sums.resize_anew(layout.size());
+    sums.clear(defaultStream);
+
+    info("Plugin %s initialized for the following particle vector: %s, %d correlator channels per particle",
+         name.c_str(), pvName.c_str(), layout.size() + layout.nlevels - 1);
+}
+
+void ParticleCorrelatorPlugin::handshake()
+{
+    const std::string quantityName = quantity == Quantity::MSD ? "msd" : "vacf";
+    SimpleSerializer::serialize(sendBuffer, quantityName, lagTimes(layout, sampleEvery * state->dt));
+    send(sendBuffer);
+}
+
+void ParticleCorrelatorPlugin::afterIntegration(cudaStream_t stream)
+{
+    if (!isTimeEvery(state, sampleEvery)) return;
+
+    auto lpv = pv->local();
+    auto& manager = lpv->dataPerParticle;
+
+    PVview view(pv, lpv);
+    const int nthreads = 128;
+
+    const float3 *unwrapped = nullptr;
+    if (quantity == Quantity::MSD)
+    {
+        auto unwrappedPositions = manager.getData<float3>(unwrappedChannelName);
+
+        SAFE_KERNEL_LAUNCH(
+            CorrelatorKernels::unwrapPositions,
+            getNblocks(view.size, nthreads), nthreads, 0, stream,
+            view, manager.getData<float4>(savedPositionChannelName)->devPtr(), unwrappedPositions->devPtr() );
+
+        unwrapped = unwrappedPositions->devPtr();
+    }
+
+    // the channels may have been reallocated since the last sample
+    for (int l = 0; l < layout.nlevels; ++l)
+    {
+        for (int j = 0; j < layout.npoints; ++j)
+            registers[l * layout.npoints + j] = manager.getData<float3>(registerName(l, j))->devPtr();
+        if (l + 1 < layout.nlevels)
+            accumulators[l] = manager.getData<float3>(accumulatorName(l))->devPtr();
+    }
+    registers   .uploadToDevice(stream);
+    accumulators.uploadToDevice(stream);
+
+    const auto& active = schedule.push();
+
+    CorrelatorKernels::ActiveLevels levels;
+    levels.n = active.size();
+    for (int l = 0; l < levels.n; ++l)
+    {
+        levels.slot  [l] = active[l].slot;
+        levels.nvalid[l] = active[l].nvalid;
+
+        for (int k = layout.firstLag(l); k < active[l].nvalid; ++k)
+            counts[l * layout.npoints + k] += view.size;
+    }
+
+    auto kernel = quantity == Quantity::MSD ?
+        CorrelatorKernels::correlate<MultiTau::Kind::SquaredDifference> :
+        CorrelatorKernels::correlate<MultiTau::Kind::Product>;
+
+    SAFE_KERNEL_LAUNCH(
+        kernel,
+        getNblocks(view.size, nthreads), nthreads, 0, stream,
+        view, unwrapped, registers.devPtr(), accumulators.devPtr(),
+        levels, layout, sums.devPtr() );
+
+    if (!isTimeEvery(state, dumpEvery)) return;
+
+    sums.downloadFromDevice(stream, ContainersSynch::Synch);
+    savedTime = state->currentTime;
+    needToSend = true;
+}
+
+void ParticleCorrelatorPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
+{
+    if (!needToSend) return;
+
+    debug2("Plugin %s is sending now data", name.c_str());
+
+    const std::vector<double> hostSums(sums.begin(), sums.end());
+
+    waitPrevSend();
+    SimpleSerializer::serialize(sendBuffer, savedTime, hostSums, counts);
+    send(sendBuffer);
+
+    needToSend = false;
+}
+
+//=================================================================================
+
+StressCorrelatorPlugin::StressCorrelatorPlugin(const MirState *state, std::string name, std::vector<std::string> pvNames,
+                                               int sampleEvery, int dumpEvery, MultiTau::Layout layout) :
+    SimulationPlugin(state, name),
+    pvNames(pvNames),
+    sampleEvery(sampleEvery),
+    dumpEvery(dumpEvery),
+    layout(layout)
+{
+    checkLayout(layout);
+}
+
+StressCorrelatorPlugin::~StressCorrelatorPlugin() = default;
+
+void StressCorrelatorPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    SimulationPlugin::setup(simulation, comm, interComm);
+
+    for (const auto& pvName : pvNames)
+        pvs.push_back(simulation->getPVbyNameOrDie(pvName));
+
+    if (rank == 0)
+        correlator = std::make_unique<MultiTau::Correlator>(layout, 3, MultiTau::Kind::Product);
+
+    info("Plugin %s initialized for %d particle vectors", name.c_str(), (int) pvs.size());
+}
+
+void StressCorrelatorPlugin::handshake()
+{
+    SimpleSerializer::serialize(sendBuffer, std::string("stress"), lagTimes(layout, sampleEvery * state->dt));
+    send(sendBuffer);
+}
+
+void StressCorrelatorPlugin::afterIntegration(cudaStream_t stream)
+{
+    if (!isTimeEvery(state, sampleEvery)) return;
+
+    localStress.clear(stream);
+
+    for (auto pv : pvs)
+    {
+        PVview view(pv, pv->local());
+        const Stress *stresses = pv->local()->dataPerParticle.getData<Stress>(ChannelNames::stresses)->devPtr();
+        const int nthreads = 128;
+
+        SAFE_KERNEL_LAUNCH(
+            CorrelatorKernels::totalOffDiagonalStress,
+            getNblocks(view.size, nthreads), nthreads, 0, stream,
+            view, stresses, localStress.devPtr() );
+    }
+
+    localStress.downloadFromDevice(stream, ContainersSynch::Synch);
+
+    const auto L = state->domain.globalSize;
+    const double volume = (double) L.x * L.y * L.z;
+    double local[3] = {localStress[0].x / volume, localStress[0].y / volume, localStress[0].z / volume};
+    double global[3];
+
+    MPI_Check( MPI_Reduce(local, global, 3, MPI_DOUBLE, MPI_SUM, 0, comm) );
+
+    if (rank == 0)
+        correlator->push(global);
+
+    if (!isTimeEvery(state, dumpEvery)) return;
+
+    savedTime = state->currentTime;
+    needToSend = true;
+}
+
+void StressCorrelatorPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
+{
+    if (!needToSend) return;
+
+    debug2("Plugin %s is sending now data", name.c_str());
+
+    // only the first rank holds the correlator
+    const std::vector<double> empty(layout.size(), 0.0);
+
+    waitPrevSend();
+    if (rank == 0)
+        SimpleSerializer::serialize(sendBuffer, savedTime, correlator->getSums(), correlator->getCounts());
+    else
+        SimpleSerializer::serialize(sendBuffer, savedTime, empty, empty);
+    send(sendBuffer);
+
+    needToSend = false;
+}
+
+//=================================================================================
+
+MultiTauCorrelatorDumper::MultiTauCorrelatorDumper(std::string name, std::string path) :
+    PostprocessPlugin(name),
+    path(makePath(path))
+{}
+
+void MultiTauCorrelatorDumper::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    PostprocessPlugin::setup(comm, interComm);
+    activated = createFoldersCollective(comm, path);
+}
+
+void MultiTauCorrelatorDumper::handshake()
+{
+    auto req = waitData();
+    MPI_Check( MPI_Wait(&req, MPI_STATUS_IGNORE) );
+    recv();
+
+    SimpleSerializer::deserialize(data, quantityName, lags);
+}
+
+void MultiTauCorrelatorDumper::deserialize()
+{
+    MirState::TimeType curTime;
+    std::vector<double> sums(lags.size(), 0.0), counts(lags.size(), 0.0);
+
+    forEachMessage([&](const std::vector<char>& msg)
+    {
+        std::vector<double> s, c;
+        SimpleSerializer::deserialize(msg, curTime, s, c);
+
+        for (size_t i = 0; i < s.size(); ++i)
+        {
+            sums  [i] += s[i];
+            counts[i] += c[i];
+        }
+    });
+
+    if (!activated) return;
+
+    std::vector<double> totalSums(sums.size()), totalCounts(counts.size());
+    MPI_Check( MPI_Reduce(sums  .data(), totalSums  .data(), sums  .size(), MPI_DOUBLE, MPI_SUM, 0, comm) );
+    MPI_Check( MPI_Reduce(counts.data(), totalCounts.data(), counts.size(), MPI_DOUBLE, MPI_SUM, 0, comm) );
+
+    if (rank != 0) return;
+
+    // the correlator is cumulative: the file always holds the best estimate
+    auto fname = path + name + ".txt";
+    FileWrapper fout;
+    if (fout.open(fname, "w") != FileWrapper::Status::Success)
+        die("Could not open file '%s'", fname.c_str());
+
+    fprintf(fout.get(), "# time %g\n", curTime);
+    fprintf(fout.get(), "# lag %s count\n", quantityName.c_str());
+
+    // the lags of the successive levels do not overlap and are increasing
+    for (size_t i = 0; i < lags.size(); ++i)
+        if (totalCounts[i] > 0)
+            fprintf(fout.get(), "%.6e %.6e %.0f\n", lags[i], totalSums[i] / totalCounts[i], totalCounts[i]);
+}
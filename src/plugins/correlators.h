@@ -0,0 +1,114 @@
+#pragma once
+
+#include "interface.h"
+#include "utils/multi_tau.h"
+
+#include <core/containers.h>
+#include <core/utils/file_wrapper.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class ParticleVector;
+
+/**
+ * Multi-tau correlation of a per-particle quantity, averaged over the particles:
+ * mean square displacement or velocity autocorrelation.
+ * The registers of each particle are stored in particle channels and follow the particles.
+ */
+class ParticleCorrelatorPlugin : public SimulationPlugin
+{
+public:
+    enum class Quantity { MSD, VACF };
+
+    ParticleCorrelatorPlugin(const MirState *state, std::string name, std::string pvName, Quantity quantity,
+                             int sampleEvery, int dumpEvery, MultiTau::Layout layout);
+    ~ParticleCorrelatorPlugin();
+
+    void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+    void afterIntegration(cudaStream_t stream) override;
+    void serializeAndSend(cudaStream_t stream) override;
+
+    bool needPostproc() override { return true; }
+
+private:
+    std::string registerName(int level, int slot) const;
+    std::string accumulatorName(int level) const;
+
+    std::string pvName;
+    ParticleVector *pv;
+    Quantity quantity;
+    int sampleEvery, dumpEvery;
+    bool needToSend = false;
+
+    MultiTau::Layout layout;
+    MultiTau::Schedule schedule;
+
+    const std::string unwrappedChannelName;
+    const std::string savedPositionChannelName;
+
+    PinnedBuffer<float3*> registers, accumulators;
+    PinnedBuffer<double> sums;
+    std::vector<double> counts;
+    MirState::TimeType savedTime = 0;
+
+    std::vector<char> sendBuffer;
+};
+
+/**
+ * Multi-tau autocorrelation of the off-diagonal components of the
+ * volume-averaged stress (virial and kinetic parts) of a set of particle vectors.
+ * The stress is reduced on the first simulation rank, which holds the correlator.
+ */
+class StressCorrelatorPlugin : public SimulationPlugin
+{
+public:
+    StressCorrelatorPlugin(const MirState *state, std::string name, std::vector<std::string> pvNames,
+                           int sampleEvery, int dumpEvery, MultiTau::Layout layout);
+    ~StressCorrelatorPlugin();
+
+    void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+    void afterIntegration(cudaStream_t stream) override;
+    void serializeAndSend(cudaStream_t stream) override;
+
+    bool needPostproc() override { return true; }
+
+private:
+    std::vector<std::string> pvNames;
+    std::vector<ParticleVector*> pvs;
+    int sampleEvery, dumpEvery;
+    bool needToSend = false;
+
+    MultiTau::Layout layout;
+    std::unique_ptr<MultiTau::Correlator> correlator;
+
+    PinnedBuffer<double3> localStress {1};
+    MirState::TimeType savedTime = 0;
+
+    std::vector<char> sendBuffer;
+};
+
+
+/**
+ * Postprocess side of the correlator plugins:
+ * merges the sums of all the ranks and writes the correlation as a function of the lag time.
+ */
+class MultiTauCorrelatorDumper : public PostprocessPlugin
+{
+public:
+    MultiTauCorrelatorDumper(std::string name, std::string path);
+
+    void setup(const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+    void deserialize() override;
+
+private:
+    std::string path;
+    bool activated = true;
+
+    std::string quantityName;
+    std::vector<double> lags;
+};
@@ -3,14 +3,43 @@
 #include "utils/time_stamp.h"
 
 #include <core/celllist.h>
+#include <core/mesh/membrane.h>
 #include <core/pvs/object_vector.h>
 #include <core/pvs/particle_vector.h>
 #include <core/simulation.h>
 #include <core/utils/cuda_common.h>
 #include <core/utils/folders.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <regex>
 
+// reordered meshes are written in the vertex order of the input mesh
+static void restoreOriginalOrder(const Mesh *mesh, std::vector<float3>& vertices)
+{
+    const auto& originalIds = mesh->getOriginalIds();
+    if (originalIds.empty()) return;
+
+    const int nvertices = mesh->getNvertices();
+    std::vector<float3> reordered(vertices.size());
+
+    for (size_t start = 0; start < vertices.size(); start += nvertices)
+        for (int i = 0; i < nvertices; ++i)
+            reordered[start + originalIds[i]] = vertices[start + i];
+
+    vertices.swap(reordered);
+}
+
+static const Mesh& getMeshType(const Mesh *mesh, int type)
+{
+    if (mesh->getNtypes() == 1)
+        return *mesh;
+
+    return static_cast<const MembraneMesh*>(mesh)->getMeshType(type);
+}
+
 MeshPlugin::MeshPlugin(const MirState *state, std::string name, std::string ovName, int dumpEvery) :
     SimulationPlugin(state, name), ovName(ovName),
     dumpEvery(dumpEvery)
@@ -22,6 +51,21 @@ void MeshPlugin::setup(Simulation* simulation, const MPI_Comm& comm, const MPI_C
 
     ov = simulation->getOVbyNameOrDie(ovName);
 
+    const auto mesh = ov->mesh.get();
+    typeNvertices.clear();
+    typeNtriangles.clear();
+    triangles.clear();
+
+    for (int type = 0; type < mesh->getNtypes(); ++type)
+    {
+        const auto& m = getMeshType(mesh, type);
+        const auto typeTriangles = m.getOriginalTriangles();
+
+        typeNvertices .push_back(m.getNvertices());
+        typeNtriangles.push_back(m.getNtriangles());
+        triangles.insert(triangles.end(), typeTriangles.begin(), typeTriangles.end());
+    }
+
     info("Plugin %s initialized for the following object vector: %s", name.c_str(), ovName.c_str());
 }
 
@@ -29,6 +73,12 @@ void MeshPlugin::beforeForces(cudaStream_t stream)
 {
     if (!isTimeEvery(state, dumpEvery)) return;
 
+    if (ov->mesh->getNtypes() > 1)
+    {
+        srcTypes = ov->local()->dataPerObject.getData<int>(ChannelNames::meshTypes);
+        srcTypes->downloadFromDevice(stream, ContainersSynch::Asynch);
+    }
+
     srcVerts = ov->local()->getMeshVertices(stream);
     srcVerts->downloadFromDevice(stream);
 }
@@ -39,22 +89,46 @@ void MeshPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
 
     debug2("Plugin %s is sending now data", name.c_str());
 
+    // the previous message refers to the vertices
+    waitPrevSend();
+
+    const auto mesh = ov->mesh.get();
+    const int objSize  = mesh->getNvertices();
+    const int nObjects = srcVerts->size() / objSize;
+
+    if (srcTypes != nullptr)
+        objectTypes.assign(srcTypes->begin(), srcTypes->end());
+    else
+        objectTypes.assign(nObjects, 0);
+
+    // only the vertices of the type of each object are sent;
+    // reordered meshes are written in the vertex order of the input mesh
     vertices.clear();
     vertices.reserve(srcVerts->size());
 
-    for (auto& p : *srcVerts)
-        vertices.push_back(state->domain.local2global(make_float3(p)));
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        const auto& m = getMeshType(mesh, objectTypes[objId]);
+        const auto& originalIds = m.getOriginalIds();
+        const int nvertices = m.getNvertices();
 
-    auto& mesh = ov->mesh;
+        const size_t start = vertices.size();
+        vertices.resize(start + nvertices);
+
+        for (int i = 0; i < nvertices; ++i)
+        {
+            const int dst = originalIds.empty() ? i : originalIds[i];
+            vertices[start + dst] = state->domain.local2global(make_float3((*srcVerts)[objId * objSize + i]));
+        }
+    }
 
     MirState::StepType timeStamp = getTimeStamp(state, dumpEvery);
     
-    waitPrevSend();
-    SimpleSerializer::serialize(sendBuffer, timeStamp, ov->name,
-                                mesh->getNvertices(), mesh->getNtriangles(), mesh->triangles,
-                                vertices);
+    SimpleSerializer::serializeSegments(message, timeStamp, ov->name,
+                                        typeNvertices, typeNtriangles, triangles,
+                                        objectTypes, vertices);
 
-    send(sendBuffer);
+    send(message);
 }
 
 //=================================================================================
@@ -75,15 +149,21 @@ static MPI_Offset writeToMPI(const std::vector<T>& data, MPI_File f, MPI_Offset
 
 static void writePLY(
         MPI_Comm comm, std::string fname,
-        int nvertices, int nverticesPerObject,
-        int ntriangles, int ntrianglesPerObject,
-        int nObjects,
-        const std::vector<int3>& mesh,
+        const std::vector<int>& typeNvertices,
+        const std::vector<int>& typeNtriangles,
+        const std::vector<int3>& triangles,
+        const std::vector<int>& objectTypes,
         const std::vector<float3>& vertices)
 {
     int rank;
     MPI_Check( MPI_Comm_rank(comm, &rank) );
 
+    const int nvertices = vertices.size();
+
+    int ntriangles = 0;
+    for (int type : objectTypes)
+        ntriangles += typeNtriangles[type];
+
     int totalVerts = 0;
     MPI_Check( MPI_Reduce(&nvertices, &totalVerts, 1, MPI_INT, MPI_SUM, 0, comm) );
 
@@ -125,13 +205,23 @@ static void writePLY(
     int verticesOffset = 0;
     MPI_Check( MPI_Exscan(&nvertices, &verticesOffset, 1, MPI_INT, MPI_SUM, comm));
 
+    std::vector<int> typeFirstTriangle(typeNtriangles.size(), 0);
+    for (size_t type = 1; type < typeNtriangles.size(); ++type)
+        typeFirstTriangle[type] = typeFirstTriangle[type-1] + typeNtriangles[type-1];
+
     std::vector<int4> connectivity;
-    for(int j = 0; j < nObjects; ++j)
-        for(int i = 0; i < ntrianglesPerObject; ++i)
+    connectivity.reserve(ntriangles);
+
+    int objectStart = verticesOffset;
+    for (int type : objectTypes)
+    {
+        for (int i = 0; i < typeNtriangles[type]; ++i)
         {
-            int3 vertIds = mesh[i] + nverticesPerObject * j + verticesOffset;
+            int3 vertIds = triangles[typeFirstTriangle[type] + i] + objectStart;
             connectivity.push_back({3, vertIds.x, vertIds.y, vertIds.z});
         }
+        objectStart += typeNvertices[type];
+    }
 
     fileOffset += writeToMPI(connectivity, f, fileOffset, comm);
 
@@ -155,23 +245,274 @@ void MeshDumper::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
 void MeshDumper::deserialize()
 {
     std::string ovName;
-    int nvertices, ntriangles;
 
     MirState::StepType timeStamp;
-    SimpleSerializer::deserialize(data, timeStamp, ovName, nvertices, ntriangles, connectivity, vertices);
+    objectTypes.clear();
+    vertices.clear();
+    forEachMessage([&](const std::vector<char>& msg)
+    {
+        SerializedArrayView<int3> msgTriangles;
+        SerializedArrayView<int> msgTypes;
+        SerializedArrayView<float3> msgVertices;
+        SimpleSerializer::deserialize(msg, timeStamp, ovName, typeNvertices, typeNtriangles,
+                                      msgTriangles, msgTypes, msgVertices);
+
+        // all the messages carry the same meshes
+        if (triangles.empty())
+            msgTriangles.appendTo(triangles);
+        msgTypes.appendTo(objectTypes);
+        msgVertices.appendTo(vertices);
+    });
 
     std::string currentFname = path + ovName + "_" + getStrZeroPadded(timeStamp) + ".ply";
 
     if (activated)
+        writePLY(comm, currentFname, typeNvertices, typeNtriangles, triangles, objectTypes, vertices);
+}
+
+
+
+
+
+//=================================================================================
+
+static constexpr char    trajectoryMagic[] = "MIRMTRAJ";
+static constexpr int32_t trajectoryVersion = 1;
+
+MeshTrajectoryPlugin::MeshTrajectoryPlugin(const MirState *state, std::string name, std::string ovName,
+                                           int dumpEvery, float quantizationStep) :
+    SimulationPlugin(state, name),
+    ovName(ovName),
+    dumpEvery(dumpEvery),
+    quantizationStep(quantizationStep)
+{
+    if (quantizationStep < 0.f)
+        die("Plugin '%s': quantization step must be non negative, got %g", name.c_str(), quantizationStep);
+}
+
+void MeshTrajectoryPlugin::setup(Simulation* simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    SimulationPlugin::setup(simulation, comm, interComm);
+
+    ov = simulation->getOVbyNameOrDie(ovName);
+
+    if (ov->mesh->getNtypes() > 1)
+        die("Plugin '%s': the mesh of several types of '%s' is not supported, use the mesh dump instead",
+            name.c_str(), ovName.c_str());
+
+    info("Plugin %s initialized for the following object vector: %s", name.c_str(), ovName.c_str());
+}
+
+void MeshTrajectoryPlugin::handshake()
+{
+    auto& mesh = ov->mesh;
+
+    waitPrevSend();
+    debug("handshake for plugin '%s': sending %d triangles for a %d vertices mesh",
+          name.c_str(), mesh->getNtriangles(), mesh->getNvertices());
+    SimpleSerializer::serialize(sendBuffer, ov->name, mesh->getNvertices(), mesh->getOriginalTriangles(), quantizationStep);
+    send(sendBuffer);
+}
+
+void MeshTrajectoryPlugin::beforeForces(cudaStream_t stream)
+{
+    if (!isTimeEvery(state, dumpEvery)) return;
+
+    srcVerts = ov->local()->getMeshVertices(stream);
+    srcVerts->downloadFromDevice(stream, ContainersSynch::Asynch);
+
+    srcIds = ov->local()->dataPerObject.getData<int64_t>(ChannelNames::globalIds);
+    srcIds->downloadFromDevice(stream);
+}
+
+void MeshTrajectoryPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
+{
+    if (!isTimeEvery(state, dumpEvery)) return;
+
+    debug2("Plugin %s is sending now data", name.c_str());
+
+    // the previous message refers to the ids, coms and vertices
+    waitPrevSend();
+
+    const int nvertices = ov->mesh->getNvertices();
+    const int nObjects  = srcVerts->size() / nvertices;
+
+    coms.resize(nObjects);
+    vertices.resize(srcVerts->size());
+
+    for (int objId = 0; objId < nObjects; ++objId)
     {
-        int nObjects = vertices.size() / nvertices;
-        writePLY(comm, currentFname,
-                nvertices*nObjects, nvertices,
-                ntriangles*nObjects, ntriangles,
-                nObjects,
-                connectivity, vertices);
+        double3 com {0.0, 0.0, 0.0};
+        for (int i = objId * nvertices; i < (objId+1) * nvertices; ++i)
+        {
+            vertices[i] = state->domain.local2global(make_float3((*srcVerts)[i]));
+            com.x += vertices[i].x;
+            com.y += vertices[i].y;
+            com.z += vertices[i].z;
+        }
+        coms[objId] = make_float3(com.x / nvertices, com.y / nvertices, com.z / nvertices);
     }
+
+    restoreOriginalOrder(ov->mesh.get(), vertices);
+
+    quantized.clear();
+    if (quantizationStep > 0.f)
+    {
+        constexpr float qmax = std::numeric_limits<int16_t>::max();
+        const float invStep = 1.0f / quantizationStep;
+        bool overflow = false;
+
+        quantized.resize(3 * vertices.size());
+
+        auto quantize = [&](float x) {
+            float q = std::round(x * invStep);
+            if (std::abs(q) > qmax)
+            {
+                overflow = true;
+                q = std::min(qmax, std::max(-qmax, q));
+            }
+            return static_cast<int16_t>(q);
+        };
+        
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const float3 r = vertices[i] - coms[i / nvertices];
+            quantized[3*i + 0] = quantize(r.x);
+            quantized[3*i + 1] = quantize(r.y);
+            quantized[3*i + 2] = quantize(r.z);
+        }
+
+        if (overflow && !overflowReported)
+        {
+            warn("Plugin '%s': some vertices are further than %g from the center of mass of their object "
+                 "and were clamped, consider a larger quantization step",
+                 name.c_str(), qmax * quantizationStep);
+            overflowReported = true;
+        }
+        
+        vertices.clear();
+    }
+
+    MirState::StepType timeStamp = getTimeStamp(state, dumpEvery);
+    
+    ids.assign(srcIds->begin(), srcIds->end());
+
+    SimpleSerializer::serializeSegments(message, timeStamp, state->currentTime, ids, coms, vertices, quantized);
+
+    send(message);
 }
 
+//=================================================================================
+
+MeshTrajectoryDumper::MeshTrajectoryDumper(std::string name, std::string path) :
+    PostprocessPlugin(name),
+    path(makePath(path))
+{}
+
+MeshTrajectoryDumper::~MeshTrajectoryDumper() = default;
 
+void MeshTrajectoryDumper::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    PostprocessPlugin::setup(comm, interComm);
+    activated = createFoldersCollective(comm, path);
+}
+
+void MeshTrajectoryDumper::handshake()
+{
+    auto req = waitData();
+    MPI_Check( MPI_Wait(&req, MPI_STATUS_IGNORE) );
+    recv();
 
+    std::string ovName;
+    std::vector<int3> triangles;
+    SimpleSerializer::deserialize(data, ovName, nvertices, triangles, quantizationStep);
+    debug("handshake for plugin '%s': received %d triangles for a %d vertices mesh",
+          name.c_str(), (int) triangles.size(), nvertices);
+
+    if (!activated) return;
+
+    fname = path + ovName + ".mtraj";
+
+    MPI_File f;
+    MPI_Check( MPI_File_open(comm, fname.c_str(), MPI_MODE_CREATE|MPI_MODE_DELETE_ON_CLOSE|MPI_MODE_WRONLY, MPI_INFO_NULL, &f) );
+    MPI_Check( MPI_File_close(&f) );
+    MPI_Check( MPI_File_open(comm, fname.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &f) );
+
+    // the topology is the same on all ranks, only one writes it
+    std::vector<char> header;
+    if (rank == 0)
+    {
+        const int32_t ntriangles = triangles.size();
+        const int32_t nv = nvertices;
+        auto append = [&header](const void *ptr, size_t size) {
+            auto cptr = static_cast<const char*>(ptr);
+            header.insert(header.end(), cptr, cptr + size);
+        };
+
+        append(trajectoryMagic, 8);
+        append(&trajectoryVersion, sizeof(trajectoryVersion));
+        append(&nv, sizeof(nv));
+        append(&ntriangles, sizeof(ntriangles));
+        append(&quantizationStep, sizeof(quantizationStep));
+        append(triangles.data(), triangles.size() * sizeof(int3));
+    }
+
+    fileOffset = writeToMPI(header, f, 0, comm);
+
+    MPI_Check( MPI_File_close(&f) );
+}
+
+void MeshTrajectoryDumper::deserialize()
+{
+    MirState::StepType timeStamp;
+    MirState::TimeType time;
+    ids      .clear();
+    coms     .clear();
+    vertices .clear();
+    quantized.clear();
+
+    forEachMessage([&](const std::vector<char>& msg)
+    {
+        SerializedArrayView<int64_t> msgIds;
+        SerializedArrayView<float3> msgComs, msgVertices;
+        SerializedArrayView<int16_t> msgQuantized;
+        SimpleSerializer::deserialize(msg, timeStamp, time, msgIds, msgComs, msgVertices, msgQuantized);
+
+        msgIds      .appendTo(ids);
+        msgComs     .appendTo(coms);
+        msgVertices .appendTo(vertices);
+        msgQuantized.appendTo(quantized);
+    });
+
+    if (!activated) return;
+
+    debug2("Plugin '%s' will write a frame of %d objects", name.c_str(), (int) ids.size());
+
+    int64_t nObjects = ids.size(), totObjects = 0;
+    MPI_Check( MPI_Allreduce(&nObjects, &totObjects, 1, MPI_INT64_T, MPI_SUM, comm) );
+
+    MPI_File f;
+    MPI_Check( MPI_File_open(comm, fname.c_str(), MPI_MODE_WRONLY, MPI_INFO_NULL, &f) );
+
+    std::vector<char> frameHeader;
+    if (rank == 0)
+    {
+        const int64_t step = timeStamp;
+        const double t = time;
+        frameHeader.resize(sizeof(step) + sizeof(t) + sizeof(totObjects));
+        memcpy(frameHeader.data(),                           &step,       sizeof(step));
+        memcpy(frameHeader.data() + sizeof(step),            &t,          sizeof(t));
+        memcpy(frameHeader.data() + sizeof(step) + sizeof(t), &totObjects, sizeof(totObjects));
+    }
+
+    fileOffset += writeToMPI(frameHeader, f, fileOffset, comm);
+    fileOffset += writeToMPI(ids,         f, fileOffset, comm);
+    fileOffset += writeToMPI(coms,        f, fileOffset, comm);
+
+    if (quantizationStep > 0.f)
+        fileOffset += writeToMPI(quantized, f, fileOffset, comm);
+    else
+        fileOffset += writeToMPI(vertices,  f, fileOffset, comm);
+
+    MPI_Check( MPI_File_close(&f) );
+}
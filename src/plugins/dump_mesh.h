@@ -1,9 +1,11 @@
 #pragma once
 
 #include <plugins/interface.h>
+#include <plugins/utils/simple_serializer.h>
 #include <core/containers.h>
 #include <core/datatypes.h>
 
+#include <cstdint>
 #include <vector>
 
 class ParticleVector;
@@ -17,8 +19,13 @@ private:
     int dumpEvery;
 
     std::vector<char> sendBuffer;
+    SegmentedMessage message;
+    std::vector<int> typeNvertices, typeNtriangles; ///< of each mesh type
+    std::vector<int3> triangles;                    ///< of all the mesh types, in the order of the input meshes
+    std::vector<int> objectTypes;
     std::vector<float3> vertices;
     PinnedBuffer<float4>* srcVerts;
+    PinnedBuffer<int>* srcTypes {nullptr};
 
     ObjectVector* ov;
 
@@ -41,7 +48,9 @@ private:
 
     bool activated = true;
 
-    std::vector<int3> connectivity;
+    std::vector<int> typeNvertices, typeNtriangles;
+    std::vector<int3> triangles;
+    std::vector<int> objectTypes;
     std::vector<float3> vertices;
 
 public:
@@ -51,3 +60,76 @@ public:
     void deserialize() override;
     void setup(const MPI_Comm& comm, const MPI_Comm& interComm) override;
 };
+
+
+/**
+ * Dump the meshes of an ObjectVector into a single trajectory file.
+ * The topology is sent once at handshake, then every frame only carries
+ * the object ids, their centers of mass and the vertex positions.
+ * Vertices are optionally quantized on 16 bits relative to the center of mass of their object.
+ */
+class MeshTrajectoryPlugin : public SimulationPlugin
+{
+private:
+    std::string ovName;
+    int dumpEvery;
+    float quantizationStep; ///< 0 to store full precision vertices
+    bool overflowReported {false};
+
+    std::vector<char> sendBuffer;
+    SegmentedMessage message;
+    std::vector<int64_t> ids;
+    std::vector<float3> coms, vertices;
+    std::vector<int16_t> quantized;
+    PinnedBuffer<float4>* srcVerts;
+    PinnedBuffer<int64_t>* srcIds;
+
+    ObjectVector* ov;
+
+public:
+    MeshTrajectoryPlugin(const MirState *state, std::string name, std::string ovName, int dumpEvery, float quantizationStep);
+
+    void setup(Simulation* simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+
+    void beforeForces(cudaStream_t stream) override;
+    void serializeAndSend(cudaStream_t stream) override;
+
+    bool needPostproc() override { return true; }
+};
+
+
+/**
+ * Writes <path>/<ov_name>.mtraj, all values little endian:
+ *
+ *   header: char[8] "MIRMTRAJ", int32 version, int32 nvertices, int32 ntriangles,
+ *           float32 quantization step, int32 triangles[ntriangles][3]
+ *   frames: int64 dump index (time step / dump_every), float64 time, int64 nobjects, int64 ids[nobjects], float32 coms[nobjects][3],
+ *           then vertices[nobjects][nvertices][3], float32 global coordinates if the quantization step is 0,
+ *           int16 multiples of the quantization step relative to the object center of mass otherwise
+ *
+ * The objects of a frame are not sorted by id.
+ */
+class MeshTrajectoryDumper : public PostprocessPlugin
+{
+private:
+    std::string path, fname;
+
+    bool activated = true;
+
+    int nvertices;
+    float quantizationStep;
+    MPI_Offset fileOffset {0};
+
+    std::vector<int64_t> ids;
+    std::vector<float3> coms, vertices;
+    std::vector<int16_t> quantized;
+
+public:
+    MeshTrajectoryDumper(std::string name, std::string path);
+    ~MeshTrajectoryDumper();
+
+    void deserialize() override;
+    void setup(const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+};
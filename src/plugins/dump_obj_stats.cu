@@ -1,7 +1,11 @@
 #include "dump_obj_stats.h"
+#include "utils/binary_records.h"
+#include "utils/fixed_format.h"
 #include "utils/simple_serializer.h"
 #include "utils/time_stamp.h"
 
+#include <core/interactions/membrane/kernels/common.h>
+#include <core/pvs/membrane_vector.h>
 #include <core/pvs/rigid_object_vector.h>
 #include <core/pvs/views/ov.h>
 #include <core/simulation.h>
@@ -53,12 +57,81 @@ __global__ void collectObjStats(OVview view, RigidMotion *motionStats)
     }
 }
 
+// area and volume from the triangles, as the membrane interactions do, and gyration tensor from the vertices
+__global__ void collectShapeMoments(OVview view, MeshView mesh, double2 *areaVolumes, ShapeDescriptors::SymmetricMatrix *gyrations)
+{
+    const int objId  = blockIdx.x;
+    const int tid    = threadIdx.x;
+    const int laneId = tid % warpSize;
+    const int offset = objId * view.objSize;
+
+    const auto com = view.comAndExtents[objId].com;
+
+    float2 av = make_float2(0.f);
+    for (int i = tid; i < mesh.ntriangles; i += blockDim.x)
+    {
+        const int3 ids = mesh.triangles[i];
+
+        const auto v0 = make_real3(make_float3( view.readPosition(offset + ids.x) ));
+        const auto v1 = make_real3(make_float3( view.readPosition(offset + ids.y) ));
+        const auto v2 = make_real3(make_float3( view.readPosition(offset + ids.z) ));
+
+        av.x += triangleArea(v0, v1, v2);
+        av.y += triangleSignedVolume(v0, v1, v2);
+    }
+
+    float3 diag    = make_float3(0.f); // xx, yy, zz
+    float3 offdiag = make_float3(0.f); // xy, xz, yz
+    for (int i = tid; i < view.objSize; i += blockDim.x)
+    {
+        const float3 dr = make_float3(view.readPosition(offset + i)) - com;
+
+        diag    += dr * dr;
+        offdiag += make_float3(dr.x * dr.y, dr.x * dr.z, dr.y * dr.z);
+    }
+
+    auto add = [](float a, float b) {return a+b;};
+
+    av      = warpReduce(av,      add);
+    diag    = warpReduce(diag,    add);
+    offdiag = warpReduce(offdiag, add);
+
+    if (laneId == 0)
+    {
+        atomicAdd(&areaVolumes[objId].x, (double) av.x);
+        atomicAdd(&areaVolumes[objId].y, (double) av.y);
+
+        auto& g = gyrations[objId];
+        atomicAdd(&g.xx, (double) diag.x);
+        atomicAdd(&g.yy, (double) diag.y);
+        atomicAdd(&g.zz, (double) diag.z);
+        atomicAdd(&g.xy, (double) offdiag.x);
+        atomicAdd(&g.xz, (double) offdiag.y);
+        atomicAdd(&g.yz, (double) offdiag.z);
+    }
+}
+
+__global__ void describeShapes(int nObjects, int objSize, const double2 *areaVolumes,
+                               const ShapeDescriptors::SymmetricMatrix *gyrations, ShapeDescriptors::Shape *shapes)
+{
+    const int objId = blockIdx.x * blockDim.x + threadIdx.x;
+    if (objId >= nObjects) return;
+
+    auto g = gyrations[objId];
+    g.xx /= objSize; g.xy /= objSize; g.xz /= objSize;
+    g.yy /= objSize; g.yz /= objSize; g.zz /= objSize;
+
+    const double2 av = areaVolumes[objId];
+    shapes[objId] = ShapeDescriptors::describe(g, av.x, av.y);
+}
+
 } // namespace ObjStatsPluginKernels
 
-ObjStatsPlugin::ObjStatsPlugin(const MirState *state, std::string name, std::string ovName, int dumpEvery) :
+ObjStatsPlugin::ObjStatsPlugin(const MirState *state, std::string name, std::string ovName, int dumpEvery, bool shape) :
     SimulationPlugin(state, name),
     ovName(ovName),
-    dumpEvery(dumpEvery)
+    dumpEvery(dumpEvery),
+    shape(shape)
 {}
 
 void ObjStatsPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
@@ -69,6 +142,14 @@ void ObjStatsPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const M
     if (ov == nullptr)
         die("No such object vector registered: %s", ovName.c_str());
 
+    if (shape && dynamic_cast<MembraneVector*>(ov) == nullptr)
+        die("Plugin '%s': shape descriptors are only available for membranes, '%s' is not a membrane vector",
+            name.c_str(), ovName.c_str());
+
+    if (shape && ov->mesh->getNtypes() > 1)
+        die("Plugin '%s': shape descriptors are not supported with the mesh of several types of '%s'",
+            name.c_str(), ovName.c_str());
+
     info("Plugin %s initialized for the following object vectors: %s", name.c_str(), ovName.c_str());
 }
 
@@ -107,11 +188,40 @@ void ObjStatsPlugin::afterIntegration(cudaStream_t stream)
         motions.copy(motionStats, stream);
         isRov = false;
     }
+
+    if (shape)
+        computeShapes(stream);
     
     savedTime = state->currentTime;
     needToSend = true;
 }
 
+void ObjStatsPlugin::computeShapes(cudaStream_t stream)
+{
+    OVview view(ov, ov->local());
+    MeshView mesh(ov->mesh.get());
+    const int nthreads = 128;
+
+    areaVolumes.resize_anew(view.nObjects);
+    gyrations  .resize_anew(view.nObjects);
+    shapeStats .resize_anew(view.nObjects);
+
+    areaVolumes.clear(stream);
+    gyrations  .clear(stream);
+
+    SAFE_KERNEL_LAUNCH(
+        ObjStatsPluginKernels::collectShapeMoments,
+        view.nObjects, nthreads, 0, stream,
+        view, mesh, areaVolumes.devPtr(), gyrations.devPtr() );
+
+    SAFE_KERNEL_LAUNCH(
+        ObjStatsPluginKernels::describeShapes,
+        getNblocks(view.nObjects, nthreads), nthreads, 0, stream,
+        view.nObjects, view.objSize, areaVolumes.devPtr(), gyrations.devPtr(), shapeStats.devPtr() );
+
+    shapes.copy(shapeStats, stream);
+}
+
 void ObjStatsPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
 {
     if (!needToSend) return;
@@ -119,7 +229,7 @@ void ObjStatsPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
     debug2("Plugin %s is sending now data", name.c_str());
 
     waitPrevSend();
-    SimpleSerializer::serialize(sendBuffer, savedTime, state->domain, isRov, ids, coms, motions);
+    SimpleSerializer::serialize(sendBuffer, savedTime, state->domain, isRov, shape, ids, coms, motions, shapes);
     send(sendBuffer);
     
     needToSend=false;
@@ -127,63 +237,137 @@ void ObjStatsPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
 
 //=================================================================================
 
-static void writeStats(MPI_Comm comm, DomainInfo domain, MPI_File& fout, float curTime, const std::vector<int64_t>& ids,
-                       const std::vector<COMandExtent>& coms, const std::vector<RigidMotion>& motions, bool isRov)
+static std::vector<char> formatStatsText(float curTime, const std::vector<int64_t>& ids,
+                                         const std::vector<COMandExtent>& coms, const std::vector<RigidMotion>& motions, bool isRov,
+                                         const std::vector<ShapeDescriptors::Shape>& shapes, bool hasShape)
+{
+    std::string content;
+    content.reserve(ids.size() * ((isRov ? 220 : 175) + (hasShape ? 95 : 0)));
+
+    auto appendReals = [&content](const char *separator, std::initializer_list<double> values)
+    {
+        content += separator;
+        bool first = true;
+        for (auto v : values)
+        {
+            if (!first) content += ' ';
+            FixedFormat::appendFixed(content, v, 10, 5);
+            first = false;
+        }
+    };
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        const auto& com = coms[i].com;
+        const auto& motion = motions[i];
+
+        FixedFormat::appendInteger(content, ids[i]);
+        content += ' ';
+        FixedFormat::appendFixed(content, curTime, 0, 5);
+
+        appendReals("   ", {com.x, com.y, com.z});
+
+        if (isRov)
+            appendReals("    ", {motion.q.x, motion.q.y, motion.q.z, motion.q.w});
+
+        appendReals("    ", {motion.vel.x,    motion.vel.y,    motion.vel.z});
+        appendReals("    ", {motion.omega.x,  motion.omega.y,  motion.omega.z});
+        appendReals("    ", {motion.force.x,  motion.force.y,  motion.force.z});
+        appendReals("    ", {motion.torque.x, motion.torque.y, motion.torque.z});
+
+        if (hasShape)
+        {
+            const auto& sh = shapes[i];
+            appendReals("    ", {sh.area, sh.volume});
+            appendReals("    ", {sh.eigenvalues.x, sh.eigenvalues.y, sh.eigenvalues.z});
+            appendReals("    ", {sh.asphericity, sh.taylor, sh.angle});
+        }
+
+        content += '\n';
+    }
+
+    return {content.begin(), content.end()};
+}
+
+static std::vector<BinaryRecords::Field> statsFields(bool isRov, bool hasShape)
 {
-    int rank;
-    MPI_Check( MPI_Comm_rank(comm, &rank) );
+    const auto realType = BinaryRecords::fieldType<RigidReal>();
+    
+    std::vector<BinaryRecords::Field> fields {
+        {"id",   BinaryRecords::FieldType::Int64,   1},
+        {"time", BinaryRecords::FieldType::Float64, 1},
+        {"com",  BinaryRecords::FieldType::Float32, 3}
+    };
 
-    int np = ids.size();
-    int n = np;
-    MPI_Check( MPI_Reduce(rank == 0 ? MPI_IN_PLACE : &n, &n, 1, MPI_INT, MPI_SUM, 0, comm) );
+    if (isRov)
+        fields.push_back({"quaternion", realType, 4});
 
-    std::stringstream ss;
-    ss.setf(std::ios::fixed, std::ios::floatfield);
-    ss.precision(5);
+    fields.push_back({"velocity", realType, 3});
+    fields.push_back({"omega",    realType, 3});
+    fields.push_back({"force",    realType, 3});
+    fields.push_back({"torque",   realType, 3});
 
-    for (int i = 0; i < np; ++i)
+    if (hasShape)
     {
-        auto com = coms[i];
-        com.com = domain.local2global(com.com);
+        fields.push_back({"area",        BinaryRecords::FieldType::Float32, 1});
+        fields.push_back({"volume",      BinaryRecords::FieldType::Float32, 1});
+        fields.push_back({"gyration",    BinaryRecords::FieldType::Float32, 3});
+        fields.push_back({"asphericity", BinaryRecords::FieldType::Float32, 1});
+        fields.push_back({"taylor",      BinaryRecords::FieldType::Float32, 1});
+        fields.push_back({"angle",       BinaryRecords::FieldType::Float32, 1});
+    }
+
+    return fields;
+}
+
+static std::vector<char> packStatsBinary(float curTime, const std::vector<int64_t>& ids,
+                                         const std::vector<COMandExtent>& coms, const std::vector<RigidMotion>& motions, bool isRov,
+                                         const std::vector<ShapeDescriptors::Shape>& shapes, bool hasShape)
+{
+    using BinaryRecords::append;
+    std::vector<char> content;
+    content.reserve(ids.size() * BinaryRecords::recordSize(statsFields(isRov, hasShape)));
 
-        ss << ids[i] << " " << curTime << "   "
-                << std::setw(10) << com.com.x << " "
-                << std::setw(10) << com.com.y << " "
-                << std::setw(10) << com.com.z;
+    auto appendReal3 = [&content](RigidReal3 v) { append(content, v.x); append(content, v.y); append(content, v.z); };
 
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        const auto& com = coms[i].com;
         const auto& motion = motions[i];
 
+        append(content, ids[i]);
+        append(content, static_cast<double>(curTime));
+        append(content, com.x); append(content, com.y); append(content, com.z);
+
         if (isRov)
         {
-            ss << "    "
-               << std::setw(10) << motion.q.x << " "
-               << std::setw(10) << motion.q.y << " "
-               << std::setw(10) << motion.q.z << " "
-               << std::setw(10) << motion.q.w;
+            append(content, motion.q.x); append(content, motion.q.y);
+            append(content, motion.q.z); append(content, motion.q.w);
         }
 
-        ss << "    "   
-           << std::setw(10) << motion.vel.x << " "
-           << std::setw(10) << motion.vel.y << " "
-           << std::setw(10) << motion.vel.z << "    "
-            
-           << std::setw(10) << motion.omega.x << " "
-           << std::setw(10) << motion.omega.y << " "
-           << std::setw(10) << motion.omega.z << "    "
-            
-           << std::setw(10) << motion.force.x << " "
-           << std::setw(10) << motion.force.y << " "
-           << std::setw(10) << motion.force.z << "    "
-            
-           << std::setw(10) << motion.torque.x << " "
-           << std::setw(10) << motion.torque.y << " "
-           << std::setw(10) << motion.torque.z;
-
-        ss << std::endl;
+        appendReal3(motion.vel);
+        appendReal3(motion.omega);
+        appendReal3(motion.force);
+        appendReal3(motion.torque);
+
+        if (hasShape)
+        {
+            const auto& sh = shapes[i];
+            append(content, sh.area);
+            append(content, sh.volume);
+            append(content, sh.eigenvalues.x); append(content, sh.eigenvalues.y); append(content, sh.eigenvalues.z);
+            append(content, sh.asphericity);
+            append(content, sh.taylor);
+            append(content, sh.angle);
+        }
     }
 
-    std::string content = ss.str();
+    return content;
+}
 
+// append the content of all ranks at the end of the file, in rank order
+static void appendOrdered(MPI_Comm comm, MPI_File& fout, const std::vector<char>& content)
+{
     MPI_Offset offset = 0, size;
     MPI_Check( MPI_File_get_size(fout, &size) );
     MPI_Check( MPI_Barrier(comm) );
@@ -192,16 +376,17 @@ static void writeStats(MPI_Comm comm, DomainInfo domain, MPI_File& fout, float c
     MPI_Check( MPI_Exscan(&len, &offset, 1, MPI_OFFSET, MPI_SUM, comm) );
 
     MPI_Status status;
-    MPI_Check( MPI_File_write_at_all(fout, offset + size, content.c_str(), len, MPI_CHAR, &status) );
+    MPI_Check( MPI_File_write_at_all(fout, offset + size, content.data(), len, MPI_CHAR, &status) );
     MPI_Check( MPI_Barrier(comm) );
 }
 
 //=================================================================================
 
 
-ObjStatsDumper::ObjStatsDumper(std::string name, std::string path) :
+ObjStatsDumper::ObjStatsDumper(std::string name, std::string path, bool binary) :
     PostprocessPlugin(name),
-    path(makePath(path))
+    path(makePath(path)),
+    binary(binary)
 {}
 
 ObjStatsDumper::~ObjStatsDumper()
@@ -227,10 +412,9 @@ void ObjStatsDumper::handshake()
 
     if (activated)
     {
-        auto fname = path + ovName + ".txt";
-        MPI_Check( MPI_File_open(comm, fname.c_str(), MPI_MODE_CREATE | MPI_MODE_DELETE_ON_CLOSE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fout) );
-        MPI_Check( MPI_File_close(&fout) );
+        auto fname = path + ovName + (binary ? ".bin" : ".txt");
         MPI_Check( MPI_File_open(comm, fname.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fout) );
+        MPI_Check( MPI_File_set_size(fout, 0) );
     }
 }
 
@@ -242,12 +426,47 @@ void ObjStatsDumper::deserialize()
     std::vector<int64_t> ids;
     std::vector<COMandExtent> coms;
     std::vector<RigidMotion> motions;
-    bool isRov;
+    std::vector<ShapeDescriptors::Shape> shapes;
+    bool isRov, hasShape;
 
-    SimpleSerializer::deserialize(data, curTime, domain, isRov, ids, coms, motions);
+    // the coms are converted to global coordinates with the domain of their own simulation rank
+    forEachMessage([&](const std::vector<char>& msg)
+    {
+        std::vector<int64_t> msgIds;
+        std::vector<COMandExtent> msgComs;
+        std::vector<RigidMotion> msgMotions;
+        std::vector<ShapeDescriptors::Shape> msgShapes;
+        SimpleSerializer::deserialize(msg, curTime, domain, isRov, hasShape, msgIds, msgComs, msgMotions, msgShapes);
 
-    if (activated)
-        writeStats(comm, domain, fout, curTime, ids, coms, motions, isRov);
+        for (auto& com : msgComs)
+            com.com = domain.local2global(com.com);
+
+        ids    .insert(ids    .end(), msgIds    .begin(), msgIds    .end());
+        coms   .insert(coms   .end(), msgComs   .begin(), msgComs   .end());
+        motions.insert(motions.end(), msgMotions.begin(), msgMotions.end());
+        shapes .insert(shapes .end(), msgShapes .begin(), msgShapes .end());
+    });
+
+    if (!activated) return;
+
+    if (binary)
+    {
+        // the fields depend on the object vector type, known only now
+        if (!headerWritten)
+        {
+            std::vector<char> header;
+            if (rank == 0)
+                header = BinaryRecords::createHeader("obj_stats", statsFields(isRov, hasShape));
+            appendOrdered(comm, fout, header);
+            headerWritten = true;
+        }
+        
+        appendOrdered(comm, fout, packStatsBinary(curTime, ids, coms, motions, isRov, shapes, hasShape));
+    }
+    else
+    {
+        appendOrdered(comm, fout, formatStatsText(curTime, ids, coms, motions, isRov, shapes, hasShape));
+    }
 }
 
 
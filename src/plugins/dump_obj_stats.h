@@ -1,6 +1,7 @@
 #pragma once
 
 #include "interface.h"
+#include "utils/shape_descriptors.h"
 
 #include <core/containers.h>
 #include <core/datatypes.h>
@@ -11,7 +12,7 @@
 class ObjStatsPlugin : public SimulationPlugin
 {
 public:
-    ObjStatsPlugin(const MirState *state, std::string name, std::string ovName, int dumpEvery);
+    ObjStatsPlugin(const MirState *state, std::string name, std::string ovName, int dumpEvery, bool shape = false);
 
     void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
 
@@ -22,14 +23,21 @@ public:
     bool needPostproc() override { return true; }
 
 private:
+    void computeShapes(cudaStream_t stream);
+
     std::string ovName;
     int dumpEvery;
+    bool shape;
     bool needToSend = false;
     
     HostBuffer<int64_t> ids;
     HostBuffer<COMandExtent> coms;
     HostBuffer<RigidMotion> motions;
     DeviceBuffer<RigidMotion> motionStats;
+    DeviceBuffer<ShapeDescriptors::SymmetricMatrix> gyrations;
+    DeviceBuffer<double2> areaVolumes;
+    DeviceBuffer<ShapeDescriptors::Shape> shapeStats;
+    HostBuffer<ShapeDescriptors::Shape> shapes;
     MirState::TimeType savedTime = 0;
     bool isRov {false};
 
@@ -42,7 +50,7 @@ private:
 class ObjStatsDumper : public PostprocessPlugin
 {
 public:
-    ObjStatsDumper(std::string name, std::string path);
+    ObjStatsDumper(std::string name, std::string path, bool binary = false);
     ~ObjStatsDumper();
 
     void deserialize() override;
@@ -54,5 +62,7 @@ private:
     int3 nranks3D;
 
     bool activated = true;
+    bool binary;
+    bool headerWritten {false};
     MPI_File fout;
 };
@@ -8,12 +8,14 @@
 
 ParticleSenderPlugin::ParticleSenderPlugin(const MirState *state, std::string name, std::string pvName, int dumpEvery,
                                            std::vector<std::string> channelNames,
-                                           std::vector<ChannelType> channelTypes) :
+                                           std::vector<ChannelType> channelTypes,
+                                           const ParticleSelectionParams& selection) :
     SimulationPlugin(state, name),
     pvName(pvName),
     dumpEvery(dumpEvery),
     channelNames(channelNames),
-    channelTypes(channelTypes)
+    channelTypes(channelTypes),
+    selector(selection)
 {
     channelData.resize(channelNames.size());
 }
@@ -23,6 +25,7 @@ void ParticleSenderPlugin::setup(Simulation *simulation, const MPI_Comm& comm, c
     SimulationPlugin::setup(simulation, comm, interComm);
 
     pv = simulation->getPVbyNameOrDie(pvName);
+    selector.setup(simulation);
 
     info("Plugin %s initialized for the following particle vector: %s", name.c_str(), pvName.c_str());
 }
@@ -53,14 +56,39 @@ void ParticleSenderPlugin::beforeForces(cudaStream_t stream)
 {
     if (!isTimeEvery(state, dumpEvery)) return;
 
-    positions .genericCopy(&pv->local()->positions() , stream);
-    velocities.genericCopy(&pv->local()->velocities(), stream);
+    // the previous message refers to the copies
+    waitPrevSend();
+
+    auto lpv = pv->local();
+
+    if (selector.keepsAll())
+    {
+        positions .genericCopy(&lpv->positions() , stream);
+        velocities.genericCopy(&lpv->velocities(), stream);
+
+        for (size_t i = 0; i < channelNames.size(); ++i)
+        {
+            auto srcContainer = lpv->dataPerParticle.getGenericData(channelNames[i]);
+            channelData[i].genericCopy(srcContainer, stream);
+        }
+        return;
+    }
+
+    // the gathers and the downloads are ordered on the stream, the device buffers can be reused
+    const int nSelected = selector.select(lpv, state->domain, stream);
+    debug2("Plugin %s selected %d out of %d particles", name.c_str(), nSelected, lpv->size());
+
+    selector.gather(&lpv->positions(), &selectedParticles, stream);
+    positions.genericCopy(&selectedParticles, stream);
+
+    selector.gather(&lpv->velocities(), &selectedParticles, stream);
+    velocities.genericCopy(&selectedParticles, stream);
 
     for (size_t i = 0; i < channelNames.size(); ++i)
     {
-        auto name = channelNames[i];
-        auto srcContainer = pv->local()->dataPerParticle.getGenericData(name);
-        channelData[i].genericCopy(srcContainer, stream); 
+        auto srcContainer = lpv->dataPerParticle.getGenericData(channelNames[i]);
+        selector.gather(srcContainer, &selectedChannel, stream);
+        channelData[i].genericCopy(&selectedChannel, stream);
     }
 }
 
@@ -79,9 +107,8 @@ void ParticleSenderPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
     MirState::StepType timeStamp = getTimeStamp(state, dumpEvery);
     
     debug2("Plugin %s is packing now data consisting of %d particles", name.c_str(), positions.size());
-    waitPrevSend();
-    SimpleSerializer::serialize(sendBuffer, timeStamp, state->currentTime, positions, velocities, channelData);
-    send(sendBuffer);
+    SimpleSerializer::serializeSegments(message, timeStamp, state->currentTime, positions, velocities, channelData);
+    send(message);
 }
 
 
@@ -136,30 +163,47 @@ void ParticleDumperPlugin::handshake()
     debug2("Plugin '%s' was set up to dump channels %s. Path is %s", name.c_str(), allNames.c_str(), path.c_str());
 }
 
-static void unpackParticles(const std::vector<float4> &pos4, const std::vector<float4> &vel4,
+// appends the particles of the views, read directly from the received message
+static void unpackParticles(const SerializedArrayView<float4> &pos4, const SerializedArrayView<float4> &vel4,
                             std::vector<float3> &pos, std::vector<float3> &vel, std::vector<int64_t> &ids)
 {
-    int n = pos4.size();
-    pos.resize(n);
-    vel.resize(n);
-    ids.resize(n);
+    const int n = pos4.size();
+    const size_t start = pos.size();
+    pos.resize(start + n);
+    vel.resize(start + n);
+    ids.resize(start + n);
 
     for (int i = 0; i < n; ++i)
     {
         auto p = Particle(pos4[i], vel4[i]);
-        pos[i] = p.r;
-        vel[i] = p.u;
-        ids[i] = p.getId();
+        pos[start + i] = p.r;
+        vel[start + i] = p.u;
+        ids[start + i] = p.getId();
     }
 }
 
 void ParticleDumperPlugin::_recvAndUnpack(MirState::TimeType &time, MirState::StepType& timeStamp)
 {
-    int c = 0;
-    SimpleSerializer::deserialize(data, timeStamp, time, pos4, vel4, channelData);
-        
-    unpackParticles(pos4, vel4, *positions, velocities, ids);
+    positions->clear();
+    velocities.clear();
+    ids.clear();
+    for (auto& cd : channelData)
+        cd.clear();
 
+    forEachMessage([&](const std::vector<char>& msg)
+    {
+        SerializedArrayView<float4> pos4, vel4;
+        std::vector<SerializedArrayView<float>> channelViews;
+        SimpleSerializer::deserialize(msg, timeStamp, time, pos4, vel4, channelViews);
+
+        unpackParticles(pos4, vel4, *positions, velocities, ids);
+
+        channelData.resize(channelViews.size());
+        for (size_t i = 0; i < channelViews.size(); ++i)
+            channelViews[i].appendTo(channelData[i]);
+    });
+
+    int c = 0;
     channels[c++].data = velocities.data();
     channels[c++].data = ids.data();
     
@@ -4,6 +4,8 @@
 #include <string>
 
 #include <plugins/interface.h>
+#include <plugins/utils/particle_selection.h>
+#include <plugins/utils/simple_serializer.h>
 #include <core/containers.h>
 #include <core/datatypes.h>
 
@@ -22,7 +24,8 @@ public:
     
     ParticleSenderPlugin(const MirState *state, std::string name, std::string pvName, int dumpEvery,
                          std::vector<std::string> channelNames,
-                         std::vector<ChannelType> channelTypes);
+                         std::vector<ChannelType> channelTypes,
+                         const ParticleSelectionParams& selection = ParticleSelectionParams());
 
     void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
     void handshake() override;
@@ -43,7 +46,13 @@ protected:
     std::vector<ChannelType> channelTypes;
     std::vector<HostBuffer<float>> channelData;
 
+    // only the selected particles are downloaded
+    ParticleSelector selector;
+    DeviceBuffer<float4> selectedParticles;
+    DeviceBuffer<float> selectedChannel;
+
     std::vector<char> sendBuffer;
+    SegmentedMessage message;
 };
 
 
@@ -62,7 +71,6 @@ protected:
     static constexpr int zeroPadding = 5;
     std::string path;
 
-    std::vector<float4> pos4, vel4;
     std::vector<float3> velocities;
     std::vector<int64_t> ids;
     std::shared_ptr<std::vector<float3>> positions;
@@ -51,6 +51,9 @@ void ParticleWithRodQuantitiesSenderPlugin::beforeForces(cudaStream_t stream)
 {
     if (!isTimeEvery(state, dumpEvery)) return;
 
+    // the previous message refers to the copies
+    waitPrevSend();
+
     positions .genericCopy(&pv->local()->positions() , stream);
     velocities.genericCopy(&pv->local()->velocities(), stream);
 
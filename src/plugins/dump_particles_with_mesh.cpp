@@ -16,6 +16,10 @@ void ParticleWithMeshSenderPlugin::setup(Simulation *simulation, const MPI_Comm&
 
     pv = simulation->getOVbyNameOrDie(pvName);
 
+    if (static_cast<ObjectVector*>(pv)->mesh->getNtypes() > 1)
+        die("Plugin '%s': the mesh of several types of '%s' is not supported, use the mesh dump instead",
+            name.c_str(), pvName.c_str());
+
     info("Plugin %s initialized for the following object vector: %s", name.c_str(), pvName.c_str());
 }
 
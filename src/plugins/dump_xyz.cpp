@@ -25,6 +25,8 @@ void XYZPlugin::beforeForces(cudaStream_t stream)
 {
     if (!isTimeEvery(state, dumpEvery)) return;
 
+    // the previous message refers to the positions
+    waitPrevSend();
     positions.copy(pv->local()->positions(), stream);
 }
 
@@ -43,16 +45,16 @@ void XYZPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
 
     MirState::StepType timeStamp = getTimeStamp(state, dumpEvery);
     
-    waitPrevSend();
-    SimpleSerializer::serialize(sendBuffer, timeStamp, pv->name, positions);
-    send(sendBuffer);
+    SimpleSerializer::serializeSegments(message, timeStamp, pv->name, positions);
+    send(message);
 }
 
 //=================================================================================
 
-XYZDumper::XYZDumper(std::string name, std::string path) :
+XYZDumper::XYZDumper(std::string name, std::string path, bool binary) :
     PostprocessPlugin(name),
-    path(makePath(path))
+    path(makePath(path)),
+    binary(binary)
 {}
 
 void XYZDumper::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
@@ -66,12 +68,20 @@ void XYZDumper::deserialize()
     std::string pvName;
     MirState::StepType timeStamp;
     
-    SimpleSerializer::deserialize(data, timeStamp, pvName, pos);
+    pos.clear();
+    forEachMessage([&](const std::vector<char>& msg)
+    {
+        SerializedArrayView<float4> msgPos;
+        SimpleSerializer::deserialize(msg, timeStamp, pvName, msgPos);
+        msgPos.appendTo(pos);
+    });
+
+    std::string currentFname = path + pvName + "_" + getStrZeroPadded(timeStamp) + (binary ? ".bin" : ".xyz");
 
-    std::string currentFname = path + pvName + "_" + getStrZeroPadded(timeStamp) + ".xyz";
+    if (!activated) return;
 
-    if (activated)
-        writeXYZ(comm, currentFname, pos.data(), pos.size());
+    if (binary) writeXYZBinary(comm, currentFname, pos.data(), pos.size());
+    else        writeXYZ      (comm, currentFname, pos.data(), pos.size());
 }
 
 
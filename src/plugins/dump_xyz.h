@@ -1,6 +1,7 @@
 #pragma once
 
 #include <plugins/interface.h>
+#include <plugins/utils/simple_serializer.h>
 #include <core/containers.h>
 #include <core/datatypes.h>
 
@@ -15,7 +16,7 @@ private:
     std::string pvName;
     int dumpEvery;
 
-    std::vector<char> sendBuffer;
+    SegmentedMessage message;
 
     ParticleVector* pv;
     
@@ -40,11 +41,12 @@ private:
     int3 nranks3D;
 
     bool activated = true;
+    bool binary;
 
     std::vector<float4> pos;
 
 public:
-    XYZDumper(std::string name, std::string path);
+    XYZDumper(std::string name, std::string path, bool binary = false);
 
     void deserialize() override;
     void setup(const MPI_Comm& comm, const MPI_Comm& interComm) override;
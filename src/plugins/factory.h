@@ -8,6 +8,7 @@
 #include "average_flow.h"
 #include "average_relative_flow.h"
 #include "channel_dumper.h"
+#include "correlators.h"
 #include "outlet.h"
 #include "density_control.h"
 #include "displacement.h"
@@ -32,6 +33,7 @@
 #include "pin_object.h"
 #include "pin_rod_extremity.h"
 #include "radial_velocity_control.h"
+#include "rdf.h"
 #include "stats.h"
 #include "temperaturize.h"
 #include "velocity_control.h"
@@ -244,16 +246,38 @@ createDumpMeshPlugin(bool computeTask, const MirState *state, std::string name,
     return { simPl, postPl };
 }
 
+inline pair_shared< MeshTrajectoryPlugin, MeshTrajectoryDumper >
+createDumpMeshTrajectoryPlugin(bool computeTask, const MirState *state, std::string name, ObjectVector* ov, int dumpEvery,
+                               std::string path, float quantizationStep)
+{
+    auto simPl  = computeTask ? std::make_shared<MeshTrajectoryPlugin> (state, name, ov->name, dumpEvery, quantizationStep) : nullptr;
+    auto postPl = computeTask ? nullptr : std::make_shared<MeshTrajectoryDumper> (name, path);
+
+    return { simPl, postPl };
+}
+
 inline pair_shared< ParticleSenderPlugin, ParticleDumperPlugin >
 createDumpParticlesPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, int dumpEvery,
-                          std::vector< std::pair<std::string, std::string> > channels, std::string path)
+                          std::vector< std::pair<std::string, std::string> > channels, std::string path,
+                          float3 boxLo, float3 boxHi, std::string sdfWall, float2 sdfRange,
+                          int stride, float fraction, int seed)
 {
     std::vector<std::string> names;
     std::vector<ParticleSenderPlugin::ChannelType> types;
 
     extractChannelInfos(channels, names, types);
+
+    ParticleSelectionParams selection;
+    selection.boxLo    = boxLo;
+    selection.boxHi    = boxHi;
+    selection.wallName = sdfWall;
+    selection.sdfLo    = sdfRange.x;
+    selection.sdfHi    = sdfRange.y;
+    selection.stride   = stride;
+    selection.fraction = fraction;
+    selection.seed     = seed;
         
-    auto simPl  = computeTask ? std::make_shared<ParticleSenderPlugin> (state, name, pv->name, dumpEvery, names, types) : nullptr;
+    auto simPl  = computeTask ? std::make_shared<ParticleSenderPlugin> (state, name, pv->name, dumpEvery, names, types, selection) : nullptr;
     auto postPl = computeTask ? nullptr : std::make_shared<ParticleDumperPlugin> (name, path);
 
     return { simPl, postPl };
@@ -290,19 +314,21 @@ createDumpParticlesWithMeshPlugin(bool computeTask, const MirState *state, std::
 }
 
 inline pair_shared< XYZPlugin, XYZDumper >
-createDumpXYZPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector* pv, int dumpEvery, std::string path)
+createDumpXYZPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector* pv, int dumpEvery, std::string path,
+                    bool binary)
 {
     auto simPl  = computeTask ? std::make_shared<XYZPlugin> (state, name, pv->name, dumpEvery) : nullptr;
-    auto postPl = computeTask ? nullptr : std::make_shared<XYZDumper> (name, path);
+    auto postPl = computeTask ? nullptr : std::make_shared<XYZDumper> (name, path, binary);
 
     return { simPl, postPl };
 }
 
 inline pair_shared< ObjStatsPlugin, ObjStatsDumper >
-createDumpObjStats(bool computeTask, const MirState *state, std::string name, ObjectVector* ov, int dumpEvery, std::string path)
+createDumpObjStats(bool computeTask, const MirState *state, std::string name, ObjectVector* ov, int dumpEvery, std::string path,
+                   bool binary, bool shape)
 {
-    auto simPl  = computeTask ? std::make_shared<ObjStatsPlugin> (state, name, ov->name, dumpEvery) : nullptr;
-    auto postPl = computeTask ? nullptr : std::make_shared<ObjStatsDumper> (name, path);
+    auto simPl  = computeTask ? std::make_shared<ObjStatsPlugin> (state, name, ov->name, dumpEvery, shape) : nullptr;
+    auto postPl = computeTask ? nullptr : std::make_shared<ObjStatsDumper> (name, path, binary);
 
     return { simPl, postPl };
 }
@@ -422,6 +448,26 @@ createParticleCheckerPlugin(bool computeTask, const MirState *state, std::string
     return { simPl, nullptr };
 }
 
+inline pair_shared< ParticleCorrelatorPlugin, MultiTauCorrelatorDumper >
+createParticleCorrelatorPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
+                               std::string quantity, int sampleEvery, int dumpEvery,
+                               int nlevels, int npoints, int averaging, std::string path)
+{
+    ParticleCorrelatorPlugin::Quantity q;
+    if      (quantity == "msd")  q = ParticleCorrelatorPlugin::Quantity::MSD;
+    else if (quantity == "vacf") q = ParticleCorrelatorPlugin::Quantity::VACF;
+    else die("Plugin '%s': unknown quantity '%s', must be 'msd' or 'vacf'", name.c_str(), quantity.c_str());
+
+    const MultiTau::Layout layout {nlevels, npoints, averaging};
+
+    auto simPl  = computeTask ?
+        std::make_shared<ParticleCorrelatorPlugin> (state, name, pv->name, q, sampleEvery, dumpEvery, layout) :
+        nullptr;
+    auto postPl = computeTask ? nullptr : std::make_shared<MultiTauCorrelatorDumper> (name, path);
+
+    return { simPl, postPl };
+}
+
 inline pair_shared< ParticleDisplacementPlugin, PostprocessPlugin >
 createParticleDisplacementPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv, int updateEvery)
 {
@@ -523,6 +569,18 @@ createRadialVelocityControlPlugin(bool computeTask, const MirState *state, std::
     return { simPl, postPl };
 }
 
+inline pair_shared< RdfPlugin, RdfDumper >
+createRdfPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
+                float rmax, int nbins, int sampleEvery, int dumpEvery, std::vector<int3> modes, std::string path)
+{
+    auto simPl  = computeTask ?
+        std::make_shared<RdfPlugin> (state, name, pv->name, rmax, nbins, modes, sampleEvery, dumpEvery) :
+        nullptr;
+    auto postPl = computeTask ? nullptr : std::make_shared<RdfDumper> (name, path);
+
+    return { simPl, postPl };
+}
+
 inline pair_shared< SimulationStats, PostprocessStats >
 createStatsPlugin(bool computeTask, const MirState *state, std::string name, std::string filename, int every)
 {
@@ -532,6 +590,23 @@ createStatsPlugin(bool computeTask, const MirState *state, std::string name, std
     return { simPl, postPl };
 }
 
+inline pair_shared< StressCorrelatorPlugin, MultiTauCorrelatorDumper >
+createStressCorrelatorPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
+                             int sampleEvery, int dumpEvery, int nlevels, int npoints, int averaging, std::string path)
+{
+    std::vector<std::string> pvNames;
+    if (computeTask) extractPVsNames(pvs, pvNames);
+
+    const MultiTau::Layout layout {nlevels, npoints, averaging};
+
+    auto simPl  = computeTask ?
+        std::make_shared<StressCorrelatorPlugin> (state, name, pvNames, sampleEvery, dumpEvery, layout) :
+        nullptr;
+    auto postPl = computeTask ? nullptr : std::make_shared<MultiTauCorrelatorDumper> (name, path);
+
+    return { simPl, postPl };
+}
+
 inline pair_shared< TemperaturizePlugin, PostprocessPlugin >
 createTemperaturizePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector* pv, float kBT, bool keepVelocity)
 {
@@ -1,6 +1,8 @@
 #include "interface.h"
+#include "utils/simple_serializer.h"
 
 #include <core/logger.h>
+#include <core/utils/postprocess_ranks.h>
 
 Plugin::Plugin() :
     comm(MPI_COMM_NULL),
@@ -20,6 +22,12 @@ void Plugin::setTag(int tag)
     this->tag = tag;
 }
 
+int Plugin::getTag() const
+{
+    _checkTag();
+    return tag;
+}
+
 void Plugin::_setup(const MPI_Comm& comm, const MPI_Comm& interComm)
 {
     MPI_Check( MPI_Comm_dup(comm, &this->comm) );
@@ -61,6 +69,13 @@ void SimulationPlugin::setup(__UNUSED Simulation *simulation, const MPI_Comm& co
 {
     debug("Setting up simulation plugin '%s', MPI tags are (%d, %d)", name.c_str(), _sizeTag(), _dataTag());
     _setup(comm, interComm);
+
+    if (interComm != MPI_COMM_NULL)
+    {
+        int nPostRanks;
+        MPI_Check( MPI_Comm_remote_size(interComm, &nPostRanks) );
+        postprocessRank = PostprocessRanks::postRank(rank, nranks, nPostRanks);
+    }
 }
 
 void SimulationPlugin::finalize()
@@ -77,6 +92,13 @@ void SimulationPlugin::waitPrevSend()
     dataReq = MPI_REQUEST_NULL;
 }
 
+bool SimulationPlugin::popSentFlag()
+{
+    const bool wasSent = sent;
+    sent = false;
+    return wasSent;
+}
+
 void SimulationPlugin::send(const std::vector<char>& data)
 {
     send(data.data(), data.size());
@@ -91,8 +113,44 @@ void SimulationPlugin::send(const void* data, int sizeInBytes)
     waitPrevSend();
         
     debug2("Plugin '%s' is sending the data (%d bytes)", name.c_str(), sizeInBytes);
-    MPI_Check( MPI_Issend(&localSendSize, 1, MPI_INT,  rank, _sizeTag(), interComm, &sizeReq) );
-    MPI_Check( MPI_Issend(data, sizeInBytes, MPI_BYTE, rank, _dataTag(), interComm, &dataReq) );
+    MPI_Check( MPI_Issend(&localSendSize, 1, MPI_INT,  postprocessRank, _sizeTag(), interComm, &sizeReq) );
+    MPI_Check( MPI_Issend(data, sizeInBytes, MPI_BYTE, postprocessRank, _dataTag(), interComm, &dataReq) );
+    sent = true;
+}
+
+void SimulationPlugin::send(const SegmentedMessage& message)
+{
+    waitPrevSend();
+
+    localSendSize = message.size();
+
+    // the receiver gets the segments concatenated, exactly as a packed buffer
+    const auto segments = message.segments();
+    std::vector<int> lengths;
+    std::vector<MPI_Aint> displacements;
+    lengths      .reserve(segments.size());
+    displacements.reserve(segments.size());
+
+    for (const auto& s : segments)
+    {
+        MPI_Aint address;
+        MPI_Check( MPI_Get_address(s.ptr, &address) );
+        lengths      .push_back(s.size);
+        displacements.push_back(address);
+    }
+
+    MPI_Datatype segmentsType;
+    MPI_Check( MPI_Type_create_hindexed(segments.size(), lengths.data(), displacements.data(), MPI_BYTE, &segmentsType) );
+    MPI_Check( MPI_Type_commit(&segmentsType) );
+        
+    debug2("Plugin '%s' is sending the data (%d bytes in %d segments)",
+           name.c_str(), localSendSize, static_cast<int>(segments.size()));
+    MPI_Check( MPI_Issend(&localSendSize, 1, MPI_INT, postprocessRank, _sizeTag(), interComm, &sizeReq) );
+    MPI_Check( MPI_Issend(MPI_BOTTOM, 1, segmentsType, postprocessRank, _dataTag(), interComm, &dataReq) );
+    sent = true;
+
+    // freed once the pending send completes
+    MPI_Check( MPI_Type_free(&segmentsType) );
 }
 
 
@@ -108,24 +166,40 @@ PostprocessPlugin::~PostprocessPlugin() = default;
 
 MPI_Request PostprocessPlugin::waitData()
 {
+    // the other simulation ranks send at the same time step,
+    // their messages are received together in recv()
     MPI_Request req;
-    MPI_Check( MPI_Irecv(&size, 1, MPI_INT, rank, _sizeTag(), interComm, &req) );
+    MPI_Check( MPI_Irecv(&size, 1, MPI_INT, firstSimulationRank, _sizeTag(), interComm, &req) );
     return req;
 }
 
-void PostprocessPlugin::recv()
+void PostprocessPlugin::_recvData(int source, int expectedSize, std::vector<char>& buffer)
 {
-    data.resize(size);
+    buffer.resize(expectedSize);
     MPI_Status status;
     int count;
-    MPI_Check( MPI_Recv(data.data(), size, MPI_BYTE, rank, _dataTag(), interComm, &status) );
+    MPI_Check( MPI_Recv(buffer.data(), expectedSize, MPI_BYTE, source, _dataTag(), interComm, &status) );
     MPI_Check( MPI_Get_count(&status, MPI_BYTE, &count) );
 
-    if (count != size)
+    if (count != expectedSize)
         error("Plugin '%s' was going to receive %d bytes, but actually got %d. That may be fatal",
-              name.c_str(), size, count);
+              name.c_str(), expectedSize, count);
+
+    debug3("Plugin '%s' has received the data (%d bytes) from simulation rank %d", name.c_str(), count, source);
+}
 
-    debug3("Plugin '%s' has received the data (%d bytes)", name.c_str(), count);
+void PostprocessPlugin::recv()
+{
+    _recvData(firstSimulationRank, size, data);
+
+    otherData.resize(nSimulationRanks - 1);
+    for (int i = 1; i < nSimulationRanks; ++i)
+    {
+        const int source = firstSimulationRank + i;
+        int otherSize;
+        MPI_Check( MPI_Recv(&otherSize, 1, MPI_INT, source, _sizeTag(), interComm, MPI_STATUS_IGNORE) );
+        _recvData(source, otherSize, otherData[i-1]);
+    }
 }
 
 void PostprocessPlugin::deserialize() {}
@@ -134,6 +208,14 @@ void PostprocessPlugin::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
 {
     debug("Setting up postproc plugin '%s', MPI tags are (%d, %d)", name.c_str(), _sizeTag(), _dataTag());
     _setup(comm, interComm);
+
+    int nSimRanks;
+    MPI_Check( MPI_Comm_remote_size(interComm, &nSimRanks) );
+    firstSimulationRank = PostprocessRanks::firstComputeRank(rank, nSimRanks, nranks);
+    nSimulationRanks    = PostprocessRanks::nComputeRanks   (rank, nSimRanks, nranks);
+
+    debug("Postproc plugin '%s' serves simulation ranks %d to %d",
+          name.c_str(), firstSimulationRank, firstSimulationRank + nSimulationRanks - 1);
 }
 
 
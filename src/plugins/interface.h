@@ -6,6 +6,7 @@
 #include <mpi.h>
 #include <vector>
 
+class SegmentedMessage;
 class Simulation;
 
 class Plugin
@@ -17,6 +18,7 @@ public:
     virtual void handshake();
 
     void setTag(int tag);
+    int getTag() const;
     
 protected:
     MPI_Comm comm, interComm;
@@ -52,13 +54,20 @@ public:
     virtual void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm);
     virtual void finalize();    
 
+    /// true if data was sent since the last call; the simulation announces these messages to the postprocess
+    bool popSentFlag();
+
 protected:
     int localSendSize;
     MPI_Request sizeReq, dataReq;
+    int postprocessRank {0}; ///< postprocess rank receiving the messages of this rank
+    bool sent {false};
 
     void waitPrevSend();
     void send(const std::vector<char>& data);
     void send(const void *data, int sizeInBytes);
+    /// send the segments directly, without packing them; \p message must be kept alive until the next waitPrevSend()
+    void send(const SegmentedMessage& message);
 };
 
 
@@ -79,8 +88,22 @@ public:
 
 protected:
 
-    std::vector<char> data;
-    int size;    
+    void _recvData(int source, int expectedSize, std::vector<char>& buffer);
+
+    /// apply \p func to the messages of all the simulation ranks served by this rank, in rank order
+    template <typename Func>
+    void forEachMessage(Func&& func) const
+    {
+        func(data);
+        for (const auto& d : otherData)
+            func(d);
+    }
+
+    std::vector<char> data;                   ///< message of the first simulation rank served by this rank
+    std::vector<std::vector<char>> otherData; ///< messages of the other simulation ranks served by this rank
+    int size;
+
+    int firstSimulationRank {0}, nSimulationRanks {1}; ///< simulation ranks served by this rank
 };
 
 
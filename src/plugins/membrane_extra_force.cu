@@ -23,15 +23,8 @@ __global__ void addForce(OVview view, const Force *forces)
 MembraneExtraForcePlugin::MembraneExtraForcePlugin(const MirState *state, std::string name, std::string pvName, const std::vector<float3>& forces) :
     SimulationPlugin(state, name),
     pvName(pvName),
-    forces(forces.size())
-{
-    HostBuffer<Force> hostForces(forces.size());
-
-    for (size_t i = 0; i < forces.size(); ++i)
-        hostForces[i].f = forces[i];
-    
-    this->forces.copy(hostForces, 0);
-}
+    inputForces(forces)
+{}
 
 void MembraneExtraForcePlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
 {
@@ -40,6 +33,30 @@ void MembraneExtraForcePlugin::setup(Simulation *simulation, const MPI_Comm& com
     auto pv_ptr = simulation->getPVbyNameOrDie(pvName);
     if ( !(pv = dynamic_cast<MembraneVector*>(pv_ptr)) )
         die("MembraneExtraForcePlugin '%s' expects a MembraneVector (given '%s')", name.c_str(), pvName.c_str());
+
+    _uploadForces();
+}
+
+void MembraneExtraForcePlugin::_uploadForces()
+{
+    const auto mesh = pv->mesh.get();
+
+    if (mesh->getNtypes() > 1)
+        die("MembraneExtraForcePlugin '%s': the mesh of several types of '%s' is not supported",
+            name.c_str(), pvName.c_str());
+
+    if (static_cast<int>(inputForces.size()) != mesh->getNvertices())
+        die("MembraneExtraForcePlugin '%s': got %d forces for the %d vertices of the mesh of '%s'",
+            name.c_str(), static_cast<int>(inputForces.size()), mesh->getNvertices(), pvName.c_str());
+
+    // the forces follow the vertex order of the input mesh, see Mesh::getOriginalIds()
+    const auto& originalIds = mesh->getOriginalIds();
+    HostBuffer<Force> hostForces(inputForces.size());
+
+    for (size_t i = 0; i < inputForces.size(); ++i)
+        hostForces[i].f = inputForces[originalIds.empty() ? i : originalIds[i]];
+
+    forces.copy(hostForces, 0);
 }
 
 void MembraneExtraForcePlugin::beforeForces(cudaStream_t stream)
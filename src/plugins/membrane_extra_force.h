@@ -22,9 +22,13 @@ public:
 
     bool needPostproc() override { return false; }
 
+private:
+    void _uploadForces();
+
 private:
     std::string pvName;
     MembraneVector *pv;
-    DeviceBuffer<Force> forces;
+    std::vector<float3> inputForces; ///< one per vertex, in the order of the input mesh
+    DeviceBuffer<Force> forces;      ///< one per vertex, in the order of the mesh in use
 };
 
@@ -258,6 +258,14 @@ void ReportPinObjectPlugin::deserialize()
 
     SimpleSerializer::deserialize(data, currentTime, nsamples, forces, torques);
 
+    for (const auto& other : otherData)
+    {
+        std::vector<float4> otherForces, otherTorques;
+        SimpleSerializer::deserialize(other, currentTime, nsamples, otherForces, otherTorques);
+        for (size_t i = 0; i < forces.size();  ++i) forces[i]  += otherForces[i];
+        for (size_t i = 0; i < torques.size(); ++i) torques[i] += otherTorques[i];
+    }
+
     MPI_Check( MPI_Reduce( (rank == 0 ? MPI_IN_PLACE : forces.data()),  forces.data(),  forces.size()*4,  MPI_FLOAT, MPI_SUM, 0, comm) );
     MPI_Check( MPI_Reduce( (rank == 0 ? MPI_IN_PLACE : torques.data()), torques.data(), torques.size()*4, MPI_FLOAT, MPI_SUM, 0, comm) );
 
@@ -0,0 +1,338 @@
+#include "rdf.h"
+#include "utils/simple_serializer.h"
+#include "utils/time_stamp.h"
+
+#include <core/celllist.h>
+#include <core/interactions/pairwise/drivers.h>
+#include <core/interactions/pairwise/kernels/fetchers.h>
+#include <core/pvs/particle_vector.h>
+#include <core/pvs/views/pv.h>
+#include <core/simulation.h>
+#include <core/utils/common.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/folders.h>
+#include <core/utils/kernel_launch.h>
+
+namespace RdfKernels
+{
+
+/// nothing to accumulate per particle, the histogram is updated directly by the pair functor
+struct NoAccumulator
+{
+    __D__ inline float get() const { return 0.f; }
+    __D__ inline void add(float) {}
+    __D__ inline void atomicAddToDst(float, PVview&, int) const {}
+    __D__ inline void atomicAddToSrc(float, PVview&, int) const {}
+};
+
+/**
+ * Pair "interaction" binning the distance of every pair closer than rmax.
+ * Each pair is counted with \c weight: 2 for the pairs of local particles, visited once,
+ * and 1 for the local-halo pairs, visited once on both ranks.
+ * The histogram hence holds the number of ordered pairs.
+ */
+class PairDistanceHistogram : public ParticleFetcher
+{
+public:
+    using ViewType     = PVview;
+    using ParticleType = Particle;
+
+    PairDistanceHistogram(float rmax, int nbins, unsigned long long weight, unsigned long long *histogram) :
+        ParticleFetcher(rmax),
+        invBinWidth(nbins / rmax),
+        nbins(nbins),
+        weight(weight),
+        histogram(histogram)
+    {}
+
+    __D__ inline float operator()(const ParticleType dst, __UNUSED int dstId, const ParticleType src, __UNUSED int srcId) const
+    {
+        const float r = sqrtf(distance2(dst.r, src.r));
+        const int bin = min(static_cast<int>(r * invBinWidth), nbins - 1);
+        atomicAdd(histogram + bin, weight);
+        return 0.f;
+    }
+
+    __D__ inline NoAccumulator getZeroedAccumulator() const { return NoAccumulator(); }
+
+private:
+    float invBinWidth;
+    int nbins;
+    unsigned long long weight;
+    unsigned long long *histogram;
+};
+
+// all the threads of a warp take part in the reductions, even past the last particle
+__global__ void structureFactorAmplitudes(PVview view, float3 globalShift, int nk, const float3 *wavevectors, double2 *amplitudes)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    float3 r = make_float3(0.f);
+    if (i < view.size)
+        r = make_float3(view.readPosition(i)) + globalShift;
+
+    for (int k = 0; k < nk; ++k)
+    {
+        float2 e = make_float2(0.f);
+        if (i < view.size)
+            sincosf(dot(wavevectors[k], r), &e.y, &e.x);
+
+        e = warpReduce(e, [](float a, float b) { return a+b; });
+
+        if (laneId() == 0)
+        {
+            atomicAdd(&amplitudes[k].x, (double) e.x);
+            atomicAdd(&amplitudes[k].y, (double) e.y);
+        }
+    }
+}
+
+} // namespace RdfKernels
+
+RdfPlugin::RdfPlugin(const MirState *state, std::string name, std::string pvName, float rmax, int nbins,
+                     std::vector<int3> modes, int sampleEvery, int dumpEvery) :
+    SimulationPlugin(state, name),
+    pvName(pvName),
+    rmax(rmax),
+    nbins(nbins),
+    modes(modes),
+    sampleEvery(sampleEvery),
+    dumpEvery(dumpEvery),
+    histogram(nbins),
+    wavevectors(modes.size()),
+    amplitudes(modes.size()),
+    structureFactor(modes.size(), 0.0)
+{
+    if (rmax <= 0.f || nbins < 1)
+        die("Plugin '%s': need a positive largest distance and at least one bin, got %g and %d",
+            name.c_str(), rmax, nbins);
+
+    if (sampleEvery < 1 || dumpEvery < sampleEvery || dumpEvery % sampleEvery != 0)
+        die("Plugin '%s': dump period (%d) must be a multiple of the sampling period (%d)",
+            name.c_str(), dumpEvery, sampleEvery);
+
+    const float3 L = state->domain.globalSize;
+    for (size_t k = 0; k < modes.size(); ++k)
+    {
+        const float3 n = make_float3(modes[k].x, modes[k].y, modes[k].z);
+        wavevectors[k] = 2.0f * static_cast<float>(M_PI) * n / L;
+    }
+}
+
+RdfPlugin::~RdfPlugin() = default;
+
+void RdfPlugin::setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    SimulationPlugin::setup(simulation, comm, interComm);
+
+    pv = simulation->getPVbyNameOrDie(pvName);
+    cl = simulation->gelCellList(pv);
+
+    // the halo is only as wide as the largest cut-off of the particle vector
+    if (cl == nullptr || cl->rc < rmax)
+        die("Plugin '%s': particle vector '%s' must interact with a cut-off of at least %g, "
+            "such that its cell list and halo cover all the pairs",
+            name.c_str(), pvName.c_str(), rmax);
+
+    histogram.clearDevice(defaultStream);
+    wavevectors.uploadToDevice(defaultStream);
+
+    info("Plugin %s initialized for particle vector '%s': %d bins up to %g, %d wavevectors",
+         name.c_str(), pvName.c_str(), nbins, rmax, (int) modes.size());
+}
+
+void RdfPlugin::handshake()
+{
+    const auto L = state->domain.globalSize;
+    const double volume = (double) L.x * L.y * L.z;
+
+    std::vector<float3> kvec(wavevectors.begin(), wavevectors.end());
+    SimpleSerializer::serialize(sendBuffer, rmax, nbins, volume, kvec);
+    send(sendBuffer);
+}
+
+void RdfPlugin::sampleDistances(cudaStream_t stream)
+{
+    const int nthreads = 128;
+    const int span = cl->getNeighbourSpan(rmax);
+
+    auto localView = cl->getView<PVview>();
+    RdfKernels::PairDistanceHistogram localPairs(rmax, nbins, 2, histogram.devPtr());
+
+    SAFE_KERNEL_LAUNCH(
+        computeSelfInteractions,
+        getNblocks(localView.size, nthreads), nthreads, 0, stream,
+        cl->cellInfo(), localView, rmax*rmax, localPairs, span );
+
+    PVview haloView(pv, pv->halo());
+    RdfKernels::PairDistanceHistogram haloPairs(rmax, nbins, 1, histogram.devPtr());
+
+    if (localView.size > 0)
+        SAFE_KERNEL_LAUNCH(
+            computeExternalInteractions_1tpp<InteractionOut::NoAcc COMMA InteractionOut::NeedAcc COMMA InteractionMode::Dilute>,
+            getNblocks(haloView.size, nthreads), nthreads, 0, stream,
+            haloView, cl->cellInfo(), localView, rmax*rmax, haloPairs, span );
+}
+
+void RdfPlugin::sampleStructureFactor(cudaStream_t stream)
+{
+    const int nk = modes.size();
+    const int nthreads = 128;
+
+    PVview view(pv, pv->local());
+    const auto& domain = state->domain;
+
+    amplitudes.clear(stream);
+    SAFE_KERNEL_LAUNCH(
+        RdfKernels::structureFactorAmplitudes,
+        getNblocks(view.size, nthreads), nthreads, 0, stream,
+        view, domain.local2global(make_float3(0.f)), nk, wavevectors.devPtr(), amplitudes.devPtr() );
+
+    amplitudes.downloadFromDevice(stream, ContainersSynch::Synch);
+
+    // the amplitudes are summed over all the particles before taking their square
+    std::vector<double> local(2*nk + 1), global(2*nk + 1);
+    for (int k = 0; k < nk; ++k)
+    {
+        local[2*k + 0] = amplitudes[k].x;
+        local[2*k + 1] = amplitudes[k].y;
+    }
+    local[2*nk] = view.size;
+
+    MPI_Check( MPI_Reduce(local.data(), global.data(), local.size(), MPI_DOUBLE, MPI_SUM, 0, comm) );
+
+    if (rank != 0 || global[2*nk] == 0) return;
+
+    for (int k = 0; k < nk; ++k)
+        structureFactor[k] += (global[2*k]*global[2*k] + global[2*k+1]*global[2*k+1]) / global[2*nk];
+}
+
+void RdfPlugin::beforeIntegration(cudaStream_t stream)
+{
+    if (!isTimeEvery(state, sampleEvery)) return;
+
+    sampleDistances(stream);
+    if (!modes.empty())
+        sampleStructureFactor(stream);
+
+    ++nsamples;
+    sumNparticles += pv->local()->size();
+
+    if (!isTimeEvery(state, dumpEvery)) return;
+
+    histogram.downloadFromDevice(stream, ContainersSynch::Synch);
+    histogram.clearDevice(stream);
+
+    savedTime = state->currentTime;
+    savedTimeStamp = getTimeStamp(state, dumpEvery);
+    needToSend = true;
+}
+
+void RdfPlugin::serializeAndSend(__UNUSED cudaStream_t stream)
+{
+    if (!needToSend) return;
+
+    debug2("Plugin %s is sending now data", name.c_str());
+
+    std::vector<unsigned long long> counts(histogram.begin(), histogram.end());
+
+    waitPrevSend();
+    SimpleSerializer::serialize(sendBuffer, savedTime, savedTimeStamp, nsamples, sumNparticles, counts, structureFactor);
+    send(sendBuffer);
+
+    // every dump holds the average since the previous one
+    nsamples = 0;
+    sumNparticles = 0;
+    std::fill(structureFactor.begin(), structureFactor.end(), 0.0);
+
+    needToSend = false;
+}
+
+//=================================================================================
+
+RdfDumper::RdfDumper(std::string name, std::string path) :
+    PostprocessPlugin(name),
+    path(makePath(path))
+{}
+
+void RdfDumper::setup(const MPI_Comm& comm, const MPI_Comm& interComm)
+{
+    PostprocessPlugin::setup(comm, interComm);
+    activated = createFoldersCollective(comm, path);
+}
+
+void RdfDumper::handshake()
+{
+    auto req = waitData();
+    MPI_Check( MPI_Wait(&req, MPI_STATUS_IGNORE) );
+    recv();
+
+    SimpleSerializer::deserialize(data, rmax, nbins, volume, wavevectors);
+}
+
+void RdfDumper::deserialize()
+{
+    MirState::TimeType curTime;
+    MirState::StepType timeStamp;
+    long long nsamples = 0;
+    double local[2] = {0.0, 0.0}; // number of particles, number of samples
+    std::vector<double> pairs(nbins, 0.0), sk(wavevectors.size(), 0.0);
+
+    forEachMessage([&](const std::vector<char>& msg)
+    {
+        double nparticles;
+        std::vector<unsigned long long> counts;
+        std::vector<double> s;
+        SimpleSerializer::deserialize(msg, curTime, timeStamp, nsamples, nparticles, counts, s);
+
+        for (int i = 0; i < nbins; ++i)
+            pairs[i] += counts[i];
+        for (size_t k = 0; k < s.size(); ++k)
+            sk[k] += s[k];
+
+        local[0] += nparticles;
+        local[1]  = nsamples; // same on all the ranks
+    });
+
+    if (!activated) return;
+
+    double global[2];
+    std::vector<double> totalPairs(pairs.size()), totalSk(sk.size());
+    MPI_Check( MPI_Reduce(local,        global,          1,            MPI_DOUBLE, MPI_SUM, 0, comm) );
+    MPI_Check( MPI_Reduce(local + 1,    global + 1,      1,            MPI_DOUBLE, MPI_MAX, 0, comm) );
+    MPI_Check( MPI_Reduce(pairs.data(), totalPairs.data(), pairs.size(), MPI_DOUBLE, MPI_SUM, 0, comm) );
+    MPI_Check( MPI_Reduce(sk.data(),    totalSk.data(),  sk.size(),    MPI_DOUBLE, MPI_SUM, 0, comm) );
+
+    if (rank != 0) return;
+
+    const double samples = global[1];
+    const double meanN   = samples > 0 ? global[0] / samples : 0.0;
+    const double density = meanN / volume;
+
+    auto fname = path + name + "_" + getStrZeroPadded(timeStamp) + ".txt";
+    FileWrapper fout;
+    if (fout.open(fname, "w") != FileWrapper::Status::Success)
+        die("Could not open file '%s'", fname.c_str());
+
+    fprintf(fout.get(), "# time %g samples %.0f particles %g\n", curTime, samples, meanN);
+    fprintf(fout.get(), "# r g(r)\n");
+
+    const double dr = rmax / nbins;
+    for (int i = 0; i < nbins; ++i)
+    {
+        const double r0 = i * dr, r1 = (i+1) * dr;
+        const double shell = 4.0 / 3.0 * M_PI * (r1*r1*r1 - r0*r0*r0);
+        const double norm  = samples * meanN * density * shell;
+
+        fprintf(fout.get(), "%.6e %.6e\n", r0 + 0.5 * dr, norm > 0 ? totalPairs[i] / norm : 0.0);
+    }
+
+    if (wavevectors.empty()) return;
+
+    fprintf(fout.get(), "\n# kx ky kz S(k)\n");
+    for (size_t k = 0; k < wavevectors.size(); ++k)
+    {
+        const auto kv = wavevectors[k];
+        fprintf(fout.get(), "%.6e %.6e %.6e %.6e\n", kv.x, kv.y, kv.z, samples > 0 ? totalSk[k] / samples : 0.0);
+    }
+}
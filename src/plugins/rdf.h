@@ -0,0 +1,86 @@
+#pragma once
+
+#include "interface.h"
+
+#include <core/containers.h>
+#include <core/datatypes.h>
+
+#include <string>
+#include <vector>
+
+class ParticleVector;
+class CellList;
+
+/**
+ * Radial distribution function g(r) and, optionally, static structure factor S(k)
+ * of a particle vector, accumulated on the device between two dumps.
+ *
+ * The pair distances are binned in one pass over the primary cell list and the halo
+ * of the particle vector, reusing the pairwise interaction drivers.
+ * The largest distance must hence not exceed the largest interaction cut-off of the particle vector.
+ * S(k) is evaluated at the wavevectors 2 pi (n_x / L_x, n_y / L_y, n_z / L_z) for the given integer modes n.
+ */
+class RdfPlugin : public SimulationPlugin
+{
+public:
+    RdfPlugin(const MirState *state, std::string name, std::string pvName, float rmax, int nbins,
+              std::vector<int3> modes, int sampleEvery, int dumpEvery);
+    ~RdfPlugin();
+
+    void setup(Simulation *simulation, const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+    void beforeIntegration(cudaStream_t stream) override;
+    void serializeAndSend(cudaStream_t stream) override;
+
+    bool needPostproc() override { return true; }
+
+private:
+    void sampleDistances(cudaStream_t stream);
+    void sampleStructureFactor(cudaStream_t stream);
+
+    std::string pvName;
+    ParticleVector *pv;
+    CellList *cl;
+
+    float rmax;
+    int nbins;
+    std::vector<int3> modes;
+    int sampleEvery, dumpEvery;
+    bool needToSend = false;
+
+    PinnedBuffer<unsigned long long> histogram;
+    PinnedBuffer<float3> wavevectors;
+    PinnedBuffer<double2> amplitudes;
+    std::vector<double> structureFactor;
+
+    long long nsamples = 0;
+    double sumNparticles = 0;
+    MirState::TimeType savedTime = 0;
+    MirState::StepType savedTimeStamp = 0;
+
+    std::vector<char> sendBuffer;
+};
+
+
+/**
+ * Postprocess side of RdfPlugin:
+ * merges the histograms of all the ranks, normalizes them and writes one file per dump.
+ */
+class RdfDumper : public PostprocessPlugin
+{
+public:
+    RdfDumper(std::string name, std::string path);
+
+    void setup(const MPI_Comm& comm, const MPI_Comm& interComm) override;
+    void handshake() override;
+    void deserialize() override;
+
+private:
+    std::string path;
+    bool activated = true;
+
+    float rmax;
+    int nbins;
+    double volume;
+    std::vector<float3> wavevectors;
+};
@@ -4,47 +4,10 @@
 
 #include <core/datatypes.h>
 #include <core/pvs/particle_vector.h>
-#include <core/pvs/views/pv.h>
 #include <core/simulation.h>
-#include <core/utils/cuda_common.h>
-#include <core/utils/kernel_launch.h>
 
-namespace StatsKernels
-{
-using Stats::ReductionType;
-
-__global__ void totalMomentumEnergy(PVview view, ReductionType *momentum, ReductionType *energy, float* maxvel)
-{
-    int tid = blockIdx.x * blockDim.x + threadIdx.x;
-
-    float3 vel, myMomentum;
-    float myEnergy = 0.f, myMaxIvelI;
-    vel = myMomentum = make_float3(0.f);
-
-    if (tid < view.size)
-    {
-        vel        = make_float3(view.readVelocity(tid));
-        myMomentum = vel * view.mass;
-        myEnergy   = dot(vel, vel) * view.mass * 0.5f;
-    }
-    
-    myMomentum = warpReduce(myMomentum, [](float a, float b) { return a+b; });
-    myEnergy   = warpReduce(myEnergy,   [](float a, float b) { return a+b; });
-    
-    myMaxIvelI = warpReduce(length(vel), [](float a, float b) { return max(a, b); });
-
-    if (laneId() == 0)
-    {
-        atomicAdd(momentum+0, (ReductionType)myMomentum.x);
-        atomicAdd(momentum+1, (ReductionType)myMomentum.y);
-        atomicAdd(momentum+2, (ReductionType)myMomentum.z);
-        atomicAdd(energy,     (ReductionType)myEnergy);
+#include <algorithm>
 
-        atomicMax((int*)maxvel, __float_as_int(myMaxIvelI));
-    }
-}
-} // namespace StatsKernels
-    
 SimulationStats::SimulationStats(const MirState *state, std::string name, int fetchEvery) :
     SimulationPlugin(state, name),
     fetchEvery(fetchEvery)
@@ -58,33 +21,39 @@ void SimulationStats::setup(Simulation *simulation, const MPI_Comm& comm, const
 {
     SimulationPlugin::setup(simulation, comm, interComm);
     pvs = simulation->getParticleVectors();
+
+    using Quantity = ReductionService::Quantity;
+    reductions = simulation->getReductionService();
+
+    for (auto pv : pvs)
+    {
+        momentumHandles.push_back(reductions->request(pv, Quantity::Momentum,      fetchEvery));
+        energyHandles  .push_back(reductions->request(pv, Quantity::KineticEnergy, fetchEvery));
+        maxvelHandles  .push_back(reductions->request(pv, Quantity::MaxSpeed,      fetchEvery));
+    }
 }
 
 void SimulationStats::afterIntegration(cudaStream_t stream)
 {
     if (!isTimeEvery(state, fetchEvery)) return;
 
-    momentum.clear(stream);
-    energy  .clear(stream);
-    maxvel  .clear(stream);
+    momentum.assign(3, 0);
+    energy  .assign(1, 0);
+    maxvel  .assign(1, 0);
 
     nparticles = 0;
-    for (auto& pv : pvs)
+    for (size_t i = 0; i < pvs.size(); ++i)
     {
-        PVview view(pv, pv->local());
+        const double *m = reductions->get(momentumHandles[i], stream);
+        for (int d = 0; d < 3; ++d)
+            momentum[d] += m[d];
 
-        SAFE_KERNEL_LAUNCH(
-                StatsKernels::totalMomentumEnergy,
-                getNblocks(view.size, 128), 128, 0, stream,
-                view, momentum.devPtr(), energy.devPtr(), maxvel.devPtr() );
+        energy[0] += reductions->get(energyHandles[i], stream)[0];
+        maxvel[0]  = std::max(maxvel[0], static_cast<float>(reductions->get(maxvelHandles[i], stream)[0]));
 
-        nparticles += view.size;
+        nparticles += pvs[i]->local()->size();
     }
 
-    momentum.downloadFromDevice(stream, ContainersSynch::Asynch);
-    energy  .downloadFromDevice(stream, ContainersSynch::Asynch);
-    maxvel  .downloadFromDevice(stream);
-
     needToDump = true;
 }
 
@@ -137,8 +106,32 @@ void PostprocessStats::deserialize()
 
     SimpleSerializer::deserialize(data, realTime, currentTime, currentTimeStep, nparticles, momentum, energy, maxvel);
 
-    MPI_Check( MPI_Reduce(&nparticles, &minNparticles, 1, mpiCountType, MPI_MIN, 0, comm) );
-    MPI_Check( MPI_Reduce(&nparticles, &maxNparticles, 1, mpiCountType, MPI_MAX, 0, comm) );
+    // min/max are taken over the simulation ranks, this rank may serve several of them
+    Stats::CountType localMinNparticles = nparticles, localMaxNparticles = nparticles;
+
+    for (const auto& other : otherData)
+    {
+        float otherRealTime;
+        Stats::CountType otherNparticles;
+        std::vector<Stats::ReductionType> otherMomentum, otherEnergy;
+        std::vector<float> otherMaxvel;
+
+        SimpleSerializer::deserialize(other, otherRealTime, currentTime, currentTimeStep,
+                                      otherNparticles, otherMomentum, otherEnergy, otherMaxvel);
+
+        localMinNparticles = std::min(localMinNparticles, otherNparticles);
+        localMaxNparticles = std::max(localMaxNparticles, otherNparticles);
+        nparticles += otherNparticles;
+
+        for (size_t i = 0; i < momentum.size(); ++i) momentum[i] += otherMomentum[i];
+        for (size_t i = 0; i < energy.size();   ++i) energy[i]   += otherEnergy[i];
+
+        maxvel[0] = std::max(maxvel[0], otherMaxvel[0]);
+        realTime  = std::max(realTime,  otherRealTime);
+    }
+
+    MPI_Check( MPI_Reduce(&localMinNparticles, &minNparticles, 1, mpiCountType, MPI_MIN, 0, comm) );
+    MPI_Check( MPI_Reduce(&localMaxNparticles, &maxNparticles, 1, mpiCountType, MPI_MAX, 0, comm) );
     
     MPI_Check( MPI_Reduce(rank == 0 ? MPI_IN_PLACE : &nparticles,     &nparticles,     1, mpiCountType,     MPI_SUM, 0, comm) );
     MPI_Check( MPI_Reduce(rank == 0 ? MPI_IN_PLACE : energy.data(),   energy.data(),   1, mpiReductionType, MPI_SUM, 0, comm) );
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <plugins/interface.h>
+#include <plugins/utils/reduction_service.h>
 #include <core/containers.h>
 #include <core/datatypes.h>
 #include <core/utils/file_wrapper.h>
@@ -32,12 +33,15 @@ private:
     bool needToDump{false};
 
     Stats::CountType nparticles;
-    PinnedBuffer<Stats::ReductionType> momentum{3}, energy{1};
-    PinnedBuffer<float> maxvel{1};
+    std::vector<Stats::ReductionType> momentum, energy;
+    std::vector<float> maxvel;
     std::vector<char> sendBuffer;
 
     std::vector<ParticleVector*> pvs;
 
+    ReductionService *reductions;
+    std::vector<ReductionService::Handle> momentumHandles, energyHandles, maxvelHandles;
+
     mTimer timer;
 };
 
@@ -0,0 +1,63 @@
+#include "binary_records.h"
+
+#include <core/logger.h>
+
+namespace BinaryRecords
+{
+
+static constexpr char magic[] = "MIRRECRD";
+static constexpr int32_t version = 1;
+
+static int fieldTypeSize(FieldType type)
+{
+    switch (type)
+    {
+    case FieldType::Int32:   return sizeof(int32_t);
+    case FieldType::Int64:   return sizeof(int64_t);
+    case FieldType::Float32: return sizeof(float);
+    case FieldType::Float64: return sizeof(double);
+    }
+    die("Unknown field type %d", static_cast<int>(type));
+    return 0;
+}
+
+int recordSize(const std::vector<Field>& fields)
+{
+    int size = 0;
+    for (const auto& f : fields)
+        size += fieldTypeSize(f.type) * f.ncomponents;
+    return size;
+}
+
+static void appendString(std::vector<char>& buffer, const std::string& s)
+{
+    append(buffer, static_cast<int32_t>(s.size()));
+    buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+std::vector<char> createHeader(const std::string& kind, const std::vector<Field>& fields)
+{
+    std::vector<char> header(magic, magic + 8);
+    append(header, version);
+
+    // header size is filled in at the end
+    const size_t headerSizeOffset = header.size();
+    append(header, int32_t(0));
+    append(header, static_cast<int32_t>(recordSize(fields)));
+
+    appendString(header, kind);
+    append(header, static_cast<int32_t>(fields.size()));
+
+    for (const auto& f : fields)
+    {
+        append(header, static_cast<int32_t>(f.type));
+        append(header, static_cast<int32_t>(f.ncomponents));
+        appendString(header, f.name);
+    }
+
+    const int32_t headerSize = header.size();
+    memcpy(header.data() + headerSizeOffset, &headerSize, sizeof(headerSize));
+    return header;
+}
+
+} // namespace BinaryRecords
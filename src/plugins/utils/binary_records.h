@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Files made of a small self-describing header followed by fixed-size records.
+ *
+ * header: char[8] "MIRRECRD", int32 version, int32 header size in bytes, int32 record size in bytes,
+ *         int32 kind length, char kind[], int32 nfields,
+ *         then for each field: int32 type, int32 number of components, int32 name length, char name[]
+ * records: the fields packed in order, without padding
+ *
+ * All values are little endian. The kind tells readers which text format the file replaces.
+ */
+namespace BinaryRecords
+{
+
+enum class FieldType : int32_t
+{
+    Int32 = 0, Int64 = 1, Float32 = 2, Float64 = 3
+};
+
+struct Field
+{
+    std::string name;
+    FieldType type;
+    int ncomponents;
+};
+
+template <typename T> FieldType fieldType();
+template <> inline FieldType fieldType<int32_t>() {return FieldType::Int32;}
+template <> inline FieldType fieldType<int64_t>() {return FieldType::Int64;}
+template <> inline FieldType fieldType<float>  () {return FieldType::Float32;}
+template <> inline FieldType fieldType<double> () {return FieldType::Float64;}
+
+int recordSize(const std::vector<Field>& fields);
+std::vector<char> createHeader(const std::string& kind, const std::vector<Field>& fields);
+
+/// append the bytes of \p v to \p buffer
+template <typename T>
+inline void append(std::vector<char>& buffer, const T& v)
+{
+    const size_t start = buffer.size();
+    buffer.resize(start + sizeof(T));
+    memcpy(buffer.data() + start, &v, sizeof(T));
+}
+
+} // namespace BinaryRecords
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/**
+ * Fast replacement of printf("%*.*f") and printf("%lld") for text dumps.
+ * The output is identical to the one of printf:
+ * values for which the rounding is not obvious (too large, not finite,
+ * or too close to a tie) are delegated to snprintf.
+ */
+namespace FixedFormat
+{
+
+namespace details
+{
+inline void appendUnsigned(std::string& out, uint64_t v, int minDigits)
+{
+    char digits[24];
+    int n = 0;
+    do
+    {
+        digits[n++] = '0' + (v % 10);
+        v /= 10;
+    } while (v > 0 || n < minDigits);
+
+    while (n > 0)
+        out.push_back(digits[--n]);
+}
+
+inline void appendPadding(std::string& out, int length, int width)
+{
+    for (int i = length; i < width; ++i)
+        out.push_back(' ');
+}
+
+inline void appendSlow(std::string& out, double x, int width, int precision)
+{
+    char buf[512];
+    snprintf(buf, sizeof(buf), "%*.*f", width, precision, x);
+    out += buf;
+}
+} // namespace details
+
+/// append \p x as printf("%lld") would
+inline void appendInteger(std::string& out, long long x)
+{
+    if (x < 0) out.push_back('-');
+    const uint64_t mag = x < 0 ? -static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+    details::appendUnsigned(out, mag, 1);
+}
+
+/// append \p x as printf("%*.*f", width, precision, x) would, with precision <= 9
+inline void appendFixed(std::string& out, double x, int width, int precision)
+{
+    constexpr double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    constexpr double maxExact = 9007199254740992.0; // 2^53
+
+    if (precision < 0 || precision > 9 || !std::isfinite(x))
+    {
+        details::appendSlow(out, x, width, precision);
+        return;
+    }
+
+    const double scale = pow10[precision];
+    if (std::abs(x) * scale >= maxExact / 4)
+    {
+        details::appendSlow(out, x, width, precision);
+        return;
+    }
+
+    // printf rounds the exact value, to nearest with ties to even;
+    // the residual of the exact product x * scale is computed with a single rounding by fma
+    const double a = std::abs(x);
+    double lower = std::floor(a * scale);
+    double residual = std::fma(a, scale, -lower);
+
+    if      (residual <  0.0) { lower -= 1.0; residual = std::fma(a, scale, -lower); }
+    else if (residual >= 1.0) { lower += 1.0; residual = std::fma(a, scale, -lower); }
+
+    if (std::abs(residual - 0.5) < 1e-6)
+    {
+        details::appendSlow(out, x, width, precision);
+        return;
+    }
+
+    const double rounded = residual > 0.5 ? lower + 1.0 : lower;
+
+    const bool negative = std::signbit(x);
+    const uint64_t mag = static_cast<uint64_t>(rounded);
+    const uint64_t ip = mag / static_cast<uint64_t>(scale);
+    uint64_t fp = mag % static_cast<uint64_t>(scale);
+
+    // digits are written backwards
+    char buf[32];
+    int n = 0;
+    for (int i = 0; i < precision; ++i, fp /= 10)
+        buf[n++] = '0' + (fp % 10);
+    if (precision > 0)
+        buf[n++] = '.';
+
+    uint64_t v = ip;
+    do
+    {
+        buf[n++] = '0' + (v % 10);
+        v /= 10;
+    } while (v > 0);
+    
+    if (negative) buf[n++] = '-';
+
+    details::appendPadding(out, n, width);
+    while (n > 0)
+        out.push_back(buf[--n]);
+}
+
+} // namespace FixedFormat
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <core/logger.h>
+#include <core/utils/cpu_gpu_defines.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Multi-tau correlators: the samples are stored in levels of registers,
+ * level l holds averages over `averaging`^l consecutive samples.
+ * Level 0 correlates the lags 0 ... points-1, level l > 0 the lags
+ * points/averaging ... points-1 in units of `averaging`^l samples.
+ * The memory and the cost per sample are hence logarithmic in the longest lag.
+ *
+ * Ramirez, Sukumaran, Vorselaars and Likhtman, J. Chem. Phys. 133, 154103 (2010)
+ */
+namespace MultiTau
+{
+
+struct Layout
+{
+    int nlevels, npoints, averaging;
+
+    inline void check() const
+    {
+        if (nlevels < 1 || averaging < 2 || npoints < averaging || npoints % averaging != 0)
+            die("Multi-tau correlator: need at least 1 level, averaging over at least 2 samples "
+                "and a multiple of it as number of points per level, got %d levels, %d points, averaging %d",
+                nlevels, npoints, averaging);
+    }
+
+    __HD__ inline int firstLag(int level) const
+    {
+        return level == 0 ? 0 : npoints / averaging;
+    }
+
+    /// lag in number of samples of the entry \p k of level \p level
+    inline int64_t lag(int level, int k) const
+    {
+        int64_t stride = 1;
+        for (int l = 0; l < level; ++l)
+            stride *= averaging;
+        return k * stride;
+    }
+
+    inline int size() const
+    {
+        return nlevels * npoints;
+    }
+};
+
+/**
+ * Where the values of a new sample go, common to all the particles of a correlator.
+ * Level l receives a value every averaging^l samples.
+ */
+class Schedule
+{
+public:
+    struct Level
+    {
+        int slot;       ///< register in which the new value is stored
+        int nvalid;     ///< number of valid registers, including the new value
+    };
+
+    Schedule(Layout layout) :
+        layout(layout),
+        heads(layout.nlevels, 0),
+        nstored(layout.nlevels, 0)
+    {
+        layout.check();
+    }
+
+    /**
+     * Register a new sample
+     * @return the levels receiving a value, level i of the result is level i of the correlator
+     */
+    inline const std::vector<Level>& push()
+    {
+        active.clear();
+
+        int64_t period = 1;
+        for (int l = 0; l < layout.nlevels; ++l)
+        {
+            if ((nsamples + 1) % period != 0)
+                break;
+
+            nstored[l] = std::min(nstored[l] + 1, layout.npoints);
+            active.push_back({heads[l], nstored[l]});
+            heads[l] = (heads[l] + 1) % layout.npoints;
+
+            period *= layout.averaging;
+        }
+
+        ++nsamples;
+        return active;
+    }
+
+    inline int64_t getNsamples() const { return nsamples; }
+
+private:
+    Layout layout;
+    std::vector<int> heads, nstored;
+    std::vector<Level> active;
+    int64_t nsamples {0};
+};
+
+enum class Kind
+{
+    Product,          ///< < x(t) . x(t + lag) >
+    SquaredDifference ///< < |x(t + lag) - x(t)|^2 >
+};
+
+/**
+ * Host correlator of one vector quantity with \p ncomponents components.
+ * Sums and counts are kept separately so that several correlators can be merged.
+ */
+class Correlator
+{
+public:
+    Correlator(Layout layout, int ncomponents, Kind kind) :
+        layout(layout),
+        ncomponents(ncomponents),
+        kind(kind),
+        schedule(layout),
+        registers(layout.size() * ncomponents, 0.0),
+        accumulators(layout.nlevels * ncomponents, 0.0),
+        sums(layout.size(), 0.0),
+        counts(layout.size(), 0.0),
+        value(ncomponents)
+    {}
+
+    inline void push(const double *sample)
+    {
+        const auto& levels = schedule.push();
+
+        value.assign(sample, sample + ncomponents);
+
+        for (size_t l = 0; l < levels.size(); ++l)
+        {
+            const auto& level = levels[l];
+            double *regs = registers.data() + l * layout.npoints * ncomponents;
+
+            for (int c = 0; c < ncomponents; ++c)
+                regs[level.slot * ncomponents + c] = value[c];
+
+            for (int k = layout.firstLag(l); k < level.nvalid; ++k)
+            {
+                const int j = (level.slot - k + layout.npoints) % layout.npoints;
+                sums  [l * layout.npoints + k] += correlate(value.data(), regs + j * ncomponents);
+                counts[l * layout.npoints + k] += 1;
+            }
+
+            // the average over the last samples goes to the next level
+            if (static_cast<int>(l) + 1 < layout.nlevels)
+            {
+                double *acc = accumulators.data() + l * ncomponents;
+                const bool next = l + 1 < levels.size();
+
+                for (int c = 0; c < ncomponents; ++c)
+                {
+                    acc[c] += value[c];
+                    if (next)
+                    {
+                        value[c] = acc[c] / layout.averaging;
+                        acc[c] = 0.0;
+                    }
+                }
+            }
+        }
+    }
+
+    const std::vector<double>& getSums()   const { return sums;   }
+    const std::vector<double>& getCounts() const { return counts; }
+
+private:
+    inline double correlate(const double *a, const double *b) const
+    {
+        double res = 0.0;
+        for (int c = 0; c < ncomponents; ++c)
+        {
+            if (kind == Kind::Product)
+                res += a[c] * b[c];
+            else
+                res += (a[c] - b[c]) * (a[c] - b[c]);
+        }
+        return res;
+    }
+
+    Layout layout;
+    int ncomponents;
+    Kind kind;
+    Schedule schedule;
+
+    std::vector<double> registers, accumulators;
+    std::vector<double> sums, counts;
+    std::vector<double> value;
+};
+
+} // namespace MultiTau
@@ -0,0 +1,182 @@
+#include "particle_selection.h"
+
+#include <core/pvs/particle_vector.h>
+#include <core/pvs/views/pv.h>
+#include <core/simulation.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/cuda_rng.h>
+#include <core/utils/kernel_launch.h>
+#include <core/walls/interface.h>
+
+#include <extern/cub/cub/device/device_scan.cuh>
+
+namespace ParticleSelectionKernels
+{
+
+struct Filter
+{
+    float3 lo, hi;               // local coordinates
+    const float *sdfs;           // nullptr if no wall
+    float sdfLo, sdfHi;
+    int64_t stride;
+    float fraction;
+    unsigned int seed;
+};
+
+__global__ void markSelected(PVview view, Filter filter, int *marks)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= view.size) return;
+
+    const Particle p = view.readParticle(i);
+
+    bool keep = p.r.x >= filter.lo.x && p.r.x <= filter.hi.x &&
+                p.r.y >= filter.lo.y && p.r.y <= filter.hi.y &&
+                p.r.z >= filter.lo.z && p.r.z <= filter.hi.z;
+
+    if (filter.sdfs != nullptr)
+    {
+        const float sdf = filter.sdfs[i];
+        keep = keep && sdf >= filter.sdfLo && sdf <= filter.sdfHi;
+    }
+
+    const int64_t id = p.getId();
+    keep = keep && (id % filter.stride == 0);
+
+    if (filter.fraction < 1.f)
+        keep = keep && Saru::saru(filter.seed, static_cast<unsigned int>(id), static_cast<unsigned int>(id >> 32)) < filter.fraction;
+
+    marks[i] = keep ? 1 : 0;
+}
+
+__global__ void compactIndices(int n, const int *marks, const int *prefix, int *indices)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+
+    if (marks[i])
+        indices[prefix[i]] = i;
+}
+
+// all the channel types are made of 4-byte words
+__global__ void gatherWords(int nSelected, int wordsPerElement, const int *indices, const int *src, int *dst)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= nSelected * wordsPerElement) return;
+
+    const int element = i / wordsPerElement;
+    const int word    = i % wordsPerElement;
+
+    dst[i] = src[indices[element] * wordsPerElement + word];
+}
+
+} // namespace ParticleSelectionKernels
+
+
+bool ParticleSelectionParams::keepsAll() const
+{
+    const bool unboundedBox =
+        boxLo.x == -inf && boxLo.y == -inf && boxLo.z == -inf &&
+        boxHi.x ==  inf && boxHi.y ==  inf && boxHi.z ==  inf;
+
+    return unboundedBox && wallName.empty() && stride == 1 && fraction >= 1.f;
+}
+
+
+ParticleSelector::ParticleSelector(const ParticleSelectionParams& params) :
+    params(params)
+{
+    if (params.stride < 1)
+        die("Particle selection: stride must be positive, got %lld", (long long) params.stride);
+
+    if (params.fraction <= 0.f)
+        die("Particle selection: fraction must be positive, got %g", params.fraction);
+}
+
+void ParticleSelector::setup(Simulation *simulation)
+{
+    if (params.wallName.empty())
+        return;
+
+    wall = dynamic_cast<SDF_basedWall*>(simulation->getWallByNameOrDie(params.wallName));
+
+    if (wall == nullptr)
+        die("Particle selection can only use SDF-based walls, but got wall '%s'", params.wallName.c_str());
+}
+
+bool ParticleSelector::keepsAll() const
+{
+    return params.keepsAll();
+}
+
+int ParticleSelector::select(LocalParticleVector *lpv, const DomainInfo& domain, cudaStream_t stream)
+{
+    const int n = lpv->size();
+    const int nthreads = 128;
+
+    ParticleSelectionKernels::Filter filter;
+    filter.lo       = domain.global2local(params.boxLo);
+    filter.hi       = domain.global2local(params.boxHi);
+    filter.sdfs     = nullptr;
+    filter.sdfLo    = params.sdfLo;
+    filter.sdfHi    = params.sdfHi;
+    filter.stride   = params.stride;
+    filter.fraction = params.fraction;
+    filter.seed     = static_cast<unsigned int>(params.seed);
+
+    if (wall != nullptr)
+    {
+        wall->sdfPerParticle(lpv, &sdfs, nullptr, 0.f, stream);
+        filter.sdfs = sdfs.devPtr();
+    }
+
+    // one more element such that the last prefix is the total count
+    marks .resize_anew(n + 1);
+    prefix.resize_anew(n + 1);
+    marks.clearDevice(stream);
+
+    PVview view(lpv->pv, lpv);
+    SAFE_KERNEL_LAUNCH(
+        ParticleSelectionKernels::markSelected,
+        getNblocks(n, nthreads), nthreads, 0, stream,
+        view, filter, marks.devPtr() );
+
+    size_t bufferSize = scanBuffer.size();
+    cub::DeviceScan::ExclusiveSum(nullptr, bufferSize, marks.devPtr(), prefix.devPtr(), n + 1, stream);
+    scanBuffer.resize_anew(bufferSize);
+    cub::DeviceScan::ExclusiveSum(scanBuffer.devPtr(), bufferSize, marks.devPtr(), prefix.devPtr(), n + 1, stream);
+
+    CUDA_Check( cudaMemcpyAsync(nSelectedBuffer.hostPtr(), prefix.devPtr() + n,
+                                sizeof(int), cudaMemcpyDeviceToHost, stream) );
+    CUDA_Check( cudaStreamSynchronize(stream) );
+    nSelected = nSelectedBuffer[0];
+
+    indices.resize_anew(nSelected);
+    SAFE_KERNEL_LAUNCH(
+        ParticleSelectionKernels::compactIndices,
+        getNblocks(n, nthreads), nthreads, 0, stream,
+        n, marks.devPtr(), prefix.devPtr(), indices.devPtr() );
+
+    return nSelected;
+}
+
+void ParticleSelector::gather(const GPUcontainer *src, GPUcontainer *dst, cudaStream_t stream)
+{
+    const int elementSize = src->datatype_size();
+
+    if (elementSize % sizeof(int) != 0 || elementSize % dst->datatype_size() != 0)
+        die("Particle selection: can not gather elements of %d bytes into elements of %d bytes",
+            elementSize, (int) dst->datatype_size());
+
+    const int wordsPerElement = elementSize / sizeof(int);
+    const int nthreads = 128;
+
+    dst->resize_anew(nSelected * elementSize / dst->datatype_size());
+
+    SAFE_KERNEL_LAUNCH(
+        ParticleSelectionKernels::gatherWords,
+        getNblocks(nSelected * wordsPerElement, nthreads), nthreads, 0, stream,
+        nSelected, wordsPerElement, indices.devPtr(),
+        reinterpret_cast<const int*>(src->genericDevPtr()),
+        reinterpret_cast<int*>(dst->genericDevPtr()) );
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <core/containers.h>
+#include <core/domain.h>
+
+#include <limits>
+#include <string>
+
+class LocalParticleVector;
+class SDF_basedWall;
+class Simulation;
+
+/**
+ * Which particles of a particle vector are dumped.
+ * A particle is kept if it passes all the filters; the default values keep everything.
+ */
+struct ParticleSelectionParams
+{
+    static constexpr float inf = std::numeric_limits<float>::infinity();
+
+    float3 boxLo {-inf, -inf, -inf}; ///< lower corner of the kept box, in global coordinates
+    float3 boxHi { inf,  inf,  inf}; ///< upper corner of the kept box, in global coordinates
+
+    std::string wallName;            ///< if not empty, keep the particles for which the SDF of that wall is in [sdfLo, sdfHi]
+    float sdfLo {-inf}, sdfHi {0.f};
+
+    int64_t stride {1};              ///< keep the particles whose id is a multiple of stride
+    float fraction {1.f};            ///< keep randomly this fraction of the particles, always the same ones for a given seed
+    int seed {0};
+
+    /// @return true if no particle is filtered out
+    bool keepsAll() const;
+};
+
+/**
+ * Evaluates ParticleSelectionParams on the device and
+ * gathers the selected particles of any per-particle channel,
+ * such that only those need to be downloaded.
+ * The selected particles keep their relative order.
+ */
+class ParticleSelector
+{
+public:
+    ParticleSelector(const ParticleSelectionParams& params);
+
+    /// find the wall, if any; must be called before select()
+    void setup(Simulation *simulation);
+
+    /// @return true if no particle is filtered out, select() and gather() are then not needed
+    bool keepsAll() const;
+
+    /**
+     * Find the selected particles of \p lpv.
+     * Synchronizes \p stream to know their number.
+     * @return number of selected particles
+     */
+    int select(LocalParticleVector *lpv, const DomainInfo& domain, cudaStream_t stream);
+
+    /// copy the selected elements of \p src into \p dst, resized accordingly
+    void gather(const GPUcontainer *src, GPUcontainer *dst, cudaStream_t stream);
+
+private:
+    ParticleSelectionParams params;
+    SDF_basedWall *wall {nullptr};
+
+    int nSelected {0};
+    DeviceBuffer<float> sdfs;
+    DeviceBuffer<int> marks, prefix, indices;
+    DeviceBuffer<char> scanBuffer;
+    PinnedBuffer<int> nSelectedBuffer {1};
+};
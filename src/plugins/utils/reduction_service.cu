@@ -0,0 +1,165 @@
+#include "reduction_service.h"
+#include "time_stamp.h"
+
+#include <core/pvs/particle_vector.h>
+#include <core/pvs/views/pv.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/kernel_launch.h>
+
+#include <algorithm>
+
+namespace ReductionServiceKernels
+{
+using Quantity = ReductionService::Quantity;
+
+constexpr int nquantities = static_cast<int>(Quantity::NumQuantities);
+
+/// position of each quantity of one particle vector in the results, -1 if not needed
+struct Offsets
+{
+    int of[nquantities];
+
+    __HD__ inline int operator[](Quantity q) const { return of[static_cast<int>(q)]; }
+};
+
+// the offsets are the same for all the threads, there is no divergence between the quantities
+__global__ void reduceQuantities(PVview view, Offsets offsets, double *results)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    const bool valid = i < view.size;
+
+    const float3 vel = valid ? make_float3(view.readVelocity(i)) : make_float3(0.f);
+
+    auto sum = [](float a, float b) { return a+b; };
+
+    if (offsets[Quantity::Momentum] >= 0)
+    {
+        const float3 momentum = warpReduce(vel * view.mass, sum);
+        if (laneId() == 0)
+            atomicAdd((double3*) (results + offsets[Quantity::Momentum]), make_double3(momentum));
+    }
+
+    if (offsets[Quantity::KineticEnergy] >= 0)
+    {
+        const float energy = warpReduce(0.5f * view.mass * dot(vel, vel), sum);
+        if (laneId() == 0)
+            atomicAdd(results + offsets[Quantity::KineticEnergy], (double) energy);
+    }
+
+    if (offsets[Quantity::MaxSpeed] >= 0)
+    {
+        const float speed = warpReduce(length(vel), [](float a, float b) { return max(a, b); });
+
+        // non-negative doubles are ordered as their bit patterns
+        if (laneId() == 0)
+            atomicMax((unsigned long long*) (results + offsets[Quantity::MaxSpeed]),
+                      (unsigned long long) __double_as_longlong((double) speed));
+    }
+
+    if (offsets[Quantity::Force] >= 0)
+    {
+        const float3 f = warpReduce(valid ? make_float3(view.forces[i]) : make_float3(0.f), sum);
+        if (laneId() == 0)
+            atomicAdd((double3*) (results + offsets[Quantity::Force]), make_double3(f));
+    }
+}
+
+} // namespace ReductionServiceKernels
+
+ReductionService::ReductionService(const MirState *state) :
+    state(state)
+{}
+
+ReductionService::~ReductionService() = default;
+
+int ReductionService::ncomponents(Quantity quantity)
+{
+    switch (quantity)
+    {
+    case Quantity::Momentum:      return 3;
+    case Quantity::KineticEnergy: return 1;
+    case Quantity::MaxSpeed:      return 1;
+    case Quantity::Force:         return 3;
+    default: die("Unknown reduction quantity %d", static_cast<int>(quantity));
+    }
+    return 0;
+}
+
+ReductionService::Handle ReductionService::request(ParticleVector *pv, Quantity quantity, int every)
+{
+    if (every <= 0)
+        die("Reduction of '%s' requested with a non-positive period %d", pv->name.c_str(), every);
+
+    requests.push_back({pv, quantity, every, -1});
+    return static_cast<Handle>(requests.size()) - 1;
+}
+
+const double* ReductionService::get(Handle handle, cudaStream_t stream)
+{
+    if (handle < 0 || handle >= static_cast<Handle>(requests.size()))
+        die("Invalid reduction handle %d", handle);
+
+    if (computedStep != state->currentStep)
+        compute(stream);
+
+    const auto& req = requests[handle];
+    if (req.offset < 0)
+        die("Reduction of '%s' is queried at step %lld, but requested every %d steps",
+            req.pv->name.c_str(), state->currentStep, req.every);
+
+    return results.hostPtr() + req.offset;
+}
+
+void ReductionService::compute(cudaStream_t stream)
+{
+    using ReductionServiceKernels::Offsets;
+
+    // the particle vectors keep the order of the requests
+    std::vector<ParticleVector*> pvs;
+    std::vector<Offsets> offsets;
+    int total = 0;
+
+    for (auto& req : requests)
+    {
+        req.offset = -1;
+        if (!isTimeEvery(state, req.every)) continue;
+
+        auto it = std::find(pvs.begin(), pvs.end(), req.pv);
+        if (it == pvs.end())
+        {
+            Offsets none;
+            std::fill(none.of, none.of + ReductionServiceKernels::nquantities, -1);
+            pvs.push_back(req.pv);
+            offsets.push_back(none);
+            it = pvs.end() - 1;
+        }
+
+        // several requests of the same quantity share the result
+        int& offset = offsets[it - pvs.begin()].of[static_cast<int>(req.quantity)];
+        if (offset < 0)
+        {
+            offset = total;
+            total += ncomponents(req.quantity);
+        }
+        req.offset = offset;
+    }
+
+    results.resize_anew(total);
+    results.clear(stream);
+
+    const int nthreads = 128;
+    for (size_t i = 0; i < pvs.size(); ++i)
+    {
+        PVview view(pvs[i], pvs[i]->local());
+
+        SAFE_KERNEL_LAUNCH(
+            ReductionServiceKernels::reduceQuantities,
+            getNblocks(view.size, nthreads), nthreads, 0, stream,
+            view, offsets[i], results.devPtr() );
+    }
+
+    debug2("Reduced %d values over %d particle vectors at step %lld", total, (int) pvs.size(), state->currentStep);
+
+    results.downloadFromDevice(stream, ContainersSynch::Synch);
+    computedStep = state->currentStep;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <core/containers.h>
+#include <core/mirheo_state.h>
+
+#include <map>
+#include <vector>
+
+class ParticleVector;
+
+/**
+ * Reductions over the local particles of the particle vectors, shared by the plugins.
+ *
+ * The plugins request the quantities they need at setup, with a sampling period.
+ * The first time a value is queried in a time step, all the quantities due at that step are computed:
+ * each particle vector is traversed by a single kernel computing all its quantities,
+ * and all the results are downloaded at once.
+ * The other queries of the same step read the downloaded values.
+ *
+ * The values are only meaningful after the integration, i.e. they must be queried in
+ * SimulationPlugin::afterIntegration()
+ */
+class ReductionService
+{
+public:
+    enum class Quantity
+    {
+        Momentum,      ///< sum of m v, 3 components
+        KineticEnergy, ///< sum of m v^2 / 2
+        MaxSpeed,      ///< maximum of |v|
+        Force,         ///< sum of the forces, 3 components
+        NumQuantities
+    };
+
+    using Handle = int;
+
+    ReductionService(const MirState *state);
+    ~ReductionService();
+
+    /// request \p quantity of the local particles of \p pv every \p every time steps
+    Handle request(ParticleVector *pv, Quantity quantity, int every);
+
+    /**
+     * @return the components of the requested quantity at the current step;
+     * the pointer is valid until the next query of another step
+     */
+    const double* get(Handle handle, cudaStream_t stream);
+
+    static int ncomponents(Quantity quantity);
+
+private:
+    struct Request
+    {
+        ParticleVector *pv;
+        Quantity quantity;
+        int every;
+        int offset;    ///< in the results of the current step, -1 if not due
+    };
+
+    void compute(cudaStream_t stream);
+
+    const MirState *state;
+    std::vector<Request> requests;
+
+    MirState::StepType computedStep {-1};
+    PinnedBuffer<double> results;
+};
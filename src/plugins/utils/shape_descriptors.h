@@ -0,0 +1,117 @@
+#pragma once
+
+#include <core/utils/cpu_gpu_defines.h>
+#include <core/utils/helper_math.h>
+
+#include <cmath>
+
+/**
+ * Shape descriptors of a deformable object computed from its gyration tensor
+ * G = < (r - r_com) (r - r_com)^T > over the vertices.
+ */
+namespace ShapeDescriptors
+{
+
+/// upper triangle of a symmetric 3x3 matrix
+struct SymmetricMatrix
+{
+    double xx, xy, xz, yy, yz, zz;
+};
+
+struct Shape
+{
+    float area, volume;
+    float3 eigenvalues;  ///< of the gyration tensor, in decreasing order
+    float asphericity;   ///< normalized, 0 for a sphere and 1 for a rod
+    float taylor;        ///< (a - c) / (a + c), with a and c the largest and smallest semi-axes
+    float angle;         ///< angle between the x axis and the projection of the major axis in the x-y plane, in (-pi/2, pi/2]
+};
+
+/// eigenvalues in decreasing order, closed-form for symmetric matrices
+__HD__ inline double3 eigenvalues(const SymmetricMatrix& m)
+{
+    const double p1 = m.xy*m.xy + m.xz*m.xz + m.yz*m.yz;
+    const double q  = (m.xx + m.yy + m.zz) / 3.0;
+
+    const double dxx = m.xx - q, dyy = m.yy - q, dzz = m.zz - q;
+    const double p2 = dxx*dxx + dyy*dyy + dzz*dzz + 2.0 * p1;
+    const double p  = sqrt(p2 / 6.0);
+
+    if (p == 0.0)
+        return make_double3(q, q, q);
+
+    // B = (G - q I) / p, r = det(B) / 2
+    const double bxx = dxx / p, byy = dyy / p, bzz = dzz / p;
+    const double bxy = m.xy / p, bxz = m.xz / p, byz = m.yz / p;
+
+    const double det = bxx * (byy*bzz - byz*byz)
+                     - bxy * (bxy*bzz - byz*bxz)
+                     + bxz * (bxy*byz - byy*bxz);
+
+    const double r = fmin(fmax(0.5 * det, -1.0), 1.0);
+    const double phi = acos(r) / 3.0;
+
+    const double e1 = q + 2.0 * p * cos(phi);
+    const double e3 = q + 2.0 * p * cos(phi + 2.0 * M_PI / 3.0);
+    const double e2 = 3.0 * q - e1 - e3;
+
+    return make_double3(e1, e2, e3);
+}
+
+/// unit eigenvector of the eigenvalue \p lambda, (1, 0, 0) if the matrix is isotropic
+__HD__ inline double3 eigenvector(const SymmetricMatrix& m, double lambda)
+{
+    const double3 r0 {m.xx - lambda, m.xy, m.xz};
+    const double3 r1 {m.xy, m.yy - lambda, m.yz};
+    const double3 r2 {m.xz, m.yz, m.zz - lambda};
+
+    // the eigenvector is orthogonal to all the rows of G - lambda I
+    const double3 c[3] = {cross(r0, r1), cross(r0, r2), cross(r1, r2)};
+
+    int best = 0;
+    double bestNorm2 = dot(c[0], c[0]);
+    for (int i = 1; i < 3; ++i)
+    {
+        const double n2 = dot(c[i], c[i]);
+        if (n2 > bestNorm2)
+        {
+            best = i;
+            bestNorm2 = n2;
+        }
+    }
+
+    if (bestNorm2 == 0.0)
+        return make_double3(1.0, 0.0, 0.0);
+
+    return c[best] / sqrt(bestNorm2);
+}
+
+__HD__ inline Shape describe(const SymmetricMatrix& gyration, float area, float volume)
+{
+    Shape s;
+    s.area   = area;
+    s.volume = volume;
+
+    const double3 l = eigenvalues(gyration);
+    s.eigenvalues = make_float3(l.x, l.y, l.z);
+
+    const double trace = l.x + l.y + l.z;
+    s.asphericity = trace > 0.0 ?
+        ((l.x-l.y)*(l.x-l.y) + (l.y-l.z)*(l.y-l.z) + (l.z-l.x)*(l.z-l.x)) / (2.0 * trace * trace) :
+        0.0;
+
+    // the semi-axes of an ellipsoid are proportional to the square roots of the eigenvalues
+    const double a = sqrt(fmax(l.x, 0.0));
+    const double c = sqrt(fmax(l.z, 0.0));
+    s.taylor = a + c > 0.0 ? (a - c) / (a + c) : 0.0;
+
+    const double3 axis = eigenvector(gyration, l.x);
+    double angle = atan2(axis.y, axis.x);
+    if (angle >   0.5 * M_PI) angle -= M_PI;
+    if (angle <= -0.5 * M_PI) angle += M_PI;
+    s.angle = angle;
+
+    return s;
+}
+
+} // namespace ShapeDescriptors
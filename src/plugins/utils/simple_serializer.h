@@ -6,6 +6,134 @@
 #include <vector>
 #include <type_traits>
 
+/**
+ * Serialized data described as a list of memory segments instead of a contiguous buffer.
+ * Small pieces (scalars, sizes, strings) are copied inside the message,
+ * the contents of large containers are only referenced:
+ * they must not be modified or freed until the message has been sent.
+ * Concatenating the segments gives the same bytes as SimpleSerializer::serialize()
+ */
+class SegmentedMessage
+{
+public:
+    struct Segment
+    {
+        const char *ptr;
+        int size;
+    };
+
+    void clear()
+    {
+        ownedBytes.clear();
+        pieces.clear();
+        totalSize = 0;
+    }
+
+    void appendCopy(const void *src, int size)
+    {
+        if (size == 0) return;
+        
+        if (pieces.empty() || !pieces.back().owned)
+            pieces.push_back({true, nullptr, ownedBytes.size(), 0});
+
+        auto csrc = reinterpret_cast<const char*>(src);
+        ownedBytes.insert(ownedBytes.end(), csrc, csrc + size);
+        pieces.back().size += size;
+        totalSize += size;
+    }
+
+    void appendReference(const void *src, int size)
+    {
+        // not worth a separate segment
+        if (size < minReferenceSize)
+        {
+            appendCopy(src, size);
+            return;
+        }
+
+        pieces.push_back({false, reinterpret_cast<const char*>(src), 0, size});
+        totalSize += size;
+    }
+
+    int size() const { return totalSize; }
+
+    /// the pointers are valid until the message is modified
+    std::vector<Segment> segments() const
+    {
+        std::vector<Segment> result;
+        result.reserve(pieces.size());
+        for (const auto& p : pieces)
+            result.push_back({p.owned ? ownedBytes.data() + p.offset : p.ptr, p.size});
+        return result;
+    }
+
+    /// copy the whole message to \p dst, of size at least size()
+    void gather(char *dst) const
+    {
+        for (const auto& s : segments())
+        {
+            memcpy(dst, s.ptr, s.size);
+            dst += s.size;
+        }
+    }
+
+private:
+    static constexpr int minReferenceSize = 256;
+
+    struct Piece
+    {
+        bool owned;
+        const char *ptr;
+        size_t offset;
+        int size;
+    };
+
+    std::vector<char> ownedBytes;
+    std::vector<Piece> pieces;
+    int totalSize {0};
+};
+
+/**
+ * Read-only view of a serialized vector of POD, pointing inside the received buffer.
+ * The buffer gives no alignment guarantee, hence elements are accessed by value
+ */
+template <typename T>
+class SerializedArrayView
+{
+    static_assert(std::is_pod<T>::value, "Only views of POD are supported");
+    
+public:
+    int size() const { return n; }
+    bool empty() const { return n == 0; }
+
+    T operator[](int i) const
+    {
+        T v;
+        memcpy(&v, ptr + i * sizeof(T), sizeof(T));
+        return v;
+    }
+
+    /// copy all the elements to \p dst, of size at least size()
+    void copyTo(T *dst) const
+    {
+        memcpy(dst, ptr, n * sizeof(T));
+    }
+
+    /// append all the elements to \p dst
+    void appendTo(std::vector<T>& dst) const
+    {
+        const size_t start = dst.size();
+        dst.resize(start + n);
+        copyTo(dst.data() + start);
+    }
+
+private:
+    friend class SimpleSerializer;
+
+    const char *ptr {nullptr};
+    int n {0};
+};
+
 // Only POD types and std::vectors/HostBuffers/PinnedBuffers of POD and std::strings are supported
 // Container size will be serialized too
 class SimpleSerializer
@@ -64,6 +192,12 @@ private:
         return (int)s.length() + sizeof(int);
     }
 
+    template<typename T>
+    static int sizeOfOne(const SerializedArrayView<T>& v)
+    {
+        return v.size() * sizeof(T) + sizeof(int);
+    }
+
     template<typename Arg>
     static int sizeOfOne(__UNUSED const Arg& arg)
     {
@@ -150,6 +284,55 @@ private:
         pack(buf, othArgs...);
     }
 
+    //============================================================================
+
+    /// Overload for the vectors of plain old data: the contents are referenced
+    template<typename Vec, EnableIfPod<ValType<Vec>> = nullptr>
+    static void describeVec(SegmentedMessage& msg, const Vec& v)
+    {
+        const int sz = v.size();
+        msg.appendCopy(&sz, sizeof(int));
+        msg.appendReference(v.data(), v.size()*sizeof(ValType<Vec>));
+    }
+    
+    /// Overload for the vectors of NON POD : other vectors or strings
+    template<typename Vec, EnableIfNonPod<ValType<Vec>> = nullptr>
+    static void describeVec(SegmentedMessage& msg, const Vec& v)
+    {
+        const int sz = v.size();
+        msg.appendCopy(&sz, sizeof(int));
+
+        for (auto& element : v)
+            describeOne(msg, element);
+    }
+
+    template<typename T> static void describeOne(SegmentedMessage& msg, const std::vector <T>& v) { describeVec(msg, v); }
+    template<typename T> static void describeOne(SegmentedMessage& msg, const HostBuffer  <T>& v) { describeVec(msg, v); }
+    template<typename T> static void describeOne(SegmentedMessage& msg, const PinnedBuffer<T>& v) { describeVec(msg, v); }
+
+    static void describeOne(SegmentedMessage& msg, const std::string& s)
+    {
+        const int sz = s.length();
+        msg.appendCopy(&sz, sizeof(int));
+        msg.appendCopy(s.c_str(), sz);
+    }
+
+    template<typename T>
+    static void describeOne(SegmentedMessage& msg, const T& v)
+    {
+        msg.appendCopy(&v, sizeOfOne(v));
+    }
+
+    static void describe(__UNUSED SegmentedMessage& msg)
+    {}
+
+    template<typename Arg, typename... OthArgs>
+    static void describe(SegmentedMessage& msg, const Arg& arg, const OthArgs&... othArgs)
+    {
+        describeOne(msg, arg);
+        describe(msg, othArgs...);
+    }
+
     //============================================================================
     
      /// Overload for the vectors of plain old data
@@ -184,6 +367,14 @@ private:
     template<typename T> static void unpackOne(const char* buf, HostBuffer  <T>& v) { unpackVec(buf, v, &HostBuffer  <T>::resize); }
     template<typename T> static void unpackOne(const char* buf, PinnedBuffer<T>& v) { unpackVec(buf, v, &PinnedBuffer<T>::resize_anew); }
     
+    template<typename T>
+    static void unpackOne(const char* buf, SerializedArrayView<T>& v)
+    {
+        v.n = *((int*)buf);
+        assert(v.n >= 0);
+        v.ptr = buf + sizeof(int);
+    }
+
     static void unpackOne(const char* buf, std::string& s)
     {
         const int sz = *((int*)buf);
@@ -232,6 +423,18 @@ public:
         unpack(buf.data(), args...);
     }
 
+    /**
+     * Describe the arguments without copying the contents of the containers,
+     * the byte layout is the same as the one of serialize().
+     * \p msg refers to the containers, see SegmentedMessage
+     */
+    template<typename... Args>
+    static void serializeSegments(SegmentedMessage& msg, const Args&... args)
+    {
+        msg.clear();
+        describe(msg, args...);
+    }
+
 
     // Unsafe variants
     template<typename... Args>
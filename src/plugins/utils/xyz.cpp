@@ -1,4 +1,25 @@
 #include "xyz.h"
+#include "binary_records.h"
+#include "fixed_format.h"
+
+#include <core/logger.h>
+
+#include <vector>
+
+// every rank writes its part of the content after the ones of the lower ranks
+static void writeOrdered(MPI_Comm comm, std::string fname, const char *content, MPI_Offset len)
+{
+    MPI_File f;
+    MPI_Check( MPI_File_open(comm, fname.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &f) );
+    MPI_Check( MPI_File_set_size(f, 0) );
+
+    MPI_Offset offset = 0;
+    MPI_Check( MPI_Exscan(&len, &offset, 1, MPI_OFFSET, MPI_SUM, comm));
+
+    MPI_Status status;
+    MPI_Check( MPI_File_write_at_all(f, offset, content, len, MPI_CHAR, &status) );
+    MPI_Check( MPI_File_close(&f));
+}
 
 void writeXYZ(MPI_Comm comm, std::string fname, const float4 *positions, int np)
 {
@@ -8,18 +29,12 @@ void writeXYZ(MPI_Comm comm, std::string fname, const float4 *positions, int np)
     int n = np;
     MPI_Check( MPI_Reduce(rank == 0 ? MPI_IN_PLACE : &n, &n, 1, MPI_INT, MPI_SUM, 0, comm) );
 
-    MPI_File f;
-    MPI_Check( MPI_File_open(comm, fname.c_str(), MPI_MODE_CREATE|MPI_MODE_DELETE_ON_CLOSE|MPI_MODE_WRONLY, MPI_INFO_NULL, &f) );
-    MPI_Check( MPI_File_close(&f) );
-    MPI_Check( MPI_File_open(comm, fname.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &f) );
-
-    std::stringstream ss;
-    ss.setf(std::ios::fixed, std::ios::floatfield);
-    ss.precision(5);
+    std::string content;
+    content.reserve(np * 40);
 
     if (rank == 0) {
-        ss <<  n << "\n";
-        ss << "# created by Mirheo" << "\n";
+        FixedFormat::appendInteger(content, n);
+        content += "\n# created by Mirheo\n";
 
         info("xyz dump to %s: total number of particles: %d", fname.c_str(), n);
     }
@@ -27,19 +42,42 @@ void writeXYZ(MPI_Comm comm, std::string fname, const float4 *positions, int np)
     for(int i = 0; i < np; ++i) {
         const auto& r = positions[i];
 
-        ss << rank << " "
-           << std::setw(10) << r.x << " "
-           << std::setw(10) << r.y << " "
-           << std::setw(10) << r.z << "\n";
+        FixedFormat::appendInteger(content, rank);
+        content += ' ';
+        FixedFormat::appendFixed(content, r.x, 10, 5);
+        content += ' ';
+        FixedFormat::appendFixed(content, r.y, 10, 5);
+        content += ' ';
+        FixedFormat::appendFixed(content, r.z, 10, 5);
+        content += '\n';
     }
 
-    std::string content = ss.str();
+    writeOrdered(comm, fname, content.data(), content.size());
+}
 
-    MPI_Offset len = content.size();
-    MPI_Offset offset = 0;
-    MPI_Check( MPI_Exscan(&len, &offset, 1, MPI_OFFSET, MPI_SUM, comm));
+void writeXYZBinary(MPI_Comm comm, std::string fname, const float4 *positions, int np)
+{
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
 
-    MPI_Status status;
-    MPI_Check( MPI_File_write_at_all(f, offset, content.c_str(), len, MPI_CHAR, &status) );
-    MPI_Check( MPI_File_close(&f));
+    const std::vector<BinaryRecords::Field> fields {
+        {"rank",     BinaryRecords::FieldType::Int32,   1},
+        {"position", BinaryRecords::FieldType::Float32, 3}
+    };
+
+    std::vector<char> content;
+    if (rank == 0)
+        content = BinaryRecords::createHeader("xyz", fields);
+
+    content.reserve(content.size() + np * BinaryRecords::recordSize(fields));
+    
+    for (int i = 0; i < np; ++i)
+    {
+        BinaryRecords::append(content, static_cast<int32_t>(rank));
+        BinaryRecords::append(content, positions[i].x);
+        BinaryRecords::append(content, positions[i].y);
+        BinaryRecords::append(content, positions[i].z);
+    }
+
+    writeOrdered(comm, fname, content.data(), content.size());
 }
@@ -5,3 +5,6 @@
 #include <core/datatypes.h>
 
 void writeXYZ(MPI_Comm comm, std::string fname, const float4 *positions, int np);
+
+/// same content as writeXYZ(), as BinaryRecords of kind "xyz" with fields rank (int32) and position (3 float32)
+void writeXYZBinary(MPI_Comm comm, std::string fname, const float4 *positions, int np);
@@ -141,6 +141,13 @@ void VirialPressureDumper::deserialize()
 
     SimpleSerializer::deserialize(data, curTime, localPressure);
 
+    for (const auto& other : otherData)
+    {
+        VirialPressure::ReductionType otherPressure;
+        SimpleSerializer::deserialize(other, curTime, otherPressure);
+        localPressure += otherPressure;
+    }
+
     if (!activated) return;
 
     MPI_Check( MPI_Reduce(&localPressure, &totalPressure, 1, mpiReductionType, MPI_SUM, 0, comm) );
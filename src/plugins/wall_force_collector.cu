@@ -4,31 +4,9 @@
 
 #include <core/datatypes.h>
 #include <core/pvs/particle_vector.h>
-#include <core/pvs/views/pv.h>
 #include <core/simulation.h>
-#include <core/utils/cuda_common.h>
-#include <core/utils/kernel_launch.h>
 #include <core/walls/interface.h>
 
-namespace WallForceCollector
-{
-__global__ void totalForce(PVview view, double3 *totalForce)
-{
-    int tid = blockIdx.x * blockDim.x + threadIdx.x;
-
-    float3 f {0.f, 0.f, 0.f};
-    
-    if (tid < view.size)
-        f = make_float3(view.forces[tid]);
-
-    f = warpReduce(f, [](float a, float b) { return a + b; });
-
-    if (laneId() == 0)
-        atomicAdd(totalForce, make_double3(f));
-}
-} //namespace WallForceCollector
-
-
 WallForceCollectorPlugin::WallForceCollectorPlugin(const MirState *state, std::string name,
                                                    std::string wallName, std::string frozenPvName,
                                                    int sampleEvery, int dumpEvery) :
@@ -54,26 +32,19 @@ void WallForceCollectorPlugin::setup(Simulation *simulation, const MPI_Comm& com
     pv = simulation->getPVbyNameOrDie(frozenPvName);
 
     bounceForceBuffer = wall->getCurrentBounceForce();
+
+    reductions  = simulation->getReductionService();
+    forceHandle = reductions->request(pv, ReductionService::Quantity::Force, sampleEvery);
 }
 
 void WallForceCollectorPlugin::afterIntegration(cudaStream_t stream)
 {   
     if (isTimeEvery(state, sampleEvery))
     {
-        pvForceBuffer.clear(stream);
-
-        PVview view(pv, pv->local());
-        const int nthreads = 128;
-
-        SAFE_KERNEL_LAUNCH(
-            WallForceCollector::totalForce,
-            getNblocks(view.size, nthreads), nthreads, 0, stream,
-            view, pvForceBuffer.devPtr() );
-
-        pvForceBuffer     .downloadFromDevice(stream);
+        const double *pvForce = reductions->get(forceHandle, stream);
         bounceForceBuffer->downloadFromDevice(stream);
 
-        totalForce += pvForceBuffer[0];
+        totalForce += make_double3(pvForce[0], pvForce[1], pvForce[2]);
         totalForce += (*bounceForceBuffer)[0];
 
         ++nsamples;
@@ -110,6 +81,14 @@ void WallForceDumperPlugin::deserialize()
     double localForce[3], totalForce[3] = {0.0, 0.0, 0.0};
 
     SimpleSerializer::deserialize(data, currentTime, nsamples, localForce);
+
+    for (const auto& other : otherData)
+    {
+        double otherForce[3];
+        SimpleSerializer::deserialize(other, currentTime, nsamples, otherForce);
+        for (int d = 0; d < 3; ++d)
+            localForce[d] += otherForce[d];
+    }
     
     MPI_Check( MPI_Reduce(localForce, totalForce, 3, MPI_DOUBLE, MPI_SUM, 0, comm) );
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <plugins/interface.h>
+#include <plugins/utils/reduction_service.h>
 #include <core/containers.h>
 #include <core/datatypes.h>
 #include <core/utils/file_wrapper.h>
@@ -37,7 +38,8 @@ private:
     ParticleVector *pv;
     
     PinnedBuffer<double3> *bounceForceBuffer {nullptr};
-    PinnedBuffer<double3> pvForceBuffer {1};
+    ReductionService *reductions;
+    ReductionService::Handle forceHandle;
     double3 totalForce {0.0, 0.0, 0.0};
     
     std::vector<char> sendBuffer;
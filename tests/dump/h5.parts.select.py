@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+
+import mirheo as mir
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--box_lo",   type=float, nargs=3, default=[-1e9, -1e9, -1e9])
+parser.add_argument("--box_hi",   type=float, nargs=3, default=[ 1e9,  1e9,  1e9])
+parser.add_argument("--stride",   type=int,   default=1)
+parser.add_argument("--fraction", type=float, default=1.0)
+parser.add_argument("--sphere",   type=float, nargs=4, default=None, help="center and radius of a sphere wall, inside=True")
+parser.add_argument("--plane",    type=float, nargs=6, default=None, help="normal and point through of a plane wall")
+parser.add_argument("--sdf_range", type=float, nargs=2, default=[-float('inf'), 0.0])
+args = parser.parse_args()
+
+ranks  = (1, 1, 2)
+domain = (4, 4, 8)
+
+u = mir.Mirheo(ranks, domain, dt=0, debug_level=3, log_filename='log', no_splash = True)
+
+pv = mir.ParticleVectors.ParticleVector('pv', mass = 1)
+ic = mir.InitialConditions.Uniform(number_density=8)
+u.registerParticleVector(pv, ic)
+
+# the wall is not attached to pv: it only serves as a filter
+wall_name = ''
+if args.sphere is not None:
+    wall_name = 'sphere'
+    u.registerWall(mir.Walls.Sphere(wall_name, center=tuple(args.sphere[:3]), radius=args.sphere[3], inside=True))
+elif args.plane is not None:
+    wall_name = 'plane'
+    u.registerWall(mir.Walls.Plane(wall_name, normal=tuple(args.plane[:3]), pointThrough=tuple(args.plane[3:])))
+
+dump_every = 1
+
+u.registerPlugins(mir.Plugins.createDumpParticles('all', pv, dump_every, [], 'h5/all-'))
+u.registerPlugins(mir.Plugins.createDumpParticles('sel', pv, dump_every, [], 'h5/sel-',
+                                                  box_lo=tuple(args.box_lo), box_hi=tuple(args.box_hi),
+                                                  sdf_wall=wall_name, sdf_range=tuple(args.sdf_range),
+                                                  stride=args.stride, fraction=args.fraction, seed=42))
+
+u.run(1)
+
+# TEST: dump.h5.parts.select
+# cd dump
+# rm -rf h5 h5.parts.select.out.txt
+# mir.run --runargs "-n 4" ./h5.parts.select.py --box_lo 1 0 2 --box_hi 3 4 6 --stride 3
+# mir.post ./utils/post.select.py --all h5/all-00000.h5 --sel h5/sel-00000.h5 --box_lo 1 0 2 --box_hi 3 4 6 --stride 3 > h5.parts.select.out.txt
+
+# TEST: dump.h5.parts.select.fraction
+# cd dump
+# rm -rf h5 h5.parts.select.out.txt
+# mir.run --runargs "-n 4" ./h5.parts.select.py --fraction 0.25
+# mir.post ./utils/post.select.py --all h5/all-00000.h5 --sel h5/sel-00000.h5 --fraction 0.25 > h5.parts.select.out.txt
+
+# TEST: dump.h5.parts.select.sphere
+# cd dump
+# rm -rf h5 h5.parts.select.out.txt
+# mir.run --runargs "-n 4" ./h5.parts.select.py --sphere 2 2 4 1.5 --sdf_range -1 0
+# mir.post ./utils/post.select.py --all h5/all-00000.h5 --sel h5/sel-00000.h5 --sphere 2 2 4 1.5 --sdf_range -1 0 > h5.parts.select.out.txt
+
+# TEST: dump.h5.parts.select.plane
+# cd dump
+# rm -rf h5 h5.parts.select.out.txt
+# mir.run --runargs "-n 4" ./h5.parts.select.py --plane 0 0 1 0 0 5
+# mir.post ./utils/post.select.py --all h5/all-00000.h5 --sel h5/sel-00000.h5 --plane 0 0 1 0 0 5 > h5.parts.select.out.txt
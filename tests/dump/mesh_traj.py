@@ -0,0 +1,30 @@
+#!/usr/bin/env python
+
+import mirheo as mir
+
+path   = "traj/"
+pvname = "rbc"
+off    = "rbc_mesh.off"
+
+ranks  = (1, 1, 1)
+domain = (12, 8, 10)
+
+u = mir.Mirheo(ranks, domain, dt=0, debug_level=3, log_filename='log', no_splash=True)
+
+mesh = mir.ParticleVectors.MembraneMesh(off)
+
+pv_rbc = mir.ParticleVectors.MembraneVector(pvname, mass=1.0, mesh=mesh)
+ic_rbc = mir.InitialConditions.Membrane([[6.0, 4.0, 5.0,   1.0, 0.0, 0.0, 0.0]])
+u.registerParticleVector(pv_rbc, ic_rbc)
+
+u.registerPlugins(mir.Plugins.createDumpMeshTrajectory("mesh_traj", pv_rbc, 1, path))
+
+u.run(3)
+
+# TEST: dump.mesh_traj
+# cd dump
+# rm -rf traj/ mesh.out.txt 
+# cp ../../data/rbc_mesh.off .
+# mir.run --runargs "-n 2" ./mesh_traj.py
+# mir.mesh_traj ply traj/rbc.mtraj traj/rbc
+# mir.post ./utils/post.ply.py --file traj/rbc_00000.ply --out mesh.out.txt
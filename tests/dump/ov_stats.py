@@ -1,6 +1,12 @@
 #!/usr/bin/env python
 
 import mirheo as mir
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--binary', action='store_true', default=False)
+parser.add_argument('--shape',  action='store_true', default=False)
+args = parser.parse_args()
 
 ranks  = (1, 1, 1)
 domain = (8, 8, 8)
@@ -17,7 +23,8 @@ ic = mir.InitialConditions.Membrane(com_q)
 
 u.registerParticleVector(ov, ic)
 
-u.registerPlugins(mir.Plugins.createDumpObjectStats("objStats", ov, dump_every=1, path="stats"))
+u.registerPlugins(mir.Plugins.createDumpObjectStats("objStats", ov, dump_every=1, path="stats",
+                                                  binary=args.binary, shape=args.shape))
 
 u.run(2)
 
@@ -28,3 +35,16 @@ u.run(2)
 # mir.run --runargs "-n 2" ./ov_stats.py
 # cp stats/rbc.txt ov_stats.out.txt
 
+# TEST: dump.ov_stats.bin
+# cd dump
+# rm -rf stats ov_stats.out.txt
+# cp ../../data/rbc_mesh.off .
+# mir.run --runargs "-n 2" ./ov_stats.py --binary
+# mir.records txt stats/rbc.bin ov_stats.out.txt
+
+# TEST: dump.ov_stats.shape
+# cd dump
+# rm -rf stats ov_stats.out.txt
+# cp ../../data/rbc_mesh.off .
+# mir.run --runargs "-n 2" ./ov_stats.py --shape
+# mir.post ./utils/post.shape.py --mesh rbc_mesh.off --stats stats/rbc.txt > ov_stats.out.txt
@@ -1,6 +1,11 @@
 #!/usr/bin/env python
 
 import mirheo as mir
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--binary', action='store_true', default=False)
+args = parser.parse_args()
 
 ranks  = (1, 1, 1)
 domain = (8, 8, 16)
@@ -17,7 +22,7 @@ ov = mir.ParticleVectors.RigidEllipsoidVector('ellipsoid', mass=1, object_size=l
 ic = mir.InitialConditions.Rigid(com_q=com_q, coords=coords)
 u.registerParticleVector(ov, ic)
 
-u.registerPlugins(mir.Plugins.createDumpObjectStats("objStats", ov, dump_every=1, path="stats"))
+u.registerPlugins(mir.Plugins.createDumpObjectStats("objStats", ov, dump_every=1, path="stats", binary=args.binary))
 
 u.run(2)
 
@@ -27,3 +32,9 @@ u.run(2)
 # mir.run --runargs "-n 2" ./rov_stats.py
 # cp stats/ellipsoid.txt rov_stats.out.txt
 
+# TEST: dump.rov_stats.bin
+# cd dump
+# rm -rf stats rov_stats.out.txt
+# mir.run --runargs "-n 2" ./rov_stats.py --binary
+# mir.records txt stats/ellipsoid.bin rov_stats.out.txt
+
@@ -0,0 +1,16 @@
+#! /usr/bin/env python
+
+import argparse
+import numpy as np
+import trimesh
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--file', type=str, required=True)
+parser.add_argument('--out',  type=str, required=True)
+args = parser.parse_args()
+
+mesh = trimesh.load(args.file)
+
+with open(args.out, "w") as f:
+    np.savetxt(f, mesh.vertices, fmt="%g")
+    np.savetxt(f, mesh.faces,    fmt="%d")
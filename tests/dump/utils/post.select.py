@@ -0,0 +1,62 @@
+#! /usr/bin/env python
+
+import argparse
+import numpy as np
+import h5py as h5
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--all',      type=str, required=True)
+parser.add_argument('--sel',      type=str, required=True)
+parser.add_argument('--box_lo',   type=float, nargs=3, default=[-1e9, -1e9, -1e9])
+parser.add_argument('--box_hi',   type=float, nargs=3, default=[ 1e9,  1e9,  1e9])
+parser.add_argument('--stride',   type=int,   default=1)
+parser.add_argument('--fraction', type=float, default=1.0)
+parser.add_argument('--sphere',   type=float, nargs=4, default=None)
+parser.add_argument('--plane',    type=float, nargs=6, default=None)
+parser.add_argument('--sdf_range', type=float, nargs=2, default=[-np.inf, 0.0])
+args = parser.parse_args()
+
+def read(fname):
+    f = h5.File(fname, "r")
+    ids = f["id"][()].flatten()
+    pos = f["position"][()]
+    order = np.argsort(ids)
+    return ids[order], pos[order]
+
+all_ids, all_pos = read(args.all)
+sel_ids, sel_pos = read(args.sel)
+
+lo = np.array(args.box_lo)
+hi = np.array(args.box_hi)
+mask = np.all((all_pos >= lo) & (all_pos <= hi), axis=1) & (all_ids % args.stride == 0)
+
+sdf = None
+if args.sphere is not None:
+    center, radius = np.array(args.sphere[:3]), args.sphere[3]
+    sdf = np.linalg.norm(all_pos - center, axis=1) - radius
+elif args.plane is not None:
+    normal, point = np.array(args.plane[:3]), np.array(args.plane[3:])
+    sdf = np.dot(all_pos - point, normal / np.linalg.norm(normal))
+
+if sdf is not None:
+    sdf_lo, sdf_hi = args.sdf_range
+    mask = mask & (sdf >= sdf_lo) & (sdf <= sdf_hi)
+
+    # the device computes the SDF in single precision: ignore the particles too close to the bounds
+    eps = 1e-4
+    ambiguous = (np.abs(sdf - sdf_lo) < eps) | (np.abs(sdf - sdf_hi) < eps)
+    kept = ~np.isin(sel_ids, all_ids[ambiguous])
+    sel_ids, sel_pos = sel_ids[kept], sel_pos[kept]
+    mask = mask & ~ambiguous
+    print("particles on both sides" if 0 < np.sum(mask) < len(mask) else "trivial selection")
+
+if args.fraction < 1.0:
+    # the random choice is not reproduced here: check that it is a subset of the expected size
+    subset = np.all(np.isin(sel_ids, all_ids[mask]))
+    expected = args.fraction * np.sum(mask)
+    close = abs(len(sel_ids) - expected) < 5 * np.sqrt(expected)
+    print("subset" if subset else "not a subset")
+    print("expected size" if close else "unexpected size %d, expected %g" % (len(sel_ids), expected))
+else:
+    same = np.array_equal(sel_ids, all_ids[mask]) and np.array_equal(sel_pos, all_pos[mask])
+    print("same particles" if same else "different particles")
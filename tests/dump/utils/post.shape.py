@@ -0,0 +1,37 @@
+#! /usr/bin/env python
+
+import argparse
+import numpy as np
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--mesh',  type=str, required=True)
+parser.add_argument('--stats', type=str, required=True)
+args = parser.parse_args()
+
+def read_off(fname):
+    with open(fname) as f:
+        lines = [l for l in f.read().splitlines() if l.strip()]
+    nv, nt = [int(x) for x in lines[1].split()[:2]]
+    vertices  = np.array([[float(x) for x in l.split()[:3]] for l in lines[2:2+nv]])
+    triangles = np.array([[int(x) for x in l.split()[1:4]] for l in lines[2+nv:2+nv+nt]])
+    return vertices, triangles
+
+v, t = read_off(args.mesh)
+
+v0, v1, v2 = v[t[:,0]], v[t[:,1]], v[t[:,2]]
+area   = 0.5 * np.sum(np.linalg.norm(np.cross(v1 - v0, v2 - v0), axis=1))
+volume = np.sum(np.einsum('ij,ij->i', v0, np.cross(v1, v2))) / 6.0
+
+d = v - v.mean(axis=0)
+l = np.sort(np.linalg.eigvalsh(d.T @ d / len(v)))[::-1]
+asphericity = ((l[0]-l[1])**2 + (l[1]-l[2])**2 + (l[2]-l[0])**2) / (2 * np.sum(l)**2)
+taylor = (np.sqrt(l[0]) - np.sqrt(l[2])) / (np.sqrt(l[0]) + np.sqrt(l[2]))
+
+expected = np.concatenate(([area, volume], l, [asphericity, taylor]))
+names = ["area", "volume", "l1", "l2", "l3", "asphericity", "taylor"]
+
+stats = np.atleast_2d(np.loadtxt(args.stats))
+for row in stats:
+    got = row[17:24]
+    for name, g, e in zip(names, got, expected):
+        print(name, "ok" if abs(g - e) <= 1e-3 * max(abs(e), 1.0) else "differs: %g %g" % (g, e))
@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+
+import numpy as np
+import mirheo as mir
+import sys, argparse
+
+sys.path.append("..")
+from common.membrane_params import lina_parameters
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--partial', action='store_true', default=False)
+parser.add_argument('--wide', action='store_true', default=False)
+parser.add_argument('--out', type=str, required=True)
+args = parser.parse_args()
+
+tend = 0.5
+dt = 0.001
+a = 1.0
+
+ranks  = (2, 1, 1)
+domain = (12, 8, 10)
+com    = [6.0, 4.0, 5.0]
+
+if args.wide:
+    # the membrane is wider than the subdomain and crosses both of its faces along x
+    tend   = 0.01
+    domain = (8, 8, 8)
+    com    = [2.0, 4.0, 4.0]
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+pv_sol = mir.ParticleVectors.ParticleVector('solvent', mass = 1)
+ic_sol = mir.InitialConditions.Uniform(number_density=8)
+u.registerParticleVector(pv_sol, ic_sol)
+
+# the membrane crosses the boundary between the two subdomains
+mesh_rbc = mir.ParticleVectors.MembraneMesh("rbc_mesh.off")
+pv_rbc   = mir.ParticleVectors.MembraneVector("rbc", mass=1.0, mesh=mesh_rbc)
+ic_rbc   = mir.InitialConditions.Membrane([com + [1.0, 0.0, 0.0, 0.0]])
+u.registerParticleVector(pv_rbc, ic_rbc)
+
+if args.partial:
+    u.setPartialObjectHalo(pv_rbc)
+
+# no random forces: both runs only differ by round-off errors
+dpd = mir.Interactions.Pairwise('dpd', rc=1.0, kind="DPD", a=10.0, gamma=10.0, kBT=0.0, power=0.25)
+
+prm_rbc = lina_parameters(1.0)
+int_rbc = mir.Interactions.MembraneForces("int_rbc", "wlc", "Kantor", **prm_rbc, stress_free=True)
+
+u.registerInteraction(dpd)
+u.registerInteraction(int_rbc)
+
+u.setInteraction(dpd, pv_sol, pv_sol)
+u.setInteraction(dpd, pv_sol, pv_rbc)
+u.setInteraction(int_rbc, pv_rbc, pv_rbc)
+
+vv = mir.Integrators.VelocityVerlet('vv')
+u.registerIntegrator(vv)
+u.setIntegrator(vv, pv_rbc)
+
+vv_dp = mir.Integrators.VelocityVerlet_withPeriodicForce('vv_dp', force=a, direction='x')
+u.registerIntegrator(vv_dp)
+u.setIntegrator(vv_dp, pv_sol)
+
+nsteps = (int) (tend/dt)
+u.run(nsteps)
+
+# only the rank owning the membrane has its particles
+if pv_rbc is not None:
+    rbc_pos = pv_rbc.getCoordinates()
+    if len(rbc_pos) > 0:
+        if args.wide:
+            # forces of the last step, including the ones from the solvent of the other rank
+            order = np.argsort(pv_rbc.get_indices())
+            np.savetxt(args.out, np.array(pv_rbc.getForces())[order])
+        else:
+            np.savetxt(args.out, np.mean(rbc_pos, axis=0))
+
+
+# TEST: fsi.membrane.partial_halo
+# cd fsi
+# rm -rf com.*.txt partial_halo.out.txt
+# cp ../../data/rbc_mesh.off .
+# mir.run --runargs "-n 4" ./membrane.partial_halo.py --out com.whole.txt
+# mir.run --runargs "-n 4" ./membrane.partial_halo.py --out com.partial.txt --partial
+# python3 -c "import numpy as np; print('same com' if np.allclose(np.loadtxt('com.whole.txt'), np.loadtxt('com.partial.txt'), atol=1e-3) else 'different com')" > partial_halo.out.txt
+
+# TEST: fsi.membrane.partial_halo.wide
+# cd fsi
+# rm -rf forces.*.txt partial_halo.out.txt
+# cp ../../data/rbc_mesh.off .
+# mir.run --runargs "-n 4" ./membrane.partial_halo.py --wide --out forces.whole.txt
+# mir.run --runargs "-n 4" ./membrane.partial_halo.py --wide --out forces.partial.txt --partial
+# python3 -c "import numpy as np; print('same forces' if np.allclose(np.loadtxt('forces.whole.txt'), np.loadtxt('forces.partial.txt'), rtol=1e-3, atol=1e-3) else 'different forces')" > partial_halo.out.txt
@@ -0,0 +1,36 @@
+#!/usr/bin/env python
+
+import mirheo as mir
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--per_post', type=int, default=1)
+parser.add_argument('--out', type=str, required=True)
+args = parser.parse_args()
+
+ranks  = (3, 1, 1)
+domain = (12, 8, 10)
+
+u = mir.Mirheo(ranks, domain, dt=0, debug_level=3, log_filename='log', no_splash=True,
+               compute_ranks_per_postprocess=args.per_post)
+
+pv = mir.ParticleVectors.ParticleVector('pv', mass = 1)
+ic = mir.InitialConditions.Uniform(number_density=2)
+u.registerParticleVector(pv, ic)
+
+u.registerPlugins(mir.Plugins.createDumpXYZ('xyz', pv, 1, args.out))
+
+u.run(2)
+
+# the initial conditions only depend on the simulation ranks:
+# the dump must not depend on how many of them share a postprocess rank
+
+# TEST: mpi.postprocess_ranks
+# cd mpi
+# rm -rf xyz1 xyz2
+# mir.run --runargs "-n 6" ./postprocess_ranks.py --per_post 1 --out xyz1
+# mir.run --runargs "-n 5" ./postprocess_ranks.py --per_post 2 --out xyz2
+# tail -n +3 xyz1/pv_00000.xyz | awk '{print $2, $3, $4}' | LC_ALL=en_US.utf8 sort > xyz1.txt
+# tail -n +3 xyz2/pv_00000.xyz | awk '{print $2, $3, $4}' | LC_ALL=en_US.utf8 sort > xyz2.txt
+# head -n 1 xyz2/pv_00000.xyz > postprocess_ranks.out.txt
+# cmp -s xyz1.txt xyz2.txt && echo "same positions" >> postprocess_ranks.out.txt
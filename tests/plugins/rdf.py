@@ -0,0 +1,34 @@
+#!/usr/bin/env python
+
+import mirheo as mir
+
+ranks  = (2, 1, 1)
+domain = (8, 8, 8)
+
+dt = 0.01
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+# ideal gas: uniform random positions and no forces, g(r) = 1
+# the small distances are poorly sampled and the positions are drawn per cell: only the mean far from 0 is compared
+pv = mir.ParticleVectors.ParticleVector('pv', mass = 1)
+u.registerParticleVector(pv, mir.InitialConditions.Uniform(number_density=8))
+
+dpd = mir.Interactions.Pairwise('dpd', rc=1.0, kind="DPD", a=0.0, gamma=0.0, kBT=0.0, power=0.5)
+u.registerInteraction(dpd)
+u.setInteraction(dpd, pv, pv)
+
+sample_every = 5
+dump_every = 20
+
+u.registerPlugins(mir.Plugins.createRdf('rdf', pv, max_distance=1.0, nbins=10,
+                                        sample_every=sample_every, dump_every=dump_every,
+                                        modes=[[1, 0, 0], [0, 2, 0]], path='rdf/'))
+
+u.run(21)
+
+# TEST: plugins.rdf
+# cd plugins
+# rm -rf rdf rdf.out.txt
+# mir.run --runargs "-n 4" ./rdf.py
+# awk '!/^#/ && NF == 2 && $1 > 0.5 {n++; g += $2} END {m = g / n; print (m > 0.9 && m < 1.1) ? "mean g(r) beyond 0.5 is 1" : "mean g(r) beyond 0.5 is " m}' rdf/rdf_00001.txt > rdf.out.txt
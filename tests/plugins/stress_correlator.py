@@ -0,0 +1,52 @@
+#!/usr/bin/env python
+
+import mirheo as mir
+import numpy as np
+
+ranks  = (1, 1, 1)
+domain = (8, 8, 8)
+
+dt = 0.01
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+# free particles: only the kinetic part of the stress, constant in time
+n = 200
+mass = 1.5
+np.random.seed(42)
+positions  = np.random.rand(n, 3) * np.array(domain)
+velocities = np.random.rand(n, 3) - 0.5
+
+pv = mir.ParticleVectors.ParticleVector('pv', mass = mass)
+ic = mir.InitialConditions.FromArray(positions.tolist(), velocities.tolist())
+u.registerParticleVector(pv=pv, ic=ic)
+
+sample_every = 2
+dump_every = 100
+
+# no forces, the interaction only provides the stress channel
+dpd = mir.Interactions.Pairwise('dpd', rc=1.0, kind="DPD", a=0.0, gamma=0.0, kBT=0.0, power=0.5,
+                                stress=True, stress_period=sample_every*dt)
+u.registerInteraction(dpd)
+u.setInteraction(dpd, pv, pv)
+
+vv = mir.Integrators.VelocityVerlet('vv')
+u.registerIntegrator(vv)
+u.setIntegrator(vv, pv)
+
+u.registerPlugins(mir.Plugins.createStressCorrelator('stress', [pv], sample_every, dump_every,
+                                                     levels=4, points=8, averaging=2, path='correlators/'))
+
+u.run(101)
+
+if u.isMasterTask():
+    v = velocities.astype(np.float32).astype(np.float64)
+    volume = np.prod(domain)
+    p = mass * np.array([np.sum(v[:,0] * v[:,1]), np.sum(v[:,0] * v[:,2]), np.sum(v[:,1] * v[:,2])]) / volume
+    np.savetxt('stress.expected.txt', [np.sum(p**2)])
+
+# TEST: plugins.stress_correlator
+# cd plugins
+# rm -rf correlators stress.expected.txt stress_correlator.out.txt
+# mir.run --runargs "-n 2" ./stress_correlator.py
+# python3 -c "import numpy as np; c = np.loadtxt('correlators/stress.txt')[:,1]; ref = np.loadtxt('stress.expected.txt'); print('constant kinetic stress correlation' if np.allclose(c, ref, rtol=1e-3) else 'wrong correlation')" > stress_correlator.out.txt
@@ -0,0 +1,133 @@
+#! /usr/bin/env python
+
+import sys
+import struct
+import numpy as np
+
+def err(s): sys.stderr.write(s)
+def shift(a): return a.pop(0)
+
+MAGIC   = b"MIRMTRAJ"
+VERSION = 1
+
+def fopen(fname):
+    try:
+        f = open(fname, "rb")
+    except IOError:
+        err("u.mesh_traj: fails to open <%s>\n" % fname)
+        sys.exit(2)
+    return f
+
+def read_header(f):
+    if f.read(8) != MAGIC:
+        err("u.mesh_traj: not a mesh trajectory file\n")
+        sys.exit(2)
+    (version, nv, nt, qstep) = struct.unpack("<iiif", f.read(16))
+    if version != VERSION:
+        err("u.mesh_traj: unsupported version %d\n" % version)
+        sys.exit(2)
+    triangles = np.frombuffer(f.read(12 * nt), dtype="<i4").reshape(nt, 3)
+    return nv, triangles, qstep
+
+def read_frames(f, nv, qstep):
+    """yield (index, time, ids, coms, vertices), objects sorted by id"""
+    while True:
+        raw = f.read(24)
+        if len(raw) < 24: return
+        (index, time, nobj) = struct.unpack("<qdq", raw)
+        ids  = np.frombuffer(f.read(8  * nobj), dtype="<i8")
+        coms = np.frombuffer(f.read(12 * nobj), dtype="<f4").reshape(nobj, 3)
+        if qstep > 0:
+            q = np.frombuffer(f.read(6 * nobj * nv), dtype="<i2").reshape(nobj, nv, 3)
+            vertices = coms[:, np.newaxis, :] + qstep * q.astype(np.float32)
+        else:
+            vertices = np.frombuffer(f.read(12 * nobj * nv), dtype="<f4").reshape(nobj, nv, 3)
+
+        order = np.argsort(ids, kind="stable")
+        yield index, time, ids[order], coms[order], vertices[order].astype(np.float32)
+
+def connectivity(triangles, nobj, nv):
+    shifts = nv * np.arange(nobj, dtype=np.int32)
+    return (triangles[np.newaxis, :, :] + shifts[:, np.newaxis, np.newaxis]).reshape(-1, 3)
+
+def write_ply(fname, vertices, faces):
+    with open(fname, "wb") as f:
+        f.write(("ply\n"
+                 "format binary_little_endian 1.0\n"
+                 "element vertex %d\n"
+                 "property float x\nproperty float y\nproperty float z\n"
+                 "element face %d\n"
+                 "property list int int vertex_index\n"
+                 "end_header\n" % (len(vertices), len(faces))).encode())
+        f.write(vertices.astype("<f4").tobytes())
+        ply_faces = np.empty((len(faces), 4), dtype="<i4")
+        ply_faces[:, 0]  = 3
+        ply_faces[:, 1:] = faces
+        f.write(ply_faces.tobytes())
+
+def write_xdmf(base, time, vertices, faces, ids, nv):
+    import h5py as h5
+    import os
+    h5name = base + ".h5"
+    with h5.File(h5name, "w") as f:
+        f["position"] = vertices
+        f["triangle"] = faces
+        f["id"]       = np.repeat(ids, nv)
+
+    h5rel = os.path.basename(h5name)
+    with open(base + ".xmf", "w") as f:
+        f.write('<?xml version="1.0"?>\n'
+                '<Xdmf Version="3.0">\n'
+                ' <Domain>\n'
+                '  <Grid Name="mesh" GridType="Uniform">\n'
+                '   <Time Value="%.10g"/>\n'
+                '   <Topology TopologyType="Triangle" NumberOfElements="%d">\n'
+                '    <DataItem Dimensions="%d 3" NumberType="Int" Precision="4" Format="HDF">%s:/triangle</DataItem>\n'
+                '   </Topology>\n'
+                '   <Geometry GeometryType="XYZ">\n'
+                '    <DataItem Dimensions="%d 3" NumberType="Float" Precision="4" Format="HDF">%s:/position</DataItem>\n'
+                '   </Geometry>\n'
+                '   <Attribute Name="id" AttributeType="Scalar" Center="Node">\n'
+                '    <DataItem Dimensions="%d 1" NumberType="Int" Precision="8" Format="HDF">%s:/id</DataItem>\n'
+                '   </Attribute>\n'
+                '  </Grid>\n'
+                ' </Domain>\n'
+                '</Xdmf>\n'
+                % (time, len(faces), len(faces), h5rel, len(vertices), h5rel, len(vertices), h5rel))
+
+argv = sys.argv
+
+if len(argv) < 3:
+    err("usage: %s <info|ply|xdmf> <file.mtraj> [prefix]\n"
+        "\t info : print the mesh and the list of frames\n"
+        "\t ply  : write <prefix>_NNNNN.ply for every frame\n"
+        "\t xdmf : write <prefix>_NNNNN.xmf and <prefix>_NNNNN.h5 for every frame\n"
+        "\t objects are sorted by id in the output\n" % argv[0])
+    exit(1)
+
+shift(argv)
+mode  = shift(argv)
+fname = shift(argv)
+prefix = shift(argv) if len(argv) else fname.rsplit(".", 1)[0]
+
+if mode not in ("info", "ply", "xdmf"):
+    err("bad mode %s, must be in [info, ply, xdmf]\n" % mode); exit(1)
+
+f = fopen(fname)
+nv, triangles, qstep = read_header(f)
+
+if mode == "info":
+    print("vertices per object: %d" % nv)
+    print("triangles per object: %d" % len(triangles))
+    print("quantization step: %g" % qstep)
+
+for (index, time, ids, coms, vertices) in read_frames(f, nv, qstep):
+    nobj  = len(ids)
+    faces = connectivity(triangles, nobj, nv)
+    base  = "%s_%05d" % (prefix, index)
+
+    if   mode == "info": print("frame %d time %g objects %d" % (index, time, nobj))
+    elif mode == "ply":  write_ply(base + ".ply", vertices.reshape(-1, 3), faces)
+    else:                write_xdmf(base, time, vertices.reshape(-1, 3), faces, ids, nv)
+
+f.close()
@@ -0,0 +1,105 @@
+#! /usr/bin/env python
+
+import sys
+import struct
+import numpy as np
+
+def err(s): sys.stderr.write(s)
+def shift(a): return a.pop(0)
+
+MAGIC   = b"MIRRECRD"
+VERSION = 1
+TYPES   = {0: "<i4", 1: "<i8", 2: "<f4", 3: "<f8"}
+
+def fopen(fname):
+    try:
+        f = open(fname, "rb")
+    except IOError:
+        err("u.records: fails to open <%s>\n" % fname)
+        sys.exit(2)
+    return f
+
+def read_string(f):
+    (n,) = struct.unpack("<i", f.read(4))
+    return f.read(n).decode()
+
+def read_header(f):
+    if f.read(8) != MAGIC:
+        err("u.records: not a records file\n")
+        sys.exit(2)
+    (version, header_size, record_size) = struct.unpack("<iii", f.read(12))
+    if version != VERSION:
+        err("u.records: unsupported version %d\n" % version)
+        sys.exit(2)
+    kind = read_string(f)
+    (nfields,) = struct.unpack("<i", f.read(4))
+    fields = []
+    for i in range(nfields):
+        (t, ncomp) = struct.unpack("<ii", f.read(8))
+        name = read_string(f)
+        fields.append((name, TYPES[t], ncomp))
+    f.seek(header_size)
+    return kind, fields, record_size
+
+def read_records(f, fields):
+    dtype = np.dtype([(name, t, (ncomp,)) for (name, t, ncomp) in fields])
+    return np.frombuffer(f.read(), dtype=dtype)
+
+def fmt(values):
+    return " ".join("%10.5f" % v for v in values)
+
+def write_xyz(out, records):
+    out.write("%d\n# created by Mirheo\n" % len(records))
+    for r in records:
+        out.write("%d %s\n" % (r["rank"][0], fmt(r["position"])))
+
+def write_obj_stats(out, records, names):
+    for r in records:
+        line = "%d %.5f   %s" % (r["id"][0], r["time"][0], fmt(r["com"]))
+        if "quaternion" in names:
+            line += "    " + fmt(r["quaternion"])
+        for q in ("velocity", "omega", "force", "torque"):
+            line += "    " + fmt(r[q])
+        if "gyration" in names:
+            line += "    " + fmt([r["area"][0], r["volume"][0]])
+            line += "    " + fmt(r["gyration"])
+            line += "    " + fmt([r["asphericity"][0], r["taylor"][0], r["angle"][0]])
+        out.write(line + "\n")
+
+argv = sys.argv
+
+if len(argv) < 3:
+    err("usage: %s <info|txt> <file.bin> [out]\n"
+        "\t info : print the header and the number of records\n"
+        "\t txt  : write the legacy text format (xyz or object statistics) to [out], stdout by default\n" % argv[0])
+    exit(1)
+
+shift(argv)
+mode  = shift(argv)
+fname = shift(argv)
+oname = shift(argv) if len(argv) else None
+
+if mode not in ("info", "txt"):
+    err("bad mode %s, must be in [info, txt]\n" % mode); exit(1)
+
+f = fopen(fname)
+kind, fields, record_size = read_header(f)
+records = read_records(f, fields)
+f.close()
+
+if mode == "info":
+    print("kind: %s" % kind)
+    print("record size: %d bytes" % record_size)
+    for (name, t, ncomp) in fields:
+        print("field %s: %s x %d" % (name, t, ncomp))
+    print("records: %d" % len(records))
+    exit(0)
+
+out = open(oname, "w") if oname else sys.stdout
+
+if   kind == "xyz":       write_xyz(out, records)
+elif kind == "obj_stats": write_obj_stats(out, records, [name for (name, t, n) in fields])
+else:
+    err("u.records: unknown kind %s\n" % kind); exit(2)
+
+if oname: out.close()
@@ -0,0 +1,62 @@
+#include <core/logger.h>
+#include <core/utils/cache.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+Logger logger;
+
+TEST (Cache, key_is_deterministic)
+{
+    Cache::Key a, b;
+    a.add(42).add(std::string("wall")).add(std::vector<float>{1.f, 2.f, 3.f});
+    b.add(42).add(std::string("wall")).add(std::vector<float>{1.f, 2.f, 3.f});
+
+    ASSERT_EQ(a.str(), b.str());
+    ASSERT_EQ(a.str().size(), 16);
+}
+
+TEST (Cache, key_depends_on_all_data)
+{
+    Cache::Key a, b, c;
+    a.add(1.0f).add(2.0f);
+    b.add(2.0f).add(1.0f);
+    c.add(std::string("ab")).add(std::string("c"));
+
+    Cache::Key d;
+    d.add(std::string("a")).add(std::string("bc"));
+
+    ASSERT_NE(a.str(), b.str());
+    ASSERT_NE(c.str(), d.str());
+}
+
+TEST (Cache, store_and_load)
+{
+    const std::string fname = "cache_test.bin";
+    const std::vector<char> data {'m', 'i', 'r', '\0', 'h', 'e', 'o'};
+    std::vector<char> loaded;
+
+    std::remove(fname.c_str());
+    ASSERT_FALSE(Cache::load(fname, loaded));
+
+    Cache::store(fname, data);
+    ASSERT_TRUE(Cache::load(fname, loaded));
+    ASSERT_EQ(data, loaded);
+
+    std::remove(fname.c_str());
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "cache.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -0,0 +1,189 @@
+#include "../timer.h"
+
+#include <core/logger.h>
+#include <core/utils/space_filling_curve.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+Logger logger;
+
+using SpaceFillingCurve::Ordering;
+
+static int3 decode(int cid, int3 ncells)
+{
+    return {cid % ncells.x, (cid / ncells.x) % ncells.y, cid / (ncells.x * ncells.y)};
+}
+
+static bool isPermutation(std::vector<int> ranks)
+{
+    std::sort(ranks.begin(), ranks.end());
+    for (int i = 0; i < static_cast<int>(ranks.size()); ++i)
+        if (ranks[i] != i) return false;
+    return true;
+}
+
+TEST (CellOrdering, hilbert_steps_are_adjacent)
+{
+    const int3 ncells {8, 8, 8};
+    const int totcells = ncells.x * ncells.y * ncells.z;
+    auto ranks = SpaceFillingCurve::computeCellRanks(ncells, Ordering::Hilbert);
+
+    std::vector<int> cells(totcells);
+    for (int cid = 0; cid < totcells; ++cid)
+        cells[ranks[cid]] = cid;
+
+    for (int i = 1; i < totcells; ++i)
+    {
+        const int3 a = decode(cells[i-1], ncells);
+        const int3 b = decode(cells[i],   ncells);
+        const int dist = std::abs(a.x-b.x) + std::abs(a.y-b.y) + std::abs(a.z-b.z);
+        ASSERT_EQ(dist, 1) << "step " << i;
+    }
+}
+
+TEST (CellOrdering, ranks_are_permutations)
+{
+    for (auto ncells : {int3{5, 7, 3}, int3{16, 16, 16}, int3{1, 9, 2}, int3{33, 4, 12}})
+        for (auto ordering : {Ordering::Lexicographic, Ordering::Morton, Ordering::Hilbert})
+        {
+            auto ranks = SpaceFillingCurve::computeCellRanks(ncells, ordering);
+            ASSERT_EQ(ranks.size(), ncells.x * ncells.y * ncells.z);
+            ASSERT_TRUE(isPermutation(ranks)) << SpaceFillingCurve::getOrderingStr(ordering);
+        }
+}
+
+TEST (CellOrdering, morton_keys)
+{
+    ASSERT_EQ(SpaceFillingCurve::mortonKey(0, 0, 0), 0);
+    ASSERT_EQ(SpaceFillingCurve::mortonKey(1, 0, 0), 1);
+    ASSERT_EQ(SpaceFillingCurve::mortonKey(0, 1, 0), 2);
+    ASSERT_EQ(SpaceFillingCurve::mortonKey(0, 0, 1), 4);
+    ASSERT_EQ(SpaceFillingCurve::mortonKey(1, 1, 1), 7);
+    ASSERT_EQ(SpaceFillingCurve::mortonKey(2, 0, 0), 8);
+}
+
+struct LocalityStats
+{
+    double linesPerBlock, cellsPerBlock;
+    double nsPerParticle;
+};
+
+// Mimics the pairwise kernels on the host: particles are sorted as the cell-list does,
+// then each block of consecutive particles visits the 27 cells around every particle.
+// We count the distinct memory lines and cells touched per block
+static LocalityStats measureLocality(Ordering ordering, int3 ncells, float density)
+{
+    constexpr int blockSize       = 128; // particles handled by one thread block
+    constexpr int particlesPerLine = 8;  // 128 bytes lines of float4
+
+    const int totcells = ncells.x * ncells.y * ncells.z;
+    const int np = static_cast<int>(density * totcells);
+    const auto ranks = SpaceFillingCurve::computeCellRanks(ncells, ordering);
+
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<float> ux(0.f, ncells.x), uy(0.f, ncells.y), uz(0.f, ncells.z);
+
+    struct P { float x, y, z; int cell; int key; };
+    std::vector<P> particles(np);
+
+    for (auto& p : particles)
+    {
+        p.x = ux(gen); p.y = uy(gen); p.z = uz(gen);
+        const int ix = static_cast<int>(p.x), iy = static_cast<int>(p.y), iz = static_cast<int>(p.z);
+        p.cell = ranks[(iz * ncells.y + iy) * ncells.x + ix];
+
+        // same octant sub-ordering as the cell-list uses with space-filling curves
+        const int octant = (p.x - ix >= 0.5f) + 2*(p.y - iy >= 0.5f) + 4*(p.z - iz >= 0.5f);
+        p.key = ordering == Ordering::Lexicographic ? p.cell : p.cell * 8 + octant;
+    }
+
+    std::stable_sort(particles.begin(), particles.end(), [](const P& a, const P& b) { return a.key < b.key; });
+
+    std::vector<int> cellStarts(totcells + 1, 0);
+    for (const auto& p : particles) cellStarts[p.cell + 1]++;
+    std::partial_sum(cellStarts.begin(), cellStarts.end(), cellStarts.begin());
+
+    long totalLines = 0, totalCells = 0;
+    double checksum = 0;
+    Timer timer;
+    timer.start();
+
+    for (int blockStart = 0; blockStart < np; blockStart += blockSize)
+    {
+        std::set<int> lines, cells;
+        const int blockEnd = std::min(np, blockStart + blockSize);
+
+        for (int i = blockStart; i < blockEnd; ++i)
+        {
+            const auto& dst = particles[i];
+            const int cx = dst.x, cy = dst.y, cz = dst.z;
+
+            for (int z = std::max(cz-1, 0); z <= std::min(cz+1, ncells.z-1); ++z)
+                for (int y = std::max(cy-1, 0); y <= std::min(cy+1, ncells.y-1); ++y)
+                    for (int x = std::max(cx-1, 0); x <= std::min(cx+1, ncells.x-1); ++x)
+                    {
+                        const int cid = ranks[(z * ncells.y + y) * ncells.x + x];
+                        cells.insert(cid);
+
+                        for (int j = cellStarts[cid]; j < cellStarts[cid+1]; ++j)
+                        {
+                            lines.insert(j / particlesPerLine);
+                            checksum += particles[j].x - dst.x;
+                        }
+                    }
+        }
+
+        totalLines += lines.size();
+        totalCells += cells.size();
+    }
+
+    timer.stop();
+
+    const int nblocks = (np + blockSize - 1) / blockSize;
+    // prevents the traversal from being optimized away
+    if (checksum == 42.0) printf(" ");
+
+    return {static_cast<double>(totalLines) / nblocks,
+            static_cast<double>(totalCells) / nblocks,
+            static_cast<double>(timer.elapsed()) / np};
+}
+
+TEST (CellOrdering, neighbour_locality_benchmark)
+{
+    const int3 ncells {32, 32, 32};
+    const float density = 8.0f;
+
+    printf("%14s %16s %16s %14s\n", "ordering", "lines / block", "cells / block", "ns / particle");
+
+    std::vector<LocalityStats> stats;
+    for (auto ordering : {Ordering::Lexicographic, Ordering::Morton, Ordering::Hilbert})
+    {
+        stats.push_back(measureLocality(ordering, ncells, density));
+        printf("%14s %16.1f %16.1f %14.1f\n", SpaceFillingCurve::getOrderingStr(ordering).c_str(),
+               stats.back().linesPerBlock, stats.back().cellsPerBlock, stats.back().nsPerParticle);
+    }
+
+    // a block of particles along a curve is compact in space, hence touches fewer cells
+    ASSERT_LT(stats[1].cellsPerBlock, stats[0].cellsPerBlock);
+    ASSERT_LT(stats[2].cellsPerBlock, stats[0].cellsPerBlock);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "cell_ordering.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+// set the membrane vector of the plugin without a simulation
+#define private public
+
+#include <core/logger.h>
+#include <core/mesh/membrane.h>
+#include <core/pvs/membrane_vector.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/helper_math.h>
+#include <plugins/membrane_extra_force.h>
+
+#include "../sphere_mesh.h"
+
+Logger logger;
+
+/// the extra forces are given in the input order of the vertices and must act on the same vertices once reordered
+static void checkExtraForces(MembraneMesh::Reordering reordering)
+{
+    const DomainInfo domain {{16.f, 16.f, 16.f}, {0.f, 0.f, 0.f}, {16.f, 16.f, 16.f}};
+    MirState state(domain, 0.f);
+
+    const auto data = createSphereMesh(4.f, 2);
+    auto mesh = std::make_shared<MembraneMesh>(data.vertices, data.faces, reordering);
+    const int nv = mesh->getNvertices();
+    const int nObjects = 3;
+
+    if (reordering != MembraneMesh::Reordering::None)
+    {
+        const auto& originalIds = mesh->getOriginalIds();
+        ASSERT_EQ(static_cast<int>(originalIds.size()), nv);
+
+        int nmoved = 0;
+        for (int i = 0; i < nv; ++i)
+            nmoved += originalIds[i] != i;
+        ASSERT_GT(nmoved, 0);
+    }
+
+    MembraneVector mv(&state, "mv", 1.f, mesh, nObjects);
+
+    // a different force on each vertex, function of its input position
+    std::vector<float3> inputForces;
+    for (const auto& r : data.vertices)
+        inputForces.push_back(make_float3(r.x, 2.f * r.y, 3.f * r.z + 1.f));
+
+    MembraneExtraForcePlugin plugin(&state, "extra_force", mv.name, inputForces);
+    plugin.pv = &mv;
+    plugin._uploadForces();
+
+    auto& forces = mv.local()->forces();
+    forces.clear(defaultStream);
+    plugin.beforeForces(defaultStream);
+    forces.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    // the vertex coordinates of the mesh follow the internal order
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        for (int i = 0; i < nv; ++i)
+        {
+            const float3 r = make_float3(mesh->vertexCoordinates[i]);
+            const float3 expected = make_float3(r.x, 2.f * r.y, 3.f * r.z + 1.f);
+            const float3 f = forces[objId * nv + i].f;
+
+            ASSERT_NEAR(f.x, expected.x, 1e-5f) << "object " << objId << ", vertex " << i;
+            ASSERT_NEAR(f.y, expected.y, 1e-5f) << "object " << objId << ", vertex " << i;
+            ASSERT_NEAR(f.z, expected.z, 1e-5f) << "object " << objId << ", vertex " << i;
+        }
+    }
+}
+
+TEST (MembraneExtraForce, input_order)
+{
+    checkExtraForces(MembraneMesh::Reordering::None);
+}
+
+TEST (MembraneExtraForce, reverse_cuthill_mckee_order)
+{
+    checkExtraForces(MembraneMesh::Reordering::ReverseCuthillMcKee);
+}
+
+TEST (MembraneExtraForce, hilbert_order)
+{
+    checkExtraForces(MembraneMesh::Reordering::Hilbert);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "membrane_extra_force.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
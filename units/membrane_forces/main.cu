@@ -0,0 +1,613 @@
+#include <core/interactions/membrane.h>
+#include <core/interactions/membrane/kernels/parameters.h>
+#include <core/logger.h>
+#include <core/mesh/membrane.h>
+#include <core/pvs/membrane_vector.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/helper_math.h>
+#include <core/walls/simple_stationary_wall.h>
+#include <core/walls/stationary_walls/plane.h>
+
+#include "../sphere_mesh.h"
+#include "../timer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+Logger logger;
+
+// Kantor energy with zero spontaneous angle: kb * (1 - cos(theta)) for each edge
+static double bendingEnergy(const std::vector<double3>& r, const std::vector<int3>& faces, double kb)
+{
+    std::map<std::pair<int,int>, double3> edgeNormals;
+    double energy = 0.0;
+
+    for (auto f : faces)
+    {
+        const int ids[3] = {f.x, f.y, f.z};
+        const double3 c = cross(r[f.y] - r[f.x], r[f.z] - r[f.x]);
+        const double3 n = c / std::sqrt(dot(c, c)); // length() is single precision
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const int a = ids[i], b = ids[(i+1) % 3];
+            auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = edgeNormals.find(key);
+
+            if (it == edgeNormals.end())
+                edgeNormals[key] = n;
+            else
+                energy += kb * (1.0 - dot(n, it->second));
+        }
+    }
+    return energy;
+}
+
+static std::vector<double3> hostBendingForces(const std::vector<double3>& r, const std::vector<int3>& faces, double kb)
+{
+    const double h = 1e-6;
+    std::vector<double3> forces(r.size());
+    auto rh = r;
+
+    for (size_t i = 0; i < r.size(); ++i)
+    {
+        double *forceComponents[3] = {&forces[i].x, &forces[i].y, &forces[i].z};
+        double *coordinates[3]     = {&rh[i].x, &rh[i].y, &rh[i].z};
+
+        for (int d = 0; d < 3; ++d)
+        {
+            const double x0 = *coordinates[d];
+
+            *coordinates[d] = x0 + h;
+            const double ep = bendingEnergy(rh, faces, kb);
+            *coordinates[d] = x0 - h;
+            const double em = bendingEnergy(rh, faces, kb);
+            *coordinates[d] = x0;
+
+            *forceComponents[d] = -(ep - em) / (2*h);
+        }
+    }
+    return forces;
+}
+
+struct ForcesOptions
+{
+    bool deterministic {false};
+    bool perObject     {false};
+    bool stressFree    {false};
+    bool juelicher     {false}; ///< Juelicher instead of Kantor bending
+    bool areaVolume    {false}; ///< switch on the global area and volume constraints
+    bool shear         {false}; ///< switch on the WLC shear and local area forces
+    float2 targetScale {1.f, 1.f}; ///< area and volume targets relative to the default ones
+};
+
+static constexpr float kb = 1.0f;
+
+/// only the bending forces switched on, and the area, volume and shear terms if requested
+static std::unique_ptr<MembraneInteraction> createBendingInteraction(const MirState *state, MembraneVector *ov, ForcesOptions options)
+{
+    // the targets are close to the area and volume of the spheres of radius 4
+    CommonMembraneParameters common;
+    common.ka = common.kv = options.areaVolume ? 100.f : 0.f;
+    common.gammaC = common.gammaT = 0.f;
+    common.kBT = 0.f;
+    common.totArea0   = 190.f * options.targetScale.x;
+    common.totVolume0 = 250.f * options.targetScale.y;
+    common.fluctuationForces = false;
+
+    WLCParameters wlc;
+    wlc.x0 = 0.5f;
+    wlc.ks = options.shear ? 1.f : 0.f;
+    wlc.mpow = 2.f;
+    wlc.kd = options.shear ? 1.f : 0.f;
+    wlc.totArea0 = common.totArea0;
+
+    KantorBendingParameters kantor;
+    kantor.kb = kb;
+    kantor.theta = 0.f;
+
+    JuelicherBendingParameters juelicher;
+    juelicher.kb = kb;
+    juelicher.C0 = 0.f;
+    juelicher.kad = 10.f * kb;
+    juelicher.DA0 = 0.f;
+
+    VarBendingParams bending = kantor;
+    if (options.juelicher)
+        bending = juelicher;
+
+    auto interaction = std::make_unique<MembraneInteraction>
+        (state, "membrane", common, bending, wlc,
+         options.stressFree, 0.f, options.deterministic, options.perObject);
+
+    interaction->setPrerequisites(ov, ov, nullptr, nullptr);
+    return interaction;
+}
+
+static void runForces(MembraneInteraction *interaction, MembraneVector *ov)
+{
+    ov->local()->forces().clear(defaultStream);
+    interaction->local(ov, ov, nullptr, nullptr, defaultStream);
+}
+
+static std::vector<float3> computeForces(MembraneInteraction *interaction, MembraneVector *ov)
+{
+    runForces(interaction, ov);
+
+    auto& forces = ov->local()->forces();
+    forces.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    std::vector<float3> result;
+    for (const auto& f : forces)
+        result.push_back(f.f);
+    return result;
+}
+
+static std::vector<float2> downloadAreaVolumes(MembraneVector *ov)
+{
+    auto areaVolumes = ov->local()->dataPerObject.getData<float2>(ChannelNames::areaVolumes);
+    areaVolumes->downloadFromDevice(defaultStream, ContainersSynch::Synch);
+    return {areaVolumes->begin(), areaVolumes->end()};
+}
+
+/// randomly perturbed spheres
+class Membranes
+{
+public:
+    Membranes(int nsubdivisions, int nObjects) :
+        domain{{32.f, 32.f, 32.f}, {0.f, 0.f, 0.f}, {32.f, 32.f, 32.f}},
+        state(domain, 0.f),
+        nObjects(nObjects)
+    {
+        const float radius = 4.f;
+        meshData = createSphereMesh(radius, nsubdivisions);
+        mesh = std::make_shared<MembraneMesh>(meshData.vertices, meshData.faces);
+        ov = std::make_unique<MembraneVector>(&state, "membranes", 1.f, mesh, nObjects);
+
+        std::mt19937 gen(4242);
+        std::uniform_real_distribution<float> noise(0.9f, 1.1f);
+
+        auto& pos = ov->local()->positions();
+        auto& vel = ov->local()->velocities();
+        const int nv = mesh->getNvertices();
+
+        for (int objId = 0; objId < nObjects; ++objId)
+        {
+            const float3 com {8.f + 8.f * (objId % 3), 16.f, 16.f};
+
+            for (int i = 0; i < nv; ++i)
+            {
+                const int pid = objId * nv + i;
+
+                Particle p;
+                p.r = com + noise(gen) * meshData.vertices[i];
+                p.u = make_float3(0.f);
+                p.setId(pid);
+                p.write2Float4(pos.hostPtr(), vel.hostPtr(), pid);
+            }
+        }
+        pos.uploadToDevice(defaultStream);
+        vel.uploadToDevice(defaultStream);
+    }
+
+    std::unique_ptr<MembraneInteraction> createInteraction(ForcesOptions options)
+    {
+        return createBendingInteraction(&state, ov.get(), options);
+    }
+
+    void run(MembraneInteraction *interaction)
+    {
+        runForces(interaction, ov.get());
+    }
+
+    std::vector<float3> computeForces(ForcesOptions options)
+    {
+        auto interaction = createInteraction(options);
+        return ::computeForces(interaction.get(), ov.get());
+    }
+
+    std::vector<float2> getAreaVolumes()
+    {
+        return downloadAreaVolumes(ov.get());
+    }
+
+    DomainInfo domain;
+    MirState state;
+    int nObjects;
+    MeshData meshData;
+    std::shared_ptr<MembraneMesh> mesh;
+    std::unique_ptr<MembraneVector> ov;
+};
+
+static float maxNorm(const std::vector<float3>& forces)
+{
+    float m = 0.f;
+    for (auto f : forces)
+        m = std::max(m, length(f));
+    return m;
+}
+
+static void expectBitEqual(const std::vector<float3>& f1, const std::vector<float3>& f2)
+{
+    ASSERT_EQ(f1.size(), f2.size());
+    for (size_t i = 0; i < f1.size(); ++i)
+    {
+        ASSERT_EQ(f1[i].x, f2[i].x);
+        ASSERT_EQ(f1[i].y, f2[i].y);
+        ASSERT_EQ(f1[i].z, f2[i].z);
+    }
+}
+
+static void expectClose(const std::vector<float3>& fref, const std::vector<float3>& f, float rtol)
+{
+    const float tol = rtol * maxNorm(fref);
+
+    ASSERT_EQ(fref.size(), f.size());
+    for (size_t i = 0; i < fref.size(); ++i)
+        ASSERT_LE(length(fref[i] - f[i]), tol) << "particle " << i;
+}
+
+class MembraneForcesTest : public ::testing::Test
+{
+protected:
+    MembraneForcesTest() :
+        membranes(1, 3)
+    {}
+
+    Membranes membranes;
+};
+
+TEST_F(MembraneForcesTest, ReverseAdjacencyIsConsistent)
+{
+    const auto& mesh = membranes.mesh;
+    const int maxDegree = mesh->getMaxDegree();
+
+    for (int v = 0; v < mesh->getNvertices(); ++v)
+    {
+        for (int i = 0; i < mesh->degrees[v]; ++i)
+        {
+            const int u = mesh->adjacent[v * maxDegree + i];
+            const int j = mesh->reverseAdjacent[v * maxDegree + i];
+            ASSERT_EQ(v, mesh->adjacent[u * maxDegree + j]);
+        }
+    }
+}
+
+TEST_F(MembraneForcesTest, GatherIsBitReproducible)
+{
+    ForcesOptions gather;
+    gather.deterministic = true;
+
+    expectBitEqual(membranes.computeForces(gather), membranes.computeForces(gather));
+
+    gather.perObject = true;
+    expectBitEqual(membranes.computeForces(gather), membranes.computeForces(gather));
+}
+
+TEST_F(MembraneForcesTest, GatherMatchesScatter)
+{
+    ForcesOptions gather;
+    gather.deterministic = true;
+
+    expectClose(membranes.computeForces({}), membranes.computeForces(gather), 1e-5f);
+}
+
+/// the total integrated curvature of the Juelicher energy is also summed in a fixed order
+TEST_F(MembraneForcesTest, JuelicherGatherIsBitReproducible)
+{
+    ForcesOptions gather;
+    gather.deterministic = true;
+    gather.juelicher = true;
+    gather.areaVolume = true;
+
+    expectBitEqual(membranes.computeForces(gather), membranes.computeForces(gather));
+
+    ForcesOptions scatter = gather;
+    scatter.deterministic = false;
+    expectClose(membranes.computeForces(scatter), membranes.computeForces(gather), 1e-5f);
+
+    gather.perObject = true;
+    expectBitEqual(membranes.computeForces(gather), membranes.computeForces(gather));
+}
+
+TEST_F(MembraneForcesTest, PerObjectMatchesPerVertex)
+{
+    ForcesOptions perVertex;
+    perVertex.areaVolume = true;
+
+    ForcesOptions perObject = perVertex;
+    perObject.perObject = true;
+
+    const auto fref = membranes.computeForces(perVertex);
+    const auto avref = membranes.getAreaVolumes();
+
+    const auto f = membranes.computeForces(perObject);
+    const auto av = membranes.getAreaVolumes();
+
+    expectClose(fref, f, 1e-5f);
+
+    ASSERT_EQ(avref.size(), av.size());
+    for (size_t i = 0; i < av.size(); ++i)
+    {
+        ASSERT_NEAR(avref[i].x, av[i].x, 1e-5f * avref[i].x);
+        ASSERT_NEAR(avref[i].y, av[i].y, 1e-5f * avref[i].y);
+    }
+}
+
+TEST_F(MembraneForcesTest, GatherMatchesHostReference)
+{
+    ForcesOptions gather;
+    gather.deterministic = true;
+
+    const auto fgather = membranes.computeForces(gather);
+    const float tol = 1e-3f * maxNorm(fgather);
+
+    const int nv = membranes.mesh->getNvertices();
+    const auto& pos = membranes.ov->local()->positions();
+
+    for (int objId = 0; objId < membranes.nObjects; ++objId)
+    {
+        std::vector<double3> r(nv);
+        for (int i = 0; i < nv; ++i)
+        {
+            const float4 p = pos[objId * nv + i];
+            r[i] = make_double3(p.x, p.y, p.z);
+        }
+
+        const auto fref = hostBendingForces(r, membranes.meshData.faces, kb);
+
+        for (int i = 0; i < nv; ++i)
+        {
+            const float3 f = fgather[objId * nv + i];
+            const float3 diff = f - make_float3(fref[i].x, fref[i].y, fref[i].z);
+            ASSERT_LE(length(diff), tol) << "object " << objId << ", vertex " << i;
+        }
+    }
+}
+
+/// objects of two sizes in one MembraneVector must get the forces they would get in separate vectors
+TEST (MembraneForces, mixed_mesh_types_match_single_types)
+{
+    const DomainInfo domain {{32.f, 32.f, 32.f}, {0.f, 0.f, 0.f}, {32.f, 32.f, 32.f}};
+    MirState state(domain, 0.f);
+
+    const std::vector<MeshData> meshData {createSphereMesh(4.f, 1), createSphereMesh(4.f, 2)};
+    std::vector<std::shared_ptr<MembraneMesh>> meshes;
+    for (const auto& m : meshData)
+        meshes.push_back(std::make_shared<MembraneMesh>(m.vertices, m.faces));
+
+    auto mixedMesh = std::make_shared<MembraneMesh>(meshes);
+    ASSERT_EQ(mixedMesh->getNtypes(), 2);
+    ASSERT_EQ(mixedMesh->getNvertices(), meshes[1]->getNvertices());
+
+    const std::vector<int> types {0, 1, 0, 1, 1};
+    const int nObjects = types.size();
+    const int objSize = mixedMesh->getNvertices();
+
+    ForcesOptions options;
+    options.stressFree = true;
+    options.areaVolume = true;
+    options.shear = true;
+
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<float> noise(0.9f, 1.1f);
+
+    MembraneVector mixed(&state, "mixed", 1.f, mixedMesh, nObjects);
+    std::vector<std::vector<float4>> objectPositions(nObjects);
+
+    auto& pos = mixed.local()->positions();
+    auto& vel = mixed.local()->velocities();
+    auto meshTypes = mixed.local()->dataPerObject.getData<int>(ChannelNames::meshTypes);
+
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        const float3 com {6.f + 5.f * objId, 16.f, 16.f};
+        const auto& vertices = meshData[types[objId]].vertices;
+
+        for (int i = 0; i < objSize; ++i)
+        {
+            const int pid = objId * objSize + i;
+
+            Particle p;
+            p.u = make_float3(0.f);
+            p.setId(pid);
+
+            if (i < static_cast<int>(vertices.size()))
+            {
+                p.r = com + noise(gen) * vertices[i];
+                objectPositions[objId].push_back(p.r2Float4());
+            }
+            else
+            {
+                p.mark();
+            }
+            p.write2Float4(pos.hostPtr(), vel.hostPtr(), pid);
+        }
+        (*meshTypes)[objId] = types[objId];
+    }
+    pos.uploadToDevice(defaultStream);
+    vel.uploadToDevice(defaultStream);
+    meshTypes->uploadToDevice(defaultStream);
+
+    auto mixedForces = computeForces(createBendingInteraction(&state, &mixed, options).get(), &mixed);
+    auto mixedAreaVolumes = downloadAreaVolumes(&mixed);
+
+    for (int type = 0; type < 2; ++type)
+    {
+        std::vector<int> objIds;
+        for (int objId = 0; objId < nObjects; ++objId)
+            if (types[objId] == type)
+                objIds.push_back(objId);
+
+        const int nv = meshes[type]->getNvertices();
+        MembraneVector single(&state, "single", 1.f, meshes[type], objIds.size());
+
+        auto& spos = single.local()->positions();
+        for (size_t k = 0; k < objIds.size(); ++k)
+            std::copy(objectPositions[objIds[k]].begin(), objectPositions[objIds[k]].end(), spos.begin() + k * nv);
+        spos.uploadToDevice(defaultStream);
+        single.local()->velocities().clear(defaultStream);
+
+        // the mixed vector constrains each type relative to its own stress-free area and volume
+        ForcesOptions singleOptions = options;
+        const float2 av  = meshes[type]->stressFreeAreaVolume;
+        const float2 av0 = meshes[0]  ->stressFreeAreaVolume;
+        singleOptions.targetScale = {av.x / av0.x, av.y / av0.y};
+
+        const auto forces = computeForces(createBendingInteraction(&state, &single, singleOptions).get(), &single);
+        const auto areaVolumes = downloadAreaVolumes(&single);
+        const float tol = 1e-5f * maxNorm(forces);
+
+        for (size_t k = 0; k < objIds.size(); ++k)
+        {
+            const int objId = objIds[k];
+
+            ASSERT_NEAR(mixedAreaVolumes[objId].x, areaVolumes[k].x, 1e-5f * areaVolumes[k].x);
+            ASSERT_NEAR(mixedAreaVolumes[objId].y, areaVolumes[k].y, 1e-5f * areaVolumes[k].y);
+
+            for (int i = 0; i < nv; ++i)
+                ASSERT_LE(length(mixedForces[objId * objSize + i] - forces[k * nv + i]), tol)
+                    << "object " << objId << ", vertex " << i;
+
+            // the placeholders do not feel any force
+            for (int i = nv; i < objSize; ++i)
+                ASSERT_EQ(length(mixedForces[objId * objSize + i]), 0.f);
+        }
+    }
+}
+
+/// the placeholders of the smaller objects must not make a wall remove them
+TEST (MembraneForces, mixed_mesh_types_are_not_removed_by_walls)
+{
+    const DomainInfo domain {{32.f, 32.f, 32.f}, {0.f, 0.f, 0.f}, {32.f, 32.f, 32.f}};
+    MirState state(domain, 0.f);
+
+    const std::vector<MeshData> meshData {createSphereMesh(4.f, 1), createSphereMesh(4.f, 2)};
+    std::vector<std::shared_ptr<MembraneMesh>> meshes;
+    for (const auto& m : meshData)
+        meshes.push_back(std::make_shared<MembraneMesh>(m.vertices, m.faces));
+
+    auto mixedMesh = std::make_shared<MembraneMesh>(meshes);
+
+    // the last object crosses the wall and must be the only one removed
+    const std::vector<int> types {0, 1, 0, 1};
+    const std::vector<float> comx {12.f, 18.f, 24.f, 4.f};
+    const int nObjects = types.size();
+    const int objSize = mixedMesh->getNvertices();
+
+    MembraneVector mixed(&state, "mixed", 1.f, mixedMesh, nObjects);
+
+    auto& pos = mixed.local()->positions();
+    auto& vel = mixed.local()->velocities();
+    auto meshTypes = mixed.local()->dataPerObject.getData<int>(ChannelNames::meshTypes);
+
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        // local coordinates
+        const float3 com {comx[objId] - 16.f, 0.f, 0.f};
+        const auto& vertices = meshData[types[objId]].vertices;
+
+        for (int i = 0; i < objSize; ++i)
+        {
+            const int pid = objId * objSize + i;
+
+            Particle p;
+            p.u = make_float3(0.f);
+            p.setId(pid);
+
+            if (i < static_cast<int>(vertices.size()))
+                p.r = com + vertices[i];
+            else
+                p.mark();
+            p.write2Float4(pos.hostPtr(), vel.hostPtr(), pid);
+        }
+        (*meshTypes)[objId] = types[objId];
+    }
+    pos.uploadToDevice(defaultStream);
+    vel.uploadToDevice(defaultStream);
+    meshTypes->uploadToDevice(defaultStream);
+
+    // everything below x = 2 is inside the wall, including the placeholders
+    SimpleStationaryWall<StationaryWall_Plane> wall("plane", &state,
+                                                     StationaryWall_Plane(make_float3(-1.f, 0.f, 0.f), make_float3(2.f, 0.f, 0.f)));
+    MPI_Comm comm = MPI_COMM_WORLD;
+    wall.setup(comm);
+    wall.removeInner(&mixed);
+
+    ASSERT_EQ(mixed.local()->nObjects, nObjects - 1);
+
+    meshTypes = mixed.local()->dataPerObject.getData<int>(ChannelNames::meshTypes);
+    meshTypes->downloadFromDevice(defaultStream);
+
+    std::vector<int> remainingTypes(meshTypes->begin(), meshTypes->end());
+    std::sort(remainingTypes.begin(), remainingTypes.end());
+    ASSERT_EQ(remainingTypes, std::vector<int>({0, 0, 1}));
+}
+
+static double timeForces(Membranes& membranes, ForcesOptions options, int nrepetitions)
+{
+    auto interaction = membranes.createInteraction(options);
+
+    // warm up
+    membranes.run(interaction.get());
+    CUDA_Check( cudaDeviceSynchronize() );
+
+    Timer timer;
+    timer.start();
+
+    for (int i = 0; i < nrepetitions; ++i)
+        membranes.run(interaction.get());
+
+    CUDA_Check( cudaDeviceSynchronize() );
+    timer.stop();
+
+    const double nvertices = membranes.nObjects * membranes.mesh->getNvertices();
+    return static_cast<double>(timer.elapsed()) / (nrepetitions * nvertices);
+}
+
+TEST (MembraneForces, per_object_benchmark)
+{
+    // no synchronization after each kernel
+    const int debugLvl = logger.getDebugLvl();
+    logger.setDebugLvl(1);
+
+    const int nrepetitions = 50;
+
+    printf("%10s %10s %24s %24s\n", "vertices", "objects", "per vertex [ns / vertex]", "per object [ns / vertex]");
+
+    // 642 and 2562 vertices
+    for (int nsubdivisions : {3, 4})
+    {
+        const int nObjects = 1 << (18 - 2 * nsubdivisions);
+        Membranes membranes(nsubdivisions, nObjects);
+
+        ForcesOptions perObject;
+        perObject.perObject = true;
+
+        const double tVertex = timeForces(membranes, {}, nrepetitions);
+        const double tObject = timeForces(membranes, perObject, nrepetitions);
+
+        printf("%10d %10d %24.3f %24.3f\n", membranes.mesh->getNvertices(), nObjects, tVertex, tObject);
+    }
+
+    logger.setDebugLvl(debugLvl);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "membrane_forces.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+// access the collision tables of the bouncer
+#define private   public
+#define protected public
+
+#include <core/bouncers/drivers/mesh.h>
+#include <core/bouncers/from_mesh.h>
+#include <core/celllist.h>
+#include <core/logger.h>
+#include <core/mesh/membrane.h>
+#include <core/pvs/membrane_vector.h>
+#include <core/pvs/particle_vector.h>
+#include <core/pvs/views/ov.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/helper_math.h>
+#include <core/utils/kernel_launch.h>
+
+#include "../sphere_mesh.h"
+
+Logger logger;
+
+using PairSet = std::set<std::pair<int,int>>;
+
+constexpr int nObjects = 2;
+constexpr int nParticles = 8000;
+
+static PairSet toSet(const int2 *pairs, int n)
+{
+    PairSet s;
+    for (int i = 0; i < n; ++i)
+        s.insert({pairs[i].x, pairs[i].y});
+    return s;
+}
+
+/// two moving spheres in a cloud of particles
+struct MeshBounceTest
+{
+    MeshBounceTest() :
+        state(DomainInfo{{24.f, 24.f, 24.f}, {0.f, 0.f, 0.f}, {24.f, 24.f, 24.f}}, 0.1f)
+    {
+        const auto data = createSphereMesh(3.f, 2);
+        mesh = std::make_shared<MembraneMesh>(data.vertices, data.faces);
+        ov = std::make_unique<MembraneVector>(&state, "spheres", 1.f, mesh, nObjects);
+
+        bouncer = std::make_unique<BounceFromMesh>(&state, "bounce", VarBounceKernel(BounceBack()));
+        bouncer->setup(ov.get());
+
+        std::mt19937 gen(4242);
+        std::uniform_real_distribution<float> u(-1.f, 1.f);
+
+        const int nv = mesh->getNvertices();
+        auto lov = ov->local();
+        auto& pos = lov->positions();
+        auto& vel = lov->velocities();
+        auto oldPos = lov->dataPerParticle.getData<float4>(ChannelNames::oldPositions);
+
+        const float3 centers[nObjects] = {{-4.f, 0.f, 0.f}, {4.f, 0.5f, 0.f}};
+
+        for (int objId = 0; objId < nObjects; ++objId)
+        {
+            for (int i = 0; i < nv; ++i)
+            {
+                const int pid = objId * nv + i;
+                const float3 r = centers[objId] + (1.f + 0.05f * u(gen)) * data.vertices[i];
+                const float3 dr = 0.1f * make_float3(u(gen), u(gen), u(gen));
+
+                Particle p;
+                p.r = r;
+                p.u = make_float3(0.f);
+                p.setId(pid);
+                p.write2Float4(pos.hostPtr(), vel.hostPtr(), pid);
+                (*oldPos)[pid] = make_float4(r - dr, 0.f);
+            }
+        }
+        pos.uploadToDevice(defaultStream);
+        vel.uploadToDevice(defaultStream);
+        oldPos->uploadToDevice(defaultStream);
+    }
+
+    /**
+     * particles displaced by at most maxDisplacement along each axis;
+     * returns the (particle, object triangle) collisions found by the bouncer and by brute force
+     */
+    std::pair<PairSet, PairSet> bounce(float maxDisplacement, long seed)
+    {
+        ParticleVector pv(&state, "particles", 1.f, nParticles);
+        bouncer->setPrerequisites(&pv);
+
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> u(-1.f, 1.f);
+
+        auto& pos = pv.local()->positions();
+        auto& vel = pv.local()->velocities();
+        for (int pid = 0; pid < nParticles; ++pid)
+        {
+            Particle p;
+            p.r = make_float3(9.f * u(gen), 5.f * u(gen), 5.f * u(gen));
+            p.u = make_float3(0.f);
+            p.setId(pid);
+            p.write2Float4(pos.hostPtr(), vel.hostPtr(), pid);
+        }
+        pos.uploadToDevice(defaultStream);
+        vel.uploadToDevice(defaultStream);
+
+        PrimaryCellList cl(&pv, 1.f, state.domain.localSize);
+        cl.build(defaultStream);
+
+        // the old positions are not reordered by the cell-list: set them after the build
+        const int np = pv.local()->size();
+        pos.downloadFromDevice(defaultStream);
+        auto oldPos = pv.local()->dataPerParticle.getData<float4>(ChannelNames::oldPositions);
+        for (int pid = 0; pid < np; ++pid)
+            (*oldPos)[pid] = pos[pid] - maxDisplacement * make_float4(u(gen), u(gen), u(gen), 0.f);
+        oldPos->uploadToDevice(defaultStream);
+
+        const auto bruteForce = bruteForceCollisions(&pv);
+
+        bouncer->bounceLocal(&pv, &cl, defaultStream);
+
+        auto& table = bouncer->fineTable;
+        table.nCollisions.downloadFromDevice(defaultStream);
+        std::vector<int2> found(table.nCollisions[0]);
+        if (!found.empty())
+            CUDA_Check( cudaMemcpy(found.data(), table.collisionTable.devPtr(), found.size() * sizeof(int2), cudaMemcpyDeviceToHost) );
+
+        return {toSet(found.data(), found.size()), bruteForce};
+    }
+
+    /// refine every (particle, triangle) pair
+    PairSet bruteForceCollisions(ParticleVector *pv)
+    {
+        const int np = pv->local()->size();
+        const int ntriangles = mesh->getNtriangles();
+
+        PinnedBuffer<int2> allPairs(np * nObjects * ntriangles);
+        for (int pid = 0, i = 0; pid < np; ++pid)
+            for (int objTrid = 0; objTrid < nObjects * ntriangles; ++objTrid)
+                allPairs[i++] = {pid, objTrid};
+        allPairs.uploadToDevice(defaultStream);
+
+        PinnedBuffer<int> nCollisions(1);
+        PinnedBuffer<int2> collisions(np * nObjects);
+        DeviceBuffer<int> collisionTimes(np);
+        nCollisions.clear(defaultStream);
+        collisionTimes.clear(defaultStream);
+
+        OVviewWithNewOldVertices vertexView(ov.get(), ov->local(), defaultStream);
+        PVviewWithOldParticles pvView(pv, pv->local());
+        MeshBounceKernels::TriangleTable table {static_cast<int>(collisions.size()), nCollisions.devPtr(), collisions.devPtr()};
+
+        const int nthreads = 128;
+        SAFE_KERNEL_LAUNCH(
+            MeshBounceKernels::refineCollisions,
+            getNblocks(allPairs.size(), nthreads), nthreads, 0, defaultStream,
+            vertexView, pvView, ov->mesh.get(),
+            allPairs.size(), allPairs.devPtr(),
+            table, collisionTimes.devPtr() );
+
+        nCollisions.downloadFromDevice(defaultStream);
+        collisions.downloadFromDevice(defaultStream);
+        EXPECT_LE(nCollisions[0], static_cast<int>(collisions.size()));
+
+        return toSet(collisions.hostPtr(), std::min(nCollisions[0], static_cast<int>(collisions.size())));
+    }
+
+    MirState state;
+    std::shared_ptr<MembraneMesh> mesh;
+    std::unique_ptr<MembraneVector> ov;
+    std::unique_ptr<BounceFromMesh> bouncer;
+};
+
+TEST (MeshBounce, candidates_match_brute_force)
+{
+    MeshBounceTest test;
+
+    // the table of candidates starts empty: the first search always grows it
+    ASSERT_EQ(static_cast<int>(test.bouncer->coarseTable.collisionTable.size()), 0);
+
+    const auto result = test.bounce(0.1f, 1);
+    ASSERT_FALSE(result.second.empty());
+    ASSERT_EQ(result.first, result.second);
+}
+
+TEST (MeshBounce, too_small_table_is_grown)
+{
+    MeshBounceTest test;
+
+    const auto few = test.bounce(0.02f, 2);
+    ASSERT_FALSE(few.second.empty());
+    ASSERT_EQ(few.first, few.second);
+
+    // larger displacements give more candidates than the table holds after the first step
+    const int previousSize = test.bouncer->coarseTable.collisionTable.size();
+
+    const auto many = test.bounce(0.1f, 3);
+    ASSERT_GT(many.second.size(), few.second.size());
+    ASSERT_EQ(many.first, many.second);
+    ASSERT_GT(static_cast<int>(test.bouncer->coarseTable.collisionTable.size()), previousSize);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "mesh_bounce.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -0,0 +1,149 @@
+#include <core/logger.h>
+#include <core/mesh/loader.h>
+#include <core/mesh/membrane.h>
+#include <core/utils/helper_math.h>
+
+#include "../sphere_mesh.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <utility>
+#include <vector>
+
+Logger logger;
+
+using Reordering = MembraneMesh::Reordering;
+
+static void writeOff(const std::string& fileName, const MeshData& mesh)
+{
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    if (rank == 0)
+    {
+        std::ofstream f(fileName);
+        f << "OFF\n" << mesh.vertices.size() << " " << mesh.faces.size() << " 0\n";
+        f.precision(9);
+
+        for (auto v : mesh.vertices)
+            f << v.x << " " << v.y << " " << v.z << "\n";
+        for (auto t : mesh.faces)
+            f << "3 " << t.x << " " << t.y << " " << t.z << "\n";
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+static void expectSameMeshes(const MembraneMesh& a, const MembraneMesh& b)
+{
+    ASSERT_EQ(a.getNvertices(),  b.getNvertices());
+    ASSERT_EQ(a.getNtriangles(), b.getNtriangles());
+    ASSERT_EQ(a.getMaxDegree(),  b.getMaxDegree());
+    ASSERT_EQ(a.getOriginalIds(), b.getOriginalIds());
+
+    for (int i = 0; i < a.getNtriangles(); ++i)
+    {
+        ASSERT_EQ(a.triangles[i].x, b.triangles[i].x);
+        ASSERT_EQ(a.triangles[i].y, b.triangles[i].y);
+        ASSERT_EQ(a.triangles[i].z, b.triangles[i].z);
+    }
+
+    const int maxDegree = a.getMaxDegree();
+
+    for (int v = 0; v < a.getNvertices(); ++v)
+    {
+        ASSERT_EQ(a.vertexCoordinates[v].x, b.vertexCoordinates[v].x);
+        ASSERT_EQ(a.vertexCoordinates[v].y, b.vertexCoordinates[v].y);
+        ASSERT_EQ(a.vertexCoordinates[v].z, b.vertexCoordinates[v].z);
+        ASSERT_EQ(a.degrees[v], b.degrees[v]);
+
+        // only the entries of the ring are set
+        for (int j = v * maxDegree; j < v * maxDegree + a.degrees[v]; ++j)
+        {
+            ASSERT_EQ(a.adjacent[j],           b.adjacent[j]);
+            ASSERT_EQ(a.reverseAdjacent[j],    b.reverseAdjacent[j]);
+            ASSERT_EQ(a.initialLengths[j],     b.initialLengths[j]);
+            ASSERT_EQ(a.initialAreas[j],       b.initialAreas[j]);
+            ASSERT_EQ(a.initialDotProducts[j], b.initialDotProducts[j]);
+        }
+    }
+
+    ASSERT_EQ(a.stressFreeAreaVolume.x, b.stressFreeAreaVolume.x);
+    ASSERT_EQ(a.stressFreeAreaVolume.y, b.stressFreeAreaVolume.y);
+}
+
+TEST (MeshLoader, off_file_gives_the_same_mesh)
+{
+    const auto data = createSphereMesh(4.f, 2);
+    writeOff("mesh_loader.off", data);
+
+    // the text round trip is exact with 9 digits
+    const MembraneMesh reference(data.vertices, data.faces);
+    auto mesh = MeshLoader::loadMembraneMesh("mesh_loader.off", Reordering::None);
+
+    expectSameMeshes(reference, *mesh);
+}
+
+TEST (MeshLoader, binary_round_trip_keeps_the_precomputed_quantities)
+{
+    const auto data = createSphereMesh(4.f, 2);
+
+    for (auto reordering : {Reordering::None, Reordering::ReverseCuthillMcKee})
+    {
+        const MembraneMesh reference(data.vertices, data.faces, reordering);
+        reference.writeBinary("mesh_loader.bin");
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        const auto contents = MeshLoader::readFile("mesh_loader.bin");
+        ASSERT_TRUE(MembraneMesh::isBinary(contents));
+
+        const MembraneMesh mesh("mesh_loader.bin", contents, Reordering::None);
+        expectSameMeshes(reference, mesh);
+    }
+}
+
+TEST (MeshLoader, off_file_is_not_binary)
+{
+    const auto data = createSphereMesh(4.f, 0);
+    writeOff("mesh_loader.off", data);
+
+    ASSERT_FALSE(MembraneMesh::isBinary(MeshLoader::readFile("mesh_loader.off")));
+}
+
+TEST (MeshLoader, identical_meshes_are_shared)
+{
+    const auto data = createSphereMesh(4.f, 1);
+    const auto other = createSphereMesh(4.f, 2);
+
+    auto a = MeshLoader::loadMembraneMesh(data.vertices, data.faces, Reordering::None);
+    auto b = MeshLoader::loadMembraneMesh(data.vertices, data.faces, Reordering::None);
+    auto c = MeshLoader::loadMembraneMesh(data.vertices, data.faces, Reordering::Hilbert);
+    auto d = MeshLoader::loadMembraneMesh(other.vertices, other.faces, Reordering::None);
+
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_NE(a, d);
+
+    // the same vertices as stress-free shape give the same quantities, but not the same kind of mesh
+    auto e = MeshLoader::loadMembraneMesh(data.vertices, data.vertices, data.faces, Reordering::None);
+    ASSERT_NE(a, e);
+    expectSameMeshes(*a, *e);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "mesh_loader.log", 9);
+
+    // read the files once per node
+    MeshLoader::setCommunicator(MPI_COMM_WORLD);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MeshLoader::setCommunicator(MPI_COMM_NULL);
+    MPI_Finalize();
+    return ret;
+}
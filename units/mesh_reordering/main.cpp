@@ -0,0 +1,211 @@
+#include <core/logger.h>
+#include <core/mesh/membrane.h>
+#include <core/mesh/reordering.h>
+#include <core/utils/helper_math.h>
+
+#include "../sphere_mesh.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+Logger logger;
+
+using MeshReordering::Method;
+
+// icosahedron subdivided nsubdivisions times, with the vertices in a random order
+static MeshData createShuffledSphereMesh(int nsubdivisions, long seed)
+{
+    auto mesh = createSphereMesh(1.f, nsubdivisions);
+
+    std::vector<int> order(mesh.vertices.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+
+    const auto newIds = MeshReordering::invert(order);
+    MeshReordering::permute(order, mesh.vertices);
+
+    for (auto& f : mesh.faces)
+        f = {newIds[f.x], newIds[f.y], newIds[f.z]};
+
+    return mesh;
+}
+
+static bool isPermutation(std::vector<int> order)
+{
+    std::sort(order.begin(), order.end());
+    for (int i = 0; i < static_cast<int>(order.size()); ++i)
+        if (order[i] != i) return false;
+    return true;
+}
+
+struct EdgeStats
+{
+    int bandwidth;      ///< largest index difference between two neighbours
+    double meanSpread;  ///< average index difference between two neighbours
+};
+
+static EdgeStats computeEdgeStats(const std::vector<int3>& faces, const std::vector<int>& newIds)
+{
+    EdgeStats stats {0, 0.0};
+    long count = 0;
+
+    auto edge = [&](int a, int b)
+    {
+        const int d = std::abs(newIds[a] - newIds[b]);
+        stats.bandwidth = std::max(stats.bandwidth, d);
+        stats.meanSpread += d;
+        ++count;
+    };
+
+    for (auto f : faces)
+    {
+        edge(f.x, f.y);
+        edge(f.y, f.z);
+        edge(f.z, f.x);
+    }
+
+    stats.meanSpread /= count;
+    return stats;
+}
+
+static const std::vector<Method> methods {Method::ReverseCuthillMcKee, Method::Hilbert};
+
+TEST (MeshReordering, order_is_a_permutation)
+{
+    const auto mesh = createShuffledSphereMesh(3, 4242);
+
+    for (auto method : methods)
+    {
+        const auto order = MeshReordering::computeOrder(method, mesh.vertices, mesh.faces);
+
+        ASSERT_EQ(order.size(), mesh.vertices.size());
+        ASSERT_TRUE(isPermutation(order));
+    }
+}
+
+TEST (MeshReordering, neighbours_get_close_indices)
+{
+    const auto mesh = createShuffledSphereMesh(3, 4242);
+
+    for (auto method : methods)
+    {
+        const int nvertices = mesh.vertices.size();
+        std::vector<int> identity(nvertices);
+        std::iota(identity.begin(), identity.end(), 0);
+
+        const auto order = MeshReordering::computeOrder(method, mesh.vertices, mesh.faces);
+
+        const auto before = computeEdgeStats(mesh.faces, identity);
+        const auto after  = computeEdgeStats(mesh.faces, MeshReordering::invert(order));
+
+        printf("%8s: bandwidth %4d -> %4d, mean spread %7.1f -> %7.1f\n",
+               MeshReordering::getMethodStr(method).c_str(),
+               before.bandwidth, after.bandwidth, before.meanSpread, after.meanSpread);
+
+        ASSERT_LT(after.meanSpread, 0.25 * before.meanSpread);
+
+        if (method == Method::ReverseCuthillMcKee)
+        {
+            ASSERT_LT(after.bandwidth, before.bandwidth / 4);
+        }
+    }
+}
+
+TEST (MeshReordering, membrane_mesh_records_the_original_order)
+{
+    const auto mesh = createShuffledSphereMesh(3, 4242);
+
+    for (auto method : methods)
+    {
+        const MembraneMesh reference(mesh.vertices, mesh.faces);
+        const MembraneMesh reordered(mesh.vertices, mesh.faces, method);
+
+        const int nvertices = reference.getNvertices();
+        const int maxDegree = reference.getMaxDegree();
+        const auto& originalIds = reordered.getOriginalIds();
+
+        ASSERT_EQ(reordered.getMaxDegree(), maxDegree);
+        ASSERT_EQ(static_cast<int>(originalIds.size()), nvertices);
+        ASSERT_TRUE(isPermutation(originalIds));
+
+        for (int i = 0; i < nvertices; ++i)
+        {
+            const int j = originalIds[i];
+            ASSERT_EQ(reordered.vertexCoordinates[i].x, reference.vertexCoordinates[j].x);
+            ASSERT_EQ(reordered.vertexCoordinates[i].y, reference.vertexCoordinates[j].y);
+            ASSERT_EQ(reordered.vertexCoordinates[i].z, reference.vertexCoordinates[j].z);
+            ASSERT_EQ(reordered.degrees[i], reference.degrees[j]);
+        }
+
+        // dumps use the input connectivity
+        const auto triangles = reordered.getOriginalTriangles();
+        ASSERT_EQ(triangles.size(), mesh.faces.size());
+
+        for (size_t i = 0; i < triangles.size(); ++i)
+        {
+            ASSERT_EQ(triangles[i].x, mesh.faces[i].x);
+            ASSERT_EQ(triangles[i].y, mesh.faces[i].y);
+            ASSERT_EQ(triangles[i].z, mesh.faces[i].z);
+        }
+    }
+}
+
+TEST (MeshReordering, stress_free_vertices_follow_the_reordering)
+{
+    const auto mesh = createShuffledSphereMesh(3, 4242);
+
+    for (auto method : methods)
+    {
+        std::vector<float3> stressFree = mesh.vertices;
+        std::mt19937 gen(1234);
+        std::uniform_real_distribution<float> noise(0.9f, 1.1f);
+        for (auto& r : stressFree)
+            r *= noise(gen);
+
+        const MembraneMesh reference(mesh.vertices, stressFree, mesh.faces);
+        const MembraneMesh reordered(mesh.vertices, stressFree, mesh.faces, method);
+
+        const int nvertices = reference.getNvertices();
+        const int maxDegree = reference.getMaxDegree();
+        const auto& originalIds = reordered.getOriginalIds();
+
+        // the rings keep their orientation, hence the same starting neighbour gives the same stress-free lengths
+        for (int i = 0; i < nvertices; ++i)
+        {
+            const int j = originalIds[i];
+            const int degree = reference.degrees[j];
+
+            const int first = originalIds[reordered.adjacent[i * maxDegree]];
+            const int *ring = &reference.adjacent[j * maxDegree];
+            const int shift = std::find(ring, ring + degree, first) - ring;
+            ASSERT_LT(shift, degree);
+
+            for (int k = 0; k < degree; ++k)
+            {
+                const int kref = j * maxDegree + (k + shift) % degree;
+                ASSERT_EQ(originalIds[reordered.adjacent[i * maxDegree + k]], reference.adjacent[kref]);
+                ASSERT_EQ(reordered.initialLengths[i * maxDegree + k], reference.initialLengths[kref]);
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "mesh_reordering.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
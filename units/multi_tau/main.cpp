@@ -0,0 +1,104 @@
+#include <core/logger.h>
+#include <plugins/utils/multi_tau.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+Logger logger;
+
+using namespace MultiTau;
+
+static const Layout layout {6, 8, 2};
+
+TEST (MultiTau, ConstantSignalProduct)
+{
+    const double c[2] = {2.0, -1.0};
+    Correlator corr(layout, 2, Kind::Product);
+
+    for (int i = 0; i < 1000; ++i)
+        corr.push(c);
+
+    const auto& sums   = corr.getSums();
+    const auto& counts = corr.getCounts();
+
+    for (int l = 0; l < layout.nlevels; ++l)
+        for (int k = layout.firstLag(l); k < layout.npoints; ++k)
+        {
+            const int i = l * layout.npoints + k;
+            ASSERT_GT(counts[i], 0);
+            ASSERT_NEAR(sums[i] / counts[i], 5.0, 1e-12);
+        }
+}
+
+TEST (MultiTau, LinearSignalSquaredDifference)
+{
+    // block averages of a linear signal are exact: the squared difference is the squared lag
+    Correlator corr(layout, 1, Kind::SquaredDifference);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        const double x = i;
+        corr.push(&x);
+    }
+
+    const auto& sums   = corr.getSums();
+    const auto& counts = corr.getCounts();
+
+    for (int l = 0; l < layout.nlevels; ++l)
+        for (int k = layout.firstLag(l); k < layout.npoints; ++k)
+        {
+            const int i = l * layout.npoints + k;
+            const double lag = layout.lag(l, k);
+            ASSERT_GT(counts[i], 0);
+            ASSERT_NEAR(sums[i] / counts[i], lag * lag, 1e-9 * (1 + lag * lag));
+        }
+}
+
+TEST (MultiTau, FirstLevelIsExact)
+{
+    const int n = 500;
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<double> udistr(-1.0, 1.0);
+
+    std::vector<double> x(n);
+    for (auto& v : x)
+        v = udistr(gen);
+
+    Correlator corr(layout, 1, Kind::Product);
+    for (auto& v : x)
+        corr.push(&v);
+
+    for (int k = 0; k < layout.npoints; ++k)
+    {
+        double ref = 0;
+        for (int i = k; i < n; ++i)
+            ref += x[i] * x[i-k];
+
+        ASSERT_EQ(corr.getCounts()[k], n - k);
+        ASSERT_NEAR(corr.getSums()[k], ref, 1e-9);
+    }
+}
+
+TEST (MultiTau, ScheduleLevels)
+{
+    Schedule schedule(layout);
+
+    for (int s = 1; s <= 64; ++s)
+    {
+        const auto& levels = schedule.push();
+
+        int expected = 0;
+        for (int period = 1; expected < layout.nlevels && s % period == 0; period *= layout.averaging)
+            ++expected;
+
+        ASSERT_EQ(levels.size(), expected);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
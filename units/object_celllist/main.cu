@@ -0,0 +1,105 @@
+#include "../packers/common.h"
+
+#include <core/logger.h>
+#include <core/object_celllist.h>
+#include <core/pvs/views/ov.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+Logger logger;
+
+using PairSet = std::set<std::pair<int,int>>;
+
+static PairSet findPairsBruteForce(ObjectVector *ov, float margin)
+{
+    auto& extents = *ov->local()->dataPerObject.getData<COMandExtent>(ChannelNames::comExtents);
+    extents.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    auto overlap = [](float lo0, float hi0, float lo1, float hi1) {return lo0 <= hi1 && lo1 <= hi0;};
+
+    PairSet pairs;
+    for (int i = 0; i < ov->local()->nObjects; ++i)
+        for (int j = i + 1; j < ov->local()->nObjects; ++j)
+        {
+            const auto a = extents[i], b = extents[j];
+
+            if (overlap(a.low.x - margin, a.high.x + margin, b.low.x, b.high.x) &&
+                overlap(a.low.y - margin, a.high.y + margin, b.low.y, b.high.y) &&
+                overlap(a.low.z - margin, a.high.z + margin, b.low.z, b.high.z))
+                pairs.insert({i, j});
+        }
+    return pairs;
+}
+
+static PairSet findPairs(ObjectVector *ov, float rc, float margin)
+{
+    ObjectCellList cl(ov, rc, ov->state->domain.localSize);
+    cl.build(ParticleVectorLocality::Local, defaultStream);
+    const int n = cl.findOverlappingPairs(margin, defaultStream);
+
+    PinnedBuffer<int2> pairs(n);
+    if (n > 0)
+        CUDA_Check( cudaMemcpy(pairs.hostPtr(), cl.getPairs().devPtr(), n * sizeof(int2), cudaMemcpyDeviceToHost) );
+
+    PairSet result;
+    for (int i = 0; i < n; ++i)
+    {
+        EXPECT_LT(pairs[i].x, pairs[i].y);
+        result.insert({pairs[i].x, pairs[i].y});
+    }
+
+    // each pair is found once
+    EXPECT_EQ(static_cast<int>(result.size()), n);
+    return result;
+}
+
+static void testPairs(int nObjects, float margin)
+{
+    const float3 L {32.f, 32.f, 32.f};
+    const DomainInfo domain {L, {0.f, 0.f, 0.f}, L};
+    MirState state(domain, /* dt */ 0.f);
+
+    const int objSize = 32;
+    auto ov = initializeRandomREV(MPI_COMM_WORLD, &state, nObjects, objSize);
+
+    // cells smaller and larger than the objects
+    for (float rc : {0.5f, 2.f, 5.f})
+    {
+        const auto pairs = findPairs(ov.get(), rc, margin);
+        const auto reference = findPairsBruteForce(ov.get(), margin);
+
+        ASSERT_EQ(pairs, reference) << "cell size " << rc;
+    }
+}
+
+TEST (ObjectCellList, pairs_without_margin)
+{
+    testPairs(1000, 0.f);
+}
+
+TEST (ObjectCellList, pairs_with_margin)
+{
+    testPairs(2000, 0.5f);
+}
+
+TEST (ObjectCellList, no_objects)
+{
+    testPairs(0, 1.f);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "object_celllist.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
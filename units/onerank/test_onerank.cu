@@ -253,7 +253,7 @@ void execute(float3 length, int niters, double& l2, double& linf)
     std::copy(vel.begin(), vel.end(), velocities.begin());
 
     auto haloExchanger = std::make_unique<ParticleHaloExchanger>();
-    haloExchanger->attach(&pv, &cells, {});
+    haloExchanger->attach(&pv, &cells, rc, {});
     SingleNodeEngine haloEngine(std::move(haloExchanger));
 
     auto redistributor = std::make_unique<ParticleRedistributor>();
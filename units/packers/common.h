@@ -7,9 +7,14 @@
 #include <core/initial_conditions/uniform.h>
 #include <core/pvs/rigid_ashape_object_vector.h>
 #include <core/pvs/rod_vector.h>
+#include <core/rigid/utils.h>
 
+#include <gtest/gtest.h>
+
+#include <algorithm>
 #include <memory>
 #include <random>
+#include <tuple>
 #include <vector>
 
 std::unique_ptr<ParticleVector>
@@ -83,6 +88,79 @@ initializeRandomREV(const MPI_Comm& comm, const MirState *state, int nObjs, int
     return rev;
 }
 
+// random orientations and velocities of the rigid objects, the particles follow the motions
+inline void setRandomMotions(RigidObjectVector *rov, long seed = 4242)
+{
+    auto lrov = rov->local();
+    auto& pos = lrov->positions();
+    auto& vel = lrov->velocities();
+    auto& mot = *lrov->dataPerObject.getData<RigidMotion>(ChannelNames::motions);
+    const int objSize = lrov->objSize;
+
+    pos.downloadFromDevice(defaultStream);
+    vel.downloadFromDevice(defaultStream);
+    mot.downloadFromDevice(defaultStream);
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> u(-1.f, 1.f);
+
+    for (size_t objId = 0; objId < mot.size(); ++objId)
+    {
+        auto& m = mot[objId];
+        m.q     = make_rigidReal4(normalize(make_float4(u(gen), u(gen), u(gen), u(gen))));
+        m.vel   = make_rigidReal3(make_float3(u(gen), u(gen), u(gen)));
+        m.omega = make_rigidReal3(make_float3(u(gen), u(gen), u(gen)));
+
+        const auto motion = toSingleMotion(m);
+
+        for (int i = 0; i < objSize; ++i)
+        {
+            const int pid = objId * objSize + i;
+            Particle p(pos[pid], vel[pid]);
+            p.r = rigidParticlePosition(motion, make_float3(rov->initialPositions[i]));
+            p.u = rigidParticleVelocity(motion, p.r);
+            p.write2Float4(pos.hostPtr(), vel.hostPtr(), pid);
+        }
+    }
+
+    pos.uploadToDevice(defaultStream);
+    vel.uploadToDevice(defaultStream);
+    mot.uploadToDevice(defaultStream);
+}
+
+// particles sorted by id, then by position for the several halo copies of one particle
+inline std::vector<Particle> sortedParticles(const PinnedBuffer<float4>& pos, const PinnedBuffer<float4>& vel)
+{
+    std::vector<Particle> particles;
+    for (size_t i = 0; i < pos.size(); ++i)
+        particles.push_back(Particle(pos[i], vel[i]));
+
+    std::sort(particles.begin(), particles.end(), [](const Particle& a, const Particle& b)
+    {
+        return std::make_tuple(a.getId(), a.r.x, a.r.y, a.r.z) <
+               std::make_tuple(b.getId(), b.r.x, b.r.y, b.r.z);
+    });
+    return particles;
+}
+
+inline void compareParticles(const std::vector<Particle>& ref, const std::vector<Particle>& res, float tol)
+{
+    ASSERT_EQ(ref.size(), res.size());
+
+    for (size_t i = 0; i < ref.size(); ++i)
+    {
+        ASSERT_EQ(ref[i].getId(), res[i].getId()) << "particle " << i;
+
+        ASSERT_NEAR(ref[i].r.x, res[i].r.x, tol) << "particle " << i;
+        ASSERT_NEAR(ref[i].r.y, res[i].r.y, tol) << "particle " << i;
+        ASSERT_NEAR(ref[i].r.z, res[i].r.z, tol) << "particle " << i;
+
+        ASSERT_NEAR(ref[i].u.x, res[i].u.x, tol) << "particle " << i;
+        ASSERT_NEAR(ref[i].u.y, res[i].u.y, tol) << "particle " << i;
+        ASSERT_NEAR(ref[i].u.z, res[i].u.z, tol) << "particle " << i;
+    }
+}
+
 std::unique_ptr<RodVector>
 initializeRandomRods(const MPI_Comm& comm, const MirState *state, int nObjs, int numSegments)
 {
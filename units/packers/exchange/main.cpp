@@ -146,7 +146,7 @@ TEST (PACKERS_EXCHANGE, particles)
     cl->build(defaultStream);
     
     auto exch = std::make_unique<ParticleHaloExchanger>();
-    exch->attach(pv.get(), cl.get(), {});
+    exch->attach(pv.get(), cl.get(), rc, {});
 
     auto engine = std::make_unique<SingleNodeEngine>(std::move(exch));
 
@@ -475,6 +475,48 @@ TEST (PACKERS_EXCHANGE, objects_extra_exchange)
 }
 
 
+// the particles of the rigid objects placed back from the motions must match the ones sent with the generic packer
+TEST (PACKERS_EXCHANGE, rigid_objects_from_motions)
+{
+    float dt = 0.f;
+    float rc = 1.f;
+    float L  = 48.f;
+    int nObjs = 1024;
+    int objSize = 555;
+
+    DomainInfo domain;
+    domain.globalSize  = {L, L, L};
+    domain.globalStart = {0.f, 0.f, 0.f};
+    domain.localSize   = {L, L, L};
+    MirState state(domain, dt);
+
+    std::vector<Particle> halos[2];
+
+    for (bool fromMotions : {false, true})
+    {
+        auto rev = initializeRandomREV(MPI_COMM_WORLD, &state, nObjs, objSize);
+        setRandomMotions(rev.get());
+
+        auto exchanger = std::make_unique<ObjectHaloExchanger>();
+        exchanger->attach(rev.get(), rc, {}, false, fromMotions);
+
+        auto engineExchange = std::make_unique<SingleNodeEngine>(std::move(exchanger));
+
+        engineExchange->init(defaultStream);
+        engineExchange->finalize(defaultStream);
+
+        auto hrev = rev->halo();
+        hrev->positions ().downloadFromDevice(defaultStream);
+        hrev->velocities().downloadFromDevice(defaultStream);
+
+        halos[fromMotions] = sortedParticles(hrev->positions(), hrev->velocities());
+    }
+
+    ASSERT_FALSE(halos[0].empty());
+    compareParticles(halos[0], halos[1], 1e-5f);
+}
+
+
 int main(int argc, char **argv)
 {
     MPI_Init(&argc, &argv);
@@ -434,6 +434,54 @@ TEST (PACKERS_REDISTRIBUTE, rods)
 }
 
 
+// the particles of the rigid objects placed back from the motions must match the ones sent with the generic packer
+TEST (PACKERS_REDISTRIBUTE, rigid_objects_from_motions)
+{
+    float dt = 0.f;
+    float L  = 64.f;
+    int nObjs = 128;
+    int objSize = 555;
+
+    DomainInfo domain;
+    domain.globalSize  = {L, L, L};
+    domain.globalStart = {0.f, 0.f, 0.f};
+    domain.localSize   = {L, L, L};
+    MirState state(domain, dt);
+
+    std::vector<Particle> locals[2];
+
+    for (bool fromMotions : {false, true})
+    {
+        auto rev = initializeRandomREV(MPI_COMM_WORLD, &state, nObjs, objSize);
+        setRandomMotions(rev.get());
+
+        auto lrev = rev->local();
+        auto& pos = lrev->positions();
+        auto& vel = lrev->velocities();
+        auto& mot = *lrev->dataPerObject.getData<RigidMotion>(ChannelNames::motions);
+
+        moveObjects(domain.localSize, pos, mot);
+
+        auto redistr = std::make_unique<ObjectRedistributor>();
+        redistr->attach(rev.get(), fromMotions);
+
+        auto engine = std::make_unique<SingleNodeEngine>(std::move(redistr));
+
+        engine->init(defaultStream);
+        engine->finalize(defaultStream);
+
+        pos.downloadFromDevice(defaultStream);
+        vel.downloadFromDevice(defaultStream);
+
+        checkInsideObjects(objSize, pos, domain.localSize);
+        locals[fromMotions] = sortedParticles(pos, vel);
+    }
+
+    ASSERT_EQ(static_cast<int>(locals[0].size()), nObjs * objSize);
+    compareParticles(locals[0], locals[1], 1e-5f);
+}
+
+
 int main(int argc, char **argv)
 {
     MPI_Init(&argc, &argv);
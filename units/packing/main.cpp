@@ -0,0 +1,204 @@
+#include <core/domain.h>
+#include <core/initial_conditions/object_positions.h>
+#include <core/initial_conditions/packing.h>
+#include <core/logger.h>
+#include <core/utils/cuda_common.h>
+#include <core/utils/helper_math.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+Logger logger;
+
+static MPI_Comm createCart(MPI_Comm comm = MPI_COMM_WORLD)
+{
+    int nranks;
+    MPI_Check( MPI_Comm_size(comm, &nranks) );
+
+    int dims[] = {0, 0, 0};
+    const int periods[] = {1, 1, 1};
+    constexpr int reorder = 0;
+    MPI_Check( MPI_Dims_create(nranks, 3, dims) );
+
+    MPI_Comm cart;
+    MPI_Check( MPI_Cart_create(comm, 3, dims, periods, reorder, &cart) );
+    return cart;
+}
+
+static std::vector<ComQ> gatherAll(MPI_Comm comm, const std::vector<ComQ>& local)
+{
+    int nranks;
+    MPI_Check( MPI_Comm_size(comm, &nranks) );
+
+    const int n = local.size() * 7;
+    std::vector<int> counts(nranks), displs(nranks);
+    MPI_Check( MPI_Allgather(&n, 1, MPI_INT, counts.data(), 1, MPI_INT, comm) );
+
+    int total = 0;
+    for (int i = 0; i < nranks; ++i)
+    {
+        displs[i] = total;
+        total += counts[i];
+    }
+
+    std::vector<float> send, recv(total);
+    for (const auto& o : local)
+        send.insert(send.end(), {o.r.x, o.r.y, o.r.z, o.q.x, o.q.y, o.q.z, o.q.w});
+
+    MPI_Check( MPI_Allgatherv(send.data(), n, MPI_FLOAT, recv.data(), counts.data(), displs.data(), MPI_FLOAT, comm) );
+
+    std::vector<ComQ> all;
+    for (int i = 0; i < total; i += 7)
+        all.push_back({{recv[i], recv[i+1], recv[i+2]}, {recv[i+3], recv[i+4], recv[i+5], recv[i+6]}});
+
+    std::sort(all.begin(), all.end(), [](const ComQ& a, const ComQ& b)
+    {
+        return std::make_tuple(a.r.x, a.r.y, a.r.z) < std::make_tuple(b.r.x, b.r.y, b.r.z);
+    });
+    return all;
+}
+
+static int countOverlaps(const std::vector<ComQ>& objects, float3 axes, float scale, float3 L)
+{
+    int n = 0;
+    for (size_t i = 0; i < objects.size(); ++i)
+        for (size_t j = i + 1; j < objects.size(); ++j)
+        {
+            // closest periodic image
+            ComQ b = objects[j];
+            const float3 d = b.r - objects[i].r;
+            b.r -= L * make_float3(std::round(d.x / L.x), std::round(d.y / L.y), std::round(d.z / L.z));
+
+            if (ObjectPacking::overlap(axes, scale, objects[i], b))
+                ++n;
+        }
+    return n;
+}
+
+static const float4 identity {1.f, 0.f, 0.f, 0.f};
+
+TEST (Packing, overlap_of_spheres)
+{
+    const float3 axes {1.f, 1.f, 1.f};
+    const ComQ a {{0.f, 0.f, 0.f}, identity};
+
+    ASSERT_TRUE (ObjectPacking::overlap(axes, 1.0f, a, {{1.9f, 0.0f, 0.0f}, identity}));
+    ASSERT_FALSE(ObjectPacking::overlap(axes, 1.0f, a, {{2.1f, 0.0f, 0.0f}, identity}));
+    ASSERT_TRUE (ObjectPacking::overlap(axes, 1.0f, a, {{1.2f, 1.2f, 0.0f}, identity}));
+    ASSERT_FALSE(ObjectPacking::overlap(axes, 0.8f, a, {{1.2f, 1.2f, 0.0f}, identity}));
+}
+
+TEST (Packing, overlap_of_ellipsoids_depends_on_orientation)
+{
+    const float3 axes {3.f, 1.f, 1.f};
+    const ComQ a {{0.f, 0.f, 0.f}, identity};
+
+    // side by side
+    ASSERT_FALSE(ObjectPacking::overlap(axes, 1.0f, a, {{0.0f, 2.1f, 0.0f}, identity}));
+    ASSERT_TRUE (ObjectPacking::overlap(axes, 1.0f, a, {{0.0f, 1.9f, 0.0f}, identity}));
+
+    // tip to tip
+    ASSERT_FALSE(ObjectPacking::overlap(axes, 1.0f, a, {{6.1f, 0.0f, 0.0f}, identity}));
+    ASSERT_TRUE (ObjectPacking::overlap(axes, 1.0f, a, {{5.9f, 0.0f, 0.0f}, identity}));
+
+    // the second one rotated by 90 degrees about z: its long axis points towards the first one
+    const float s = std::sqrt(0.5f);
+    const float4 rotz {s, 0.f, 0.f, s};
+    ASSERT_TRUE (ObjectPacking::overlap(axes, 1.0f, a, {{0.0f, 3.5f, 0.0f}, rotz}));
+    ASSERT_FALSE(ObjectPacking::overlap(axes, 1.0f, a, {{0.0f, 4.1f, 0.0f}, rotz}));
+}
+
+TEST (Packing, objects_are_local_and_do_not_overlap)
+{
+    auto cart = createCart();
+    const float3 L {48.f, 48.f, 48.f};
+    const auto domain = createDomainInfo(cart, L);
+
+    const float3 axes {2.f, 1.f, 1.f};
+    const float numberDensity = 0.02f;
+    const ObjectPacking packing(axes, numberDensity);
+
+    const auto result = packing.generate(cart, domain);
+    ASSERT_EQ(result.scale, 1.0f);
+
+    for (const auto& o : result.com_q)
+        ASSERT_TRUE(domain.inSubDomain(o.r));
+
+    const auto all = gatherAll(cart, result.com_q);
+    ASSERT_EQ(countOverlaps(all, axes, 1.0f, L), 0);
+
+    // dilute enough for all the objects to be placed
+    const float expected = numberDensity * L.x * L.y * L.z;
+    ASSERT_NEAR(all.size(), expected, 0.1f * expected);
+
+    MPI_Check( MPI_Comm_free(&cart) );
+}
+
+TEST (Packing, growth_removes_the_overlaps)
+{
+    auto cart = createCart();
+    const float3 L {32.f, 32.f, 32.f};
+    const auto domain = createDomainInfo(cart, L);
+
+    const float3 axes {1.5f, 1.5f, 0.75f};
+    const float numberDensity = 0.05f;
+    const ObjectPacking packing(axes, numberDensity, 0.5f, 5);
+
+    const auto result = packing.generate(cart, domain);
+    ASSERT_GT(result.scale, 0.5f);
+
+    const auto all = gatherAll(cart, result.com_q);
+    ASSERT_EQ(countOverlaps(all, axes, result.scale, L), 0);
+
+    MPI_Check( MPI_Comm_free(&cart) );
+}
+
+TEST (Packing, file_round_trip)
+{
+    auto cart = createCart();
+    const float3 L {24.f, 24.f, 24.f};
+    const auto domain = createDomainInfo(cart, L);
+
+    const ObjectPacking packing({1.f, 1.f, 1.f}, 0.05f);
+    const auto result = packing.generate(cart, domain);
+
+    ObjectPositions::write(cart, "packing.comq", result.com_q, 0.75f);
+    const auto local = ObjectPositions::readLocal(cart, domain, "packing.comq");
+
+    ASSERT_EQ(local.scale, 0.75f);
+
+    for (const auto& o : local.com_q)
+        ASSERT_TRUE(domain.inSubDomain(o.r));
+
+    ASSERT_EQ(local.com_q.size(), result.com_q.size());
+
+    const auto written = gatherAll(cart, result.com_q);
+    const auto read    = gatherAll(cart, local.com_q);
+    ASSERT_EQ(written.size(), read.size());
+
+    for (size_t i = 0; i < written.size(); ++i)
+    {
+        ASSERT_EQ(written[i].r.x, read[i].r.x);
+        ASSERT_EQ(written[i].r.y, read[i].r.y);
+        ASSERT_EQ(written[i].r.z, read[i].r.z);
+        ASSERT_EQ(written[i].q.x, read[i].q.x);
+        ASSERT_EQ(written[i].q.w, read[i].q.w);
+    }
+
+    MPI_Check( MPI_Comm_free(&cart) );
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "packing.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
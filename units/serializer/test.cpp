@@ -3,6 +3,7 @@
 #include <core/logger.h>
 #include <plugins/utils/simple_serializer.h>
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstdio>
@@ -90,6 +91,65 @@ TEST(Serializer, Mixed)
 
 }
 
+TEST(Serializer, SegmentsHaveSameBytes)
+{
+    float s1 = 1;
+    double s2 = 42.0;
+    std::vector<int> s3(1000);
+    std::vector<std::string> s4{"density", "velocity"};
+    std::vector<std::vector<float>> s5{std::vector<float>(500, 3.f), std::vector<float>(2, 5.f), {}};
+    HostBuffer<float4> s6(300);
+
+    for (size_t i = 0; i < s3.size(); ++i) s3[i] = i;
+    for (size_t i = 0; i < s6.size(); ++i) s6[i] = make_float4(i, 2*i, 3*i, 4*i);
+
+    std::vector<char> buf;
+    SegmentedMessage msg;
+    SimpleSerializer::serialize        (buf, s1, s2, s3, s4, s5, s6);
+    SimpleSerializer::serializeSegments(msg, s1, s2, s3, s4, s5, s6);
+
+    ASSERT_EQ(msg.size(), buf.size());
+
+    // the large containers are referenced, not copied
+    const auto segments = msg.segments();
+    ASSERT_TRUE(std::any_of(segments.begin(), segments.end(),
+                            [&](const SegmentedMessage::Segment& s) { return s.ptr == (const char*) s3.data(); }));
+    
+    std::vector<char> gathered(msg.size());
+    msg.gather(gathered.data());
+    ASSERT_EQ(gathered, buf);
+}
+
+TEST(Serializer, Views)
+{
+    double s1 = 42.0, d1;
+    std::vector<float4> s2{make_float4(1, 2, 3, 4), make_float4(5, 6, 7, 8), make_float4(9, 10, 11, 12)};
+    std::vector<std::vector<float>> s3{{1.f, 2.f}, {}, {3.f, 4.f, 5.f}};
+    std::string s4{"end"}, d4;
+    std::vector<char> buf;
+
+    SerializedArrayView<float4> d2;
+    std::vector<SerializedArrayView<float>> d3;
+
+    SimpleSerializer::serialize  (buf, s1, s2, s3, s4);
+    SimpleSerializer::deserialize(buf, d1, d2, d3, d4);
+
+    myassert(s1 == d1, "mismatch on 1");
+    myassert(s4 == d4, "mismatch on 4");
+
+    ASSERT_EQ(d2.size(), s2.size());
+    for (int i = 0; i < d2.size(); ++i)
+        myassert(d2[i].x == s2[i].x && d2[i].w == s2[i].w, "mismatch on 2[" + std::to_string(i) + "]");
+
+    ASSERT_EQ(d3.size(), s3.size());
+    for (size_t i = 0; i < s3.size(); ++i)
+    {
+        std::vector<float> copy;
+        d3[i].appendTo(copy);
+        myassert(copy == s3[i], "mismatch on 3[" + std::to_string(i) + "]");
+    }
+}
+
 int main(int argc, char **argv)
 {
     MPI_Init(&argc, &argv);
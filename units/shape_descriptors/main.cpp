@@ -0,0 +1,99 @@
+#include <core/logger.h>
+#include <plugins/utils/shape_descriptors.h>
+
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+
+Logger logger;
+
+using namespace ShapeDescriptors;
+
+// R diag(l) R^T, with R the rotation of angle theta around z followed by phi around x
+static SymmetricMatrix rotatedDiagonal(double3 l, double theta, double phi)
+{
+    double R[3][3];
+    const double ct = cos(theta), st = sin(theta);
+    const double cp = cos(phi),   sp = sin(phi);
+
+    const double Rz[3][3] = {{ct, -st, 0}, {st, ct, 0}, {0, 0, 1}};
+    const double Rx[3][3] = {{1, 0, 0}, {0, cp, -sp}, {0, sp, cp}};
+
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+        {
+            R[i][j] = 0;
+            for (int k = 0; k < 3; ++k)
+                R[i][j] += Rx[i][k] * Rz[k][j];
+        }
+
+    const double d[3] = {l.x, l.y, l.z};
+    double G[3][3];
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+        {
+            G[i][j] = 0;
+            for (int k = 0; k < 3; ++k)
+                G[i][j] += R[i][k] * d[k] * R[j][k];
+        }
+
+    return {G[0][0], G[0][1], G[0][2], G[1][1], G[1][2], G[2][2]};
+}
+
+TEST (ShapeDescriptors, EigenvaluesOfRotatedMatrices)
+{
+    const double3 l {4.0, 2.0, 1.0};
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto m = rotatedDiagonal(l, angle(gen), angle(gen));
+        const auto e = eigenvalues(m);
+
+        ASSERT_NEAR(e.x, l.x, 1e-9);
+        ASSERT_NEAR(e.y, l.y, 1e-9);
+        ASSERT_NEAR(e.z, l.z, 1e-9);
+
+        const auto v = eigenvector(m, e.x);
+        const double3 Gv {m.xx*v.x + m.xy*v.y + m.xz*v.z,
+                          m.xy*v.x + m.yy*v.y + m.yz*v.z,
+                          m.xz*v.x + m.yz*v.y + m.zz*v.z};
+
+        ASSERT_NEAR(length(Gv - e.x * v), 0.0, 1e-9);
+    }
+}
+
+TEST (ShapeDescriptors, EllipsoidInShearPlane)
+{
+    const double3 l {4.0, 2.0, 1.0};
+    const double theta = 0.3;
+
+    const auto s = describe(rotatedDiagonal(l, theta, 0.0), 1.f, 2.f);
+
+    ASSERT_NEAR(s.angle, theta, 1e-5);
+    ASSERT_NEAR(s.taylor, (2.0 - 1.0) / (2.0 + 1.0), 1e-6);
+    ASSERT_NEAR(s.asphericity, (4.0 + 1.0 + 9.0) / (2.0 * 49.0), 1e-6);
+    ASSERT_EQ(s.area,   1.f);
+    ASSERT_EQ(s.volume, 2.f);
+
+    // the orientation is folded into (-pi/2, pi/2]
+    const auto flipped = describe(rotatedDiagonal(l, theta + M_PI, 0.0), 1.f, 2.f);
+    ASSERT_NEAR(flipped.angle, theta, 1e-5);
+}
+
+TEST (ShapeDescriptors, Sphere)
+{
+    const auto s = describe({1.0, 0.0, 0.0, 1.0, 0.0, 1.0}, 1.f, 1.f);
+
+    ASSERT_EQ(s.asphericity, 0.f);
+    ASSERT_EQ(s.taylor,      0.f);
+    ASSERT_EQ(s.eigenvalues.x, 1.f);
+    ASSERT_EQ(s.eigenvalues.z, 1.f);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
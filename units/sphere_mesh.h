@@ -0,0 +1,69 @@
+#pragma once
+
+#include <core/utils/helper_math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+struct MeshData
+{
+    std::vector<float3> vertices;
+    std::vector<int3> faces;
+};
+
+// icosahedron subdivided nsubdivisions times, consistently oriented
+inline MeshData createSphereMesh(float radius, int nsubdivisions)
+{
+    const float t = 0.5f * (1.f + std::sqrt(5.f));
+
+    MeshData mesh;
+    mesh.vertices = {{-1,  t,  0}, { 1,  t,  0}, {-1, -t,  0}, { 1, -t,  0},
+                     { 0, -1,  t}, { 0,  1,  t}, { 0, -1, -t}, { 0,  1, -t},
+                     { t,  0, -1}, { t,  0,  1}, {-t,  0, -1}, {-t,  0,  1}};
+
+    mesh.faces = {{0, 11,  5}, {0,  5,  1}, {0,  1,  7}, {0,  7, 10}, {0, 10, 11},
+                  {1,  5,  9}, {5, 11,  4}, {11, 10, 2}, {10, 7,  6}, {7,  1,  8},
+                  {3,  9,  4}, {3,  4,  2}, {3,  2,  6}, {3,  6,  8}, {3,  8,  9},
+                  {4,  9,  5}, {2,  4, 11}, {6,  2, 10}, {8,  6,  7}, {9,  8,  1}};
+
+    for (int level = 0; level < nsubdivisions; ++level)
+    {
+        std::vector<int3> coarseFaces;
+        coarseFaces.swap(mesh.faces);
+
+        std::map<std::pair<int,int>, int> midPoints;
+
+        auto midPoint = [&](int a, int b)
+        {
+            auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = midPoints.find(key);
+            if (it != midPoints.end())
+                return it->second;
+
+            const int id = mesh.vertices.size();
+            mesh.vertices.push_back(0.5f * (mesh.vertices[a] + mesh.vertices[b]));
+            midPoints[key] = id;
+            return id;
+        };
+
+        for (auto f : coarseFaces)
+        {
+            const int ab = midPoint(f.x, f.y);
+            const int bc = midPoint(f.y, f.z);
+            const int ca = midPoint(f.z, f.x);
+
+            mesh.faces.push_back({f.x, ab, ca});
+            mesh.faces.push_back({f.y, bc, ab});
+            mesh.faces.push_back({f.z, ca, bc});
+            mesh.faces.push_back({ab,  bc, ca});
+        }
+    }
+
+    for (auto& v : mesh.vertices)
+        v = radius * normalize(v);
+
+    return mesh;
+}